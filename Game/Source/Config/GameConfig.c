@@ -1,14 +1,60 @@
 #include "Config/GameConfig.h"
 
+#include <limits.h>
+
 #include "Otter/Config/Config.h"
 #include "Otter/Util/File.h"
 #include "Otter/Util/HashMap.h"
 #include "Otter/Util/Log.h"
+#include "Otter/Util/Sampler.h"
+#include "Otter/Util/String/Number.h"
+
+#define CONFIG_WIDTH                    "width"
+#define CONFIG_HEIGHT                   "height"
+#define CONFIG_SHADER_DIRECTORY         "shaderDirectory"
+#define CONFIG_SAMPLE_MODEL             "sampleModel"
+#define CONFIG_PROFILE_CAPTURE_ON_START "profileCaptureOnStart"
+#define CONFIG_PROFILE_CAPTURE_FRAMES   "profileCaptureFrames"
+#define CONFIG_SAMPLE_ON_START          "sampleOnStart"
+#define CONFIG_SAMPLE_RATE              "sampleRate"
+#define CONFIG_HITCH_BUDGET             "hitchBudget"
+
+static int game_config_get_int(
+    HashMap* configMap, const char* key, int defaultValue)
+{
+  const char* valueStr = hash_map_get_value(configMap, key, strlen(key) + 1);
+  if (valueStr == NULL)
+  {
+    return defaultValue;
+  }
+
+  int64_t value;
+  if (!number_parse_integer(string_view_from_cstr(valueStr), &value)
+      || value < INT_MIN || value > INT_MAX)
+  {
+    LOG_WARNING("Setting %s is not an integer. Using %d.", key, defaultValue);
+    return defaultValue;
+  }
+  return (int) value;
+}
 
-#define CONFIG_WIDTH            "width"
-#define CONFIG_HEIGHT           "height"
-#define CONFIG_SHADER_DIRECTORY "shaderDirectory"
-#define CONFIG_SAMPLE_MODEL     "sampleModel"
+static float game_config_get_float(
+    HashMap* configMap, const char* key, float defaultValue)
+{
+  const char* valueStr = hash_map_get_value(configMap, key, strlen(key) + 1);
+  if (valueStr == NULL)
+  {
+    return defaultValue;
+  }
+
+  double value;
+  if (!number_parse_double(string_view_from_cstr(valueStr), &value))
+  {
+    LOG_WARNING("Setting %s is not a number. Using %g.", key, defaultValue);
+    return defaultValue;
+  }
+  return (float) value;
+}
 
 bool game_config_parse(GameConfig* config, const char* filename)
 {
@@ -26,14 +72,10 @@ bool game_config_parse(GameConfig* config, const char* filename)
     LOG_ERROR("Could not parse configuration.");
     return false;
   }
-  free(configStr);
-
-  char* widthStr =
-      hash_map_get_value(&configMap, CONFIG_WIDTH, strlen(CONFIG_WIDTH) + 1);
-  char* heightStr =
-      hash_map_get_value(&configMap, CONFIG_HEIGHT, strlen(CONFIG_HEIGHT) + 1);
-  config->width  = widthStr != NULL ? atoi(widthStr) : 1920;
-  config->height = heightStr != NULL ? atoi(heightStr) : 1080;
+  config->source = configStr;
+
+  config->width  = game_config_get_int(&configMap, CONFIG_WIDTH, 1920);
+  config->height = game_config_get_int(&configMap, CONFIG_HEIGHT, 1080);
   LOG_DEBUG("Setting window to (%d, %d)", config->width, config->height);
 
   config->shaderDirectory = hash_map_get_value(
@@ -41,10 +83,10 @@ bool game_config_parse(GameConfig* config, const char* filename)
   if (config->shaderDirectory == NULL)
   {
     LOG_ERROR("Shader directory not found in configuration.");
-    hash_map_destroy(&configMap, free);
+    hash_map_destroy(&configMap, NULL);
+    free(configStr);
     return false;
   }
-  config->shaderDirectory = _strdup(config->shaderDirectory);
   LOG_DEBUG("Setting shader directory to %s", config->shaderDirectory);
 
   config->sampleModel = hash_map_get_value(
@@ -52,19 +94,43 @@ bool game_config_parse(GameConfig* config, const char* filename)
   if (config->sampleModel == NULL)
   {
     LOG_ERROR("Sample model not found in configuration.");
-    hash_map_destroy(&configMap, free);
+    hash_map_destroy(&configMap, NULL);
+    free(configStr);
     return false;
   }
-  config->sampleModel = _strdup(config->sampleModel);
   LOG_DEBUG("Setting sample model to %s", config->sampleModel);
 
-  hash_map_destroy(&configMap, free);
+  config->profileCaptureOnStart =
+      game_config_get_int(&configMap, CONFIG_PROFILE_CAPTURE_ON_START, 0) != 0;
+  config->profileCaptureFrames =
+      game_config_get_int(&configMap, CONFIG_PROFILE_CAPTURE_FRAMES, 300);
+  if (config->profileCaptureFrames <= 0)
+  {
+    LOG_WARNING("Setting %s must be positive. Using 300.",
+        CONFIG_PROFILE_CAPTURE_FRAMES);
+    config->profileCaptureFrames = 300;
+  }
+
+  config->sampleOnStart =
+      game_config_get_int(&configMap, CONFIG_SAMPLE_ON_START, 0) != 0;
+  config->sampleRate = game_config_get_int(
+      &configMap, CONFIG_SAMPLE_RATE, SAMPLER_DEFAULT_RATE);
+  if (config->sampleRate <= 0)
+  {
+    LOG_WARNING("Setting %s must be positive. Using %d.", CONFIG_SAMPLE_RATE,
+        SAMPLER_DEFAULT_RATE);
+    config->sampleRate = SAMPLER_DEFAULT_RATE;
+  }
+
+  config->hitchBudget =
+      game_config_get_float(&configMap, CONFIG_HITCH_BUDGET, 0.0f);
+
+  hash_map_destroy(&configMap, NULL);
 
   return true;
 }
 
 void game_config_destroy(GameConfig* config)
 {
-  free(config->shaderDirectory);
-  free(config->sampleModel);
+  free(config->source);
 }
@@ -1,13 +1,29 @@
 #pragma once
 
+#include <stdbool.h>
+
 #define DEFAULT_GAME_CONFIG_PATH "Config/config.ini"
 
 typedef struct GameConfig
 {
   int width;
   int height;
+  // The loaded file. String settings point into it.
+  char* source;
   char* shaderDirectory;
   char* sampleModel;
+  // Capture a profile of the first frames. Captures can also be started with
+  // the capture_profile key.
+  bool profileCaptureOnStart;
+  // Frames each profile capture covers.
+  int profileCaptureFrames;
+  // Sample every thread's stack for the whole run, for flame graphs.
+  bool sampleOnStart;
+  // Samples a second each thread gets.
+  int sampleRate;
+  // Frames longer than this many times the median are written out as
+  // hitches. 0 turns it off.
+  float hitchBudget;
 } GameConfig;
 
 bool game_config_parse(GameConfig* config, const char* filename);
@@ -2,6 +2,7 @@
 
 #include "Input/InputMap.h"
 #include "Otter/Math/Mat.h"
+#include "Otter/Math/Quaternion.h"
 #include "Otter/Render/RenderInstance.h"
 
 void update_camera_position(
@@ -16,9 +17,11 @@ void update_camera_position(
     Vec4 translation = {0.0f, 0.0f, 1.0f, 1.0f};
     Mat4 rotationMatrix;
     mat4_identity(rotationMatrix);
-    mat4_rotate(rotationMatrix, renderInstance->cameraTransform.rotation.x,
+    mat4_rotate_quaternion(rotationMatrix,
+        renderInstance->cameraTransform.rotation.x,
         renderInstance->cameraTransform.rotation.y,
-        renderInstance->cameraTransform.rotation.z);
+        renderInstance->cameraTransform.rotation.z,
+        renderInstance->cameraTransform.rotation.w);
     vec4_multiply_mat4(&translation, rotationMatrix);
 
     Vec3* translation3d = (Vec3*) &translation;
@@ -34,9 +37,11 @@ void update_camera_position(
     Vec4 translation = {1.0f, 0.0f, 0.0f, 1.0f};
     Mat4 rotationMatrix;
     mat4_identity(rotationMatrix);
-    mat4_rotate(rotationMatrix, renderInstance->cameraTransform.rotation.x,
+    mat4_rotate_quaternion(rotationMatrix,
+        renderInstance->cameraTransform.rotation.x,
         renderInstance->cameraTransform.rotation.y,
-        renderInstance->cameraTransform.rotation.z);
+        renderInstance->cameraTransform.rotation.z,
+        renderInstance->cameraTransform.rotation.w);
     vec4_multiply_mat4(&translation, rotationMatrix);
 
     Vec3* translation3d = (Vec3*) &translation;
@@ -48,8 +53,12 @@ void update_camera_position(
   float turnRight = input_map_get_action_value(map, "turn_right");
   if (!isnan(turnLeft) && !isnan(turnRight))
   {
-    renderInstance->cameraTransform.rotation.y +=
-        (turnLeft - turnRight) * deltaTime * 3.f;
+    Vec3 up = {0.0f, 1.0f, 0.0f};
+    Vec4 turn;
+    quaternion_from_axis_angle(
+        &turn, &up, (turnLeft - turnRight) * deltaTime * 3.f);
+    quaternion_multiply(&renderInstance->cameraTransform.rotation, &turn);
+    quaternion_normalize(&renderInstance->cameraTransform.rotation);
   }
 
   float moveUp   = input_map_get_action_value(map, "move_up");
@@ -2,6 +2,7 @@
 
 #include "Otter/Config/Config.h"
 #include "Otter/Util/File.h"
+#include "Otter/Util/String/Number.h"
 
 bool input_map_create(InputMap* map)
 {
@@ -22,6 +23,24 @@ bool input_map_create(InputMap* map)
           &map->actionValues, HASH_MAP_DEFAULT_BUCKETS, HASH_MAP_DEFAULT_COEF);
 }
 
+// Mouse and controller definitions are a prefix letter and a button index.
+static bool input_map_parse_index(
+    char* definition, size_t definitionSize, InputEventSource* source)
+{
+  int64_t index;
+  if (!number_parse_integer(
+          string_view_create(&definition[1], definitionSize - 1), &index)
+      || index < 0 || index > UINT32_MAX)
+  {
+    LOG_WARNING("Invalid input index in %.*s", (int) definitionSize,
+        definition);
+    return false;
+  }
+
+  source->index = (uint32_t) index;
+  return true;
+}
+
 static bool input_map_convert_definition_to_source(
     char* definition, size_t definitionSize, InputEventSource* source)
 {
@@ -33,12 +52,12 @@ static bool input_map_convert_definition_to_source(
   else if (definitionSize > 1 && definition[0] == 'M')
   {
     source->source = INPUT_TYPE_MOUSE;
-    source->index  = atoi(&definition[1]);
+    return input_map_parse_index(definition, definitionSize, source);
   }
   else if (definitionSize > 1 && definition[0] == 'C')
   {
     source->source = INPUT_TYPE_CONTROLLER;
-    source->index  = atoi(&definition[1]);
+    return input_map_parse_index(definition, definitionSize, source);
   }
   else
   {
@@ -85,10 +104,12 @@ void input_map_load_key_binds(InputMap* map, HashMap* key_binds)
 
 void input_map_add_action(InputMap* map, InputEventSource source, char* action)
 {
+  // Every binding for an action shares the name stored as its key in
+  // `actionValues`.
+  size_t actionLength = strlen(action) + 1;
+  hash_map_set_value_float(&map->actionValues, action, actionLength, 0.0f);
   hash_map_set_value(&map->sourceToActions, &source, sizeof(InputEventSource),
-      _strdup(action));
-  hash_map_set_value_float(
-      &map->actionValues, action, strlen(action) + 1, 0.0f);
+      (void*) hash_map_get_key(&map->actionValues, action, actionLength));
 }
 
 bool input_map_load_key_binds_from_file(InputMap* map, const char* path)
@@ -110,11 +131,10 @@ bool input_map_load_key_binds_from_file(InputMap* map, const char* path)
     return false;
   }
 
-  free(keyBindStr);
-
   input_map_load_key_binds(map, &keyBinds);
 
-  hash_map_destroy(&keyBinds, free);
+  hash_map_destroy(&keyBinds, NULL);
+  free(keyBindStr);
 
   return true;
 }
@@ -178,9 +198,6 @@ static void input_map_update_axis(InputMap* map, float value,
 
 static void input_map_update_controller_actions(InputMap* map)
 {
-  AutoArray inputs;
-  auto_array_create(&inputs, sizeof(InputEvent));
-
   XINPUT_STATE state;
   for (DWORD i = 0; i < XUSER_MAX_COUNT; ++i)
   {
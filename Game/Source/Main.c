@@ -13,12 +13,24 @@
 #include "Otter/Render/RenderInstance.h"
 #include "Otter/Render/Texture/Texture.h"
 #include "Otter/Script/ScriptEngine.h"
+#include "Otter/Util/Counter.h"
 #include "Otter/Util/File.h"
+#include "Otter/Util/Lock.h"
 #include "Otter/Util/Log.h"
+#include "Otter/Util/Memory/MemoryTag.h"
 #include "Otter/Util/Profiler.h"
+#include "Otter/Util/Sampler.h"
 #include "Render/RenderSystem.h"
 #include "Window/GameWindow.h"
 
+// Where profile captures are written, relative to the working directory.
+#define PROFILE_CAPTURE_PATH "profile.json"
+// Where stack samples are written. Fold them with otter-samplefold.
+#define SAMPLE_PATH "samples.bin"
+
+// Where frames that take far longer than usual are written.
+#define HITCH_DIRECTORY "hitches"
+
 int main()
 {
   wWinMain(GetModuleHandle(NULL), NULL, L"", 1);
@@ -27,12 +39,14 @@ int main()
 static void update_position(
     Context* context, uint64_t entityId, void** components)
 {
-  Entity* entity =
-      entity_component_map_get_entity(context->entityComponentMap, entityId);
+  TransformStore* transforms = &context->entityComponentMap->transforms;
+  Transform transform;
+  transform_store_get(transforms, entityId, &transform);
 
   Vec3 velocity = *(Vec3*) components[0];
   vec3_multiply(&velocity, context->deltaTime * 10.0f);
-  vec3_add(&entity->transform.position, &velocity);
+  vec3_add(&transform.position, &velocity);
+  transform_store_set(transforms, entityId, &transform);
 }
 
 int WINAPI wWinMain(
@@ -43,36 +57,55 @@ int WINAPI wWinMain(
   (void) cmdLine;
   (void) cmdShow;
 
+  // Before the scheduler so its threads are profiled from the start.
+  LARGE_INTEGER g_timerFrequency;
+  QueryPerformanceFrequency(&g_timerFrequency);
+  profiler_init(g_timerFrequency);
+  profiler_set_thread_name("Main");
+  sampler_register_thread("Main");
+
   task_scheduler_init();
 
   GameConfig config;
   if (!game_config_parse(&config, DEFAULT_GAME_CONFIG_PATH))
   {
+    sampler_stop();
+    profiler_destroy();
     return -1;
   }
 
-  size_t fileLength = 0;
-  char* glbTest     = file_load(config.sampleModel, &fileLength);
-  if (glbTest == NULL)
+  if (config.sampleOnStart)
+  {
+    sampler_start(SAMPLE_PATH, config.sampleRate);
+  }
+
+  // The asset's images point into the mapping, so it stays mapped until they
+  // are on the GPU.
+  FileView glbFile;
+  if (!file_map(config.sampleModel, &glbFile))
   {
     LOG_ERROR("Unable to find file %s", config.sampleModel);
     game_config_destroy(&config);
+    sampler_stop();
+    profiler_destroy();
     return -1;
   }
+  file_prefetch(&glbFile, 0, glbFile.length);
 
   GlbAsset asset;
-  if (!glb_load_asset(glbTest, fileLength, &asset))
+  PROFILE_ZONE("glb_load_asset");
+  bool loaded = glb_load_asset(glbFile.data, glbFile.length, &asset);
+  PROFILE_ZONE_END();
+  if (!loaded)
   {
     LOG_ERROR("Unable to parse %s", config.sampleModel);
-    free(glbTest);
+    file_unmap(&glbFile);
     game_config_destroy(&config);
+    sampler_stop();
+    profiler_destroy();
     return -1;
   }
-  free(glbTest);
 
-  LARGE_INTEGER g_timerFrequency;
-  QueryPerformanceFrequency(&g_timerFrequency);
-  profiler_init(g_timerFrequency);
   HWND window = game_window_create(config.width, config.height, WM_WINDOWED);
   RenderInstance* renderInstance =
       render_instance_create(window, config.shaderDirectory);
@@ -80,8 +113,10 @@ int WINAPI wWinMain(
   {
     LOG_ERROR("Failed to initialize render instance.");
     glb_free_asset(&asset);
+    file_unmap(&glbFile);
     game_config_destroy(&config);
     game_window_destroy(window);
+    sampler_stop();
     profiler_destroy();
     task_scheduler_destroy();
     return -1;
@@ -129,10 +164,12 @@ int WINAPI wWinMain(
   {
     LOG_ERROR("Failed to create cube mesh.");
     glb_free_asset(&asset);
+    file_unmap(&glbFile);
     game_config_destroy(&config);
     task_scheduler_destroy();
     render_instance_destroy(renderInstance);
     game_window_destroy(window);
+    sampler_stop();
     profiler_destroy();
     return -1;
   }
@@ -145,11 +182,13 @@ int WINAPI wWinMain(
   {
     LOG_ERROR("Failed to create default texture.");
     glb_free_asset(&asset);
+    file_unmap(&glbFile);
     game_config_destroy(&config);
     task_scheduler_destroy();
     mesh_destroy(&cubeMesh, renderInstance->logicalDevice);
     render_instance_destroy(renderInstance);
     game_window_destroy(window);
+    sampler_stop();
     profiler_destroy();
     return -1;
   }
@@ -186,15 +225,18 @@ int WINAPI wWinMain(
     {
       LOG_ERROR("Failed to create texture.");
       glb_free_asset(&asset);
+      file_unmap(&glbFile);
       game_config_destroy(&config);
       task_scheduler_destroy();
       mesh_destroy(&cubeMesh, renderInstance->logicalDevice);
       render_instance_destroy(renderInstance);
       game_window_destroy(window);
+      sampler_stop();
       profiler_destroy();
       return -1;
     }
   }
+  file_unmap(&glbFile);
 
   StableAutoArray materials;
   stable_auto_array_create(
@@ -277,6 +319,7 @@ int WINAPI wWinMain(
       mesh_destroy(&cubeMesh, renderInstance->logicalDevice);
       render_instance_destroy(renderInstance);
       game_window_destroy(window);
+      sampler_stop();
       profiler_destroy();
       return -1;
     }
@@ -301,17 +344,24 @@ int WINAPI wWinMain(
 
   SystemRegistry systemRegistry;
   system_registry_create(&systemRegistry);
-  system_registry_register_system(&systemRegistry,
-      (SystemCallback) render_mesh_system, 2, CT_MESH, CT_MATERIAL);
   system_registry_register_system(
       &systemRegistry, (SystemCallback) update_position, 1, CT_VELOCITY);
 
+  // Run after the world matrices are updated for the frame.
+  SystemRegistry renderSystemRegistry;
+  system_registry_create(&renderSystemRegistry);
+  system_registry_register_system(&renderSystemRegistry,
+      (SystemCallback) render_mesh_system, 2, CT_MESH, CT_MATERIAL);
+
   // Create the light.
   // TODO: We probably want to make a parenting system for entities.
   uint64_t light = entity_component_map_create_entity(&entityComponentMap);
   Entity* lightEntity =
       entity_component_map_get_entity(&entityComponentMap, light);
-  lightEntity->transform.position = (Vec3){16.0f, -16.0f, 16.0f};
+  Transform lightTransform;
+  transform_identity(&lightTransform);
+  lightTransform.position = (Vec3){16.0f, -16.0f, 16.0f};
+  transform_store_set(&entityComponentMap.transforms, light, &lightTransform);
 
   entity_component_map_add_component(&entityComponentMap, light, CT_VELOCITY);
   Vec3* velocity = (Vec3*) entity_component_map_get_component(
@@ -341,11 +391,13 @@ int WINAPI wWinMain(
     LOG_ERROR("Failed to create input map.");
     glb_free_asset(&asset);
     entity_component_map_destroy(&entityComponentMap, &scriptEngine);
+    system_registry_destroy(&renderSystemRegistry);
     system_registry_destroy(&systemRegistry);
     script_engine_shutdown(&scriptEngine);
     game_config_destroy(&config);
     render_instance_destroy(renderInstance);
     game_window_destroy(window);
+    sampler_stop();
     profiler_destroy();
     task_scheduler_destroy();
     return -1;
@@ -361,9 +413,23 @@ int WINAPI wWinMain(
       .renderInstance          = renderInstance,
       .entityComponentMap      = &entityComponentMap,
       .deltaTime               = 0};
-  while (!game_window_process_message(window))
+  if (config.profileCaptureOnStart)
+  {
+    profiler_capture_start(PROFILE_CAPTURE_PATH, config.profileCaptureFrames);
+  }
+  profiler_hitch_detect(HITCH_DIRECTORY, config.hitchBudget);
+
+  bool captureHeld = false;
+  while (true)
   {
-    profiler_clock_start("preframe");
+    render_instance_begin_frame(renderInstance);
+    if (game_window_process_message(
+            window, render_instance_get_frame_allocator(renderInstance)))
+    {
+      break;
+    }
+
+    PROFILE_ZONE("preframe");
     LARGE_INTEGER currentTime;
     QueryPerformanceCounter(&currentTime);
     context.deltaTime = ((float) (currentTime.QuadPart - lastFrameTime.QuadPart)
@@ -374,9 +440,21 @@ int WINAPI wWinMain(
 
     update_camera_position(&inputMap, renderInstance, context.deltaTime);
 
+    bool capturePressed =
+        input_map_get_action_value(&inputMap, "capture_profile") > 0.5f;
+    if (capturePressed && !captureHeld && !profiler_capture_active())
+    {
+      profiler_capture_start(
+          PROFILE_CAPTURE_PATH, config.profileCaptureFrames);
+    }
+    captureHeld = capturePressed;
+
     system_registry_run_systems(&systemRegistry, &entityComponentMap, &context);
     entity_component_map_run_scripts(
         &entityComponentMap, &scriptEngine, &context);
+    transform_store_update(&entityComponentMap.transforms);
+    system_registry_run_systems(
+        &renderSystemRegistry, &entityComponentMap, &context);
 
     // Draw scene
     Mat4 floorTransform;
@@ -405,21 +483,22 @@ int WINAPI wWinMain(
             assetMesh, material, glbAsset->transform, renderInstance);
       }
     }
-    profiler_clock_end("preframe");
+    PROFILE_ZONE_END();
 
     render_instance_draw(renderInstance);
+    // Counters go first so captures get the frame's totals.
+    counter_update();
+    profiler_update();
+    memory_tag_update();
 
     // TODO: Make a timer utility. THis is just getting ridiculous.
     if ((float) (currentTime.QuadPart - lastStatTime.QuadPart)
             / g_timerFrequency.QuadPart
         > 1.0f)
     {
-      const char* keys[] = {};
-      for (int i = 0; i < _countof(keys); i++)
-      {
-        float time = profiler_clock_get(keys[i]);
-        printf("[%s]        \t%f ms\n", keys[i], time * 1000.0f);
-      }
+      profiler_report(stdout);
+      memory_tag_report(stdout);
+      counter_report(stdout);
       lastStatTime = currentTime;
     }
 
@@ -447,6 +526,7 @@ int WINAPI wWinMain(
 
   glb_free_asset(&asset);
   script_engine_shutdown(&scriptEngine);
+  system_registry_destroy(&renderSystemRegistry);
   system_registry_destroy(&systemRegistry);
   entity_component_map_destroy(&entityComponentMap, &scriptEngine);
   stable_auto_array_destroy(&materials);
@@ -457,8 +537,13 @@ int WINAPI wWinMain(
   mesh_destroy(&cubeMesh, renderInstance->logicalDevice);
   render_instance_destroy(renderInstance);
   game_window_destroy(window);
+  sampler_stop();
   profiler_destroy();
 
+  lock_report(stdout);
+  // Anything still counted here was never freed.
+  memory_tag_report(stdout);
+
   return 0;
 }
 
@@ -119,7 +119,8 @@ static LRESULT CALLBACK game_window_process(
     DestroyWindow(window);
     break;
   case WM_DESTROY:
-    auto_array_destroy(inputs);
+    // The events themselves belong to whichever frame allocator they were
+    // recorded into.
     free(inputs);
     PostQuitMessage(0);
     break;
@@ -192,10 +193,13 @@ void game_window_destroy(HWND window)
   DestroyWindow(window);
 }
 
-bool game_window_process_message(HWND window)
+bool game_window_process_message(HWND window, Allocator* frameAllocator)
 {
-  // Clear out old input events.
-  auto_array_clear((AutoArray*) GetWindowLongPtr(window, GWLP_USERDATA));
+  // Drop old input events. Their storage is released along with the frame
+  // they were recorded in.
+  auto_array_create_with_allocator(
+      (AutoArray*) GetWindowLongPtr(window, GWLP_USERDATA), sizeof(InputEvent),
+      frameAllocator);
 
   MSG msg;
   while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
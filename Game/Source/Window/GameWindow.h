@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Otter/Util/Memory/Allocator.h"
+
 enum WindowMode
 {
   WM_WINDOWED,
@@ -8,4 +10,4 @@ enum WindowMode
 
 HWND game_window_create(int width, int height, enum WindowMode windowMode);
 void game_window_destroy(HWND window);
-bool game_window_process_message(HWND window);
+bool game_window_process_message(HWND window, Allocator* frameAllocator);
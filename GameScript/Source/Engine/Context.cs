@@ -28,9 +28,10 @@ namespace OtterEngine
 
     public Transform GetTransform(ulong entity)
     {
-      IntPtr entityPtr = EntityComponentMap.entity_component_map_get_entity(_entityMap, entity);
-      IntPtr entityTransform = Entity.entity_get_transform(entityPtr);
-      return Marshal.PtrToStructure<Transform>(entityTransform);
+      IntPtr transforms = EntityComponentMap.entity_component_map_get_transforms(_entityMap);
+      NativeTransform transform;
+      TransformStore.transform_store_get(transforms, entity, out transform);
+      return transform.ToTransform();
     }
   }
 }
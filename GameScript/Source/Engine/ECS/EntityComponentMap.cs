@@ -10,5 +10,8 @@ namespace OtterEngine.ECS
 
     [DllImport("OtterECS", CallingConvention = CallingConvention.Cdecl)]
     public static extern IntPtr entity_component_map_get_entity(IntPtr map, ulong entity);
+
+    [DllImport("OtterECS", CallingConvention = CallingConvention.Cdecl)]
+    public static extern IntPtr entity_component_map_get_transforms(IntPtr map);
   }
 }
@@ -0,0 +1,37 @@
+namespace OtterEngine.ECS
+{
+  using System;
+  using System.Runtime.InteropServices;
+  using OtterEngine.Math;
+
+  // Laid out like the native Transform. It's blittable, so it's pinned and
+  // written in place rather than copied through unmanaged memory.
+  [StructLayout(LayoutKind.Sequential)]
+  internal struct NativeTransform
+  {
+    public float positionX;
+    public float positionY;
+    public float positionZ;
+    public float rotationX;
+    public float rotationY;
+    public float rotationZ;
+    public float rotationW;
+    public float scaleX;
+    public float scaleY;
+    public float scaleZ;
+
+    public Transform ToTransform()
+    {
+      return new Transform(
+        new Vec3(positionX, positionY, positionZ),
+        new Quaternion(rotationX, rotationY, rotationZ, rotationW),
+        new Vec3(scaleX, scaleY, scaleZ));
+    }
+  }
+
+  internal class TransformStore
+  {
+    [DllImport("OtterECS", CallingConvention = CallingConvention.Cdecl)]
+    public static extern void transform_store_get(IntPtr store, ulong entity, out NativeTransform transform);
+  }
+}
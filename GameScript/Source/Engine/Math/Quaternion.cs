@@ -0,0 +1,32 @@
+namespace OtterEngine.Math
+{
+  using System;
+  using System.Runtime.InteropServices;
+
+  [StructLayout(LayoutKind.Sequential)]
+  class Quaternion
+  {
+    public float x;
+    public float y;
+    public float z;
+    public float w;
+
+    public Quaternion(float x, float y, float z, float w)
+    {
+      this.x = x;
+      this.y = y;
+      this.z = z;
+      this.w = w;
+    }
+
+    public static Quaternion Identity()
+    {
+      return new Quaternion(0, 0, 0, 1);
+    }
+
+    public override string ToString()
+    {
+      return "(" + x + ", " + y + ", " + z + ", " + w + ")";
+    }
+  }
+}
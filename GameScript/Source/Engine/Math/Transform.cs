@@ -7,17 +7,17 @@ namespace OtterEngine.Math
   class Transform
   {
     public Vec3 position;
-    public Vec3 rotation;
+    public Quaternion rotation;
     public Vec3 scale;
 
     public Transform()
     {
       position = new Vec3(0, 0, 0);
-      rotation = new Vec3(0, 0, 0);
+      rotation = Quaternion.Identity();
       scale = new Vec3(1, 1, 1);
     }
 
-    public Transform(Vec3 position, Vec3 rotation, Vec3 scale)
+    public Transform(Vec3 position, Quaternion rotation, Vec3 scale)
     {
       this.position = position;
       this.rotation = rotation;
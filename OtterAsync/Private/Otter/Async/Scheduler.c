@@ -1,11 +1,22 @@
 #include "Otter/Async/Scheduler.h"
 
+#include <stdio.h>
+
+#include "Otter/Util/Counter.h"
+#include "Otter/Util/Lock.h"
+#include "Otter/Util/Memory/PoolAllocator.h"
+#include "Otter/Util/Profiler.h"
+#include "Otter/Util/Sampler.h"
+
 typedef struct TaskData
 {
   void* userData;
   enum TaskFlags flags;
   HANDLE completionHandle;
   TaskFunction function;
+  // Arrow in profile captures from where the task was queued to where it
+  // ran. 0 when nothing was capturing.
+  uint64_t flow;
   struct TaskData* next;
 } TaskData;
 
@@ -20,10 +31,11 @@ typedef struct ThreadData
 
 static HANDLE g_endOfProcess;
 static HANDLE g_schedulerThread;
-static CRITICAL_SECTION g_taskQueueLock;
+static Lock g_taskQueueLock;
 static TaskData* g_taskQueueHead;
 static TaskData* g_taskQueueTail;
 static int g_numberOfThreads;
+static PoolAllocator g_taskAllocator;
 
 int task_scheduler_get_number_of_threads()
 {
@@ -33,7 +45,7 @@ int task_scheduler_get_number_of_threads()
 static TaskData* task_scheduler_dequeue()
 {
   TaskData* taskData = NULL;
-  EnterCriticalSection(&g_taskQueueLock);
+  LOCK_ACQUIRE(&g_taskQueueLock);
   if (g_taskQueueHead != NULL)
   {
     taskData        = g_taskQueueHead;
@@ -43,12 +55,17 @@ static TaskData* task_scheduler_dequeue()
       g_taskQueueTail = NULL;
     }
   }
-  LeaveCriticalSection(&g_taskQueueLock);
+  LOCK_RELEASE(&g_taskQueueLock);
   return taskData;
 }
 
 static DWORD WINAPI task_process(ThreadData* threadData)
 {
+  char name[32];
+  snprintf(name, sizeof(name), "Task worker %d", threadData->threadId);
+  profiler_set_thread_name(name);
+  sampler_register_thread(name);
+
   HANDLE eventHandles[] = {threadData->endThread, threadData->functionReady};
   while (true)
   {
@@ -61,8 +78,11 @@ static DWORD WINAPI task_process(ThreadData* threadData)
       break;
     }
 
+    PROFILE_ZONE("task");
+    profiler_flow_end(threadData->taskData->flow);
     threadData->taskData->function(
         threadData->taskData->userData, threadData->threadId);
+    PROFILE_ZONE_END();
     if (threadData->taskData->completionHandle != NULL)
     {
       SetEvent(threadData->taskData->completionHandle);
@@ -73,7 +93,8 @@ static DWORD WINAPI task_process(ThreadData* threadData)
       free(threadData->taskData->userData);
     }
 
-    free(threadData->taskData);
+    allocator_deallocate(
+        &g_taskAllocator.allocator, threadData->taskData, sizeof(TaskData));
     threadData->taskData = NULL;
   }
 
@@ -133,7 +154,8 @@ static DWORD WINAPI task_scheduler(void* unused)
 
 void task_scheduler_init()
 {
-  InitializeCriticalSection(&g_taskQueueLock);
+  lock_create(&g_taskQueueLock, "task_queue_lock");
+  pool_allocator_create(&g_taskAllocator);
   g_endOfProcess    = CreateEvent(NULL, true, false, NULL);
   g_schedulerThread = CreateThread(NULL, 0, task_scheduler, NULL, 0, NULL);
 }
@@ -144,13 +166,15 @@ void task_scheduler_destroy()
   WaitForSingleObject(g_schedulerThread, 30000);
   CloseHandle(g_endOfProcess);
   CloseHandle(g_schedulerThread);
-  DeleteCriticalSection(&g_taskQueueLock);
+  lock_destroy(&g_taskQueueLock);
+  pool_allocator_destroy(&g_taskAllocator);
 }
 
 HANDLE task_scheduler_enqueue(
     TaskFunction function, void* data, enum TaskFlags flags)
 {
-  TaskData* taskData = malloc(sizeof(TaskData));
+  TaskData* taskData =
+      allocator_allocate(&g_taskAllocator.allocator, sizeof(TaskData));
   if (taskData == NULL)
   {
     return NULL;
@@ -160,9 +184,10 @@ HANDLE task_scheduler_enqueue(
   taskData->userData         = data;
   taskData->flags            = flags;
   taskData->completionHandle = CreateEvent(NULL, true, false, NULL);
+  taskData->flow             = profiler_flow_begin();
   taskData->next             = NULL;
 
-  EnterCriticalSection(&g_taskQueueLock);
+  LOCK_ACQUIRE(&g_taskQueueLock);
   if (g_taskQueueHead != NULL)
   {
     g_taskQueueTail->next = taskData;
@@ -173,7 +198,8 @@ HANDLE task_scheduler_enqueue(
     g_taskQueueHead = taskData;
     g_taskQueueTail = taskData;
   }
-  LeaveCriticalSection(&g_taskQueueLock);
+  LOCK_RELEASE(&g_taskQueueLock);
+  COUNTER_ADD(tasks_enqueued, 1);
 
   return taskData->completionHandle;
 }
@@ -80,16 +80,12 @@ bool config_parse(HashMap* configMap, char* config)
     }
     line[separator] = '\0';
 
-    char* key = line;
+    // Both halves are already null terminated in place, so the map can point
+    // straight into the buffer.
+    char* key   = line;
+    char* value = &line[separator + 1];
 
-    char* value = _strdup(&line[separator + 1]);
-    if (value == NULL)
-    {
-      LOG_WARNING("Invalid value on line %d", lineNumber);
-      continue;
-    }
-
-    if (!hash_map_set_value(configMap, key, strlen(key) + 1, value))
+    if (!hash_map_set_value(configMap, key, separator + 1, value))
     {
       LOG_ERROR("Failed to set value for key %s", key);
       return false;
@@ -3,4 +3,14 @@
 #include "Otter/Config/export.h"
 #include "Otter/Util/HashMap.h"
 
+/**
+ * @brief Parse `key=value` lines into `map`.
+ *
+ * The buffer is modified in place and values point into it, so `config` must
+ * outlive the map. Destroy the map without a destructor.
+ *
+ * @param map The map to create and fill.
+ * @param config The null terminated contents of a config file.
+ * @return true if the map could be created and filled, false otherwise.
+ */
 OTTERCONFIG_API bool config_parse(HashMap* map, char* config);
@@ -2,16 +2,17 @@
 
 #include "Otter/Util/Log.h"
 
-void component_pool_create(ComponentPool* pool)
+void component_pool_create(ComponentPool* pool, Allocator* allocator)
 {
   pool->registeredComponents = 0;
+  pool->allocator            = allocator;
 }
 
 void component_pool_destroy(ComponentPool* pool)
 {
   for (uint64_t i = 0; i < _countof(pool->componentLists); ++i)
   {
-    if (pool->registeredComponents & (1 << i))
+    if (pool->registeredComponents & (1ULL << i))
     {
       sparse_auto_array_destroy(&pool->componentLists[i]);
     }
@@ -21,21 +22,22 @@ void component_pool_destroy(ComponentPool* pool)
 void component_pool_register_component(
     ComponentPool* pool, uint64_t componentIndex, uint64_t componentSize)
 {
-  if (pool->registeredComponents & (1 << componentIndex))
+  if (pool->registeredComponents & (1ULL << componentIndex))
   {
     LOG_WARNING("Component %llu is already registered", componentIndex);
     return;
   }
 
-  pool->registeredComponents |= (1 << componentIndex);
-  sparse_auto_array_create(
-      &pool->componentLists[componentIndex], componentSize);
+  pool->registeredComponents |= (1ULL << componentIndex);
+  // Reserved so component pointers survive other components being added.
+  sparse_auto_array_create_reserved(&pool->componentLists[componentIndex],
+      componentSize, COMPONENT_POOL_MAX_COMPONENTS, pool->allocator);
 }
 
 uint64_t component_pool_allocate_component(
     ComponentPool* pool, uint64_t componentIndex)
 {
-  if (!(pool->registeredComponents & (1 << componentIndex)))
+  if (!(pool->registeredComponents & (1ULL << componentIndex)))
   {
     LOG_WARNING("Component %llu is not registered", componentIndex);
     return COMPONENT_ID_INVALID;
@@ -47,7 +49,7 @@ uint64_t component_pool_allocate_component(
 void component_pool_deallocate_component(
     ComponentPool* pool, uint64_t componentIndex, uint64_t component)
 {
-  if (!(pool->registeredComponents & (1 << componentIndex)))
+  if (!(pool->registeredComponents & (1ULL << componentIndex)))
   {
     LOG_WARNING("Component %llu is not registered", componentIndex);
     return;
@@ -60,7 +62,7 @@ void component_pool_deallocate_component(
 void* component_pool_get_component(
     ComponentPool* pool, uint64_t componentIndex, uint64_t component)
 {
-  if (!(pool->registeredComponents & (1 << componentIndex)))
+  if (!(pool->registeredComponents & (1ULL << componentIndex)))
   {
     LOG_WARNING("Component %llu is not registered", componentIndex);
     return NULL;
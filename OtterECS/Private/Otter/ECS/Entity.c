@@ -1,14 +1,14 @@
 #include "Otter/ECS/Entity.h"
 
-bool entity_create(Entity* entity, uint64_t id)
+bool entity_create(Entity* entity, uint64_t id, Allocator* allocator)
 {
-  if (!hash_map_create(&entity->componentIndices, HASH_MAP_DEFAULT_BUCKETS,
-          HASH_MAP_DEFAULT_COEF))
+  if (!hash_map_create_with_allocator(&entity->componentIndices,
+          HASH_MAP_DEFAULT_BUCKETS, HASH_MAP_DEFAULT_COEF, allocator))
   {
     return false;
   }
-  sparse_auto_array_create(&entity->scripts, sizeof(uint32_t));
-  transform_identity(&entity->transform);
+  sparse_auto_array_create_with_allocator(
+      &entity->scripts, sizeof(uint32_t), allocator);
   entity->id = id;
 
   return true;
@@ -68,9 +68,3 @@ void entity_run_update(Entity* entity, uint64_t entityId,
     }
   }
 }
-
-Transform* entity_get_transform(Entity* entity)
-{
-  return &entity->transform;
-}
-
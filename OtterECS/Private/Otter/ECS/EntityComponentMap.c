@@ -4,12 +4,19 @@
 #include "Otter/Util/Array/SparseAutoArray.h"
 #include "Otter/Util/HashMap.h"
 #include "Otter/Util/Log.h"
+#include "Otter/Util/Memory/MemoryTag.h"
 
 void entity_component_map_create(EntityComponentMap* map)
 {
-  sparse_auto_array_create(&map->entities, sizeof(Entity));
-  bit_map_create(&map->components);
-  component_pool_create(&map->componentPool);
+  // Entities, their component indices and the component storage are all
+  // small and churn often, so keep them out of the general heap. Entities are
+  // reserved up front so `Entity*` stays valid while more are created.
+  pool_allocator_create_tagged(&map->allocator, MEMORY_TAG_ECS);
+  sparse_auto_array_create_reserved(&map->entities, sizeof(Entity),
+      ENTITY_COMPONENT_MAP_MAX_ENTITIES, &map->allocator.allocator);
+  bit_map_create_with_allocator(&map->components, &map->allocator.allocator);
+  component_pool_create(&map->componentPool, &map->allocator.allocator);
+  transform_store_create(&map->transforms);
 }
 
 static void entity_component_map_destroy_all_components(EntityComponentMap* map,
@@ -29,15 +36,18 @@ void entity_component_map_destroy(
 {
   entity_component_map_destroy_all_components(
       map, &map->componentPool, scriptEngine);
+  component_pool_destroy(&map->componentPool);
+  transform_store_destroy(&map->transforms);
   bit_map_destroy(&map->components);
   sparse_auto_array_destroy(&map->entities);
+  pool_allocator_destroy(&map->allocator);
 }
 
 uint64_t entity_component_map_create_entity(EntityComponentMap* map)
 {
   uint64_t index = sparse_auto_array_allocate(&map->entities);
   Entity* entity = (Entity*) sparse_auto_array_get(&map->entities, index);
-  if (!entity_create(entity, index))
+  if (!entity_create(entity, index, &map->allocator.allocator))
   {
     // TODO: Handle error.
     LOG_ERROR("Unable to create entity.");
@@ -48,6 +58,7 @@ uint64_t entity_component_map_create_entity(EntityComponentMap* map)
   {
     bit_map_expand(&map->components);
   }
+  transform_store_add(&map->transforms, index);
 
   return index;
 }
@@ -143,3 +154,8 @@ void entity_component_map_run_scripts(
     }
   }
 }
+
+TransformStore* entity_component_map_get_transforms(EntityComponentMap* map)
+{
+  return &map->transforms;
+}
@@ -5,6 +5,9 @@
 #include "Otter/ECS/EntityComponentMap.h"
 #include "Otter/Util/Array/SparseAutoArray.h"
 #include "Otter/Util/BitMap.h"
+#include "Otter/Util/Counter.h"
+#include "Otter/Util/Memory/MemoryTag.h"
+#include "Otter/Util/Profiler.h"
 
 typedef struct System
 {
@@ -15,7 +18,8 @@ typedef struct System
 
 void system_registry_create(SystemRegistry* registry)
 {
-  sparse_auto_array_create(registry, sizeof(System));
+  sparse_auto_array_create_with_allocator(
+      registry, sizeof(System), memory_tag_get_allocator(MEMORY_TAG_ECS));
 }
 
 void system_registry_destroy(SystemRegistry* registry)
@@ -41,7 +45,8 @@ uint64_t system_registry_register_system(SystemRegistry* registry,
   System* system        = (System*) sparse_auto_array_get(registry, id);
   system->system        = systemCallback;
   system->componentMask = 0;
-  auto_array_create(&system->components, sizeof(uint64_t));
+  auto_array_create_with_allocator(&system->components, sizeof(uint64_t),
+      memory_tag_get_allocator(MEMORY_TAG_ECS));
 
   for (int i = 0; i < componentCount; ++i)
   {
@@ -68,6 +73,7 @@ static void system_registry_run_system(
 {
   void* components[sizeof(BitMapSlot) * 8] = {0};
   uint64_t componentCount                  = 0;
+  uint64_t iterated                        = 0;
 
   for (uint64_t entityId = 0;
        entityId < entityComponentMap->entities.components.size; ++entityId)
@@ -93,14 +99,17 @@ static void system_registry_run_system(
 
         system->system(context, entityId, components);
         componentCount = 0;
+        iterated++;
       }
     }
   }
+  COUNTER_ADD(entities_iterated, iterated);
 }
 
 void system_registry_run_systems(SystemRegistry* registry,
     EntityComponentMap* entityComponentMap, void* context)
 {
+  PROFILE_ZONE("system_registry_run_systems");
   for (uint64_t i = 0; i < registry->components.size; ++i)
   {
     System* system = (System*) sparse_auto_array_get(registry, i);
@@ -109,4 +118,5 @@ void system_registry_run_systems(SystemRegistry* registry,
       system_registry_run_system(system, entityComponentMap, context);
     }
   }
+  PROFILE_ZONE_END();
 }
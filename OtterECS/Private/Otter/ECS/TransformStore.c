@@ -0,0 +1,211 @@
+#include "Otter/ECS/TransformStore.h"
+
+#include <string.h>
+
+#include "Otter/Async/Scheduler.h"
+#include "Otter/Util/Counter.h"
+#include "Otter/Util/Memory/MemoryTag.h"
+#include "Otter/Util/Profiler.h"
+
+typedef struct TransformStoreTask
+{
+  TransformStore* store;
+  TransformArrays transforms;
+  size_t firstBlock;
+  size_t endBlock;
+} TransformStoreTask;
+
+void transform_store_create(TransformStore* store)
+{
+  Allocator* allocator = memory_tag_get_allocator(MEMORY_TAG_ECS);
+  for (int i = 0; i < 3; i++)
+  {
+    auto_array_create_with_allocator(
+        &store->position[i], sizeof(float), allocator);
+    auto_array_create_with_allocator(
+        &store->scale[i], sizeof(float), allocator);
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    auto_array_create_with_allocator(
+        &store->rotation[i], sizeof(float), allocator);
+  }
+  auto_array_create_with_allocator(
+      &store->worldMatrices, sizeof(Mat4), allocator);
+  auto_array_create_with_allocator(
+      &store->dirtyBlocks, sizeof(bool), allocator);
+}
+
+void transform_store_destroy(TransformStore* store)
+{
+  for (int i = 0; i < 3; i++)
+  {
+    auto_array_destroy(&store->position[i]);
+    auto_array_destroy(&store->scale[i]);
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    auto_array_destroy(&store->rotation[i]);
+  }
+  auto_array_destroy(&store->worldMatrices);
+  auto_array_destroy(&store->dirtyBlocks);
+}
+
+static void transform_store_grow_component(AutoArray* component)
+{
+  memset(auto_array_allocate_many(component, TRANSFORM_STORE_BLOCK), 0,
+      TRANSFORM_STORE_BLOCK * sizeof(float));
+}
+
+void transform_store_add(TransformStore* store, uint64_t entityId)
+{
+  // IDs in new blocks that no entity has yet are left zeroed. They're made
+  // into matrices along with the rest of the block, which does no harm.
+  while (store->dirtyBlocks.size * TRANSFORM_STORE_BLOCK <= entityId)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      transform_store_grow_component(&store->position[i]);
+      transform_store_grow_component(&store->scale[i]);
+    }
+    for (int i = 0; i < 4; i++)
+    {
+      transform_store_grow_component(&store->rotation[i]);
+    }
+    auto_array_allocate_many(&store->worldMatrices, TRANSFORM_STORE_BLOCK);
+    *(bool*) auto_array_allocate(&store->dirtyBlocks) = true;
+  }
+
+  Transform identity;
+  transform_identity(&identity);
+  transform_store_set(store, entityId, &identity);
+}
+
+void transform_store_get(
+    TransformStore* store, uint64_t entityId, Transform* transform)
+{
+  for (int i = 0; i < 3; i++)
+  {
+    transform->position.val[i] =
+        *(float*) auto_array_get(&store->position[i], entityId);
+    transform->scale.val[i] =
+        *(float*) auto_array_get(&store->scale[i], entityId);
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    transform->rotation.val[i] =
+        *(float*) auto_array_get(&store->rotation[i], entityId);
+  }
+}
+
+void transform_store_set(
+    TransformStore* store, uint64_t entityId, const Transform* transform)
+{
+  for (int i = 0; i < 3; i++)
+  {
+    *(float*) auto_array_get(&store->position[i], entityId) =
+        transform->position.val[i];
+    *(float*) auto_array_get(&store->scale[i], entityId) =
+        transform->scale.val[i];
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    *(float*) auto_array_get(&store->rotation[i], entityId) =
+        transform->rotation.val[i];
+  }
+  *(bool*) auto_array_get(
+      &store->dirtyBlocks, entityId / TRANSFORM_STORE_BLOCK) = true;
+}
+
+// Make the matrices of each run of dirty blocks in the task's range with one
+// kernel call.
+static void transform_store_update_blocks(
+    TransformStoreTask* task, int threadId)
+{
+  (void) threadId;
+
+  bool* dirtyBlocks = task->store->dirtyBlocks.buffer;
+  Mat4* matrices    = task->store->worldMatrices.buffer;
+  size_t updated    = 0;
+
+  size_t block = task->firstBlock;
+  while (block < task->endBlock)
+  {
+    size_t end = block;
+    while (end < task->endBlock && dirtyBlocks[end])
+    {
+      dirtyBlocks[end] = false;
+      end++;
+    }
+
+    if (end > block)
+    {
+      transform_arrays_to_matrices(&task->transforms,
+          block * TRANSFORM_STORE_BLOCK, (end - block) * TRANSFORM_STORE_BLOCK,
+          matrices);
+      updated += (end - block) * TRANSFORM_STORE_BLOCK;
+      block = end;
+    }
+    else
+    {
+      block++;
+    }
+  }
+  COUNTER_ADD(world_matrices_updated, updated);
+}
+
+void transform_store_update(TransformStore* store)
+{
+  PROFILE_ZONE("transform_store_update");
+  TransformStoreTask task = {.store = store};
+  for (int i = 0; i < 3; i++)
+  {
+    task.transforms.position[i] = store->position[i].buffer;
+    task.transforms.scale[i]    = store->scale[i].buffer;
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    task.transforms.rotation[i] = store->rotation[i].buffer;
+  }
+
+  size_t blockCount = store->dirtyBlocks.size;
+  size_t taskCount  = blockCount / TRANSFORM_STORE_TASK_BLOCKS;
+  size_t threads    = (size_t) task_scheduler_get_number_of_threads();
+  if (taskCount > threads)
+  {
+    taskCount = threads;
+  }
+
+  // Too few blocks to be worth waking workers for, or no scheduler running.
+  if (taskCount <= 1)
+  {
+    task.endBlock = blockCount;
+    transform_store_update_blocks(&task, 0);
+  }
+  else
+  {
+    TransformStoreTask tasks[TASK_SCHEDULER_THREADS];
+    HANDLE handles[TASK_SCHEDULER_THREADS];
+    for (size_t i = 0; i < taskCount; i++)
+    {
+      tasks[i]            = task;
+      tasks[i].firstBlock = blockCount * i / taskCount;
+      tasks[i].endBlock   = blockCount * (i + 1) / taskCount;
+      handles[i]          = task_scheduler_enqueue(
+          (TaskFunction) transform_store_update_blocks, &tasks[i], 0);
+    }
+
+    for (size_t i = 0; i < taskCount; i++)
+    {
+      WaitForSingleObject(handles[i], INFINITE);
+      CloseHandle(handles[i]);
+    }
+  }
+  PROFILE_ZONE_END();
+}
+
+Mat4* transform_store_get_world_matrix(
+    TransformStore* store, uint64_t entityId)
+{
+  return (Mat4*) auto_array_get(&store->worldMatrices, entityId);
+}
@@ -3,13 +3,17 @@
 #include "Otter/ECS/export.h"
 #include "Otter/Util/Array/SparseAutoArray.h"
 
+#define COMPONENT_POOL_MAX_COMPONENTS (1024 * 1024)
+
 typedef struct ComponentPool
 {
   SparseAutoArray componentLists[64];
   uint64_t registeredComponents;
+  Allocator* allocator;
 } ComponentPool;
 
-OTTERECS_API void component_pool_create(ComponentPool* pool);
+OTTERECS_API void component_pool_create(
+    ComponentPool* pool, Allocator* allocator);
 
 OTTERECS_API void component_pool_destroy(ComponentPool* pool);
 
@@ -2,15 +2,21 @@
 
 #include "Otter/ECS/ComponentPool.h"
 #include "Otter/ECS/Entity.h"
+#include "Otter/ECS/TransformStore.h"
 #include "Otter/ECS/export.h"
 #include "Otter/Util/Array/SparseAutoArray.h"
 #include "Otter/Util/BitMap.h"
+#include "Otter/Util/Memory/PoolAllocator.h"
+
+#define ENTITY_COMPONENT_MAP_MAX_ENTITIES (1024 * 1024)
 
 typedef struct EntityComponentMap
 {
+  PoolAllocator allocator;
   SparseAutoArray entities;
   BitMap components;
   ComponentPool componentPool;
+  TransformStore transforms;
 } EntityComponentMap;
 
 OTTERECS_API void entity_component_map_create(EntityComponentMap* map);
@@ -39,3 +45,9 @@ OTTERECS_API void* entity_component_map_get_component(
 OTTERECS_API void entity_component_map_run_scripts(
     EntityComponentMap* map, ScriptEngine* scriptEngine, void* context);
 
+/**
+ * @brief Get the store holding every entity's transform, for callers that
+ * can't reach into the map.
+ */
+OTTERECS_API TransformStore* entity_component_map_get_transforms(
+    EntityComponentMap* map);
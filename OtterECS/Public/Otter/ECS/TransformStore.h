@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Otter/ECS/export.h"
+#include "Otter/Math/Transform.h"
+#include "Otter/Util/Array/AutoArray.h"
+
+// How many entities' matrices are made together. They share a dirty flag, and
+// the store grows by this many at a time so every kernel load is full.
+#define TRANSFORM_STORE_BLOCK 8
+
+// The fewest blocks worth giving a scheduler worker of their own.
+#define TRANSFORM_STORE_TASK_BLOCKS 128
+
+/**
+ * @brief The transform of every entity, indexed by entity ID. Each component
+ * has its own array so many world matrices can be made at once, and the
+ * matrices are packed in one array for systems to read.
+ */
+typedef struct TransformStore
+{
+  AutoArray position[3];
+  AutoArray rotation[4];
+  AutoArray scale[3];
+  AutoArray worldMatrices;
+  // Whether a transform in each block changed since the last update.
+  AutoArray dirtyBlocks;
+} TransformStore;
+
+OTTERECS_API void transform_store_create(TransformStore* store);
+
+OTTERECS_API void transform_store_destroy(TransformStore* store);
+
+/**
+ * @brief Give `entityId` the identity transform, growing the store if the ID
+ * is past the end.
+ */
+OTTERECS_API void transform_store_add(TransformStore* store, uint64_t entityId);
+
+OTTERECS_API void transform_store_get(
+    TransformStore* store, uint64_t entityId, Transform* transform);
+
+/** @brief Change the entity's transform, which is seen by the next update. */
+OTTERECS_API void transform_store_set(
+    TransformStore* store, uint64_t entityId, const Transform* transform);
+
+/**
+ * @brief Make the world matrix of every block with a changed transform,
+ * splitting the blocks between the scheduler's workers when there are enough
+ * of them. Blocks that didn't change are skipped.
+ */
+OTTERECS_API void transform_store_update(TransformStore* store);
+
+/** @brief Get the entity's world matrix as of the last update. */
+OTTERECS_API Mat4* transform_store_get_world_matrix(
+    TransformStore* store, uint64_t entityId);
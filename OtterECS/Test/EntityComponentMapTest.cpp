@@ -179,3 +179,23 @@ TEST(EntityComponentMap, GetComponent)
 
   entity_component_map_destroy(&map, NULL);
 }
+
+TEST(EntityComponentMap, CreateEntityHasIdentityTransform)
+{
+  EntityComponentMap map;
+  entity_component_map_create(&map);
+
+  uint64_t entity = entity_component_map_create_entity(&map);
+  transform_store_update(&map.transforms);
+
+  Mat4* matrix = transform_store_get_world_matrix(&map.transforms, entity);
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      EXPECT_FLOAT_EQ((*matrix)[i][j], i == j ? 1.0f : 0.0f);
+    }
+  }
+
+  entity_component_map_destroy(&map, NULL);
+}
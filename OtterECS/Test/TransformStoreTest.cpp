@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "Otter/ECS/TransformStore.h"
+
+#include "Otter/Async/Scheduler.h"
+#include "Otter/Math/Quaternion.h"
+}
+
+static void make_transform(Transform* transform, int seed)
+{
+  transform->position = {{{1.5f * seed, -0.25f * seed, 3.0f}}};
+  transform->scale    = {{{1.0f + 0.1f * seed, 0.5f, -2.0f}}};
+  quaternion_from_euler(
+      &transform->rotation, 0.3f * seed, 1.1f - 0.2f * seed, -0.7f);
+}
+
+static void expect_world_matrix(
+    TransformStore* store, uint64_t entity, const Transform* transform)
+{
+  Mat4 expected;
+  transform_to_matrix(expected, transform);
+  Mat4* actual = transform_store_get_world_matrix(store, entity);
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      EXPECT_FLOAT_EQ(expected[i][j], (*actual)[i][j])
+          << "entity " << entity << " [" << i << "][" << j << "]";
+    }
+  }
+}
+
+TEST(TransformStore, GetReturnsSetTransform)
+{
+  TransformStore store;
+  transform_store_create(&store);
+  transform_store_add(&store, 5);
+
+  Transform expected;
+  make_transform(&expected, 3);
+  transform_store_set(&store, 5, &expected);
+
+  Transform actual;
+  transform_store_get(&store, 5, &actual);
+  EXPECT_EQ(memcmp(&expected, &actual, sizeof(Transform)), 0);
+
+  transform_store_destroy(&store);
+}
+
+TEST(TransformStore, UpdateMakesWorldMatrices)
+{
+  TransformStore store;
+  transform_store_create(&store);
+
+  // Not a whole number of blocks.
+  const uint64_t count = 101;
+  for (uint64_t i = 0; i < count; i++)
+  {
+    transform_store_add(&store, i);
+    Transform transform;
+    make_transform(&transform, (int) i);
+    transform_store_set(&store, i, &transform);
+  }
+  transform_store_update(&store);
+
+  for (uint64_t i = 0; i < count; i++)
+  {
+    Transform transform;
+    make_transform(&transform, (int) i);
+    expect_world_matrix(&store, i, &transform);
+  }
+
+  transform_store_destroy(&store);
+}
+
+TEST(TransformStore, UpdateSkipsUnchangedBlocks)
+{
+  TransformStore store;
+  transform_store_create(&store);
+  for (uint64_t i = 0; i < 2 * TRANSFORM_STORE_BLOCK; i++)
+  {
+    transform_store_add(&store, i);
+  }
+  transform_store_update(&store);
+
+  // Only the second block is marked as changed, so the first block's matrix
+  // keeps what's written over it.
+  Mat4* untouched = transform_store_get_world_matrix(&store, 3);
+  (*untouched)[3][0] = 42.0f;
+
+  Transform transform;
+  make_transform(&transform, 7);
+  transform_store_set(&store, TRANSFORM_STORE_BLOCK + 1, &transform);
+  transform_store_update(&store);
+
+  EXPECT_FLOAT_EQ((*untouched)[3][0], 42.0f);
+  expect_world_matrix(&store, TRANSFORM_STORE_BLOCK + 1, &transform);
+
+  transform_store_destroy(&store);
+}
+
+TEST(TransformStore, UpdateSplitsBlocksBetweenWorkers)
+{
+  task_scheduler_init();
+  // The workers are counted once the scheduler's thread has started them.
+  while (task_scheduler_get_number_of_threads() == 0)
+  {
+    Sleep(1);
+  }
+  ASSERT_GT(task_scheduler_get_number_of_threads(), 1);
+
+  TransformStore store;
+  transform_store_create(&store);
+
+  // Enough blocks for two tasks, with the last one not a whole block.
+  const uint64_t count =
+      2 * TRANSFORM_STORE_TASK_BLOCKS * TRANSFORM_STORE_BLOCK + 3;
+  for (uint64_t i = 0; i < count; i++)
+  {
+    transform_store_add(&store, i);
+    Transform transform;
+    make_transform(&transform, (int) (i % 64));
+    transform_store_set(&store, i, &transform);
+  }
+  transform_store_update(&store);
+
+  for (uint64_t i = 0; i < count; i++)
+  {
+    Transform transform;
+    make_transform(&transform, (int) (i % 64));
+    expect_world_matrix(&store, i, &transform);
+  }
+
+  transform_store_destroy(&store);
+  task_scheduler_destroy();
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+void mat_benchmarks_run();
+
+void transform_benchmarks_run();
+
+void vec_benchmarks_run();
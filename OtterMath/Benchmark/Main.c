@@ -0,0 +1,9 @@
+#include "Benchmarks.h"
+
+int main()
+{
+  mat_benchmarks_run();
+  vec_benchmarks_run();
+  transform_benchmarks_run();
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Benchmarks.h"
+#include "Otter/Math/Mat.h"
+#include "Otter/Math/Mat4Kernels.h"
+#include "Otter/Util/Benchmark.h"
+
+// About as many vertices as a large mesh.
+#define MAT_BENCHMARK_POINTS 4096
+
+typedef struct MatBenchmark
+{
+  const Mat4Kernels* kernels;
+  Mat4 matrix;
+  // Only turns, so multiplying by it again and again keeps values finite.
+  Mat4 rotation;
+  Vec3* points;
+  Vec3* result;
+} MatBenchmark;
+
+static void mat4_multiply_benchmark(void* userData, uint64_t iterations)
+{
+  MatBenchmark* benchmark = userData;
+  Mat4 result;
+  mat4_identity(result);
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    benchmark->kernels->multiply(benchmark->rotation, result);
+  }
+  benchmark_do_not_optimize(result);
+}
+
+static void mat4_multiply_vec4_benchmark(void* userData, uint64_t iterations)
+{
+  MatBenchmark* benchmark = userData;
+  Vec4 vec                = {{{1.0f, 2.0f, 3.0f, 1.0f}}};
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    benchmark->kernels->multiply_vec4(&vec, benchmark->rotation);
+  }
+  benchmark_do_not_optimize(&vec);
+}
+
+static void mat4_inverse_affine_benchmark(void* userData, uint64_t iterations)
+{
+  MatBenchmark* benchmark = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    // Inverting twice gets back to about the same matrix.
+    benchmark->kernels->inverse_affine(benchmark->matrix);
+  }
+  benchmark_do_not_optimize(benchmark->matrix);
+}
+
+static void mat4_transform_points_benchmark(
+    void* userData, uint64_t iterations)
+{
+  MatBenchmark* benchmark = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    benchmark->kernels->transform_points(benchmark->matrix, benchmark->points,
+        benchmark->result, MAT_BENCHMARK_POINTS);
+    benchmark_do_not_optimize(benchmark->result);
+  }
+}
+
+void mat_benchmarks_run()
+{
+  MatBenchmark benchmark;
+  benchmark.points = malloc(MAT_BENCHMARK_POINTS * sizeof(Vec3));
+  benchmark.result = malloc(MAT_BENCHMARK_POINTS * sizeof(Vec3));
+  if (benchmark.points == NULL || benchmark.result == NULL)
+  {
+    free(benchmark.points);
+    free(benchmark.result);
+    return;
+  }
+  for (int i = 0; i < MAT_BENCHMARK_POINTS; i++)
+  {
+    benchmark.points[i] =
+        (Vec3){{{(float) i, (float) (i % 17), (float) (i % 5)}}};
+  }
+
+  for (int level = CPU_SIMD_SCALAR; level <= cpu_get_simd_level(); level++)
+  {
+    const char* levelName = cpu_simd_level_name((CpuSimdLevel) level);
+    benchmark.kernels     = mat4_get_kernels((CpuSimdLevel) level);
+    mat4_identity(benchmark.matrix);
+    mat4_scale(benchmark.matrix, 2.0f, 2.0f, 2.0f);
+    mat4_rotate(benchmark.matrix, 0.1f, 0.2f, 0.3f);
+    mat4_translate(benchmark.matrix, 1.0f, 2.0f, 3.0f);
+    mat4_identity(benchmark.rotation);
+    mat4_rotate(benchmark.rotation, 0.1f, 0.2f, 0.3f);
+
+    char name[64];
+    snprintf(name, sizeof(name), "mat4_multiply (%s)", levelName);
+    benchmark_run(name, mat4_multiply_benchmark, &benchmark);
+    snprintf(name, sizeof(name), "vec4_multiply_mat4 (%s)", levelName);
+    benchmark_run(name, mat4_multiply_vec4_benchmark, &benchmark);
+    snprintf(name, sizeof(name), "mat4_inverse_affine (%s)", levelName);
+    benchmark_run(name, mat4_inverse_affine_benchmark, &benchmark);
+    snprintf(name, sizeof(name), "mat4_transform_points %d (%s)",
+        MAT_BENCHMARK_POINTS, levelName);
+    benchmark_run(name, mat4_transform_points_benchmark, &benchmark);
+  }
+
+  free(benchmark.points);
+  free(benchmark.result);
+}
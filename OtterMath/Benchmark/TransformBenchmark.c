@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Benchmarks.h"
+#include "Otter/Math/Mat4Kernels.h"
+#include "Otter/Math/Quaternion.h"
+#include "Otter/Math/Transform.h"
+#include "Otter/Util/Benchmark.h"
+
+// About as many entities as a busy scene.
+#define TRANSFORM_BENCHMARK_COUNT 4096
+
+typedef struct TransformBenchmark
+{
+  const Mat4Kernels* kernels;
+  Transform* transforms;
+  TransformArrays arrays;
+  float* values;
+  Mat4* result;
+} TransformBenchmark;
+
+static void transform_to_matrix_each_benchmark(
+    void* userData, uint64_t iterations)
+{
+  TransformBenchmark* benchmark = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    for (int j = 0; j < TRANSFORM_BENCHMARK_COUNT; j++)
+    {
+      transform_to_matrix(benchmark->result[j], &benchmark->transforms[j]);
+    }
+    benchmark_do_not_optimize(benchmark->result);
+  }
+}
+
+static void transforms_to_matrices_benchmark(
+    void* userData, uint64_t iterations)
+{
+  TransformBenchmark* benchmark = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    benchmark->kernels->transforms_to_matrices(&benchmark->arrays, 0,
+        TRANSFORM_BENCHMARK_COUNT, benchmark->result);
+    benchmark_do_not_optimize(benchmark->result);
+  }
+}
+
+void transform_benchmarks_run()
+{
+  TransformBenchmark benchmark;
+  benchmark.transforms = malloc(TRANSFORM_BENCHMARK_COUNT * sizeof(Transform));
+  benchmark.values = malloc(10 * TRANSFORM_BENCHMARK_COUNT * sizeof(float));
+  benchmark.result = malloc(TRANSFORM_BENCHMARK_COUNT * sizeof(Mat4));
+  if (benchmark.transforms == NULL || benchmark.values == NULL
+      || benchmark.result == NULL)
+  {
+    free(benchmark.transforms);
+    free(benchmark.values);
+    free(benchmark.result);
+    return;
+  }
+
+  for (int i = 0; i < 3; i++)
+  {
+    benchmark.arrays.position[i] =
+        &benchmark.values[i * TRANSFORM_BENCHMARK_COUNT];
+    benchmark.arrays.scale[i] =
+        &benchmark.values[(3 + i) * TRANSFORM_BENCHMARK_COUNT];
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    benchmark.arrays.rotation[i] =
+        &benchmark.values[(6 + i) * TRANSFORM_BENCHMARK_COUNT];
+  }
+
+  for (int i = 0; i < TRANSFORM_BENCHMARK_COUNT; i++)
+  {
+    Transform* transform = &benchmark.transforms[i];
+    transform->position  = (Vec3){{{(float) i, (float) (i % 17), 1.0f}}};
+    transform->scale     = (Vec3){{{1.0f, (float) (i % 5) + 1.0f, 1.0f}}};
+    quaternion_from_euler(&transform->rotation, 0.01f * i, 0.2f, -0.3f);
+    for (int j = 0; j < 3; j++)
+    {
+      benchmark.arrays.position[j][i] = transform->position.val[j];
+      benchmark.arrays.scale[j][i]    = transform->scale.val[j];
+    }
+    for (int j = 0; j < 4; j++)
+    {
+      benchmark.arrays.rotation[j][i] = transform->rotation.val[j];
+    }
+  }
+
+  char name[64];
+  snprintf(name, sizeof(name), "transform_to_matrix %d",
+      TRANSFORM_BENCHMARK_COUNT);
+  benchmark_run(name, transform_to_matrix_each_benchmark, &benchmark);
+
+  for (int level = CPU_SIMD_SCALAR; level <= cpu_get_simd_level(); level++)
+  {
+    benchmark.kernels = mat4_get_kernels((CpuSimdLevel) level);
+    snprintf(name, sizeof(name), "transform_arrays_to_matrices %d (%s)",
+        TRANSFORM_BENCHMARK_COUNT,
+        cpu_simd_level_name((CpuSimdLevel) level));
+    benchmark_run(name, transforms_to_matrices_benchmark, &benchmark);
+  }
+
+  free(benchmark.transforms);
+  free(benchmark.values);
+  free(benchmark.result);
+}
@@ -0,0 +1,227 @@
+#include <Windows.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Benchmarks.h"
+#include "Otter/Math/Mat.h"
+#include "Otter/Math/Quaternion.h"
+#include "Otter/Math/Transform.h"
+#include "Otter/Math/Vec.h"
+#include "Otter/Util/Benchmark.h"
+#include "Otter/Util/Log.h"
+
+// About as many triangles as a large mesh.
+#define VEC_BENCHMARK_TRIANGLES 4096
+
+typedef void (*Vec3Function)(Vec3* result, const Vec3* operand);
+typedef void (*Vec3ScalarFunction)(Vec3* result, float operand);
+typedef void (*Mat4Function)(Mat4 matrix);
+typedef void (*Mat4MultiplyFunction)(Mat4 operand, Mat4 matrix);
+
+// The DLL's exports, which cost what every call did before the small
+// functions were inlined.
+typedef struct VecExports
+{
+  Vec3Function add;
+  Vec3ScalarFunction divide;
+  Mat4Function identity;
+  Mat4MultiplyFunction multiply;
+} VecExports;
+
+typedef struct VecBenchmark
+{
+  VecExports exports;
+  Vec3* vertices;
+  Transform transform;
+  // The transform's rotation as the angles it used to be kept as.
+  Vec3 euler;
+} VecBenchmark;
+
+typedef struct Bounds
+{
+  Vec3 min;
+  Vec3 max;
+} Bounds;
+
+static void vec_benchmark_adjust_bounds(Bounds* bounds, const Vec3* position)
+{
+  bounds->min.x = fminf(position->x, bounds->min.x);
+  bounds->min.y = fminf(position->y, bounds->min.y);
+  bounds->min.z = fminf(position->z, bounds->min.z);
+
+  bounds->max.x = fmaxf(position->x, bounds->max.x);
+  bounds->max.y = fmaxf(position->y, bounds->max.y);
+  bounds->max.z = fmaxf(position->z, bounds->max.z);
+}
+
+// What a bounding volume hierarchy does for each triangle it adds: find its
+// centroid, and grow the bounds and cluster of the centroids.
+static void centroids_benchmark(void* userData, uint64_t iterations)
+{
+  VecBenchmark* benchmark = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    Bounds bounds = {{{{FLT_MAX, FLT_MAX, FLT_MAX}}},
+        {{{-FLT_MAX, -FLT_MAX, -FLT_MAX}}}};
+    Vec3 cluster  = {0};
+    for (int tri = 0; tri < VEC_BENCHMARK_TRIANGLES; tri++)
+    {
+      Vec3 centroid = {0};
+      vec3_add(&centroid, &benchmark->vertices[tri * 3]);
+      vec3_add(&centroid, &benchmark->vertices[tri * 3 + 1]);
+      vec3_add(&centroid, &benchmark->vertices[tri * 3 + 2]);
+      vec3_divide(&centroid, 3);
+
+      vec_benchmark_adjust_bounds(&bounds, &centroid);
+      vec3_add(&cluster, &centroid);
+    }
+    benchmark_do_not_optimize(&bounds);
+    benchmark_do_not_optimize(&cluster);
+  }
+}
+
+static void centroids_exported_benchmark(void* userData, uint64_t iterations)
+{
+  VecBenchmark* benchmark   = userData;
+  const VecExports* exports = &benchmark->exports;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    Bounds bounds = {{{{FLT_MAX, FLT_MAX, FLT_MAX}}},
+        {{{-FLT_MAX, -FLT_MAX, -FLT_MAX}}}};
+    Vec3 cluster  = {0};
+    for (int tri = 0; tri < VEC_BENCHMARK_TRIANGLES; tri++)
+    {
+      Vec3 centroid = {0};
+      exports->add(&centroid, &benchmark->vertices[tri * 3]);
+      exports->add(&centroid, &benchmark->vertices[tri * 3 + 1]);
+      exports->add(&centroid, &benchmark->vertices[tri * 3 + 2]);
+      exports->divide(&centroid, 3);
+
+      vec_benchmark_adjust_bounds(&bounds, &centroid);
+      exports->add(&cluster, &centroid);
+    }
+    benchmark_do_not_optimize(&bounds);
+    benchmark_do_not_optimize(&cluster);
+  }
+}
+
+static void transform_to_matrix_benchmark(void* userData, uint64_t iterations)
+{
+  VecBenchmark* benchmark = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    Mat4 matrix;
+    transform_to_matrix(matrix, &benchmark->transform);
+    benchmark_do_not_optimize(matrix);
+  }
+}
+
+static void transform_apply_benchmark(void* userData, uint64_t iterations)
+{
+  VecBenchmark* benchmark = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    Mat4 matrix;
+    mat4_identity(matrix);
+    transform_apply(matrix, &benchmark->transform);
+    benchmark_do_not_optimize(matrix);
+  }
+}
+
+// The scale, Euler rotation and translation made as whole matrices and
+// multiplied in through the exports, the way `transform_apply` used to.
+static void transform_apply_exported_benchmark(
+    void* userData, uint64_t iterations)
+{
+  VecBenchmark* benchmark    = userData;
+  const VecExports* exports  = &benchmark->exports;
+  const Transform* transform = &benchmark->transform;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    Mat4 matrix;
+    Mat4 step;
+    exports->identity(matrix);
+
+    exports->identity(step);
+    step[0][0] = transform->scale.x;
+    step[1][1] = transform->scale.y;
+    step[2][2] = transform->scale.z;
+    exports->multiply(step, matrix);
+
+    mat4_rotate(matrix, benchmark->euler.x, benchmark->euler.y,
+        benchmark->euler.z);
+
+    exports->identity(step);
+    step[3][0] = transform->position.x;
+    step[3][1] = transform->position.y;
+    step[3][2] = transform->position.z;
+    exports->multiply(step, matrix);
+
+    benchmark_do_not_optimize(matrix);
+  }
+}
+
+static bool vec_benchmark_load_exports(VecExports* exports)
+{
+  HMODULE math = GetModuleHandleA("OtterMath.dll");
+  if (math == NULL)
+  {
+    LOG_ERROR("OtterMath.dll isn't loaded.");
+    return false;
+  }
+
+  exports->add      = (Vec3Function) GetProcAddress(math, "vec3_add");
+  exports->divide   = (Vec3ScalarFunction) GetProcAddress(math, "vec3_divide");
+  exports->identity = (Mat4Function) GetProcAddress(math, "mat4_identity");
+  exports->multiply =
+      (Mat4MultiplyFunction) GetProcAddress(math, "mat4_multiply");
+  if (exports->add == NULL || exports->divide == NULL
+      || exports->identity == NULL || exports->multiply == NULL)
+  {
+    LOG_ERROR("OtterMath.dll is missing a vector or matrix export.");
+    return false;
+  }
+  return true;
+}
+
+void vec_benchmarks_run()
+{
+  VecBenchmark benchmark;
+  if (!vec_benchmark_load_exports(&benchmark.exports))
+  {
+    return;
+  }
+
+  benchmark.vertices = malloc(VEC_BENCHMARK_TRIANGLES * 3 * sizeof(Vec3));
+  if (benchmark.vertices == NULL)
+  {
+    return;
+  }
+  for (int i = 0; i < VEC_BENCHMARK_TRIANGLES * 3; i++)
+  {
+    benchmark.vertices[i] =
+        (Vec3){{{(float) i, (float) (i % 17), (float) (i % 5)}}};
+  }
+
+  benchmark.transform.position = (Vec3){{{1.0f, 2.0f, 3.0f}}};
+  benchmark.transform.scale    = (Vec3){{{2.0f, 2.0f, 2.0f}}};
+  benchmark.euler              = (Vec3){{{0.1f, 0.2f, 0.3f}}};
+  quaternion_from_euler(&benchmark.transform.rotation, benchmark.euler.x,
+      benchmark.euler.y, benchmark.euler.z);
+
+  char name[64];
+  snprintf(name, sizeof(name), "bvh centroids %d (inline)",
+      VEC_BENCHMARK_TRIANGLES);
+  benchmark_run(name, centroids_benchmark, &benchmark);
+  snprintf(name, sizeof(name), "bvh centroids %d (exported)",
+      VEC_BENCHMARK_TRIANGLES);
+  benchmark_run(name, centroids_exported_benchmark, &benchmark);
+  benchmark_run(
+      "transform_to_matrix", transform_to_matrix_benchmark, &benchmark);
+  benchmark_run("transform_apply", transform_apply_benchmark, &benchmark);
+  benchmark_run("transform_apply (euler, exported)",
+      transform_apply_exported_benchmark, &benchmark);
+
+  free(benchmark.vertices);
+}
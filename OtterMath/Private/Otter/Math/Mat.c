@@ -1,52 +1,29 @@
+// Compile the inline functions in Mat.h as this DLL's exports.
+#define OTTERMATH_MAT_INLINE OTTERMATH_API
 #include "Otter/Math/Mat.h"
 
-void mat4_identity(Mat4 matrix)
-{
-  memset(matrix, 0, sizeof(Mat4));
-  matrix[0][0] = 1.0f;
-  matrix[1][1] = 1.0f;
-  matrix[2][2] = 1.0f;
-  matrix[3][3] = 1.0f;
-}
+#include "Otter/Math/Mat4Kernels.h"
 
 void mat4_multiply(Mat4 operand, Mat4 matrix)
 {
-  Mat4 result = {0};
-
-  for (int i = 0; i < 4; ++i)
-  {
-    for (int j = 0; j < 4; ++j)
-    {
-      for (int k = 0; k < 4; ++k)
-      {
-        result[i][j] += matrix[i][k] * operand[k][j];
-      }
-    }
-  }
-
-  memcpy(matrix, result, sizeof(Mat4));
+  mat4_get_kernels(CPU_SIMD_COUNT)->multiply(operand, matrix);
 }
 
-void mat4_translate(Mat4 matrix, float x, float y, float z)
+void mat4_transpose(Mat4 matrix)
 {
-  Mat4 translationMatrix;
-  mat4_identity(translationMatrix);
-  translationMatrix[3][0] = x;
-  translationMatrix[3][1] = y;
-  translationMatrix[3][2] = z;
-
-  mat4_multiply(translationMatrix, matrix);
+  mat4_get_kernels(CPU_SIMD_COUNT)->transpose(matrix);
 }
 
-void mat4_scale(Mat4 matrix, float x, float y, float z)
+bool mat4_inverse_affine(Mat4 matrix)
 {
-  Mat4 scaleMatrix;
-  mat4_identity(scaleMatrix);
-  scaleMatrix[0][0] = x;
-  scaleMatrix[1][1] = y;
-  scaleMatrix[2][2] = z;
+  return mat4_get_kernels(CPU_SIMD_COUNT)->inverse_affine(matrix);
+}
 
-  mat4_multiply(scaleMatrix, matrix);
+void mat4_transform_points(
+    Mat4 matrix, const Vec3* points, Vec3* result, size_t count)
+{
+  mat4_get_kernels(CPU_SIMD_COUNT)->transform_points(
+      matrix, points, result, count);
 }
 
 void mat4_rotate(Mat4 matrix, float roll, float pitch, float yaw)
@@ -0,0 +1,475 @@
+#include "Otter/Math/Mat4Kernels.h"
+
+#include <immintrin.h>
+
+static void mat4_multiply_scalar(Mat4 operand, Mat4 matrix)
+{
+  Mat4 result = {0};
+
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      for (int k = 0; k < 4; ++k)
+      {
+        result[i][j] += matrix[i][k] * operand[k][j];
+      }
+    }
+  }
+
+  memcpy(matrix, result, sizeof(Mat4));
+}
+
+static void mat4_multiply_vec4_scalar(Vec4* vec, Mat4 matrix)
+{
+  Vec4 result = *vec;
+
+  result.x = vec->x * matrix[0][0] + vec->y * matrix[1][0]
+           + vec->z * matrix[2][0] + vec->w * matrix[3][0];
+  result.y = vec->x * matrix[0][1] + vec->y * matrix[1][1]
+           + vec->z * matrix[2][1] + vec->w * matrix[3][1];
+  result.z = vec->x * matrix[0][2] + vec->y * matrix[1][2]
+           + vec->z * matrix[2][2] + vec->w * matrix[3][2];
+  result.w = vec->x * matrix[0][3] + vec->y * matrix[1][3]
+           + vec->z * matrix[2][3] + vec->w * matrix[3][3];
+
+  *vec = result;
+}
+
+static void mat4_transpose_scalar(Mat4 matrix)
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = i + 1; j < 4; ++j)
+    {
+      float value  = matrix[i][j];
+      matrix[i][j] = matrix[j][i];
+      matrix[j][i] = value;
+    }
+  }
+}
+
+// Inverts the upper 3x3 with the cross products of its rows, which are the
+// columns of the inverse scaled by the determinant, then moves the
+// translation back through it.
+static bool mat4_inverse_affine_scalar(Mat4 matrix)
+{
+  Vec3 rows[3] = {{matrix[0][0], matrix[0][1], matrix[0][2]},
+      {matrix[1][0], matrix[1][1], matrix[1][2]},
+      {matrix[2][0], matrix[2][1], matrix[2][2]}};
+  Vec3 columns[3] = {rows[1], rows[2], rows[0]};
+  vec3_cross(&columns[0], &rows[2]);
+  vec3_cross(&columns[1], &rows[0]);
+  vec3_cross(&columns[2], &rows[1]);
+
+  float determinant = vec3_dot(&rows[0], &columns[0]);
+  if (determinant == 0.0f)
+  {
+    return false;
+  }
+  float inverseDeterminant = 1.0f / determinant;
+
+  Mat4 inverse;
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      inverse[i][j] = columns[j].val[i] * inverseDeterminant;
+    }
+    inverse[i][3] = 0.0f;
+  }
+  for (int j = 0; j < 3; ++j)
+  {
+    inverse[3][j] = -(matrix[3][0] * inverse[0][j]
+                      + matrix[3][1] * inverse[1][j]
+                      + matrix[3][2] * inverse[2][j]);
+  }
+  inverse[3][3] = 1.0f;
+
+  memcpy(matrix, inverse, sizeof(Mat4));
+  return true;
+}
+
+static void mat4_transform_points_scalar(
+    Mat4 matrix, const Vec3* points, Vec3* result, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    Vec3 point  = points[i];
+    result[i].x = point.x * matrix[0][0] + point.y * matrix[1][0]
+                + point.z * matrix[2][0] + matrix[3][0];
+    result[i].y = point.x * matrix[0][1] + point.y * matrix[1][1]
+                + point.z * matrix[2][1] + matrix[3][1];
+    result[i].z = point.x * matrix[0][2] + point.y * matrix[1][2]
+                + point.z * matrix[2][2] + matrix[3][2];
+  }
+}
+
+static void mat4_from_transforms_scalar(const TransformArrays* transforms,
+    size_t first, size_t count, Mat4* result)
+{
+  for (size_t i = first; i < first + count; i++)
+  {
+    Transform transform;
+    transform.position.x = transforms->position[0][i];
+    transform.position.y = transforms->position[1][i];
+    transform.position.z = transforms->position[2][i];
+    transform.rotation.x = transforms->rotation[0][i];
+    transform.rotation.y = transforms->rotation[1][i];
+    transform.rotation.z = transforms->rotation[2][i];
+    transform.rotation.w = transforms->rotation[3][i];
+    transform.scale.x    = transforms->scale[0][i];
+    transform.scale.y    = transforms->scale[1][i];
+    transform.scale.z    = transforms->scale[2][i];
+    transform_to_matrix(result[i], &transform);
+  }
+}
+
+// Vec3s aren't padded, so only three lanes are stored.
+static void mat4_store_vec3(Vec3* result, __m128 vec)
+{
+  float values[4];
+  _mm_storeu_ps(values, vec);
+  memcpy(result, values, sizeof(Vec3));
+}
+
+// Each lane of `vec` times the matching row, summed in order.
+CPU_TARGET_SSE42 static __m128 mat4_combine_sse42(
+    __m128 vec, const __m128 rows[4])
+{
+  __m128 result = _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0x00), rows[0]);
+  result        = _mm_add_ps(
+      result, _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0x55), rows[1]));
+  result = _mm_add_ps(
+      result, _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0xaa), rows[2]));
+  return _mm_add_ps(
+      result, _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0xff), rows[3]));
+}
+
+CPU_TARGET_SSE42 static void mat4_multiply_sse42(Mat4 operand, Mat4 matrix)
+{
+  __m128 rows[4] = {_mm_loadu_ps(operand[0]), _mm_loadu_ps(operand[1]),
+      _mm_loadu_ps(operand[2]), _mm_loadu_ps(operand[3])};
+
+  __m128 result[4];
+  for (int i = 0; i < 4; ++i)
+  {
+    result[i] = mat4_combine_sse42(_mm_loadu_ps(matrix[i]), rows);
+  }
+  for (int i = 0; i < 4; ++i)
+  {
+    _mm_storeu_ps(matrix[i], result[i]);
+  }
+}
+
+CPU_TARGET_SSE42 static void mat4_multiply_vec4_sse42(Vec4* vec, Mat4 matrix)
+{
+  __m128 rows[4] = {_mm_loadu_ps(matrix[0]), _mm_loadu_ps(matrix[1]),
+      _mm_loadu_ps(matrix[2]), _mm_loadu_ps(matrix[3])};
+  _mm_storeu_ps(vec->val, mat4_combine_sse42(_mm_loadu_ps(vec->val), rows));
+}
+
+CPU_TARGET_SSE42 static void mat4_transpose_sse42(Mat4 matrix)
+{
+  __m128 row0 = _mm_loadu_ps(matrix[0]);
+  __m128 row1 = _mm_loadu_ps(matrix[1]);
+  __m128 row2 = _mm_loadu_ps(matrix[2]);
+  __m128 row3 = _mm_loadu_ps(matrix[3]);
+  _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+  _mm_storeu_ps(matrix[0], row0);
+  _mm_storeu_ps(matrix[1], row1);
+  _mm_storeu_ps(matrix[2], row2);
+  _mm_storeu_ps(matrix[3], row3);
+}
+
+// a.yzx * b.zxy - a.zxy * b.yzx, the same products as `vec3_cross`.
+CPU_TARGET_SSE42 static __m128 mat4_cross_sse42(__m128 a, __m128 b)
+{
+  __m128 left = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)),
+      _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2)));
+  __m128 right = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2)),
+      _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1)));
+  return _mm_sub_ps(left, right);
+}
+
+CPU_TARGET_SSE42 static bool mat4_inverse_affine_sse42(Mat4 matrix)
+{
+  __m128 row0    = _mm_loadu_ps(matrix[0]);
+  __m128 row1    = _mm_loadu_ps(matrix[1]);
+  __m128 row2    = _mm_loadu_ps(matrix[2]);
+  __m128 column0 = mat4_cross_sse42(row1, row2);
+  __m128 column1 = mat4_cross_sse42(row2, row0);
+  __m128 column2 = mat4_cross_sse42(row0, row1);
+
+  // Summed across in order, like `vec3_dot`.
+  __m128 products   = _mm_mul_ps(row0, column0);
+  float determinant = _mm_cvtss_f32(products)
+                    + _mm_cvtss_f32(_mm_shuffle_ps(products, products, 0x55))
+                    + _mm_cvtss_f32(_mm_shuffle_ps(products, products, 0xaa));
+  if (determinant == 0.0f)
+  {
+    return false;
+  }
+
+  __m128 inverseDeterminant = _mm_set1_ps(1.0f / determinant);
+  __m128 inverse0           = _mm_mul_ps(column0, inverseDeterminant);
+  __m128 inverse1           = _mm_mul_ps(column1, inverseDeterminant);
+  __m128 inverse2           = _mm_mul_ps(column2, inverseDeterminant);
+  __m128 inverse3           = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(inverse0, inverse1, inverse2, inverse3);
+
+  __m128 rows[4] = {inverse0, inverse1, inverse2, _mm_setzero_ps()};
+  __m128 translation = mat4_combine_sse42(_mm_loadu_ps(matrix[3]), rows);
+  translation = _mm_xor_ps(translation, _mm_set1_ps(-0.0f));
+  translation = _mm_blend_ps(translation, _mm_set1_ps(1.0f), 0x8);
+
+  _mm_storeu_ps(matrix[0], inverse0);
+  _mm_storeu_ps(matrix[1], inverse1);
+  _mm_storeu_ps(matrix[2], inverse2);
+  _mm_storeu_ps(matrix[3], translation);
+  return true;
+}
+
+CPU_TARGET_SSE42 static void mat4_transform_points_sse42(
+    Mat4 matrix, const Vec3* points, Vec3* result, size_t count)
+{
+  __m128 row0 = _mm_loadu_ps(matrix[0]);
+  __m128 row1 = _mm_loadu_ps(matrix[1]);
+  __m128 row2 = _mm_loadu_ps(matrix[2]);
+  __m128 row3 = _mm_loadu_ps(matrix[3]);
+  for (size_t i = 0; i < count; ++i)
+  {
+    __m128 point = _mm_mul_ps(_mm_set1_ps(points[i].x), row0);
+    point = _mm_add_ps(point, _mm_mul_ps(_mm_set1_ps(points[i].y), row1));
+    point = _mm_add_ps(point, _mm_mul_ps(_mm_set1_ps(points[i].z), row2));
+    mat4_store_vec3(&result[i], _mm_add_ps(point, row3));
+  }
+}
+
+// Lane i of `a` to `d` is row `row` of `result[i]`.
+CPU_TARGET_SSE42 static void mat4_store_transposed_sse42(
+    Mat4* result, int row, __m128 a, __m128 b, __m128 c, __m128 d)
+{
+  _MM_TRANSPOSE4_PS(a, b, c, d);
+  _mm_storeu_ps(result[0][row], a);
+  _mm_storeu_ps(result[1][row], b);
+  _mm_storeu_ps(result[2][row], c);
+  _mm_storeu_ps(result[3][row], d);
+}
+
+// Four transforms at once, one in each lane, with the same operations as
+// `transform_to_matrix`.
+CPU_TARGET_SSE42 static void mat4_from_transforms_sse42(
+    const TransformArrays* transforms, size_t first, size_t count,
+    Mat4* result)
+{
+  __m128 zero = _mm_setzero_ps();
+  __m128 one  = _mm_set1_ps(1.0f);
+  __m128 two  = _mm_set1_ps(2.0f);
+  size_t i    = first;
+  for (; i + 4 <= first + count; i += 4)
+  {
+    __m128 x = _mm_loadu_ps(&transforms->rotation[0][i]);
+    __m128 y = _mm_loadu_ps(&transforms->rotation[1][i]);
+    __m128 z = _mm_loadu_ps(&transforms->rotation[2][i]);
+    __m128 w = _mm_loadu_ps(&transforms->rotation[3][i]);
+
+    __m128 xx = _mm_mul_ps(x, x);
+    __m128 yy = _mm_mul_ps(y, y);
+    __m128 zz = _mm_mul_ps(z, z);
+    __m128 xy = _mm_mul_ps(x, y);
+    __m128 xz = _mm_mul_ps(x, z);
+    __m128 yz = _mm_mul_ps(y, z);
+    __m128 wx = _mm_mul_ps(w, x);
+    __m128 wy = _mm_mul_ps(w, y);
+    __m128 wz = _mm_mul_ps(w, z);
+
+    __m128 sx = _mm_loadu_ps(&transforms->scale[0][i]);
+    mat4_store_transposed_sse42(&result[i], 0,
+        _mm_mul_ps(sx, _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)))),
+        _mm_mul_ps(sx, _mm_mul_ps(two, _mm_add_ps(xy, wz))),
+        _mm_mul_ps(sx, _mm_mul_ps(two, _mm_sub_ps(xz, wy))), zero);
+
+    __m128 sy = _mm_loadu_ps(&transforms->scale[1][i]);
+    mat4_store_transposed_sse42(&result[i], 1,
+        _mm_mul_ps(sy, _mm_mul_ps(two, _mm_sub_ps(xy, wz))),
+        _mm_mul_ps(sy, _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)))),
+        _mm_mul_ps(sy, _mm_mul_ps(two, _mm_add_ps(wx, yz))), zero);
+
+    __m128 sz = _mm_loadu_ps(&transforms->scale[2][i]);
+    mat4_store_transposed_sse42(&result[i], 2,
+        _mm_mul_ps(sz, _mm_mul_ps(two, _mm_add_ps(wy, xz))),
+        _mm_mul_ps(sz, _mm_mul_ps(two, _mm_sub_ps(yz, wx))),
+        _mm_mul_ps(sz, _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)))),
+        zero);
+
+    mat4_store_transposed_sse42(&result[i], 3,
+        _mm_loadu_ps(&transforms->position[0][i]),
+        _mm_loadu_ps(&transforms->position[1][i]),
+        _mm_loadu_ps(&transforms->position[2][i]), one);
+  }
+  mat4_from_transforms_scalar(transforms, i, first + count - i, result);
+}
+
+// Two rows of the result at once, one in each half.
+CPU_TARGET_AVX2 static __m256 mat4_combine_avx2(
+    __m256 vecs, const __m256 rows[4])
+{
+  __m256 result = _mm256_mul_ps(_mm256_permute_ps(vecs, 0x00), rows[0]);
+  result        = _mm256_add_ps(
+      result, _mm256_mul_ps(_mm256_permute_ps(vecs, 0x55), rows[1]));
+  result = _mm256_add_ps(
+      result, _mm256_mul_ps(_mm256_permute_ps(vecs, 0xaa), rows[2]));
+  return _mm256_add_ps(
+      result, _mm256_mul_ps(_mm256_permute_ps(vecs, 0xff), rows[3]));
+}
+
+CPU_TARGET_AVX2 static void mat4_multiply_avx2(Mat4 operand, Mat4 matrix)
+{
+  __m256 rows[4] = {_mm256_broadcast_ps((const __m128*) operand[0]),
+      _mm256_broadcast_ps((const __m128*) operand[1]),
+      _mm256_broadcast_ps((const __m128*) operand[2]),
+      _mm256_broadcast_ps((const __m128*) operand[3])};
+
+  __m256 top    = mat4_combine_avx2(_mm256_loadu_ps(matrix[0]), rows);
+  __m256 bottom = mat4_combine_avx2(_mm256_loadu_ps(matrix[2]), rows);
+  _mm256_storeu_ps(matrix[0], top);
+  _mm256_storeu_ps(matrix[2], bottom);
+}
+
+CPU_TARGET_AVX2 static void mat4_transform_points_avx2(
+    Mat4 matrix, const Vec3* points, Vec3* result, size_t count)
+{
+  __m256 row0 = _mm256_broadcast_ps((const __m128*) matrix[0]);
+  __m256 row1 = _mm256_broadcast_ps((const __m128*) matrix[1]);
+  __m256 row2 = _mm256_broadcast_ps((const __m128*) matrix[2]);
+  __m256 row3 = _mm256_broadcast_ps((const __m128*) matrix[3]);
+
+  // Two points are loaded at once with the next point's x, so the last two
+  // are left to the SSE version.
+  __m256i xIndices = _mm256_setr_epi32(0, 0, 0, 0, 3, 3, 3, 3);
+  __m256i yIndices = _mm256_setr_epi32(1, 1, 1, 1, 4, 4, 4, 4);
+  __m256i zIndices = _mm256_setr_epi32(2, 2, 2, 2, 5, 5, 5, 5);
+  size_t i         = 0;
+  for (; i + 3 <= count; i += 2)
+  {
+    __m256 pair  = _mm256_loadu_ps(points[i].val);
+    __m256 point = _mm256_mul_ps(
+        _mm256_permutevar8x32_ps(pair, xIndices), row0);
+    point = _mm256_add_ps(point,
+        _mm256_mul_ps(_mm256_permutevar8x32_ps(pair, yIndices), row1));
+    point = _mm256_add_ps(point,
+        _mm256_mul_ps(_mm256_permutevar8x32_ps(pair, zIndices), row2));
+    point = _mm256_add_ps(point, row3);
+    mat4_store_vec3(&result[i], _mm256_castps256_ps128(point));
+    mat4_store_vec3(&result[i + 1], _mm256_extractf128_ps(point, 1));
+  }
+  mat4_transform_points_sse42(matrix, &points[i], &result[i], count - i);
+}
+
+// Transpose each half of `a` to `d` like `_MM_TRANSPOSE4_PS`, so `rows[i]`
+// holds lane i in its bottom half and lane i + 4 in its top half.
+CPU_TARGET_AVX2 static void mat4_transpose_halves_avx2(
+    __m256 rows[4], __m256 a, __m256 b, __m256 c, __m256 d)
+{
+  __m256 ab0 = _mm256_unpacklo_ps(a, b);
+  __m256 ab1 = _mm256_unpackhi_ps(a, b);
+  __m256 cd0 = _mm256_unpacklo_ps(c, d);
+  __m256 cd1 = _mm256_unpackhi_ps(c, d);
+  rows[0]    = _mm256_shuffle_ps(ab0, cd0, 0x44);
+  rows[1]    = _mm256_shuffle_ps(ab0, cd0, 0xee);
+  rows[2]    = _mm256_shuffle_ps(ab1, cd1, 0x44);
+  rows[3]    = _mm256_shuffle_ps(ab1, cd1, 0xee);
+}
+
+// Write two rows of each of eight matrices, one whole register at a time.
+CPU_TARGET_AVX2 static void mat4_store_row_pairs_avx2(
+    Mat4* result, int row, const __m256 first[4], const __m256 second[4])
+{
+  for (int i = 0; i < 4; i++)
+  {
+    _mm256_storeu_ps(
+        result[i][row], _mm256_permute2f128_ps(first[i], second[i], 0x20));
+    _mm256_storeu_ps(result[i + 4][row],
+        _mm256_permute2f128_ps(first[i], second[i], 0x31));
+  }
+}
+
+CPU_TARGET_AVX2 static void mat4_from_transforms_avx2(
+    const TransformArrays* transforms, size_t first, size_t count,
+    Mat4* result)
+{
+  __m256 zero = _mm256_setzero_ps();
+  __m256 one  = _mm256_set1_ps(1.0f);
+  __m256 two  = _mm256_set1_ps(2.0f);
+  size_t i    = first;
+  for (; i + 8 <= first + count; i += 8)
+  {
+    __m256 x = _mm256_loadu_ps(&transforms->rotation[0][i]);
+    __m256 y = _mm256_loadu_ps(&transforms->rotation[1][i]);
+    __m256 z = _mm256_loadu_ps(&transforms->rotation[2][i]);
+    __m256 w = _mm256_loadu_ps(&transforms->rotation[3][i]);
+
+    __m256 xx = _mm256_mul_ps(x, x);
+    __m256 yy = _mm256_mul_ps(y, y);
+    __m256 zz = _mm256_mul_ps(z, z);
+    __m256 xy = _mm256_mul_ps(x, y);
+    __m256 xz = _mm256_mul_ps(x, z);
+    __m256 yz = _mm256_mul_ps(y, z);
+    __m256 wx = _mm256_mul_ps(w, x);
+    __m256 wy = _mm256_mul_ps(w, y);
+    __m256 wz = _mm256_mul_ps(w, z);
+
+    __m256 row0[4];
+    __m256 sx = _mm256_loadu_ps(&transforms->scale[0][i]);
+    mat4_transpose_halves_avx2(row0,
+        _mm256_mul_ps(sx, _mm256_sub_ps(one,
+            _mm256_mul_ps(two, _mm256_add_ps(yy, zz)))),
+        _mm256_mul_ps(sx, _mm256_mul_ps(two, _mm256_add_ps(xy, wz))),
+        _mm256_mul_ps(sx, _mm256_mul_ps(two, _mm256_sub_ps(xz, wy))), zero);
+
+    __m256 row1[4];
+    __m256 sy = _mm256_loadu_ps(&transforms->scale[1][i]);
+    mat4_transpose_halves_avx2(row1,
+        _mm256_mul_ps(sy, _mm256_mul_ps(two, _mm256_sub_ps(xy, wz))),
+        _mm256_mul_ps(sy, _mm256_sub_ps(one,
+            _mm256_mul_ps(two, _mm256_add_ps(xx, zz)))),
+        _mm256_mul_ps(sy, _mm256_mul_ps(two, _mm256_add_ps(wx, yz))), zero);
+    mat4_store_row_pairs_avx2(&result[i], 0, row0, row1);
+
+    __m256 row2[4];
+    __m256 sz = _mm256_loadu_ps(&transforms->scale[2][i]);
+    mat4_transpose_halves_avx2(row2,
+        _mm256_mul_ps(sz, _mm256_mul_ps(two, _mm256_add_ps(wy, xz))),
+        _mm256_mul_ps(sz, _mm256_mul_ps(two, _mm256_sub_ps(yz, wx))),
+        _mm256_mul_ps(sz, _mm256_sub_ps(one,
+            _mm256_mul_ps(two, _mm256_add_ps(xx, yy)))), zero);
+
+    __m256 row3[4];
+    mat4_transpose_halves_avx2(row3,
+        _mm256_loadu_ps(&transforms->position[0][i]),
+        _mm256_loadu_ps(&transforms->position[1][i]),
+        _mm256_loadu_ps(&transforms->position[2][i]), one);
+    mat4_store_row_pairs_avx2(&result[i], 2, row2, row3);
+  }
+  mat4_from_transforms_sse42(transforms, i, first + count - i, result);
+}
+
+// Operations that gain nothing from wider registers share the SSE versions.
+static const Mat4Kernels g_mat4Kernels[CPU_SIMD_COUNT] = {
+    {mat4_multiply_scalar, mat4_multiply_vec4_scalar, mat4_transpose_scalar,
+        mat4_inverse_affine_scalar, mat4_transform_points_scalar,
+        mat4_from_transforms_scalar},
+    {mat4_multiply_sse42, mat4_multiply_vec4_sse42, mat4_transpose_sse42,
+        mat4_inverse_affine_sse42, mat4_transform_points_sse42,
+        mat4_from_transforms_sse42},
+    {mat4_multiply_avx2, mat4_multiply_vec4_sse42, mat4_transpose_sse42,
+        mat4_inverse_affine_sse42, mat4_transform_points_avx2,
+        mat4_from_transforms_avx2},
+};
+
+const Mat4Kernels* mat4_get_kernels(CpuSimdLevel level)
+{
+  CpuSimdLevel supported = cpu_get_simd_level();
+  return &g_mat4Kernels[level < supported ? level : supported];
+}
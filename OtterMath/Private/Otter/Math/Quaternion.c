@@ -0,0 +1,57 @@
+#include "Otter/Math/Quaternion.h"
+
+void quaternion_from_euler(Vec4* result, float roll, float pitch, float yaw)
+{
+  // mat4_rotate turns by `yaw` around x, then `pitch` around y, then `roll`
+  // around z.
+  float sinX = sinf(yaw * 0.5f);
+  float cosX = cosf(yaw * 0.5f);
+  float sinY = sinf(pitch * 0.5f);
+  float cosY = cosf(pitch * 0.5f);
+  float sinZ = sinf(roll * 0.5f);
+  float cosZ = cosf(roll * 0.5f);
+
+  result->x = sinX * cosY * cosZ - cosX * sinY * sinZ;
+  result->y = cosX * sinY * cosZ + sinX * cosY * sinZ;
+  result->z = cosX * cosY * sinZ - sinX * sinY * cosZ;
+  result->w = cosX * cosY * cosZ + sinX * sinY * sinZ;
+}
+
+void quaternion_from_axis_angle(Vec4* result, const Vec3* axis, float angle)
+{
+  float s   = sinf(angle * 0.5f);
+  result->x = axis->x * s;
+  result->y = axis->y * s;
+  result->z = axis->z * s;
+  result->w = cosf(angle * 0.5f);
+}
+
+void quaternion_multiply(Vec4* result, const Vec4* operand)
+{
+  const Vec4* a = operand;
+  const Vec4* b = result;
+
+  Vec4 res = {{{a->w * b->x + a->x * b->w + a->y * b->z - a->z * b->y,
+      a->w * b->y - a->x * b->z + a->y * b->w + a->z * b->x,
+      a->w * b->z + a->x * b->y - a->y * b->x + a->z * b->w,
+      a->w * b->w - a->x * b->x - a->y * b->y - a->z * b->z}}};
+  *result  = res;
+}
+
+void quaternion_normalize(Vec4* result)
+{
+  float length = sqrtf(result->x * result->x + result->y * result->y
+                       + result->z * result->z + result->w * result->w);
+  float scale  = 1.0f / length;
+  result->x *= scale;
+  result->y *= scale;
+  result->z *= scale;
+  result->w *= scale;
+}
+
+void quaternion_conjugate(Vec4* result)
+{
+  result->x = -result->x;
+  result->y = -result->y;
+  result->z = -result->z;
+}
@@ -1,6 +1,7 @@
 #include "Otter/Math/Transform.h"
 
 #include "Otter/Math/Mat.h"
+#include "Otter/Math/Mat4Kernels.h"
 
 void transform_identity(Transform* transform)
 {
@@ -11,18 +12,55 @@ void transform_identity(Transform* transform)
   transform->rotation.x = 0;
   transform->rotation.y = 0;
   transform->rotation.z = 0;
+  transform->rotation.w = 1;
 
   transform->scale.x = 1;
   transform->scale.y = 1;
   transform->scale.z = 1;
 }
 
+void transform_to_matrix(Mat4 matrix, const Transform* transform)
+{
+  float x = transform->rotation.x;
+  float y = transform->rotation.y;
+  float z = transform->rotation.z;
+  float w = transform->rotation.w;
+
+  // The rows of mat4_rotate_quaternion's matrix, each scaled by its axis.
+  float sx     = transform->scale.x;
+  matrix[0][0] = sx * (1.0f - 2.0f * (y * y + z * z));
+  matrix[0][1] = sx * (2.0f * (x * y + w * z));
+  matrix[0][2] = sx * (2.0f * (x * z - w * y));
+  matrix[0][3] = 0.0f;
+
+  float sy     = transform->scale.y;
+  matrix[1][0] = sy * (2.0f * (x * y - w * z));
+  matrix[1][1] = sy * (1.0f - 2.0f * (x * x + z * z));
+  matrix[1][2] = sy * (2.0f * (w * x + y * z));
+  matrix[1][3] = 0.0f;
+
+  float sz     = transform->scale.z;
+  matrix[2][0] = sz * (2.0f * (w * y + x * z));
+  matrix[2][1] = sz * (2.0f * (y * z - w * x));
+  matrix[2][2] = sz * (1.0f - 2.0f * (x * x + y * y));
+  matrix[2][3] = 0.0f;
+
+  matrix[3][0] = transform->position.x;
+  matrix[3][1] = transform->position.y;
+  matrix[3][2] = transform->position.z;
+  matrix[3][3] = 1.0f;
+}
+
 void transform_apply(Mat4 matrix, Transform* transform)
 {
-  mat4_scale(
-      matrix, transform->scale.x, transform->scale.y, transform->scale.z);
-  mat4_rotate(matrix, transform->rotation.x, transform->rotation.y,
-      transform->rotation.z);
-  mat4_translate(matrix, transform->position.x, transform->position.y,
-      transform->position.z);
+  Mat4 transformMatrix;
+  transform_to_matrix(transformMatrix, transform);
+  mat4_multiply(transformMatrix, matrix);
+}
+
+void transform_arrays_to_matrices(const TransformArrays* transforms,
+    size_t first, size_t count, Mat4* result)
+{
+  mat4_get_kernels(CPU_SIMD_COUNT)->transforms_to_matrices(
+      transforms, first, count, result);
 }
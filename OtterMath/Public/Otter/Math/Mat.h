@@ -1,17 +1,74 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
 #include "Otter/Math/MatDef.h"
+#include "Otter/Math/Vec.h"
 #include "Otter/Math/export.h"
 
-OTTERMATH_API void mat4_identity(Mat4 matrix);
-
+/** @brief Multiply `matrix` by `operand`, so `operand` is applied after it. */
 OTTERMATH_API void mat4_multiply(Mat4 operand, Mat4 matrix);
 
-OTTERMATH_API void mat4_translate(Mat4 matrix, float x, float y, float z);
+OTTERMATH_API void mat4_transpose(Mat4 matrix);
 
-OTTERMATH_API void mat4_scale(Mat4 matrix, float x, float y, float z);
+/**
+ * @brief Invert a matrix whose last column is (0, 0, 0, 1), such as any mix
+ * of scales, rotations and translations.
+ *
+ * @return False, leaving `matrix` as it was, if it has no inverse.
+ */
+OTTERMATH_API bool mat4_inverse_affine(Mat4 matrix);
+
+/**
+ * @brief Transform `count` points by `matrix` into `result`, which can be
+ * `points`.
+ */
+OTTERMATH_API void mat4_transform_points(
+    Mat4 matrix, const Vec3* points, Vec3* result, size_t count);
 
 OTTERMATH_API void mat4_rotate(Mat4 matrix, float roll, float pitch, float yaw);
 
 OTTERMATH_API void mat4_rotate_quaternion(
     Mat4 matrix, float x, float y, float z, float w);
+
+// Inlined like the small functions in Vec.h, and compiled as exports by Mat.c.
+#ifndef OTTERMATH_MAT_INLINE
+#define OTTERMATH_MAT_INLINE static OTTER_FORCEINLINE
+#endif
+
+OTTERMATH_MAT_INLINE void mat4_identity(Mat4 matrix)
+{
+  memset(matrix, 0, sizeof(Mat4));
+  matrix[0][0] = 1.0f;
+  matrix[1][1] = 1.0f;
+  matrix[2][2] = 1.0f;
+  matrix[3][3] = 1.0f;
+}
+
+/**
+ * @brief Translate after `matrix`. Only the translation's non-zero terms are
+ * multiplied, which gives what `mat4_multiply` would.
+ */
+OTTERMATH_MAT_INLINE void mat4_translate(
+    Mat4 matrix, float x, float y, float z)
+{
+  for (int row = 0; row < 4; row++)
+  {
+    matrix[row][0] += matrix[row][3] * x;
+    matrix[row][1] += matrix[row][3] * y;
+    matrix[row][2] += matrix[row][3] * z;
+  }
+}
+
+/** @brief Scale after `matrix`. */
+OTTERMATH_MAT_INLINE void mat4_scale(Mat4 matrix, float x, float y, float z)
+{
+  for (int row = 0; row < 4; row++)
+  {
+    matrix[row][0] *= x;
+    matrix[row][1] *= y;
+    matrix[row][2] *= z;
+  }
+}
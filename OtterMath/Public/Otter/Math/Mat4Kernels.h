@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "Otter/Math/MatDef.h"
+#include "Otter/Math/Transform.h"
+#include "Otter/Math/Vec.h"
+#include "Otter/Math/export.h"
+#include "Otter/Util/Cpu.h"
+
+/**
+ * @brief One instruction set's version of each matrix operation. Every
+ * version does the same float operations in the same order, so they give the
+ * same results.
+ */
+typedef struct Mat4Kernels
+{
+  void (*multiply)(Mat4 operand, Mat4 matrix);
+  void (*multiply_vec4)(Vec4* vec, Mat4 matrix);
+  void (*transpose)(Mat4 matrix);
+  bool (*inverse_affine)(Mat4 matrix);
+  void (*transform_points)(
+      Mat4 matrix, const Vec3* points, Vec3* result, size_t count);
+  void (*transforms_to_matrices)(const TransformArrays* transforms,
+      size_t first, size_t count, Mat4* result);
+} Mat4Kernels;
+
+/**
+ * @brief Get the kernels written for `level`. Levels the CPU doesn't support
+ * fall back to the widest one it does, so `CPU_SIMD_COUNT` gets the fastest.
+ */
+OTTERMATH_API const Mat4Kernels* mat4_get_kernels(CpuSimdLevel level);
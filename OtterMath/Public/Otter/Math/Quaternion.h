@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Otter/Math/Vec.h"
+#include "Otter/Math/export.h"
+
+// Quaternions are kept in a Vec4 as (x, y, z, w), with w the real part.
+
+/**
+ * @brief Make the rotation `mat4_rotate` does with the same angles.
+ */
+OTTERMATH_API void quaternion_from_euler(
+    Vec4* result, float roll, float pitch, float yaw);
+
+/** @brief Make a rotation of `angle` radians around the unit vector `axis`. */
+OTTERMATH_API void quaternion_from_axis_angle(
+    Vec4* result, const Vec3* axis, float angle);
+
+/**
+ * @brief Combine two rotations, so `operand` is applied after `result`, like
+ * `mat4_multiply`.
+ */
+OTTERMATH_API void quaternion_multiply(Vec4* result, const Vec4* operand);
+
+/** @brief Scale back to unit length, which drifts after many multiplies. */
+OTTERMATH_API void quaternion_normalize(Vec4* result);
+
+/** @brief Make the opposite of a unit quaternion's rotation. */
+OTTERMATH_API void quaternion_conjugate(Vec4* result);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stddef.h>
+
 #include "Otter/Math/MatDef.h"
 #include "Otter/Math/Vec.h"
 #include "Otter/Math/export.h"
@@ -7,11 +9,41 @@
 typedef struct Transform
 {
   Vec3 position;
-  Vec3 rotation;
+  // A unit quaternion, made with the functions in Quaternion.h.
+  Vec4 rotation;
   Vec3 scale;
 } Transform;
 
+/**
+ * @brief Many transforms kept as one array per component, such as every x
+ * position in `position[0]`, so several can be loaded into a register at
+ * once.
+ */
+typedef struct TransformArrays
+{
+  float* position[3];
+  float* rotation[4];
+  float* scale[3];
+} TransformArrays;
+
 OTTERMATH_API void transform_identity(Transform* transform);
 
+/**
+ * @brief Write the matrix that scales, rotates and then translates by
+ * `transform`. Only the affine 3x4 part is worked out, in one pass, so it's
+ * much cheaper than building each step and multiplying them.
+ */
+OTTERMATH_API void transform_to_matrix(
+    Mat4 matrix, const Transform* transform);
+
+/** @brief Multiply `matrix` by the matrix for `transform`. */
 OTTERMATH_API void transform_apply(Mat4 matrix, Transform* transform);
 
+/**
+ * @brief Write the matrix for each transform from `first` up to
+ * `first + count` to the same index of `result`. Gives what
+ * `transform_to_matrix` does, but works out four or eight at a time.
+ */
+OTTERMATH_API void transform_arrays_to_matrices(
+    const TransformArrays* transforms, size_t first, size_t count,
+    Mat4* result);
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <math.h>
+#include <stddef.h>
+
 #include "Otter/Math/MatDef.h"
 #include "Otter/Math/export.h"
 
@@ -48,22 +51,82 @@ typedef struct Vec4
 
 OTTERMATH_API void vec4_multiply_mat4(Vec4* vec, Mat4 mat);
 
-OTTERMATH_API void vec3_add(Vec3* result, const Vec3* operand);
+// The functions below cost less than a call into the DLL, so they're defined
+// here to be inlined. Vec.c compiles them a second time as exports for C# and
+// anything else that can't use this header.
+#ifndef OTTERMATH_VEC_INLINE
+#define OTTERMATH_VEC_INLINE static OTTER_FORCEINLINE
+#endif
 
-OTTERMATH_API void vec3_subtract(Vec3* result, const Vec3* operand);
+OTTERMATH_VEC_INLINE void vec3_add(Vec3* result, const Vec3* operand)
+{
+  result->x += operand->x;
+  result->y += operand->y;
+  result->z += operand->z;
+}
 
-OTTERMATH_API void vec3_multiply(Vec3* result, float operand);
+OTTERMATH_VEC_INLINE void vec3_subtract(Vec3* result, const Vec3* operand)
+{
+  result->x -= operand->x;
+  result->y -= operand->y;
+  result->z -= operand->z;
+}
 
-OTTERMATH_API void vec3_divide(Vec3* result, float operand);
+OTTERMATH_VEC_INLINE void vec3_multiply(Vec3* result, float operand)
+{
+  result->x *= operand;
+  result->y *= operand;
+  result->z *= operand;
+}
 
-OTTERMATH_API void vec3_normalize(Vec3* result);
+OTTERMATH_VEC_INLINE void vec3_divide(Vec3* result, float operand)
+{
+  vec3_multiply(result, 1.0f / operand);
+}
+
+OTTERMATH_VEC_INLINE void vec3_normalize(Vec3* result)
+{
+  float w = sqrtf(
+      result->x * result->x + result->y * result->y + result->z * result->z);
+  vec3_divide(result, w);
+}
 
-OTTERMATH_API void vec3_cross(Vec3* result, const Vec3* operand);
+OTTERMATH_VEC_INLINE void vec3_cross(Vec3* result, const Vec3* operand)
+{
+  Vec3 res = {result->y * operand->z - result->z * operand->y,
+      result->z * operand->x - result->x * operand->z,
+      result->x * operand->y - result->y * operand->x};
+  *result  = res;
+}
 
-OTTERMATH_API float vec3_dot(const Vec3* result, const Vec3* operand);
+OTTERMATH_VEC_INLINE float vec3_dot(const Vec3* result, const Vec3* operand)
+{
+  return result->x * operand->x + result->y * operand->y
+       + result->z * operand->z;
+}
 
-OTTERMATH_API size_t vec3_max_index(const Vec3* result);
+OTTERMATH_VEC_INLINE size_t vec3_max_index(const Vec3* result)
+{
+  size_t max = 0;
+  if (result->y > result->x)
+  {
+    max = 1;
+  }
+  if (result->z > result->val[max])
+  {
+    max = 2;
+  }
+  return max;
+}
 
-OTTERMATH_API void vec2_subtract_scalar(Vec2* result, float operand);
+OTTERMATH_VEC_INLINE void vec2_subtract_scalar(Vec2* result, float operand)
+{
+  result->x -= operand;
+  result->y -= operand;
+}
 
-OTTERMATH_API void vec2_multiply(Vec2* result, float operand);
+OTTERMATH_VEC_INLINE void vec2_multiply(Vec2* result, float operand)
+{
+  result->x *= operand;
+  result->y *= operand;
+}
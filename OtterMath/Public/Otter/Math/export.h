@@ -5,3 +5,9 @@
 #else
 #define OTTERMATH_API __declspec(dllimport)
 #endif
+
+#ifdef _MSC_VER
+#define OTTER_FORCEINLINE __forceinline
+#else
+#define OTTER_FORCEINLINE inline __attribute__((always_inline))
+#endif
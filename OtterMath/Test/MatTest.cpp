@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+extern "C"
+{
+#include "Otter/Math/Mat.h"
+#include "Otter/Math/Mat4Kernels.h"
+}
+
+// Scale, rotation and translation, with values that don't round evenly.
+static void make_affine(Mat4 matrix, float seed)
+{
+  mat4_identity(matrix);
+  mat4_scale(matrix, 1.5f + seed, 0.75f, 2.25f - seed);
+  mat4_rotate(matrix, 0.3f * seed, 1.1f, -0.7f + seed);
+  mat4_translate(matrix, 12.5f, -3.25f * seed, 0.125f);
+}
+
+static void expect_matrices_equal(Mat4 expected, Mat4 actual, int level)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      EXPECT_FLOAT_EQ(expected[i][j], actual[i][j])
+          << cpu_simd_level_name((CpuSimdLevel) level) << " [" << i << "]["
+          << j << "]";
+    }
+  }
+}
+
+TEST(MatTest, MultipliesInOrder)
+{
+  Mat4 matrix;
+  mat4_identity(matrix);
+  mat4_scale(matrix, 2.0f, 2.0f, 2.0f);
+  mat4_translate(matrix, 1.0f, 2.0f, 3.0f);
+
+  Vec4 point = {{{1.0f, 1.0f, 1.0f, 1.0f}}};
+  vec4_multiply_mat4(&point, matrix);
+  EXPECT_FLOAT_EQ(point.x, 3.0f);
+  EXPECT_FLOAT_EQ(point.y, 4.0f);
+  EXPECT_FLOAT_EQ(point.z, 5.0f);
+  EXPECT_FLOAT_EQ(point.w, 1.0f);
+}
+
+TEST(MatTest, TranslateAndScaleMatchMultiply)
+{
+  for (int seed = 0; seed < 8; seed++)
+  {
+    Mat4 actual;
+    Mat4 expected;
+    make_affine(actual, (float) seed);
+    memcpy(expected, actual, sizeof(Mat4));
+
+    Mat4 operand;
+    mat4_identity(operand);
+    operand[0][0] = 0.5f + seed;
+    operand[1][1] = 3.0f;
+    operand[2][2] = -1.25f;
+    mat4_multiply(operand, expected);
+    mat4_identity(operand);
+    operand[3][0] = -7.5f;
+    operand[3][1] = 0.1f * seed;
+    operand[3][2] = 42.0f;
+    mat4_multiply(operand, expected);
+
+    mat4_scale(actual, 0.5f + seed, 3.0f, -1.25f);
+    mat4_translate(actual, -7.5f, 0.1f * seed, 42.0f);
+    expect_matrices_equal(expected, actual, CPU_SIMD_SCALAR);
+  }
+}
+
+TEST(MatTest, KernelsAgreeWithScalar)
+{
+  const Mat4Kernels* scalar = mat4_get_kernels(CPU_SIMD_SCALAR);
+  for (int level = CPU_SIMD_SSE42; level <= cpu_get_simd_level(); level++)
+  {
+    const Mat4Kernels* kernels = mat4_get_kernels((CpuSimdLevel) level);
+    for (int seed = 0; seed < 8; seed++)
+    {
+      Mat4 operand;
+      Mat4 expected;
+      Mat4 actual;
+      make_affine(operand, seed * 0.37f);
+      make_affine(expected, seed * -0.21f);
+      memcpy(actual, expected, sizeof(Mat4));
+      scalar->multiply(operand, expected);
+      kernels->multiply(operand, actual);
+      expect_matrices_equal(expected, actual, level);
+
+      scalar->transpose(expected);
+      kernels->transpose(actual);
+      expect_matrices_equal(expected, actual, level);
+
+      make_affine(expected, seed * 0.53f);
+      memcpy(actual, expected, sizeof(Mat4));
+      ASSERT_TRUE(scalar->inverse_affine(expected));
+      ASSERT_TRUE(kernels->inverse_affine(actual));
+      expect_matrices_equal(expected, actual, level);
+
+      Vec4 expectedVec = {{{1.5f, -2.0f, seed * 0.75f, 1.0f}}};
+      Vec4 actualVec   = expectedVec;
+      scalar->multiply_vec4(&expectedVec, operand);
+      kernels->multiply_vec4(&actualVec, operand);
+      for (int i = 0; i < 4; i++)
+      {
+        EXPECT_FLOAT_EQ(expectedVec.val[i], actualVec.val[i]);
+      }
+    }
+  }
+}
+
+TEST(MatTest, TransformsPointsLikeVec4)
+{
+  Mat4 matrix;
+  make_affine(matrix, 0.4f);
+
+  // An odd count leaves a point over after the pairs.
+  std::vector<Vec3> points;
+  for (int i = 0; i < 7; i++)
+  {
+    points.push_back({{{i * 1.25f, 3.0f - i, i * i * 0.5f}}});
+  }
+
+  for (int level = CPU_SIMD_SCALAR; level <= cpu_get_simd_level(); level++)
+  {
+    std::vector<Vec3> result(points.size());
+    mat4_get_kernels((CpuSimdLevel) level)
+        ->transform_points(matrix, points.data(), result.data(), points.size());
+
+    for (size_t i = 0; i < points.size(); i++)
+    {
+      Vec4 expected = {{{points[i].x, points[i].y, points[i].z, 1.0f}}};
+      mat4_get_kernels(CPU_SIMD_SCALAR)->multiply_vec4(&expected, matrix);
+      EXPECT_FLOAT_EQ(result[i].x, expected.x)
+          << cpu_simd_level_name((CpuSimdLevel) level);
+      EXPECT_FLOAT_EQ(result[i].y, expected.y);
+      EXPECT_FLOAT_EQ(result[i].z, expected.z);
+    }
+  }
+}
+
+TEST(MatTest, InverseUndoesTransform)
+{
+  Mat4 matrix;
+  Mat4 inverse;
+  make_affine(matrix, 0.8f);
+  memcpy(inverse, matrix, sizeof(Mat4));
+  ASSERT_TRUE(mat4_inverse_affine(inverse));
+
+  mat4_multiply(inverse, matrix);
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      EXPECT_NEAR(matrix[i][j], i == j ? 1.0f : 0.0f, 1e-5f);
+    }
+  }
+}
+
+TEST(MatTest, SingularMatricesHaveNoInverse)
+{
+  Mat4 matrix;
+  mat4_identity(matrix);
+  mat4_scale(matrix, 1.0f, 0.0f, 1.0f);
+
+  for (int level = CPU_SIMD_SCALAR; level <= cpu_get_simd_level(); level++)
+  {
+    Mat4 copy;
+    memcpy(copy, matrix, sizeof(Mat4));
+    EXPECT_FALSE(mat4_get_kernels((CpuSimdLevel) level)->inverse_affine(copy));
+    EXPECT_EQ(memcmp(copy, matrix, sizeof(Mat4)), 0);
+  }
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+extern "C"
+{
+#include "Otter/Math/Mat.h"
+#include "Otter/Math/Mat4Kernels.h"
+#include "Otter/Math/Quaternion.h"
+#include "Otter/Math/Transform.h"
+}
+
+static void expect_matrices_near(Mat4 expected, Mat4 actual)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      EXPECT_NEAR(expected[i][j], actual[i][j], 1e-5f)
+          << "[" << i << "][" << j << "]";
+    }
+  }
+}
+
+TEST(TransformTest, QuaternionFromEulerMatchesRotate)
+{
+  for (int seed = 0; seed < 8; seed++)
+  {
+    float roll  = 0.3f * seed;
+    float pitch = 1.1f - 0.2f * seed;
+    float yaw   = -0.7f + 0.45f * seed;
+
+    Mat4 expected;
+    mat4_identity(expected);
+    mat4_rotate(expected, roll, pitch, yaw);
+
+    Vec4 rotation;
+    quaternion_from_euler(&rotation, roll, pitch, yaw);
+    Mat4 actual;
+    mat4_identity(actual);
+    mat4_rotate_quaternion(
+        actual, rotation.x, rotation.y, rotation.z, rotation.w);
+
+    expect_matrices_near(expected, actual);
+  }
+}
+
+TEST(TransformTest, QuaternionMultiplyAppliesOperandAfter)
+{
+  Vec3 axis = {0.0f, 1.0f, 0.0f};
+  Vec4 first;
+  quaternion_from_axis_angle(&first, &axis, 0.8f);
+  Vec4 second;
+  quaternion_from_euler(&second, 0.4f, -0.3f, 1.2f);
+
+  Mat4 expected;
+  mat4_identity(expected);
+  mat4_rotate_quaternion(expected, first.x, first.y, first.z, first.w);
+  mat4_rotate_quaternion(expected, second.x, second.y, second.z, second.w);
+
+  quaternion_multiply(&first, &second);
+  Mat4 actual;
+  mat4_identity(actual);
+  mat4_rotate_quaternion(actual, first.x, first.y, first.z, first.w);
+
+  expect_matrices_near(expected, actual);
+}
+
+TEST(TransformTest, ToMatrixMatchesEachStep)
+{
+  Transform transform;
+  transform.position = {{{12.5f, -3.25f, 0.125f}}};
+  transform.scale    = {{{1.5f, 0.75f, -2.25f}}};
+  quaternion_from_euler(&transform.rotation, 0.3f, 1.1f, -0.7f);
+
+  Mat4 expected;
+  mat4_identity(expected);
+  mat4_scale(expected, transform.scale.x, transform.scale.y,
+      transform.scale.z);
+  mat4_rotate_quaternion(expected, transform.rotation.x,
+      transform.rotation.y, transform.rotation.z, transform.rotation.w);
+  mat4_translate(expected, transform.position.x, transform.position.y,
+      transform.position.z);
+
+  Mat4 actual;
+  transform_to_matrix(actual, &transform);
+  expect_matrices_near(expected, actual);
+}
+
+TEST(TransformTest, IdentityIsIdentityMatrix)
+{
+  Transform transform;
+  transform_identity(&transform);
+
+  Mat4 expected;
+  mat4_identity(expected);
+  Mat4 actual;
+  transform_to_matrix(actual, &transform);
+  expect_matrices_near(expected, actual);
+}
+
+TEST(TransformTest, ArrayKernelsMatchToMatrix)
+{
+  // Not a multiple of any kernel's width, and started partway in.
+  const size_t count = 27;
+  const size_t first = 3;
+  std::vector<float> values(10 * count);
+  TransformArrays transforms;
+  for (int i = 0; i < 3; i++)
+  {
+    transforms.position[i] = &values[i * count];
+    transforms.scale[i]    = &values[(3 + i) * count];
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    transforms.rotation[i] = &values[(6 + i) * count];
+  }
+
+  std::vector<Transform> expected(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    Transform* transform = &expected[i];
+    transform->position  = {{{1.5f * i, -0.25f * i, 3.0f}}};
+    transform->scale     = {{{1.0f + 0.1f * i, 0.5f, -2.0f}}};
+    quaternion_from_euler(
+        &transform->rotation, 0.3f * i, 1.1f - 0.2f * i, -0.7f);
+    for (int j = 0; j < 3; j++)
+    {
+      transforms.position[j][i] = transform->position.val[j];
+      transforms.scale[j][i]    = transform->scale.val[j];
+    }
+    for (int j = 0; j < 4; j++)
+    {
+      transforms.rotation[j][i] = transform->rotation.val[j];
+    }
+  }
+
+  for (int level = CPU_SIMD_SCALAR; level <= cpu_get_simd_level(); level++)
+  {
+    std::vector<float> results(16 * count);
+    Mat4* actual = reinterpret_cast<Mat4*>(results.data());
+    mat4_get_kernels((CpuSimdLevel) level)
+        ->transforms_to_matrices(&transforms, first, count - first, actual);
+    for (size_t i = first; i < count; i++)
+    {
+      Mat4 matrix;
+      transform_to_matrix(matrix, &expected[i]);
+      for (int j = 0; j < 16; j++)
+      {
+        EXPECT_FLOAT_EQ(matrix[j / 4][j % 4], actual[i][j / 4][j % 4])
+            << cpu_simd_level_name((CpuSimdLevel) level) << " transform "
+            << i << " [" << j / 4 << "][" << j % 4 << "]";
+      }
+    }
+  }
+}
@@ -6,8 +6,8 @@
 #include "Extern/stb_image.h"
 #include "Otter/Async/Scheduler.h"
 #include "Otter/Render/Gltf/GlbJsonChunk.h"
-#include "Otter/Util/Json/Json.h"
 #include "Otter/Util/Log.h"
+#include "Otter/Util/Memory/MemoryTag.h"
 
 #define GLB_MAGIC 0x46546C67
 
@@ -36,50 +36,12 @@ typedef struct MeshLoadParams
   GlbMeshPrimitive* primitive;
   AutoArray* accessors;
   AutoArray* bufferViews;
-  char* binaryData;
+  const char* binaryData;
   size_t assetMeshIndex;
   AutoArray* assetMeshes;
   GlbNode* node;
 } MeshLoadParams;
 
-typedef struct TextureLoadParams
-{
-  GlbBufferView* bufferView;
-  size_t index;
-  GlbChunk* binaryChunk;
-  GlbAssetImage* assetImage;
-} TextureLoadParams;
-
-static void glb_json_chunk_load_texture(TextureLoadParams* params, int threadId)
-{
-  (void) threadId;
-
-  // params->assetImage->data = stbi_load_from_memory(
-  //     (uint8_t*) &params->binaryChunk->data[params->bufferView->offset],
-  //     params->bufferView->length, &params->assetImage->width,
-  //     &params->assetImage->height, &params->assetImage->channels,
-  //     STBI_rgb_alpha);
-  // params->assetImage->channels = 4;
-
-  params->assetImage->data = malloc(params->bufferView->length);
-  if (params->assetImage->data == NULL)
-  {
-    LOG_ERROR("Unable to allocate memory for image.");
-    return;
-  }
-  memcpy(params->assetImage->data,
-      &params->binaryChunk->data[params->bufferView->offset],
-      params->bufferView->length);
-  params->assetImage->width    = params->bufferView->length;
-  params->assetImage->height   = 0;
-  params->assetImage->channels = 0;
-
-  if (params->assetImage->data == NULL)
-  {
-    LOG_ERROR("Unable to load image.");
-  }
-}
-
 static void glb_json_chunk_load_mesh(MeshLoadParams* params, int threadId)
 {
   (void) threadId;
@@ -100,53 +62,59 @@ static void glb_json_chunk_load_mesh(MeshLoadParams* params, int threadId)
       auto_array_get(params->accessors, params->primitive->position);
   GlbBufferView* positionBuffer =
       auto_array_get(params->bufferViews, positionAccessor->bufferView);
-  Vec3* positions = (Vec3*) &params->binaryData[positionBuffer->offset];
+  const Vec3* positions =
+      (const Vec3*) &params->binaryData[positionBuffer->offset];
 
   GlbAccessor* indexAccessor =
       auto_array_get(params->accessors, params->primitive->indices);
   GlbBufferView* indicesBuffer =
       auto_array_get(params->bufferViews, indexAccessor->bufferView);
-  uint16_t* indices = (uint16_t*) &params->binaryData[indicesBuffer->offset];
+  const uint16_t* indices =
+      (const uint16_t*) &params->binaryData[indicesBuffer->offset];
 
   GlbBufferView* normalBuffer = NULL;
-  Vec3* normals               = NULL;
+  const Vec3* normals         = NULL;
   if (params->primitive->normal >= 0)
   {
     GlbAccessor* normalAccessor =
         auto_array_get(params->accessors, params->primitive->normal);
     normalBuffer =
         auto_array_get(params->bufferViews, normalAccessor->bufferView);
-    normals = (Vec3*) &params->binaryData[normalBuffer->offset];
+    normals = (const Vec3*) &params->binaryData[normalBuffer->offset];
   }
 
   GlbBufferView* tangentBuffer = NULL;
-  Vec4* tangents               = NULL;
+  const Vec4* tangents         = NULL;
   if (params->primitive->tangent >= 0)
   {
     GlbAccessor* tangentAccessor =
         auto_array_get(params->accessors, params->primitive->tangent);
     tangentBuffer =
         auto_array_get(params->bufferViews, tangentAccessor->bufferView);
-    tangents = (Vec4*) &params->binaryData[tangentBuffer->offset];
+    tangents = (const Vec4*) &params->binaryData[tangentBuffer->offset];
   }
 
   GlbBufferView* uvBuffer = NULL;
-  Vec2* uvs               = NULL;
+  const Vec2* uvs         = NULL;
   if (params->primitive->uv >= 0)
   {
     GlbAccessor* uvAccessor =
         auto_array_get(params->accessors, params->primitive->uv);
     uvBuffer = auto_array_get(params->bufferViews, uvAccessor->bufferView);
-    uvs      = (Vec2*) &params->binaryData[uvBuffer->offset];
+    uvs      = (const Vec2*) &params->binaryData[uvBuffer->offset];
   }
 
   GlbAssetMesh* assetMesh =
       auto_array_get(params->assetMeshes, params->assetMeshIndex);
-  assetMesh->vertices = calloc(positionAccessor->count, sizeof(MeshVertex));
   assetMesh->numOfVertices = positionAccessor->count;
+  assetMesh->vertices      = OTTER_ALLOC(
+      MEMORY_TAG_ASSET, assetMesh->numOfVertices * sizeof(MeshVertex));
+  // Attributes the mesh doesn't have are left zeroed.
+  memset(assetMesh->vertices, 0, assetMesh->numOfVertices * sizeof(MeshVertex));
 
-  assetMesh->indices      = calloc(indexAccessor->count, sizeof(uint16_t));
   assetMesh->numOfIndices = indexAccessor->count;
+  assetMesh->indices      = OTTER_ALLOC(
+      MEMORY_TAG_ASSET, assetMesh->numOfIndices * sizeof(uint16_t));
 
   for (uint32_t attribute = 0; attribute < positionAccessor->count; attribute++)
   {
@@ -168,10 +136,7 @@ static void glb_json_chunk_load_mesh(MeshLoadParams* params, int threadId)
     }
   }
 
-  for (uint32_t index = 0; index < indexAccessor->count; index++)
-  {
-    assetMesh->indices[index] = indices[index];
-  }
+  memcpy(assetMesh->indices, indices, indexAccessor->count * sizeof(uint16_t));
 
   memcpy(&assetMesh->transform, &params->node->transform, sizeof(Mat4));
 
@@ -181,7 +146,7 @@ static void glb_json_chunk_load_mesh(MeshLoadParams* params, int threadId)
 // TODO: More closely examine where you're reading from content and ensure it
 // doesn't go over the contentSize.
 OTTERRENDER_API bool glb_load_asset(
-    char* content, size_t contentSize, GlbAsset* asset)
+    const char* content, size_t contentSize, GlbAsset* asset)
 {
   if (contentSize < sizeof(GlbHeader))
   {
@@ -189,7 +154,7 @@ OTTERRENDER_API bool glb_load_asset(
     return false;
   }
 
-  GlbHeader* glbHeader = (GlbHeader*) content;
+  const GlbHeader* glbHeader = (const GlbHeader*) content;
   if (glbHeader->magic != GLB_MAGIC || glbHeader->version != 2
       || glbHeader->length != contentSize)
   {
@@ -197,40 +162,34 @@ OTTERRENDER_API bool glb_load_asset(
     return false;
   }
 
-  GlbChunk* jsonChunk = (GlbChunk*) (content + sizeof(GlbHeader));
+  const GlbChunk* jsonChunk = (const GlbChunk*) (content + sizeof(GlbHeader));
   if (jsonChunk->type != GCT_JSON)
   {
     LOG_ERROR("First chunk must be a JSON chunk.");
     return false;
   }
 
-  size_t bytesParsed = 0;
-  JsonValue* glbJsonData =
-      json_parse(jsonChunk->data, jsonChunk->length, &bytesParsed);
-  if (glbJsonData == NULL)
-  {
-    LOG_ERROR("Unable to parse JSON chunk");
-    return false;
-  }
-
   GlbJsonChunk parsedJsonChunk = {0};
-  if (!glb_json_chunk_parse(glbJsonData, &parsedJsonChunk))
+  if (!glb_json_chunk_parse(
+          jsonChunk->data, jsonChunk->length, &parsedJsonChunk))
   {
-    json_destroy(glbJsonData);
+    glb_json_chunk_destroy(&parsedJsonChunk);
     return false;
   }
 
-  GlbChunk* binaryChunk = (GlbChunk*) (jsonChunk->data + jsonChunk->length);
+  const GlbChunk* binaryChunk =
+      (const GlbChunk*) (jsonChunk->data + jsonChunk->length);
   if (binaryChunk->type != GCT_BIN)
   {
     LOG_ERROR("Second chunk must be a binary chunk.");
-    json_destroy(glbJsonData);
+    glb_json_chunk_destroy(&parsedJsonChunk);
     return false;
   }
 
   AutoArray meshLoadParams;
   auto_array_create(&meshLoadParams, sizeof(MeshLoadParams));
-  auto_array_create(&asset->meshes, sizeof(GlbAssetMesh));
+  auto_array_create_with_allocator(&asset->meshes, sizeof(GlbAssetMesh),
+      memory_tag_get_allocator(MEMORY_TAG_ASSET));
   for (uint32_t i = 0; i < parsedJsonChunk.nodes.size; i++)
   {
     GlbNode* node = auto_array_get(&parsedJsonChunk.nodes, i);
@@ -266,7 +225,8 @@ OTTERRENDER_API bool glb_load_asset(
         (TaskFunction) glb_json_chunk_load_mesh, taskParams, 0);
   }
 
-  auto_array_create(&asset->materials, sizeof(GlbAssetMaterial));
+  auto_array_create_with_allocator(&asset->materials, sizeof(GlbAssetMaterial),
+      memory_tag_get_allocator(MEMORY_TAG_ASSET));
   auto_array_allocate_many(&asset->materials, parsedJsonChunk.materials.size);
   for (uint32_t i = 0; i < parsedJsonChunk.materials.size; i++)
   {
@@ -288,7 +248,8 @@ OTTERRENDER_API bool glb_load_asset(
     assetMaterial->alphaCutoff = material->alphaCutoff;
   }
 
-  auto_array_create(&asset->textures, sizeof(uint32_t));
+  auto_array_create_with_allocator(&asset->textures, sizeof(uint32_t),
+      memory_tag_get_allocator(MEMORY_TAG_ASSET));
   auto_array_allocate_many(&asset->textures, parsedJsonChunk.textures.size);
   for (uint32_t i = 0; i < parsedJsonChunk.textures.size; i++)
   {
@@ -297,34 +258,24 @@ OTTERRENDER_API bool glb_load_asset(
     *assetTexture          = texture->source;
   }
 
-  auto_array_create(&asset->images, sizeof(GlbAssetImage));
+  auto_array_create_with_allocator(&asset->images, sizeof(GlbAssetImage),
+      memory_tag_get_allocator(MEMORY_TAG_ASSET));
   auto_array_allocate_many(&asset->images, parsedJsonChunk.images.size);
 
-  AutoArray textureLoadTasks;
-  auto_array_create(&textureLoadTasks, sizeof(HANDLE));
-  auto_array_allocate_many(&textureLoadTasks, asset->images.size);
-
-  AutoArray textureLoadParams;
-  auto_array_create(&textureLoadParams, sizeof(TextureLoadParams));
-  auto_array_allocate_many(&textureLoadParams, asset->images.size);
-
+  // Images stay encoded, so they are handed out straight from the binary
+  // chunk rather than copied.
   for (uint32_t i = 0; i < parsedJsonChunk.images.size; i++)
   {
     GlbImage* image = auto_array_get(&parsedJsonChunk.images, i);
     GlbBufferView* imageBuffer =
         auto_array_get(&parsedJsonChunk.bufferViews, image->bufferView);
     GlbAssetImage* assetImage = auto_array_get(&asset->images, i);
-    assetImage->colorType     = image->colorType;
-
-    TextureLoadParams* taskParams = auto_array_get(&textureLoadParams, i);
-    taskParams->bufferView        = imageBuffer;
-    taskParams->index             = i;
-    taskParams->binaryChunk       = binaryChunk;
-    taskParams->assetImage        = assetImage;
-
-    HANDLE* task = auto_array_get(&textureLoadTasks, i);
-    *task        = task_scheduler_enqueue(
-        (TaskFunction) glb_json_chunk_load_texture, taskParams, 0);
+    assetImage->data =
+        (const uint8_t*) &binaryChunk->data[imageBuffer->offset];
+    assetImage->width     = imageBuffer->length;
+    assetImage->height    = 0;
+    assetImage->channels  = 0;
+    assetImage->colorType = image->colorType;
   }
 
   LOG_DEBUG("Waiting for meshes to load");
@@ -334,13 +285,6 @@ OTTERRENDER_API bool glb_load_asset(
     WaitForSingleObject(*task, INFINITE);
   }
 
-  LOG_DEBUG("Waiting for textures to load");
-  for (uint32_t i = 0; i < textureLoadTasks.size; i++)
-  {
-    HANDLE* task = auto_array_get(&textureLoadTasks, i);
-    WaitForSingleObject(*task, INFINITE);
-  }
-
   LOG_DEBUG("Loaded %d meshes, %d materials, %d textures, and %d images.",
       asset->meshes.size, asset->materials.size, asset->textures.size,
       asset->images.size);
@@ -348,11 +292,7 @@ OTTERRENDER_API bool glb_load_asset(
   auto_array_destroy(&meshLoadTasks);
   auto_array_destroy(&meshLoadParams);
 
-  auto_array_destroy(&textureLoadTasks);
-  auto_array_destroy(&textureLoadParams);
-
   glb_json_chunk_destroy(&parsedJsonChunk);
-  json_destroy(glbJsonData);
 
   return true;
 }
@@ -362,15 +302,10 @@ OTTERRENDER_API void glb_free_asset(GlbAsset* asset)
   for (size_t i = 0; i < asset->meshes.size; i++)
   {
     GlbAssetMesh* mesh = auto_array_get(&asset->meshes, i);
-    free(mesh->vertices);
-    free(mesh->indices);
-  }
-
-  for (size_t i = 0; i < asset->images.size; i++)
-  {
-    GlbAssetImage* image = auto_array_get(&asset->images, i);
-    // stbi_image_free(image->data);
-    free(image->data);
+    OTTER_FREE(MEMORY_TAG_ASSET, mesh->vertices,
+        mesh->numOfVertices * sizeof(MeshVertex));
+    OTTER_FREE(
+        MEMORY_TAG_ASSET, mesh->indices, mesh->numOfIndices * sizeof(uint16_t));
   }
 
   auto_array_destroy(&asset->meshes);
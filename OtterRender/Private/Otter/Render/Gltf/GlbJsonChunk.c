@@ -1,152 +1,230 @@
 #include "Otter/Render/Gltf/GlbJsonChunk.h"
 
-#include <time.h>
-
 #include "Otter/Math/Mat.h"
-#include "Otter/Util/Json/Json.h"
+#include "Otter/Util/Json/JsonCursor.h"
 #include "Otter/Util/Log.h"
+#include "Otter/Util/Memory/MemoryTag.h"
 
-static bool glb_json_chunk_parse_vec3(JsonValue* jsonValue, Vec3* result)
+// Read an array of exactly `count` numbers. `values` is only written when the
+// whole array is valid.
+static bool glb_json_chunk_parse_floats(
+    JsonCursor* cursor, float* values, uint32_t count)
 {
-  if (jsonValue->type != JT_ARRAY || jsonValue->array.size != 3)
+  if (!json_cursor_enter_array(cursor))
   {
     return false;
   }
 
-  JsonValue* x = *(JsonValue**) auto_array_get(&jsonValue->array, 0);
-  JsonValue* y = *(JsonValue**) auto_array_get(&jsonValue->array, 1);
-  JsonValue* z = *(JsonValue**) auto_array_get(&jsonValue->array, 2);
-  if ((x->type != JT_INTEGER && x->type != JT_FLOAT)
-      || (y->type != JT_INTEGER && y->type != JT_FLOAT)
-      || (z->type != JT_INTEGER && z->type != JT_FLOAT))
+  float parsed[16];
+  uint32_t length = 0;
+  bool valid      = count <= 16;
+  while (json_cursor_next_element(cursor))
+  {
+    double value;
+    if (length >= count)
+    {
+      json_cursor_skip(cursor);
+      valid = false;
+    }
+    else if (json_cursor_get_number(cursor, &value))
+    {
+      parsed[length] = (float) value;
+    }
+    else
+    {
+      valid = false;
+    }
+    length++;
+  }
+
+  if (!valid || length != count)
   {
     return false;
   }
+  memcpy(values, parsed, count * sizeof(float));
+  return true;
+}
 
-  result->x =
-      x->type == JT_INTEGER ? (float) x->integer : (float) x->floatingPoint;
-  result->y =
-      y->type == JT_INTEGER ? (float) y->integer : (float) y->floatingPoint;
-  result->z =
-      z->type == JT_INTEGER ? (float) z->integer : (float) z->floatingPoint;
+static bool glb_json_chunk_parse_vec3(JsonCursor* cursor, Vec3* result)
+{
+  return glb_json_chunk_parse_floats(cursor, result->val, 3);
+}
 
-  return true;
+static bool glb_json_chunk_parse_vec4(JsonCursor* cursor, Vec4* result)
+{
+  return glb_json_chunk_parse_floats(cursor, result->val, 4);
 }
 
-static bool glb_json_chunk_parse_vec4(JsonValue* jsonValue, Vec4* result)
+// Reads a texture info object such as `normalTexture`. `strength` may be NULL
+// when the texture has none.
+static void glb_json_chunk_parse_texture_info(JsonCursor* cursor,
+    const char* name, uint32_t* index, float* strength)
 {
-  if (jsonValue->type != JT_ARRAY || jsonValue->array.size != 4)
+  if (!json_cursor_enter_object(cursor))
   {
-    return false;
+    return;
   }
 
-  JsonValue* x = *(JsonValue**) auto_array_get(&jsonValue->array, 0);
-  JsonValue* y = *(JsonValue**) auto_array_get(&jsonValue->array, 1);
-  JsonValue* z = *(JsonValue**) auto_array_get(&jsonValue->array, 2);
-  JsonValue* w = *(JsonValue**) auto_array_get(&jsonValue->array, 3);
-  if ((x->type != JT_INTEGER && x->type != JT_FLOAT)
-      || (y->type != JT_INTEGER && y->type != JT_FLOAT)
-      || (z->type != JT_INTEGER && z->type != JT_FLOAT)
-      || (w->type != JT_INTEGER && w->type != JT_FLOAT))
+  bool hasIndex = false;
+  StringView key;
+  while (json_cursor_next_member(cursor, &key))
   {
-    return false;
+    int64_t value;
+    double number;
+    if (string_view_equals_cstr(key, "index"))
+    {
+      hasIndex = json_cursor_get_integer(cursor, &value);
+      if (hasIndex)
+      {
+        *index = (uint32_t) value;
+      }
+    }
+    else if (strength != NULL && string_view_equals_cstr(key, "strength")
+             && json_cursor_get_number(cursor, &number))
+    {
+      *strength = (float) number;
+    }
+    else
+    {
+      json_cursor_skip(cursor);
+    }
+  }
+
+  if (!hasIndex)
+  {
+    LOG_WARNING("%s texture source was not an integer.", name);
+  }
+}
+
+// Members can come in any order, so the transform is only built once the
+// whole node has been read.
+typedef struct GlbNodeTransform
+{
+  bool hasMatrix;
+  bool hasTranslation;
+  bool hasRotation;
+  bool hasScale;
+  bool valid;
+  float matrix[16];
+  Vec3 translation;
+  Vec4 rotation;
+  Vec3 scale;
+} GlbNodeTransform;
+
+static void glb_json_chunk_apply_node_transformation(
+    GlbNodeTransform* transform, GlbNode* newNode)
+{
+  if (transform->hasMatrix)
+  {
+    for (uint32_t m = 0; m < 16; m++)
+    {
+      newNode->transform[m / 4][m % 4] = transform->matrix[m];
+    }
+    return;
   }
 
-  result->x =
-      x->type == JT_INTEGER ? (float) x->integer : (float) x->floatingPoint;
-  result->y =
-      y->type == JT_INTEGER ? (float) y->integer : (float) y->floatingPoint;
-  result->z =
-      z->type == JT_INTEGER ? (float) z->integer : (float) z->floatingPoint;
-  result->w =
-      w->type == JT_INTEGER ? (float) w->integer : (float) w->floatingPoint;
+  if (transform->hasTranslation)
+  {
+    mat4_translate(newNode->transform, transform->translation.x,
+        transform->translation.y, transform->translation.z);
+  }
 
-  return true;
+  if (transform->hasRotation)
+  {
+    mat4_rotate_quaternion(newNode->transform, transform->rotation.x,
+        transform->rotation.y, transform->rotation.z, transform->rotation.w);
+  }
+
+  if (transform->hasScale)
+  {
+    mat4_scale(newNode->transform, transform->scale.x, transform->scale.y,
+        transform->scale.z);
+  }
 }
 
 static bool glb_json_chunk_parse_node_transformation(
-    JsonValue* nodeElement, GlbNode* newNode)
+    JsonCursor* cursor, StringView key, GlbNodeTransform* transform)
 {
-  JsonValue* transformMatrix =
-      hash_map_get_value(&nodeElement->object, "matrix", strlen("matrix"));
-  if (transformMatrix != NULL)
+  if (string_view_equals_cstr(key, "matrix"))
   {
-    if (transformMatrix->type != JT_ARRAY || transformMatrix->array.size != 16)
+    transform->hasMatrix = true;
+    if (!glb_json_chunk_parse_floats(cursor, transform->matrix, 16))
     {
       LOG_WARNING("Matrix was not in the right format for node.");
-      return false;
+      transform->valid = false;
     }
-
-    for (uint32_t m = 0; m < 16; m++)
+  }
+  else if (string_view_equals_cstr(key, "translation"))
+  {
+    transform->hasTranslation = true;
+    if (!glb_json_chunk_parse_vec3(cursor, &transform->translation))
     {
-      JsonValue* matrixElement =
-          *(JsonValue**) auto_array_get(&transformMatrix->array, m);
-      if (matrixElement->type != JT_FLOAT && matrixElement->type != JT_INTEGER)
-      {
-        LOG_WARNING("Matrix element was not a number for node.");
-        return false;
-      }
-      newNode->transform[m / 4][m % 4] = matrixElement->type == JT_FLOAT
-                                           ? matrixElement->floatingPoint
-                                           : matrixElement->integer;
+      LOG_WARNING("Translation was not in the right format for node.");
+      transform->valid = false;
     }
   }
-  else
+  else if (string_view_equals_cstr(key, "rotation"))
   {
-    JsonValue* translation = hash_map_get_value(
-        &nodeElement->object, "translation", strlen("translation"));
-    if (translation != NULL)
+    transform->hasRotation = true;
+    if (!glb_json_chunk_parse_vec4(cursor, &transform->rotation))
     {
-      Vec3 translationTransform = {0};
-      if (!glb_json_chunk_parse_vec3(translation, &translationTransform))
-      {
-        LOG_WARNING("Translation was not in the right format for node.");
-        return false;
-      }
-      mat4_translate(newNode->transform, translationTransform.x,
-          translationTransform.y, translationTransform.z);
+      LOG_WARNING("Rotation was not in the right format for node.");
+      transform->valid = false;
     }
-
-    JsonValue* rotation = hash_map_get_value(
-        &nodeElement->object, "rotation", strlen("rotation"));
-    if (rotation != NULL)
+  }
+  else if (string_view_equals_cstr(key, "scale"))
+  {
+    transform->hasScale = true;
+    if (!glb_json_chunk_parse_vec3(cursor, &transform->scale))
     {
-      Vec4 rotationTransform = {0};
-      if (!glb_json_chunk_parse_vec4(rotation, &rotationTransform))
-      {
-        LOG_WARNING("Rotation was not in the right format for node.");
-        return false;
-      }
-      mat4_rotate_quaternion(newNode->transform, rotationTransform.x,
-          rotationTransform.y, rotationTransform.z, rotationTransform.w);
+      LOG_WARNING("Scale was not in the right format for node.");
+      transform->valid = false;
     }
+  }
+  else
+  {
+    return false;
+  }
+
+  return true;
+}
+
+static void glb_json_chunk_parse_children(
+    JsonCursor* cursor, GlbNode* newNode, uint32_t nodeIndex)
+{
+  if (!json_cursor_enter_array(cursor))
+  {
+    return;
+  }
 
-    JsonValue* scale =
-        hash_map_get_value(&nodeElement->object, "scale", strlen("scale"));
-    if (scale != NULL)
+  while (json_cursor_next_element(cursor))
+  {
+    int64_t child;
+    if (json_cursor_get_integer(cursor, &child))
     {
-      Vec3 scaleTransform = {0};
-      if (!glb_json_chunk_parse_vec3(scale, &scaleTransform))
-      {
-        LOG_WARNING("Scale was not in the right format for node.");
-        return false;
-      }
-      mat4_scale(newNode->transform, scaleTransform.x, scaleTransform.y,
-          scaleTransform.z);
+      *(uint32_t*) auto_array_allocate(&newNode->children) = (uint32_t) child;
+    }
+    else
+    {
+      LOG_WARNING("Child was not a number for node %d", nodeIndex);
     }
   }
-
-  return true;
 }
 
-static void glb_json_chunk_parse_nodes(JsonValue* nodes, AutoArray* array)
+static bool glb_json_chunk_parse_nodes(JsonCursor* cursor, AutoArray* array)
 {
-  auto_array_create(array, sizeof(GlbNode));
+  auto_array_create_with_allocator(
+      array, sizeof(GlbNode), memory_tag_get_allocator(MEMORY_TAG_ASSET));
+  if (!json_cursor_enter_array(cursor))
+  {
+    LOG_ERROR("Nodes were not an array.");
+    return false;
+  }
 
-  for (uint32_t i = 0; i < nodes->array.size; i++)
+  uint32_t i = 0;
+  for (; json_cursor_next_element(cursor); i++)
   {
-    JsonValue* nodeElement = *(JsonValue**) auto_array_get(&nodes->array, i);
-    if (nodeElement->type != JT_OBJECT)
+    if (!json_cursor_enter_object(cursor))
     {
       LOG_WARNING("Node was not an object for node %d", i);
       continue;
@@ -155,713 +233,857 @@ static void glb_json_chunk_parse_nodes(JsonValue* nodes, AutoArray* array)
     GlbNode* newNode = auto_array_allocate(array);
     newNode->type    = NT_EMPTY;
     mat4_identity(newNode->transform);
+    auto_array_create_with_allocator(&newNode->children, sizeof(uint32_t),
+        memory_tag_get_allocator(MEMORY_TAG_ASSET));
 
-    JsonValue* meshIndex =
-        hash_map_get_value(&nodeElement->object, "mesh", strlen("mesh"));
-    if (meshIndex != NULL && meshIndex->type == JT_INTEGER)
+    GlbNodeTransform transform = {0};
+    transform.valid            = true;
+
+    StringView key;
+    while (json_cursor_next_member(cursor, &key))
     {
-      newNode->type = NT_MESH;
-      newNode->mesh = meshIndex->integer;
+      int64_t meshIndex;
+      if (string_view_equals_cstr(key, "mesh"))
+      {
+        if (json_cursor_get_integer(cursor, &meshIndex))
+        {
+          newNode->type = NT_MESH;
+          newNode->mesh = (uint32_t) meshIndex;
+        }
+      }
+      else if (string_view_equals_cstr(key, "children"))
+      {
+        glb_json_chunk_parse_children(cursor, newNode, i);
+      }
+      else if (!glb_json_chunk_parse_node_transformation(
+                   cursor, key, &transform))
+      {
+        json_cursor_skip(cursor);
+      }
     }
 
-    if (!glb_json_chunk_parse_node_transformation(nodeElement, newNode))
+    if (!transform.valid)
     {
       newNode->type = NT_EMPTY;
       LOG_WARNING("Node transformation was not parsed properly for node %d", i);
       continue;
     }
-
-    auto_array_create(&newNode->children, sizeof(uint32_t));
-    JsonValue* children = hash_map_get_value(
-        &nodeElement->object, "children", strlen("children"));
-    if (children != NULL && children->type == JT_ARRAY)
-    {
-      for (uint32_t c = 0; c < children->array.size; c++)
-      {
-        JsonValue* child = *(JsonValue**) auto_array_get(&children->array, c);
-        if (child->type == JT_INTEGER)
-        {
-          *(uint32_t*) auto_array_allocate(&newNode->children) = child->integer;
-        }
-        else
-        {
-          LOG_WARNING("Child was not a number for node %d", i);
-        }
-      }
-    }
+    glb_json_chunk_apply_node_transformation(&transform, newNode);
   }
+
+  return true;
 }
 
-static void glb_json_chunk_parse_meshes(JsonValue* meshes, AutoArray* array)
+static void glb_json_chunk_parse_attributes(
+    JsonCursor* cursor, GlbMeshPrimitive* primitive)
 {
-  auto_array_create(array, sizeof(GlbMesh));
-
-  auto_array_allocate_many(array, meshes->array.size);
-  for (uint32_t i = 0; i < meshes->array.size; i++)
+  StringView key;
+  while (json_cursor_next_member(cursor, &key))
   {
-    GlbMesh* mesh = auto_array_get(array, i);
-    auto_array_create(&mesh->primitives, sizeof(GlbMeshPrimitive));
-
-    JsonValue* meshElement = *(JsonValue**) auto_array_get(&meshes->array, i);
-    if (meshElement->type != JT_OBJECT)
+    int32_t* attribute = NULL;
+    if (string_view_equals_cstr(key, "POSITION"))
     {
-      LOG_ERROR("Mesh was not an object.");
-      continue;
+      attribute = &primitive->position;
     }
-
-    JsonValue* primitives = hash_map_get_value(
-        &meshElement->object, "primitives", strlen("primitives"));
-    if (primitives == NULL || primitives->type != JT_ARRAY)
+    else if (string_view_equals_cstr(key, "NORMAL"))
     {
-      LOG_ERROR("Primitives were not present.");
-      continue;
+      attribute = &primitive->normal;
     }
-
-    for (uint32_t p = 0; p < primitives->array.size; p++)
+    else if (string_view_equals_cstr(key, "TANGENT"))
     {
-      JsonValue* primitive =
-          *(JsonValue**) auto_array_get(&primitives->array, p);
-      if (primitive == NULL || primitive->type != JT_OBJECT)
-      {
-        LOG_ERROR("Primitive was not an object.");
-        continue;
-      }
-      JsonValue* attributes = hash_map_get_value(
-          &primitive->object, "attributes", strlen("attributes"));
-      if (attributes == NULL || attributes->type != JT_OBJECT)
-      {
-        LOG_ERROR("Attributes were not present.");
-        continue;
-      }
+      attribute = &primitive->tangent;
+    }
+    else if (string_view_equals_cstr(key, "TEXCOORD_0"))
+    {
+      attribute = &primitive->uv;
+    }
 
-      JsonValue* indices =
-          hash_map_get_value(&primitive->object, "indices", strlen("indices"));
-      if (indices == NULL || indices->type != JT_INTEGER)
-      {
-        LOG_ERROR("Indices were not present.");
-        continue;
-      }
+    int64_t accessor;
+    if (attribute == NULL)
+    {
+      json_cursor_skip(cursor);
+    }
+    else if (json_cursor_get_integer(cursor, &accessor))
+    {
+      *attribute = (int32_t) accessor;
+    }
+  }
+}
 
-      GlbMeshPrimitive* meshPrimitives = auto_array_allocate(&mesh->primitives);
-      meshPrimitives->position         = -1;
-      meshPrimitives->normal           = -1;
-      meshPrimitives->tangent          = -1;
-      meshPrimitives->uv               = -1;
-      meshPrimitives->indices          = indices->integer;
-      meshPrimitives->material         = -1;
-
-      JsonValue* position = hash_map_get_value(
-          &attributes->object, "POSITION", strlen("POSITION"));
-      if (position != NULL && position->type == JT_INTEGER)
-      {
-        meshPrimitives->position = position->integer;
-      }
-      else
-      {
-        LOG_WARNING("Position was not in the right format.");
-      }
+static void glb_json_chunk_parse_primitive(JsonCursor* cursor, GlbMesh* mesh)
+{
+  if (!json_cursor_enter_object(cursor))
+  {
+    LOG_ERROR("Primitive was not an object.");
+    return;
+  }
 
-      JsonValue* normal =
-          hash_map_get_value(&attributes->object, "NORMAL", strlen("NORMAL"));
-      if (normal != NULL && normal->type == JT_INTEGER)
-      {
-        meshPrimitives->normal = normal->integer;
-      }
-      else
+  GlbMeshPrimitive primitive;
+  primitive.position = -1;
+  primitive.normal   = -1;
+  primitive.tangent  = -1;
+  primitive.uv       = -1;
+  primitive.indices  = -1;
+  primitive.material = -1;
+
+  bool hasAttributes = false;
+  bool hasIndices    = false;
+  StringView key;
+  while (json_cursor_next_member(cursor, &key))
+  {
+    int64_t value;
+    if (string_view_equals_cstr(key, "attributes"))
+    {
+      hasAttributes = json_cursor_enter_object(cursor);
+      if (hasAttributes)
       {
-        LOG_WARNING("Normal was not in the right format.");
+        glb_json_chunk_parse_attributes(cursor, &primitive);
       }
-
-      JsonValue* tangent =
-          hash_map_get_value(&attributes->object, "TANGENT", strlen("TANGENT"));
-      if (tangent != NULL && tangent->type == JT_INTEGER)
+    }
+    else if (string_view_equals_cstr(key, "indices"))
+    {
+      hasIndices = json_cursor_get_integer(cursor, &value);
+      if (hasIndices)
       {
-        meshPrimitives->tangent = tangent->integer;
+        primitive.indices = (int32_t) value;
       }
-      else
+    }
+    else if (string_view_equals_cstr(key, "material"))
+    {
+      if (json_cursor_get_integer(cursor, &value))
       {
-        LOG_WARNING("Tangent was not in the right format.");
+        primitive.material = (int32_t) value;
       }
+    }
+    else
+    {
+      json_cursor_skip(cursor);
+    }
+  }
 
-      JsonValue* uv = hash_map_get_value(
-          &attributes->object, "TEXCOORD_0", strlen("TEXCOORD_0"));
-      if (uv != NULL && uv->type == JT_INTEGER)
-      {
-        meshPrimitives->uv = uv->integer;
-      }
-      else
-      {
-        LOG_WARNING("UV was not in the right format.");
-      }
+  if (!hasAttributes)
+  {
+    LOG_ERROR("Attributes were not present.");
+    return;
+  }
+  if (!hasIndices)
+  {
+    LOG_ERROR("Indices were not present.");
+    return;
+  }
 
-      JsonValue* material = hash_map_get_value(
-          &primitive->object, "material", strlen("material"));
-      if (material != NULL && material->type == JT_INTEGER)
-      {
-        meshPrimitives->material = material->integer;
-      }
-      else
-      {
-        LOG_WARNING("Material was not in the right format.");
-      }
-    }
+  if (primitive.position < 0)
+  {
+    LOG_WARNING("Position was not in the right format.");
   }
+  if (primitive.normal < 0)
+  {
+    LOG_WARNING("Normal was not in the right format.");
+  }
+  if (primitive.tangent < 0)
+  {
+    LOG_WARNING("Tangent was not in the right format.");
+  }
+  if (primitive.uv < 0)
+  {
+    LOG_WARNING("UV was not in the right format.");
+  }
+  if (primitive.material < 0)
+  {
+    LOG_WARNING("Material was not in the right format.");
+  }
+
+  *(GlbMeshPrimitive*) auto_array_allocate(&mesh->primitives) = primitive;
 }
 
-static void glb_json_chunk_parse_materials(
-    JsonValue* materials, AutoArray* array)
+static bool glb_json_chunk_parse_meshes(JsonCursor* cursor, AutoArray* array)
 {
-  auto_array_create(array, sizeof(GlbMaterial));
-  auto_array_allocate_many(array, materials->array.size);
+  auto_array_create_with_allocator(
+      array, sizeof(GlbMesh), memory_tag_get_allocator(MEMORY_TAG_ASSET));
+  if (!json_cursor_enter_array(cursor))
+  {
+    LOG_ERROR("Meshes were not an array.");
+    return false;
+  }
 
-  for (uint32_t i = 0; i < materials->array.size; i++)
+  while (json_cursor_next_element(cursor))
   {
-    GlbMaterial* material              = auto_array_get(array, i);
-    material->baseColorFactor.x        = 1.0f;
-    material->baseColorFactor.y        = 1.0f;
-    material->baseColorFactor.z        = 1.0f;
-    material->baseColorFactor.w        = 1.0f;
-    material->baseColorTexture         = -1;
-    material->metallicFactor           = 1.0f;
-    material->roughnessFactor          = 1.0f;
-    material->metallicRoughnessTexture = -1;
-    material->normalTexture            = -1;
-    material->occlusionTexture         = -1;
-    material->occlusionStrength        = 0.0f;
-    material->emissiveFactor.x         = 0.0f;
-    material->emissiveFactor.y         = 0.0f;
-    material->emissiveFactor.z         = 0.0f;
-    material->emissiveTexture          = -1;
-    material->alphaMode                = GLB_MATERIAL_ALPHA_MODE_OPAQUE;
-    material->alphaCutoff              = 0.5f;
+    GlbMesh* mesh = auto_array_allocate(array);
+    auto_array_create_with_allocator(&mesh->primitives,
+        sizeof(GlbMeshPrimitive), memory_tag_get_allocator(MEMORY_TAG_ASSET));
 
-    JsonValue* materialElement =
-        *(JsonValue**) auto_array_get(&materials->array, i);
-    if (materialElement->type != JT_OBJECT)
+    if (!json_cursor_enter_object(cursor))
     {
-      LOG_ERROR("Material was not an object.");
+      LOG_ERROR("Mesh was not an object.");
       continue;
     }
 
-    JsonValue* name =
-        hash_map_get_value(&materialElement->object, "name", strlen("name"));
-
-    JsonValue* pbr = hash_map_get_value(&materialElement->object,
-        "pbrMetallicRoughness", strlen("pbrMetallicRoughness"));
-    if (pbr != NULL && pbr->type == JT_OBJECT)
+    bool hasPrimitives = false;
+    StringView key;
+    while (json_cursor_next_member(cursor, &key))
     {
-      JsonValue* baseColorFactor = hash_map_get_value(
-          &pbr->object, "baseColorFactor", strlen("baseColorFactor"));
-      if (baseColorFactor != NULL)
+      if (string_view_equals_cstr(key, "primitives")
+          && json_cursor_enter_array(cursor))
       {
-        if (!glb_json_chunk_parse_vec4(
-                baseColorFactor, &material->baseColorFactor))
+        hasPrimitives = true;
+        while (json_cursor_next_element(cursor))
         {
-          LOG_ERROR("Base color factor was not in the right format.");
+          glb_json_chunk_parse_primitive(cursor, mesh);
         }
       }
-
-      JsonValue* baseColorTexture = hash_map_get_value(
-          &pbr->object, "baseColorTexture", strlen("baseColorTexture"));
-      if (baseColorTexture != NULL && baseColorTexture->type == JT_OBJECT)
+      else if (!string_view_equals_cstr(key, "primitives"))
       {
-        JsonValue* baseColorTextureSource = hash_map_get_value(
-            &baseColorTexture->object, "index", strlen("index"));
-        if (baseColorTextureSource != NULL
-            && baseColorTextureSource->type == JT_INTEGER)
-        {
-          material->baseColorTexture = baseColorTextureSource->integer;
-        }
-        else
-        {
-          LOG_WARNING("Base color texture source was not an integer.");
-        }
+        json_cursor_skip(cursor);
       }
+    }
 
-      JsonValue* metallicFactor = hash_map_get_value(
-          &pbr->object, "metallicFactor", strlen("metallicFactor"));
-      if (metallicFactor != NULL && metallicFactor->type == JT_FLOAT)
-      {
-        material->metallicFactor = metallicFactor->floatingPoint;
-      }
+    if (!hasPrimitives)
+    {
+      LOG_ERROR("Primitives were not present.");
+    }
+  }
 
-      JsonValue* roughnessFactor = hash_map_get_value(
-          &pbr->object, "roughnessFactor", strlen("roughnessFactor"));
-      if (roughnessFactor != NULL && roughnessFactor->type == JT_FLOAT)
-      {
-        material->roughnessFactor = roughnessFactor->floatingPoint;
-      }
+  return true;
+}
 
-      JsonValue* metallicRoughnessTexture = hash_map_get_value(&pbr->object,
-          "metallicRoughnessTexture", strlen("metallicRoughnessTexture"));
-      if (metallicRoughnessTexture != NULL
-          && metallicRoughnessTexture->type == JT_OBJECT)
+static void glb_json_chunk_parse_pbr(
+    JsonCursor* cursor, GlbMaterial* material)
+{
+  StringView key;
+  while (json_cursor_next_member(cursor, &key))
+  {
+    double value;
+    if (string_view_equals_cstr(key, "baseColorFactor"))
+    {
+      if (!glb_json_chunk_parse_vec4(cursor, &material->baseColorFactor))
       {
-        JsonValue* metallicRoughnessTextureSource = hash_map_get_value(
-            &metallicRoughnessTexture->object, "index", strlen("index"));
-        if (metallicRoughnessTextureSource != NULL
-            && metallicRoughnessTextureSource->type == JT_INTEGER)
-        {
-          material->metallicRoughnessTexture =
-              metallicRoughnessTextureSource->integer;
-        }
-        else
-        {
-          LOG_WARNING("Metallic roughness texture source was not an integer.");
-        }
+        LOG_ERROR("Base color factor was not in the right format.");
       }
     }
-    else
+    else if (string_view_equals_cstr(key, "baseColorTexture"))
     {
-      LOG_WARNING("PBR was not an object.");
+      glb_json_chunk_parse_texture_info(
+          cursor, "Base color", &material->baseColorTexture, NULL);
     }
-
-    JsonValue* normalTexture = hash_map_get_value(
-        &materialElement->object, "normalTexture", strlen("normalTexture"));
-    if (normalTexture != NULL && normalTexture->type == JT_OBJECT)
+    else if (string_view_equals_cstr(key, "metallicFactor"))
     {
-      JsonValue* normalTextureSource =
-          hash_map_get_value(&normalTexture->object, "index", strlen("index"));
-      if (normalTextureSource != NULL
-          && normalTextureSource->type == JT_INTEGER)
+      if (json_cursor_get_number(cursor, &value))
       {
-        material->normalTexture = normalTextureSource->integer;
-      }
-      else
-      {
-        LOG_WARNING("Normal texture source was not an integer.");
+        material->metallicFactor = (float) value;
       }
     }
-
-    JsonValue* occlusionTexture = hash_map_get_value(&materialElement->object,
-        "occlusionTexture", strlen("occlusionTexture"));
-    if (occlusionTexture != NULL && occlusionTexture->type == JT_OBJECT)
+    else if (string_view_equals_cstr(key, "roughnessFactor"))
     {
-      JsonValue* occlusionTextureSource = hash_map_get_value(
-          &occlusionTexture->object, "index", strlen("index"));
-      if (occlusionTextureSource != NULL
-          && occlusionTextureSource->type == JT_INTEGER)
-      {
-        material->occlusionTexture = occlusionTextureSource->integer;
-      }
-      else
+      if (json_cursor_get_number(cursor, &value))
       {
-        LOG_WARNING("Occlusion texture source was not an integer.");
+        material->roughnessFactor = (float) value;
       }
+    }
+    else if (string_view_equals_cstr(key, "metallicRoughnessTexture"))
+    {
+      glb_json_chunk_parse_texture_info(cursor, "Metallic roughness",
+          &material->metallicRoughnessTexture, NULL);
+    }
+    else
+    {
+      json_cursor_skip(cursor);
+    }
+  }
+}
+
+static void glb_json_chunk_parse_alpha_mode(
+    JsonCursor* cursor, GlbMaterial* material)
+{
+  StringView alphaModeName;
+  if (!json_cursor_get_unescaped_string(cursor, &alphaModeName))
+  {
+    return;
+  }
+
+  if (string_view_equals_cstr(alphaModeName, "OPAQUE"))
+  {
+    material->alphaMode = GLB_MATERIAL_ALPHA_MODE_OPAQUE;
+  }
+  else if (string_view_equals_cstr(alphaModeName, "MASK"))
+  {
+    material->alphaMode = GLB_MATERIAL_ALPHA_MODE_MASK;
+  }
+  else if (string_view_equals_cstr(alphaModeName, "BLEND"))
+  {
+    material->alphaMode = GLB_MATERIAL_ALPHA_MODE_BLEND;
+  }
+  else
+  {
+    LOG_ERROR("Alpha mode was not recognized.");
+  }
+}
 
-      JsonValue* occlusionStrength = hash_map_get_value(
-          &occlusionTexture->object, "strength", strlen("strength"));
-      if (occlusionStrength != NULL && occlusionStrength->type == JT_FLOAT)
+static void glb_json_chunk_parse_material(
+    JsonCursor* cursor, GlbMaterial* material)
+{
+  bool hasPbr = false;
+  StringView key;
+  while (json_cursor_next_member(cursor, &key))
+  {
+    double value;
+    if (string_view_equals_cstr(key, "pbrMetallicRoughness"))
+    {
+      hasPbr = json_cursor_enter_object(cursor);
+      if (hasPbr)
       {
-        material->occlusionStrength = occlusionStrength->floatingPoint;
+        glb_json_chunk_parse_pbr(cursor, material);
       }
     }
-
-    JsonValue* emissiveFactor = hash_map_get_value(
-        &materialElement->object, "emissiveFactor", strlen("emissiveFactor"));
-    if (emissiveFactor != NULL)
+    else if (string_view_equals_cstr(key, "normalTexture"))
+    {
+      glb_json_chunk_parse_texture_info(
+          cursor, "Normal", &material->normalTexture, NULL);
+    }
+    else if (string_view_equals_cstr(key, "occlusionTexture"))
     {
-      if (!glb_json_chunk_parse_vec3(emissiveFactor, &material->emissiveFactor))
+      glb_json_chunk_parse_texture_info(cursor, "Occlusion",
+          &material->occlusionTexture, &material->occlusionStrength);
+    }
+    else if (string_view_equals_cstr(key, "emissiveFactor"))
+    {
+      if (!glb_json_chunk_parse_vec3(cursor, &material->emissiveFactor))
       {
         LOG_ERROR("Emissive factor was not in the right format.");
       }
     }
-
-    JsonValue* emissiveTexture = hash_map_get_value(
-        &materialElement->object, "emissiveTexture", strlen("emissiveTexture"));
-    if (emissiveTexture != NULL && emissiveTexture->type == JT_OBJECT)
+    else if (string_view_equals_cstr(key, "emissiveTexture"))
     {
-      JsonValue* emissiveTextureSource = hash_map_get_value(
-          &emissiveTexture->object, "index", strlen("index"));
-      if (emissiveTextureSource != NULL
-          && emissiveTextureSource->type == JT_INTEGER)
-      {
-        material->emissiveTexture = emissiveTextureSource->integer;
-      }
-      else
-      {
-        LOG_WARNING("Emissive texture source was not an integer.");
-      }
+      glb_json_chunk_parse_texture_info(
+          cursor, "Emissive", &material->emissiveTexture, NULL);
     }
-
-    JsonValue* alphaMode = hash_map_get_value(
-        &materialElement->object, "alphaMode", strlen("alphaMode"));
-    if (alphaMode != NULL && alphaMode->type == JT_STRING)
+    else if (string_view_equals_cstr(key, "alphaMode"))
     {
-      if (strcmp(alphaMode->string, "OPAQUE") == 0)
-      {
-        material->alphaMode = GLB_MATERIAL_ALPHA_MODE_OPAQUE;
-      }
-      else if (strcmp(alphaMode->string, "MASK") == 0)
-      {
-        material->alphaMode = GLB_MATERIAL_ALPHA_MODE_MASK;
-      }
-      else if (strcmp(alphaMode->string, "BLEND") == 0)
-      {
-        material->alphaMode = GLB_MATERIAL_ALPHA_MODE_BLEND;
-      }
-      else
+      glb_json_chunk_parse_alpha_mode(cursor, material);
+    }
+    else if (string_view_equals_cstr(key, "alphaCutoff"))
+    {
+      if (json_cursor_get_number(cursor, &value))
       {
-        LOG_ERROR("Alpha mode was not recognized.");
+        material->alphaCutoff = (float) value;
       }
     }
+    else
+    {
+      json_cursor_skip(cursor);
+    }
+  }
+
+  if (!hasPbr)
+  {
+    LOG_WARNING("PBR was not an object.");
+  }
+}
+
+static bool glb_json_chunk_parse_materials(
+    JsonCursor* cursor, AutoArray* array)
+{
+  auto_array_create_with_allocator(
+      array, sizeof(GlbMaterial), memory_tag_get_allocator(MEMORY_TAG_ASSET));
+  if (!json_cursor_enter_array(cursor))
+  {
+    LOG_ERROR("Materials were not an array.");
+    return false;
+  }
 
-    JsonValue* alphaCutoff = hash_map_get_value(
-        &materialElement->object, "alphaCutoff", strlen("alphaCutoff"));
-    if (alphaCutoff != NULL && alphaCutoff->type == JT_FLOAT)
+  while (json_cursor_next_element(cursor))
+  {
+    GlbMaterial* material              = auto_array_allocate(array);
+    material->baseColorFactor.x        = 1.0f;
+    material->baseColorFactor.y        = 1.0f;
+    material->baseColorFactor.z        = 1.0f;
+    material->baseColorFactor.w        = 1.0f;
+    material->baseColorTexture         = -1;
+    material->metallicFactor           = 1.0f;
+    material->roughnessFactor          = 1.0f;
+    material->metallicRoughnessTexture = -1;
+    material->normalTexture            = -1;
+    material->occlusionTexture         = -1;
+    material->occlusionStrength        = 0.0f;
+    material->emissiveFactor.x         = 0.0f;
+    material->emissiveFactor.y         = 0.0f;
+    material->emissiveFactor.z         = 0.0f;
+    material->emissiveTexture          = -1;
+    material->alphaMode                = GLB_MATERIAL_ALPHA_MODE_OPAQUE;
+    material->alphaCutoff              = 0.5f;
+
+    if (!json_cursor_enter_object(cursor))
     {
-      material->alphaCutoff = alphaCutoff->floatingPoint;
+      LOG_ERROR("Material was not an object.");
+      continue;
     }
+    glb_json_chunk_parse_material(cursor, material);
   }
+
+  return true;
 }
 
-static void glb_json_chunk_parse_textures(JsonValue* textures, AutoArray* array)
+static bool glb_json_chunk_parse_textures(JsonCursor* cursor, AutoArray* array)
 {
-  auto_array_create(array, sizeof(GlbTexture));
+  auto_array_create_with_allocator(
+      array, sizeof(GlbTexture), memory_tag_get_allocator(MEMORY_TAG_ASSET));
+  if (!json_cursor_enter_array(cursor))
+  {
+    LOG_ERROR("Textures were not an array.");
+    return false;
+  }
 
-  for (uint32_t i = 0; i < textures->array.size; i++)
+  while (json_cursor_next_element(cursor))
   {
     GlbTexture* texture = auto_array_allocate(array);
     texture->source     = -1;
     texture->sampler    = -1;
 
-    JsonValue* textureElement =
-        *(JsonValue**) auto_array_get(&textures->array, i);
-    if (textureElement->type != JT_OBJECT)
+    if (!json_cursor_enter_object(cursor))
     {
       LOG_ERROR("Texture was not an object.");
       continue;
     }
 
-    JsonValue* source =
-        hash_map_get_value(&textureElement->object, "source", strlen("source"));
-    if (source != NULL && source->type == JT_INTEGER)
+    StringView key;
+    while (json_cursor_next_member(cursor, &key))
     {
-      texture->source = source->integer;
+      int64_t value;
+      if (string_view_equals_cstr(key, "source"))
+      {
+        if (json_cursor_get_integer(cursor, &value))
+        {
+          texture->source = (uint32_t) value;
+        }
+      }
+      else if (string_view_equals_cstr(key, "sampler"))
+      {
+        if (json_cursor_get_integer(cursor, &value))
+        {
+          texture->sampler = (uint32_t) value;
+        }
+      }
+      else
+      {
+        json_cursor_skip(cursor);
+      }
     }
+  }
 
-    JsonValue* sampler = hash_map_get_value(
-        &textureElement->object, "sampler", strlen("sampler"));
-    if (sampler != NULL && sampler->type == JT_INTEGER)
-    {
-      texture->sampler = sampler->integer;
-    }
+  return true;
+}
+
+static void glb_json_chunk_parse_mime_type(JsonCursor* cursor, GlbImage* image)
+{
+  StringView mimeTypeName;
+  if (!json_cursor_get_unescaped_string(cursor, &mimeTypeName))
+  {
+    return;
+  }
+
+  if (string_view_equals_cstr(mimeTypeName, "image/jpeg"))
+  {
+    image->mimeType = GIM_JPEG;
+  }
+  else if (string_view_equals_cstr(mimeTypeName, "image/png"))
+  {
+    image->mimeType = GIM_PNG;
+  }
+  else
+  {
+    LOG_ERROR("Mime type was not recognized.");
   }
 }
 
-static void glb_json_chunk_parse_images(JsonValue* images, AutoArray* array)
+static bool glb_json_chunk_parse_images(JsonCursor* cursor, AutoArray* array)
 {
-  auto_array_create(array, sizeof(GlbImage));
+  auto_array_create_with_allocator(
+      array, sizeof(GlbImage), memory_tag_get_allocator(MEMORY_TAG_ASSET));
+  if (!json_cursor_enter_array(cursor))
+  {
+    LOG_ERROR("Images were not an array.");
+    return false;
+  }
 
-  for (uint32_t i = 0; i < images->array.size; i++)
+  while (json_cursor_next_element(cursor))
   {
     GlbImage* image   = auto_array_allocate(array);
     image->bufferView = -1;
     image->colorType  = GICT_SRGB;
     image->mimeType   = GIM_JPEG;
 
-    JsonValue* imageElement = *(JsonValue**) auto_array_get(&images->array, i);
-    if (imageElement->type != JT_OBJECT)
+    if (!json_cursor_enter_object(cursor))
     {
       LOG_ERROR("Image was not an object.");
       continue;
     }
 
-    JsonValue* bufferView = hash_map_get_value(
-        &imageElement->object, "bufferView", strlen("bufferView"));
-    if (bufferView != NULL && bufferView->type == JT_INTEGER)
-    {
-      image->bufferView = bufferView->integer;
-    }
-
-    JsonValue* name =
-        hash_map_get_value(&imageElement->object, "name", strlen("name"));
-    if (name != NULL && name->type == JT_STRING
-        && strstr(name->string, "_BaseColor") == NULL)
-    {
-      image->colorType = GICT_LINEAR;
-    }
-
-    JsonValue* mimeType = hash_map_get_value(
-        &imageElement->object, "mimeType", strlen("mimeType"));
-    if (mimeType != NULL && mimeType->type == JT_STRING)
+    StringView key;
+    while (json_cursor_next_member(cursor, &key))
     {
-      if (strcmp(mimeType->string, "image/jpeg") == 0)
+      int64_t bufferView;
+      StringView name;
+      if (string_view_equals_cstr(key, "bufferView"))
+      {
+        if (json_cursor_get_integer(cursor, &bufferView))
+        {
+          image->bufferView = (uint32_t) bufferView;
+        }
+      }
+      else if (string_view_equals_cstr(key, "name"))
       {
-        image->mimeType = GIM_JPEG;
+        if (json_cursor_get_unescaped_string(cursor, &name)
+            && string_view_find(name, STRING_VIEW_LITERAL("_BaseColor"))
+                   == SIZE_MAX)
+        {
+          image->colorType = GICT_LINEAR;
+        }
       }
-      else if (strcmp(mimeType->string, "image/png") == 0)
+      else if (string_view_equals_cstr(key, "mimeType"))
       {
-        image->mimeType = GIM_PNG;
+        glb_json_chunk_parse_mime_type(cursor, image);
       }
       else
       {
-        LOG_ERROR("Mime type was not recognized.");
+        json_cursor_skip(cursor);
       }
     }
   }
+
+  return true;
 }
 
-static bool glb_json_chunk_parse_accessors(
-    JsonValue* accessors, AutoArray* array)
+static bool glb_json_chunk_parse_rank(StringView rank, enum GlbRank* result)
 {
-  auto_array_create(array, sizeof(GlbAccessor));
-
-  for (uint32_t i = 0; i < accessors->array.size; i++)
+  if (string_view_equals_cstr(rank, "SCALAR"))
   {
-    JsonValue* accessorElement =
-        *(JsonValue**) auto_array_get(&accessors->array, i);
-    if (accessorElement->type != JT_OBJECT)
-    {
-      LOG_ERROR("Accessor was not an object.");
-      return false;
-    }
-
-    JsonValue* bufferView = hash_map_get_value(
-        &accessorElement->object, "bufferView", strlen("bufferView"));
-    JsonValue* componentType = hash_map_get_value(
-        &accessorElement->object, "componentType", strlen("componentType"));
-    JsonValue* count =
-        hash_map_get_value(&accessorElement->object, "count", strlen("count"));
-    JsonValue* type =
-        hash_map_get_value(&accessorElement->object, "type", strlen("type"));
-    if (bufferView == NULL || bufferView->type != JT_INTEGER
-        || componentType == NULL || componentType->type != JT_INTEGER
-        || count == NULL || count->type != JT_INTEGER || type == NULL
-        || type->type != JT_STRING)
-    {
-      LOG_ERROR("Accessor property was not in the right format.");
-      return false;
-    }
+    *result = GR_SCALAR;
+  }
+  else if (string_view_equals_cstr(rank, "VEC2"))
+  {
+    *result = GR_VEC2;
+  }
+  else if (string_view_equals_cstr(rank, "VEC3"))
+  {
+    *result = GR_VEC3;
+  }
+  else if (string_view_equals_cstr(rank, "VEC4"))
+  {
+    *result = GR_VEC4;
+  }
+  else if (string_view_equals_cstr(rank, "MAT2"))
+  {
+    *result = GR_MAT2;
+  }
+  else if (string_view_equals_cstr(rank, "MAT3"))
+  {
+    *result = GR_MAT3;
+  }
+  else if (string_view_equals_cstr(rank, "MAT4"))
+  {
+    *result = GR_MAT4;
+  }
+  else
+  {
+    LOG_ERROR(
+        "Unknown accessor rank found %.*s", (int) rank.length, rank.data);
+    return false;
+  }
+  return true;
+}
 
-    GlbAccessor* accessor   = auto_array_allocate(array);
-    accessor->bufferView    = bufferView->integer;
-    accessor->componentType = componentType->integer;
-    accessor->count         = count->integer;
+static bool glb_json_chunk_parse_accessor(
+    JsonCursor* cursor, GlbAccessor* accessor)
+{
+  if (!json_cursor_enter_object(cursor))
+  {
+    LOG_ERROR("Accessor was not an object.");
+    return false;
+  }
 
-    if (strcmp(type->string, "SCALAR") == 0)
-    {
-      accessor->rank = GR_SCALAR;
-    }
-    else if (strcmp(type->string, "VEC2") == 0)
+  bool hasBufferView    = false;
+  bool hasComponentType = false;
+  bool hasCount         = false;
+  bool hasRank          = false;
+  bool hasMin           = false;
+  bool hasMax           = false;
+  StringView key;
+  while (json_cursor_next_member(cursor, &key))
+  {
+    int64_t value = 0;
+    StringView rank;
+    if (string_view_equals_cstr(key, "bufferView"))
     {
-      accessor->rank = GR_VEC2;
+      hasBufferView        = json_cursor_get_integer(cursor, &value);
+      accessor->bufferView = (uint32_t) value;
     }
-    else if (strcmp(type->string, "VEC3") == 0)
+    else if (string_view_equals_cstr(key, "componentType"))
     {
-      accessor->rank = GR_VEC3;
+      hasComponentType        = json_cursor_get_integer(cursor, &value);
+      accessor->componentType = (enum GlbComponentType) value;
     }
-    else if (strcmp(type->string, "VEC4") == 0)
+    else if (string_view_equals_cstr(key, "count"))
     {
-      accessor->rank = GR_VEC4;
+      hasCount        = json_cursor_get_integer(cursor, &value);
+      accessor->count = (uint32_t) value;
     }
-    else if (strcmp(type->string, "MAT2") == 0)
+    else if (string_view_equals_cstr(key, "type"))
     {
-      accessor->rank = GR_MAT2;
+      hasRank = json_cursor_get_unescaped_string(cursor, &rank)
+             && glb_json_chunk_parse_rank(rank, &accessor->rank);
     }
-    else if (strcmp(type->string, "MAT3") == 0)
+    else if (string_view_equals_cstr(key, "min"))
     {
-      accessor->rank = GR_MAT3;
+      hasMin = glb_json_chunk_parse_vec3(cursor, &accessor->min);
     }
-    else if (strcmp(type->string, "MAT4") == 0)
+    else if (string_view_equals_cstr(key, "max"))
     {
-      accessor->rank = GR_MAT4;
+      hasMax = glb_json_chunk_parse_vec3(cursor, &accessor->max);
     }
     else
     {
-      LOG_ERROR("Unknown accessor rank found %s", type->string);
-      return false;
+      json_cursor_skip(cursor);
     }
+  }
 
-    accessor->useBounds = false;
-    JsonValue* max =
-        hash_map_get_value(&accessorElement->object, "max", strlen("max"));
-    JsonValue* min =
-        hash_map_get_value(&accessorElement->object, "min", strlen("min"));
-    if (min != NULL && glb_json_chunk_parse_vec3(min, &accessor->min)
-        && max != NULL && glb_json_chunk_parse_vec3(max, &accessor->max))
-    {
-      accessor->useBounds = true;
-    }
+  if (!hasBufferView || !hasComponentType || !hasCount || !hasRank)
+  {
+    LOG_ERROR("Accessor property was not in the right format.");
+    return false;
   }
 
+  accessor->useBounds = hasMin && hasMax;
   return true;
 }
 
-static bool glb_json_chunk_parse_buffer_views(
-    JsonValue* bufferViews, AutoArray* array)
+static bool glb_json_chunk_parse_accessors(
+    JsonCursor* cursor, AutoArray* array)
 {
-  auto_array_create(array, sizeof(GlbBufferView));
-
-  for (uint32_t i = 0; i < bufferViews->array.size; i++)
+  auto_array_create_with_allocator(
+      array, sizeof(GlbAccessor), memory_tag_get_allocator(MEMORY_TAG_ASSET));
+  if (!json_cursor_enter_array(cursor))
   {
-    JsonValue* bufferViewElement =
-        *(JsonValue**) auto_array_get(&bufferViews->array, i);
-    if (bufferViewElement->type != JT_OBJECT)
-    {
-      LOG_ERROR("Buffer view was not an object");
-      return false;
-    }
+    LOG_ERROR("Accessors were not an array.");
+    return false;
+  }
 
-    JsonValue* buffer = hash_map_get_value(
-        &bufferViewElement->object, "buffer", strlen("buffer"));
-    JsonValue* length = hash_map_get_value(
-        &bufferViewElement->object, "byteLength", strlen("byteLength"));
-    JsonValue* offset = hash_map_get_value(
-        &bufferViewElement->object, "byteOffset", strlen("byteOffset"));
-    if (buffer == NULL || buffer->type != JT_INTEGER || length == NULL
-        || length->type != JT_INTEGER || offset == NULL
-        || offset->type != JT_INTEGER)
+  while (json_cursor_next_element(cursor))
+  {
+    GlbAccessor accessor;
+    if (!glb_json_chunk_parse_accessor(cursor, &accessor))
     {
-      LOG_ERROR("Buffer view property was not in the right format");
       return false;
     }
-
-    GlbBufferView* bufferView = auto_array_allocate(array);
-    bufferView->buffer        = buffer->integer;
-    bufferView->length        = length->integer;
-    bufferView->offset        = offset->integer;
+    *(GlbAccessor*) auto_array_allocate(array) = accessor;
   }
 
   return true;
 }
 
-bool glb_json_chunk_parse_buffers(JsonValue* buffers, AutoArray* array)
+static bool glb_json_chunk_parse_buffer_view(
+    JsonCursor* cursor, GlbBufferView* bufferView)
 {
-  auto_array_create(array, sizeof(GlbBuffer));
+  if (!json_cursor_enter_object(cursor))
+  {
+    LOG_ERROR("Buffer view was not an object");
+    return false;
+  }
 
-  for (uint32_t i = 0; i < buffers->array.size; i++)
+  bool hasBuffer = false;
+  bool hasLength = false;
+  bool hasOffset = false;
+  StringView key;
+  while (json_cursor_next_member(cursor, &key))
   {
-    JsonValue* bufferElement =
-        *(JsonValue**) auto_array_get(&buffers->array, i);
-    if (bufferElement->type != JT_OBJECT)
+    int64_t value = 0;
+    if (string_view_equals_cstr(key, "buffer"))
     {
-      LOG_ERROR("Buffer was not an object");
-      return false;
+      hasBuffer          = json_cursor_get_integer(cursor, &value);
+      bufferView->buffer = (uint32_t) value;
     }
-
-    JsonValue* length = hash_map_get_value(
-        &bufferElement->object, "byteLength", strlen("byteLength"));
-    if (length == NULL || length->type != JT_INTEGER)
+    else if (string_view_equals_cstr(key, "byteLength"))
     {
-      LOG_ERROR("Buffer length not found.");
-      return false;
+      hasLength          = json_cursor_get_integer(cursor, &value);
+      bufferView->length = (uint32_t) value;
+    }
+    else if (string_view_equals_cstr(key, "byteOffset"))
+    {
+      hasOffset          = json_cursor_get_integer(cursor, &value);
+      bufferView->offset = (uint32_t) value;
+    }
+    else
+    {
+      json_cursor_skip(cursor);
     }
-
-    GlbBuffer* buffer  = auto_array_allocate(array);
-    buffer->byteLength = length->integer;
   }
 
+  if (!hasBuffer || !hasLength || !hasOffset)
+  {
+    LOG_ERROR("Buffer view property was not in the right format");
+    return false;
+  }
   return true;
 }
 
-bool glb_json_chunk_parse(JsonValue* json, GlbJsonChunk* jsonChunk)
+static bool glb_json_chunk_parse_buffer_views(
+    JsonCursor* cursor, AutoArray* array)
 {
-  if (json->type != JT_OBJECT)
+  auto_array_create_with_allocator(
+      array, sizeof(GlbBufferView), memory_tag_get_allocator(MEMORY_TAG_ASSET));
+  if (!json_cursor_enter_array(cursor))
   {
-    LOG_ERROR("Top-level GLTF was not an object.");
+    LOG_ERROR("Buffer views were not an array.");
     return false;
   }
 
-  JsonValue* nodes =
-      hash_map_get_value(&json->object, "nodes", strlen("nodes"));
-  if (nodes != NULL)
+  while (json_cursor_next_element(cursor))
   {
-    if (nodes->type != JT_ARRAY)
+    GlbBufferView bufferView;
+    if (!glb_json_chunk_parse_buffer_view(cursor, &bufferView))
     {
-      LOG_ERROR("Nodes were not an array.");
       return false;
     }
-    glb_json_chunk_parse_nodes(nodes, &jsonChunk->nodes);
+    *(GlbBufferView*) auto_array_allocate(array) = bufferView;
   }
 
-  JsonValue* meshes =
-      hash_map_get_value(&json->object, "meshes", strlen("meshes"));
-  if (meshes != NULL)
+  return true;
+}
+
+static bool glb_json_chunk_parse_buffer(JsonCursor* cursor, GlbBuffer* buffer)
+{
+  if (!json_cursor_enter_object(cursor))
   {
-    if (meshes->type != JT_ARRAY)
-    {
-      LOG_ERROR("Meshes were not an array.");
-      return false;
-    }
-    glb_json_chunk_parse_meshes(meshes, &jsonChunk->meshes);
+    LOG_ERROR("Buffer was not an object");
+    return false;
   }
 
-  JsonValue* materials =
-      hash_map_get_value(&json->object, "materials", strlen("materials"));
-  if (materials != NULL)
+  bool hasLength = false;
+  StringView key;
+  while (json_cursor_next_member(cursor, &key))
   {
-    if (materials->type != JT_ARRAY)
+    int64_t length = 0;
+    if (string_view_equals_cstr(key, "byteLength"))
     {
-      LOG_ERROR("Materials were not an array.");
-      return false;
+      hasLength          = json_cursor_get_integer(cursor, &length);
+      buffer->byteLength = (uint32_t) length;
+    }
+    else
+    {
+      json_cursor_skip(cursor);
     }
-    glb_json_chunk_parse_materials(materials, &jsonChunk->materials);
   }
 
-  JsonValue* textures =
-      hash_map_get_value(&json->object, "textures", strlen("textures"));
-  if (textures != NULL)
+  if (!hasLength)
   {
-    if (textures->type != JT_ARRAY)
-    {
-      LOG_ERROR("Textures were not an array.");
-      return false;
-    }
-    glb_json_chunk_parse_textures(textures, &jsonChunk->textures);
+    LOG_ERROR("Buffer length not found.");
+    return false;
   }
+  return true;
+}
 
-  JsonValue* images =
-      hash_map_get_value(&json->object, "images", strlen("images"));
-  if (images != NULL)
+static bool glb_json_chunk_parse_buffers(JsonCursor* cursor, AutoArray* array)
+{
+  auto_array_create_with_allocator(
+      array, sizeof(GlbBuffer), memory_tag_get_allocator(MEMORY_TAG_ASSET));
+  if (!json_cursor_enter_array(cursor))
   {
-    if (images->type != JT_ARRAY)
-    {
-      LOG_ERROR("Images were not an array.");
-      return false;
-    }
-    glb_json_chunk_parse_images(images, &jsonChunk->images);
+    LOG_ERROR("Buffers were not an array.");
+    return false;
   }
 
-  JsonValue* accessors =
-      hash_map_get_value(&json->object, "accessors", strlen("accessors"));
-  if (accessors != NULL)
+  while (json_cursor_next_element(cursor))
   {
-    if (accessors->type != JT_ARRAY)
+    GlbBuffer buffer;
+    if (!glb_json_chunk_parse_buffer(cursor, &buffer))
     {
-      LOG_ERROR("Accessors were not an array.");
       return false;
     }
-    glb_json_chunk_parse_accessors(accessors, &jsonChunk->accessors);
+    *(GlbBuffer*) auto_array_allocate(array) = buffer;
   }
 
-  JsonValue* bufferViews =
-      hash_map_get_value(&json->object, "bufferViews", strlen("bufferViews"));
-  if (bufferViews != NULL)
+  return true;
+}
+
+static bool glb_json_chunk_parse_root(
+    JsonCursor* cursor, GlbJsonChunk* jsonChunk)
+{
+  if (!json_cursor_enter_object(cursor))
   {
-    if (bufferViews->type != JT_ARRAY)
-    {
-      LOG_ERROR("Buffer views were not an array.");
-      return false;
-    }
-    glb_json_chunk_parse_buffer_views(bufferViews, &jsonChunk->bufferViews);
+    LOG_ERROR("Top-level GLTF was not an object.");
+    return false;
   }
 
-  JsonValue* buffers =
-      hash_map_get_value(&json->object, "buffers", strlen("buffers"));
-  if (buffers != NULL)
+  StringView key;
+  while (json_cursor_next_member(cursor, &key))
   {
-    if (buffers->type != JT_ARRAY)
+    bool result = true;
+    if (string_view_equals_cstr(key, "nodes"))
+    {
+      result = glb_json_chunk_parse_nodes(cursor, &jsonChunk->nodes);
+    }
+    else if (string_view_equals_cstr(key, "meshes"))
+    {
+      result = glb_json_chunk_parse_meshes(cursor, &jsonChunk->meshes);
+    }
+    else if (string_view_equals_cstr(key, "materials"))
+    {
+      result = glb_json_chunk_parse_materials(cursor, &jsonChunk->materials);
+    }
+    else if (string_view_equals_cstr(key, "textures"))
+    {
+      result = glb_json_chunk_parse_textures(cursor, &jsonChunk->textures);
+    }
+    else if (string_view_equals_cstr(key, "images"))
+    {
+      result = glb_json_chunk_parse_images(cursor, &jsonChunk->images);
+    }
+    else if (string_view_equals_cstr(key, "accessors"))
+    {
+      result = glb_json_chunk_parse_accessors(cursor, &jsonChunk->accessors);
+    }
+    else if (string_view_equals_cstr(key, "bufferViews"))
+    {
+      result =
+          glb_json_chunk_parse_buffer_views(cursor, &jsonChunk->bufferViews);
+    }
+    else if (string_view_equals_cstr(key, "buffers"))
+    {
+      result = glb_json_chunk_parse_buffers(cursor, &jsonChunk->buffers);
+    }
+    else
+    {
+      json_cursor_skip(cursor);
+    }
+
+    if (!result)
     {
-      LOG_ERROR("Buffers were not an array.");
       return false;
     }
-    glb_json_chunk_parse_buffers(buffers, &jsonChunk->buffers);
   }
 
   return true;
 }
 
+bool glb_json_chunk_parse(
+    const char* json, size_t jsonLength, GlbJsonChunk* jsonChunk)
+{
+  JsonCursor cursor;
+  if (!json_cursor_create(&cursor, json, jsonLength, NULL))
+  {
+    LOG_ERROR("Unable to parse JSON chunk");
+    return false;
+  }
+
+  bool result = glb_json_chunk_parse_root(&cursor, jsonChunk);
+  if (result && !json_cursor_finish(&cursor))
+  {
+    LOG_ERROR("Unable to parse JSON chunk");
+    result = false;
+  }
+
+  json_cursor_destroy(&cursor);
+  return result;
+}
+
 void glb_json_chunk_destroy(GlbJsonChunk* jsonChunk)
 {
   auto_array_destroy(&jsonChunk->accessors);
@@ -869,6 +1091,7 @@ void glb_json_chunk_destroy(GlbJsonChunk* jsonChunk)
   auto_array_destroy(&jsonChunk->bufferViews);
   auto_array_destroy(&jsonChunk->materials);
   auto_array_destroy(&jsonChunk->textures);
+  auto_array_destroy(&jsonChunk->images);
 
   for (uint32_t i = 0; i < jsonChunk->nodes.size; i++)
   {
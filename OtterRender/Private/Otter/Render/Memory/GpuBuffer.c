@@ -2,8 +2,7 @@
 
 #include "Otter/Render/Memory/MemoryType.h"
 #include "Otter/Util/Log.h"
-
-static size_t g_allocations = 0;
+#include "Otter/Util/Memory/MemoryTag.h"
 
 bool gpu_buffer_allocate(GpuBuffer* buffer, VkDeviceSize size,
     VkBufferUsageFlags usage, VkMemoryPropertyFlags memoryProperties,
@@ -64,7 +63,8 @@ bool gpu_buffer_allocate(GpuBuffer* buffer, VkDeviceSize size,
     return false;
   }
 
-  // LOG_DEBUG("Allocation %lu: %lu bytes", g_allocations++, size);
+  buffer->allocationSize = memoryRequirements.size;
+  memory_tag_track(MEMORY_TAG_GPU_BUFFER, buffer->allocationSize);
 
   return true;
 }
@@ -74,7 +74,7 @@ void gpu_buffer_free(GpuBuffer* buffer, VkDevice logicalDevice)
   vkFreeMemory(logicalDevice, buffer->memory, NULL);
   vkDestroyBuffer(logicalDevice, buffer->buffer, NULL);
 
-  g_allocations -= 1;
+  memory_tag_untrack(MEMORY_TAG_GPU_BUFFER, buffer->allocationSize);
 }
 
 bool gpu_buffer_write(GpuBuffer* buffer, const uint8_t* data, VkDeviceSize size,
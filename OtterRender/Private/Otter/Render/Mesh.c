@@ -1,5 +1,6 @@
 #include "Otter/Render/Mesh.h"
 
+#include "Otter/Util/Counter.h"
 #include "Otter/Util/Log.h"
 
 bool mesh_create(Mesh* mesh, const void* vertices, uint64_t vertexSize,
@@ -124,6 +125,7 @@ bool mesh_create(Mesh* mesh, const void* vertices, uint64_t vertexSize,
 
   gpu_buffer_free(&vertexStagingBuffer, logicalDevice);
   gpu_buffer_free(&indexStagingBuffer, logicalDevice);
+  COUNTER_ADD(bytes_uploaded, mesh->vertices.size + mesh->indices.size);
 
   return true;
 }
@@ -8,6 +8,7 @@
 #include "Otter/Render/RenderPass/GBufferPass.h"
 #include "Otter/Render/Texture/ImageSampler.h"
 #include "Otter/Render/Uniform/Material.h"
+#include "Otter/Util/Counter.h"
 #include "Otter/Util/Log.h"
 
 bool g_buffer_pipeline_create(const char* shaderDirectory,
@@ -293,6 +294,10 @@ void g_buffer_pipeline_write_material(VkCommandBuffer commandBuffer,
   {
     LOG_ERROR("WARN: Unable to allocate descriptors");
   }
+  else
+  {
+    COUNTER_ADD(descriptor_sets, 1);
+  }
 
   VkDescriptorImageInfo albedoImageInfo = {
       .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
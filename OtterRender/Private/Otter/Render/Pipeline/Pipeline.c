@@ -2,34 +2,38 @@
 
 #include "Otter/Util/File.h"
 #include "Otter/Util/Log.h"
+#include "Otter/Util/Profiler.h"
 
 VkShaderModule pipeline_load_shader_module(
     const char* file, VkDevice logicalDevice)
 {
-  uint64_t shaderLength = 0;
-  char* shaderCode      = file_load(file, &shaderLength);
-  if (shaderCode == NULL)
+  PROFILE_ZONE("pipeline_load_shader_module");
+  FileView shaderCode;
+  if (!file_map(file, &shaderCode))
   {
     LOG_ERROR("Unable to find vertex shader");
+    PROFILE_ZONE_END();
     return VK_NULL_HANDLE;
   }
 
   VkShaderModuleCreateInfo shaderCreateInfo = {
       .sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-      .pCode    = (uint32_t*) shaderCode,
-      .codeSize = shaderLength};
+      .pCode    = (const uint32_t*) shaderCode.data,
+      .codeSize = shaderCode.length};
 
   VkShaderModule shaderModule = VK_NULL_HANDLE;
   if (vkCreateShaderModule(
           logicalDevice, &shaderCreateInfo, NULL, &shaderModule)
       != VK_SUCCESS)
   {
-    free(shaderCode);
+    file_unmap(&shaderCode);
     LOG_ERROR("Unable to create shader module.");
+    PROFILE_ZONE_END();
     return VK_NULL_HANDLE;
   }
 
-  free(shaderCode);
+  file_unmap(&shaderCode);
+  PROFILE_ZONE_END();
 
   return shaderModule;
 }
@@ -8,10 +8,13 @@
 #include "Otter/Render/RenderQueue.h"
 #include "Otter/Render/Uniform/ViewProjection.h"
 #include "Otter/Util/Array/AutoArray.h"
+#include "Otter/Util/Counter.h"
+#include "Otter/Util/Memory/MemoryTag.h"
 #include "Otter/Util/Profiler.h"
 
 #define DESCRIPTOR_POOL_SIZE 64
 #define DESCRIPTOR_SET_LIMIT 8 * 1024
+#define FRAME_ARENA_SIZE     256 * 1024
 
 typedef struct RecordGBufferCommandsParams
 {
@@ -37,12 +40,15 @@ bool render_frame_create(RenderFrame* renderFrame, uint32_t graphicsQueueFamily,
       .queueFamilyIndex = graphicsQueueFamily};
 
   const int numberOfThreads = task_scheduler_get_number_of_threads();
+  Allocator* allocator      = memory_tag_get_allocator(MEMORY_TAG_RENDER);
 
-  auto_array_create(&renderFrame->secondaryCommandPools, sizeof(VkCommandPool));
+  auto_array_create_with_allocator(
+      &renderFrame->secondaryCommandPools, sizeof(VkCommandPool), allocator);
   auto_array_allocate_many(
       &renderFrame->secondaryCommandPools, numberOfThreads);
 
-  auto_array_create(&renderFrame->meshCommandBufferLists, sizeof(AutoArray));
+  auto_array_create_with_allocator(
+      &renderFrame->meshCommandBufferLists, sizeof(AutoArray), allocator);
   auto_array_allocate_many(
       &renderFrame->meshCommandBufferLists, numberOfThreads);
 
@@ -50,7 +56,8 @@ bool render_frame_create(RenderFrame* renderFrame, uint32_t graphicsQueueFamily,
   {
     AutoArray* meshCommandBuffers =
         auto_array_get(&renderFrame->meshCommandBufferLists, i);
-    auto_array_create(meshCommandBuffers, sizeof(VkCommandBuffer));
+    auto_array_create_with_allocator(
+        meshCommandBuffers, sizeof(VkCommandBuffer), allocator);
 
     VkCommandPool* pool =
         auto_array_get(&renderFrame->secondaryCommandPools, i);
@@ -96,7 +103,8 @@ bool render_frame_create(RenderFrame* renderFrame, uint32_t graphicsQueueFamily,
       {.type               = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
           .descriptorCount = DESCRIPTOR_POOL_SIZE}};
 
-  auto_array_create(&renderFrame->descriptorPools, sizeof(VkDescriptorPool));
+  auto_array_create_with_allocator(
+      &renderFrame->descriptorPools, sizeof(VkDescriptorPool), allocator);
   auto_array_allocate_many(&renderFrame->descriptorPools, numberOfThreads);
 
   VkDescriptorPoolCreateInfo createInfo = {
@@ -164,12 +172,15 @@ bool render_frame_create(RenderFrame* renderFrame, uint32_t graphicsQueueFamily,
     return false;
   }
 
-  auto_array_create(&renderFrame->recordTasks, sizeof(HANDLE));
-  auto_array_create(
-      &renderFrame->recordCommands, sizeof(RecordGBufferCommandsParams));
+  if (!arena_create(&renderFrame->arena, FRAME_ARENA_SIZE, allocator))
+  {
+    LOG_ERROR("Unable to allocate frame arena");
+    return false;
+  }
+  render_frame_begin(renderFrame);
 
-  auto_array_create(&renderFrame->renderQueue, sizeof(RenderCommand));
-  auto_array_create(&renderFrame->perRenderBuffers, sizeof(GpuBuffer));
+  auto_array_create_with_allocator(
+      &renderFrame->perRenderBuffers, sizeof(GpuBuffer), allocator);
 
   acceleration_structure_create(&renderFrame->accelerationStructure);
 
@@ -179,6 +190,18 @@ bool render_frame_create(RenderFrame* renderFrame, uint32_t graphicsQueueFamily,
   return true;
 }
 
+void render_frame_begin(RenderFrame* renderFrame)
+{
+  arena_reset(&renderFrame->arena);
+
+  auto_array_create_with_allocator(
+      &renderFrame->recordTasks, sizeof(HANDLE), &renderFrame->arena.allocator);
+  auto_array_create_with_allocator(&renderFrame->recordCommands,
+      sizeof(RecordGBufferCommandsParams), &renderFrame->arena.allocator);
+  auto_array_create_with_allocator(&renderFrame->renderQueue,
+      sizeof(RenderCommand), &renderFrame->arena.allocator);
+}
+
 void render_frame_destroy(
     RenderFrame* renderFrame, VkCommandPool commandPool, VkDevice logicalDevice)
 {
@@ -215,11 +238,8 @@ void render_frame_destroy(
   gpu_buffer_free(&renderFrame->vpBuffer, logicalDevice);
   gpu_buffer_free(&renderFrame->lightBuffer, logicalDevice);
 
-  auto_array_destroy(&renderFrame->recordTasks);
-  auto_array_destroy(&renderFrame->recordCommands);
-
   auto_array_destroy(&renderFrame->perRenderBuffers);
-  auto_array_destroy(&renderFrame->renderQueue);
+  arena_destroy(&renderFrame->arena);
 
   acceleration_structure_destroy(
       &renderFrame->accelerationStructure, logicalDevice);
@@ -272,9 +292,11 @@ static void render_frame_draw_mesh(RenderCommand* meshCommand,
       commandBuffer, 0, 1, &meshCommand->mesh->vertices.buffer, &offset);
   vkCmdBindIndexBuffer(commandBuffer, meshCommand->mesh->indices.buffer, 0,
       VK_INDEX_TYPE_UINT16);
-  vkCmdDrawIndexed(commandBuffer,
-      (uint32_t) meshCommand->mesh->indices.size / sizeof(uint16_t), 1, 0, 0,
-      0);
+  uint32_t indexCount =
+      (uint32_t) (meshCommand->mesh->indices.size / sizeof(uint16_t));
+  vkCmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
+  COUNTER_ADD(draw_calls, 1);
+  COUNTER_ADD(triangles, indexCount / 3);
 }
 
 static void render_frame_start_pass(VkCommandBuffer commandBuffer,
@@ -395,8 +417,9 @@ static void render_frame_render_g_buffer(RenderFrame* renderFrame,
   mat4_identity(vp.view);
   mat4_translate(
       vp.view, -camera->position.x, -camera->position.y, -camera->position.z);
-  mat4_rotate(
-      vp.view, -camera->rotation.x, -camera->rotation.y, -camera->rotation.z);
+  // The conjugate turns back by the camera's rotation.
+  mat4_rotate_quaternion(vp.view, -camera->rotation.x, -camera->rotation.y,
+      -camera->rotation.z, camera->rotation.w);
   projection_create_perspective(vp.projection, 90.0f,
       (float) renderStack->lightingPass.imageSize.width
           / (float) renderStack->lightingPass.imageSize.height,
@@ -409,13 +432,13 @@ static void render_frame_render_g_buffer(RenderFrame* renderFrame,
     return;
   }
 
-  profiler_clock_start("sort_meshes");
+  PROFILE_ZONE("sort_meshes");
   qsort(renderFrame->renderQueue.buffer, renderFrame->renderQueue.size,
       sizeof(RenderCommand),
       (int (*)(const void*, const void*)) render_command_compare);
-  profiler_clock_end("sort_meshes");
+  PROFILE_ZONE_END();
 
-  profiler_clock_start("render_meshes");
+  PROFILE_ZONE("render_meshes");
 
   uint32_t lastMaterialIndex = 0;
   for (uint32_t i = 0; i < renderFrame->renderQueue.size; i++)
@@ -458,8 +481,9 @@ static void render_frame_render_g_buffer(RenderFrame* renderFrame,
 
   for (size_t i = 0; i < renderFrame->recordTasks.size; i++)
   {
-    WaitForSingleObject(
-        *(HANDLE*) auto_array_get(&renderFrame->recordTasks, i), INFINITE);
+    HANDLE task = *(HANDLE*) auto_array_get(&renderFrame->recordTasks, i);
+    WaitForSingleObject(task, INFINITE);
+    CloseHandle(task);
   }
 
   for (int i = 0; i < renderFrame->meshCommandBufferLists.size; i++)
@@ -474,7 +498,7 @@ static void render_frame_render_g_buffer(RenderFrame* renderFrame,
     }
   }
 
-  profiler_clock_end("render_meshes");
+  PROFILE_ZONE_END();
 }
 
 static void render_frame_render_lighting(RenderFrame* renderFrame,
@@ -664,8 +688,6 @@ void render_frame_draw(RenderFrame* renderFrame, RenderStack* renderStack,
     // TODO: Handle error
     return;
   }
-
-  auto_array_clear(&renderFrame->renderQueue);
 }
 
 void render_frame_clear_buffers(
@@ -690,9 +712,6 @@ void render_frame_clear_buffers(
           meshCommandBuffers->size, meshCommandBuffers->buffer);
     }
 
-    auto_array_clear(&renderFrame->recordTasks);
-    auto_array_clear(&renderFrame->recordCommands);
-
     auto_array_clear(meshCommandBuffers);
     vkResetCommandPool(logicalDevice, *commandPool, 0);
   }
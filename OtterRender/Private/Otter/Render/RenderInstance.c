@@ -4,6 +4,7 @@
 #include "Otter/Render/RenderPass/GBufferPass.h"
 #include "Otter/Render/RenderPass/LightingPass.h"
 #include "Otter/Render/RenderQueue.h"
+#include "Otter/Util/Profiler.h"
 
 #define VK_VALIDATION_LAYER_NAME   "VK_LAYER_KHRONOS_validation"
 #define VK_MONITOR_LAYER_NAME      "VK_LAYER_LUNARG_monitor"
@@ -888,6 +889,25 @@ void render_instance_destroy(RenderInstance* renderInstance)
   free(renderInstance);
 }
 
+void render_instance_begin_frame(RenderInstance* renderInstance)
+{
+  RenderFrame* frame = &renderInstance->frames[renderInstance->currentFrame];
+  if (vkWaitForFences(renderInstance->logicalDevice, 1, &frame->inflightFence,
+          VK_TRUE, UINT64_MAX)
+      != VK_SUCCESS)
+  {
+    LOG_ERROR("Error: Could not wait for fence");
+    return;
+  }
+
+  render_frame_begin(frame);
+}
+
+Allocator* render_instance_get_frame_allocator(RenderInstance* renderInstance)
+{
+  return &renderInstance->frames[renderInstance->currentFrame].arena.allocator;
+}
+
 void render_instance_draw(RenderInstance* renderInstance)
 {
   uint32_t image;
@@ -912,6 +932,7 @@ void render_instance_draw(RenderInstance* renderInstance)
   vkGetDeviceQueue(renderInstance->logicalDevice,
       renderInstance->graphicsQueueFamily, 0, &graphicsQueue);
 
+  PROFILE_ZONE("render_frame_draw");
   render_frame_draw(&renderInstance->frames[renderInstance->currentFrame],
       &renderInstance->swapchain->renderStacks[image],
       &renderInstance->gBufferPipeline, &renderInstance->pbrPipeline,
@@ -921,6 +942,7 @@ void render_instance_draw(RenderInstance* renderInstance)
       renderInstance->swapchain->lightingPass, graphicsQueue,
       renderInstance->commandPool, renderInstance->physicalDevice,
       renderInstance->logicalDevice);
+  PROFILE_ZONE_END();
 
   VkPresentInfoKHR presentInfo = {.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
       .pWaitSemaphores = &renderInstance->frames[renderInstance->currentFrame]
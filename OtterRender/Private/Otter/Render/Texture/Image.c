@@ -2,6 +2,7 @@
 
 #include "Otter/Render/Memory/MemoryType.h"
 #include "Otter/Util/Log.h"
+#include "Otter/Util/Memory/MemoryTag.h"
 
 bool image_create(VkExtent2D extents, uint32_t layers, VkFormat format,
     VkImageUsageFlags usage, bool useMipMap,
@@ -64,9 +65,14 @@ bool image_create(VkExtent2D extents, uint32_t layers, VkFormat format,
       != VK_SUCCESS)
   {
     LOG_ERROR("Unable to bind memory to render image.");
+    vkFreeMemory(logicalDevice, image->memory, NULL);
+    image->memory = VK_NULL_HANDLE;
     return false;
   }
 
+  image->memorySize = memRequirements.size;
+  memory_tag_track(MEMORY_TAG_GPU_IMAGE, image->memorySize);
+
   return true;
 }
 
@@ -237,5 +243,6 @@ void image_destroy(Image* image, VkDevice logicalDevice)
   {
     LOG_DEBUG("Freeing memory %llx", image->memory);
     vkFreeMemory(logicalDevice, image->memory, NULL);
+    memory_tag_untrack(MEMORY_TAG_GPU_IMAGE, image->memorySize);
   }
 }
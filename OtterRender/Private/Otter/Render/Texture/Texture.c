@@ -1,6 +1,7 @@
 #include "Otter/Render/Texture/Texture.h"
 
 #include "Otter/Render/Memory/GpuBuffer.h"
+#include "Otter/Util/Counter.h"
 #include "Otter/Util/Log.h"
 
 bool texture_create(Texture* texture, const uint8_t* data, uint32_t width,
@@ -115,6 +116,7 @@ bool texture_create(Texture* texture, const uint8_t* data, uint32_t width,
     image_destroy(&texture->image, logicalDevice);
     return false;
   }
+  COUNTER_ADD(bytes_uploaded, (uint64_t) width * height * channels);
 
   return true;
 }
@@ -17,7 +17,8 @@ typedef struct GlbAssetMesh
 
 typedef struct GlbAssetImage
 {
-  uint8_t* data;
+  // Encoded image bytes inside the content the asset was loaded from.
+  const uint8_t* data;
   int width;
   int height;
   int channels;
@@ -52,7 +53,13 @@ typedef struct GlbAsset
   AutoArray images;
 } GlbAsset;
 
+/**
+ * @brief Load the meshes, materials and images of a GLB file.
+ *
+ * Images point into `content` instead of being copied, so it has to outlive
+ * any use of them. Meshes are converted and owned by the asset.
+ */
 OTTERRENDER_API bool glb_load_asset(
-    char* content, size_t contentSize, GlbAsset* asset);
+    const char* content, size_t contentSize, GlbAsset* asset);
 
 OTTERRENDER_API void glb_free_asset(GlbAsset* asset);
@@ -3,7 +3,6 @@
 #include "Otter/Math/MatDef.h"
 #include "Otter/Math/Vec.h"
 #include "Otter/Util/Array/AutoArray.h"
-#include "Otter/Util/Json/Json.h"
 
 typedef enum NodeType
 {
@@ -140,6 +139,7 @@ typedef struct GlbJsonChunk
   AutoArray images;
 } GlbJsonChunk;
 
-bool glb_json_chunk_parse(JsonValue* json, GlbJsonChunk* jsonChunk);
+bool glb_json_chunk_parse(
+    const char* json, size_t jsonLength, GlbJsonChunk* jsonChunk);
 
 void glb_json_chunk_destroy(GlbJsonChunk* jsonChunk);
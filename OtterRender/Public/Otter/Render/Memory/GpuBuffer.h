@@ -9,6 +9,8 @@ typedef struct GpuBuffer
   VkBuffer buffer;
   VkDeviceMemory memory;
   VkDeviceSize size;
+  // What the device handed out, which can be more than `size`.
+  VkDeviceSize allocationSize;
   void* mapped;
 } GpuBuffer;
 
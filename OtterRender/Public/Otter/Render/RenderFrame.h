@@ -11,6 +11,7 @@
 #include "Otter/Render/RayTracing/ShaderBindingTable.h"
 #include "Otter/Render/RenderStack.h"
 #include "Otter/Util/Array/AutoArray.h"
+#include "Otter/Util/Memory/Arena.h"
 
 typedef struct RenderFrame
 {
@@ -30,6 +31,10 @@ typedef struct RenderFrame
   GpuBuffer vpBuffer;
   GpuBuffer lightBuffer;
 
+  // Backs everything that only lives until this frame slot comes around
+  // again. Reset by `render_frame_begin` once `inflightFence` has signaled.
+  Arena arena;
+
   AutoArray recordTasks;
   AutoArray recordCommands;
 
@@ -48,6 +53,8 @@ bool render_frame_create(RenderFrame* renderFrame, uint32_t graphicsQueueFamily,
     VkPhysicalDevice physicalDevice, VkDevice logicalDevice,
     VkCommandPool commandPool);
 
+void render_frame_begin(RenderFrame* renderFrame);
+
 void render_frame_destroy(RenderFrame* renderFrame, VkCommandPool commandPool,
     VkDevice logicalDevice);
 
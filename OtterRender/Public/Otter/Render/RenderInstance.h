@@ -73,6 +73,26 @@ OTTERRENDER_API void render_instance_wait_for_idle(
 
 OTTERRENDER_API void render_instance_destroy(RenderInstance* renderInstance);
 
+/**
+ * @brief Wait until the GPU is done with the current frame slot and reset its
+ * frame arena. Must be called before anything is queued for the frame.
+ *
+ * @param renderInstance The render instance.
+ */
+OTTERRENDER_API void render_instance_begin_frame(
+    RenderInstance* renderInstance);
+
+/**
+ * @brief Get an allocator for data that only needs to live for the current
+ * frame. Memory from it is released by the next `render_instance_begin_frame`
+ * for the same frame slot, so it stays valid while that frame is in flight.
+ *
+ * @param renderInstance The render instance.
+ * @return The current frame's allocator.
+ */
+OTTERRENDER_API Allocator* render_instance_get_frame_allocator(
+    RenderInstance* renderInstance);
+
 OTTERRENDER_API void render_instance_draw(RenderInstance* renderInstance);
 
 OTTERRENDER_API void render_instance_queue_mesh_draw(Mesh* mesh,
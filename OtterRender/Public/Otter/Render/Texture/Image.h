@@ -10,6 +10,7 @@ typedef struct Image
   VkImage image;
   VkFormat format;
   VkDeviceMemory memory;
+  VkDeviceSize memorySize;
   VkExtent2D size;
   uint32_t mipLevels;
 } Image;
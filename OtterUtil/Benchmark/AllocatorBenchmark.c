@@ -0,0 +1,99 @@
+#include <stdint.h>
+
+#include "Benchmarks.h"
+#include "Otter/Util/Benchmark.h"
+#include "Otter/Util/Array/AutoArray.h"
+#include "Otter/Util/HashMap.h"
+#include "Otter/Util/Memory/Arena.h"
+#include "Otter/Util/Memory/PoolAllocator.h"
+
+#define ALLOCATOR_BENCHMARK_BLOCKS 256
+
+static void allocator_churn_benchmark(void* userData, uint64_t iterations)
+{
+  Allocator* allocator = userData;
+  void* blocks[ALLOCATOR_BENCHMARK_BLOCKS];
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    for (int j = 0; j < ALLOCATOR_BENCHMARK_BLOCKS; j++)
+    {
+      blocks[j] = allocator_allocate(allocator, 16 + (j % 4) * 16);
+    }
+    benchmark_do_not_optimize(blocks);
+    for (int j = 0; j < ALLOCATOR_BENCHMARK_BLOCKS; j++)
+    {
+      allocator_deallocate(allocator, blocks[j], 16 + (j % 4) * 16);
+    }
+  }
+}
+
+static void hash_map_fill_benchmark(void* userData, uint64_t iterations)
+{
+  Allocator* allocator = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    HashMap map;
+    hash_map_create_with_allocator(&map, 64, HASH_MAP_DEFAULT_COEF, allocator);
+    for (uint64_t key = 0; key < ALLOCATOR_BENCHMARK_BLOCKS; key++)
+    {
+      hash_map_set_value(&map, &key, sizeof(key), NULL);
+    }
+    hash_map_destroy(&map, NULL);
+  }
+}
+
+// Mimics a frame filling a few transient queues and then dropping them.
+static void frame_queue_benchmark(void* userData, uint64_t iterations)
+{
+  Arena* arena         = userData;
+  Allocator* allocator = arena != NULL ? &arena->allocator : NULL;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    AutoArray queues[3];
+    for (int q = 0; q < _countof(queues); q++)
+    {
+      auto_array_create_with_allocator(&queues[q], 64 + q * 16, allocator);
+      for (int j = 0; j < ALLOCATOR_BENCHMARK_BLOCKS; j++)
+      {
+        auto_array_allocate(&queues[q]);
+      }
+      benchmark_do_not_optimize(queues[q].buffer);
+    }
+
+    if (arena != NULL)
+    {
+      arena_reset(arena);
+    }
+    else
+    {
+      for (int q = 0; q < _countof(queues); q++)
+      {
+        auto_array_destroy(&queues[q]);
+      }
+    }
+  }
+}
+
+void allocator_benchmarks_run()
+{
+  PoolAllocator pool;
+  pool_allocator_create(&pool);
+
+  benchmark_run("malloc churn 256 blocks", allocator_churn_benchmark, NULL);
+  benchmark_run("PoolAllocator churn 256 blocks", allocator_churn_benchmark,
+      &pool.allocator);
+
+  benchmark_run("malloc HashMap fill 256", hash_map_fill_benchmark, NULL);
+  benchmark_run("PoolAllocator HashMap fill 256", hash_map_fill_benchmark,
+      &pool.allocator);
+
+  pool_allocator_destroy(&pool);
+
+  Arena arena;
+  arena_create(&arena, ARENA_DEFAULT_BLOCK_SIZE, NULL);
+
+  benchmark_run("malloc frame queues", frame_queue_benchmark, NULL);
+  benchmark_run("Arena frame queues", frame_queue_benchmark, &arena);
+
+  arena_destroy(&arena);
+}
@@ -0,0 +1,190 @@
+#include <stdint.h>
+
+#include "Benchmarks.h"
+#include "Otter/Util/Array/AutoArray.h"
+#include "Otter/Util/Array/TypedArray.h"
+#include "Otter/Util/Array/VirtualArray.h"
+#include "Otter/Util/Benchmark.h"
+
+#define ARRAY_BENCHMARK_ELEMENTS 1024
+
+TYPED_ARRAY_DEFINE(IntArray, int_array, int);
+TYPED_ARRAY_DEFINE_SMALL(SmallIntArray, small_int_array, int, 16);
+
+static void auto_array_push_benchmark(void* userData, uint64_t iterations)
+{
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    AutoArray array;
+    auto_array_create(&array, sizeof(int));
+    for (int j = 0; j < ARRAY_BENCHMARK_ELEMENTS; j++)
+    {
+      *(int*) auto_array_allocate(&array) = j;
+    }
+    benchmark_do_not_optimize(array.buffer);
+    auto_array_destroy(&array);
+  }
+}
+
+static void typed_array_push_benchmark(void* userData, uint64_t iterations)
+{
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    IntArray array;
+    int_array_create(&array);
+    for (int j = 0; j < ARRAY_BENCHMARK_ELEMENTS; j++)
+    {
+      int_array_push(&array, j);
+    }
+    benchmark_do_not_optimize(array.heap);
+    int_array_destroy(&array);
+  }
+}
+
+static void auto_array_small_benchmark(void* userData, uint64_t iterations)
+{
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    AutoArray array;
+    auto_array_create(&array, sizeof(int));
+    for (int j = 0; j < 8; j++)
+    {
+      *(int*) auto_array_allocate(&array) = j;
+    }
+    benchmark_do_not_optimize(array.buffer);
+    auto_array_destroy(&array);
+  }
+}
+
+static void typed_array_small_benchmark(void* userData, uint64_t iterations)
+{
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    SmallIntArray array;
+    small_int_array_create(&array);
+    for (int j = 0; j < 8; j++)
+    {
+      small_int_array_push(&array, j);
+    }
+    benchmark_do_not_optimize(small_int_array_data(&array));
+    small_int_array_destroy(&array);
+  }
+}
+
+static void auto_array_push_large_benchmark(void* userData, uint64_t iterations)
+{
+  AutoArray* array = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    *(int*) auto_array_allocate(array) = (int) i;
+  }
+  benchmark_do_not_optimize(array->buffer);
+}
+
+static void virtual_array_push_large_benchmark(
+    void* userData, uint64_t iterations)
+{
+  VirtualArray* array = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    *(int*) virtual_array_allocate(array) = (int) i;
+  }
+  benchmark_do_not_optimize(array->buffer);
+}
+
+static void auto_array_get_benchmark(void* userData, uint64_t iterations)
+{
+  AutoArray* array = userData;
+  int sum          = 0;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    for (size_t j = 0; j < array->size; j++)
+    {
+      sum += *(int*) auto_array_get(array, j);
+    }
+  }
+  benchmark_do_not_optimize(&sum);
+}
+
+static void typed_array_get_benchmark(void* userData, uint64_t iterations)
+{
+  IntArray* array = userData;
+  int sum         = 0;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    for (size_t j = 0; j < array->size; j++)
+    {
+      sum += *int_array_get(array, j);
+    }
+  }
+  benchmark_do_not_optimize(&sum);
+}
+
+static void auto_array_push_pop_benchmark(void* userData, uint64_t iterations)
+{
+  AutoArray* array = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    auto_array_allocate_many(array, ARRAY_BENCHMARK_ELEMENTS);
+    auto_array_pop_many(array, ARRAY_BENCHMARK_ELEMENTS);
+  }
+}
+
+static void typed_array_push_pop_benchmark(void* userData, uint64_t iterations)
+{
+  IntArray* array = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    int_array_allocate_many(array, ARRAY_BENCHMARK_ELEMENTS);
+    int_array_pop_many(array, ARRAY_BENCHMARK_ELEMENTS);
+  }
+}
+
+void array_benchmarks_run()
+{
+  benchmark_run("AutoArray push 1024", auto_array_push_benchmark, NULL);
+  benchmark_run("TypedArray push 1024", typed_array_push_benchmark, NULL);
+
+  benchmark_run("AutoArray push 8", auto_array_small_benchmark, NULL);
+  benchmark_run("TypedArray (16 inline) push 8", typed_array_small_benchmark,
+      NULL);
+
+  AutoArray autoArray;
+  auto_array_create(&autoArray, sizeof(int));
+  IntArray typedArray;
+  int_array_create(&typedArray);
+  for (int i = 0; i < ARRAY_BENCHMARK_ELEMENTS; i++)
+  {
+    *(int*) auto_array_allocate(&autoArray) = i;
+    int_array_push(&typedArray, i);
+  }
+
+  benchmark_run("AutoArray get 1024", auto_array_get_benchmark, &autoArray);
+  benchmark_run("TypedArray get 1024", typed_array_get_benchmark, &typedArray);
+
+  auto_array_clear(&autoArray);
+  int_array_clear(&typedArray);
+
+  benchmark_run("AutoArray push/pop 1024", auto_array_push_pop_benchmark,
+      &autoArray);
+  benchmark_run("TypedArray push/pop 1024", typed_array_push_pop_benchmark,
+      &typedArray);
+
+  auto_array_destroy(&autoArray);
+  int_array_destroy(&typedArray);
+
+  // These keep growing across every iteration the benchmark runs, which is
+  // where realloc has to copy and a reservation does not.
+  AutoArray largeAutoArray;
+  auto_array_create(&largeAutoArray, sizeof(int));
+  VirtualArray largeVirtualArray;
+  virtual_array_create(&largeVirtualArray, sizeof(int), 1ULL << 30, VAF_NONE);
+
+  benchmark_run("AutoArray push unbounded", auto_array_push_large_benchmark,
+      &largeAutoArray);
+  benchmark_run("VirtualArray push unbounded",
+      virtual_array_push_large_benchmark, &largeVirtualArray);
+
+  auto_array_destroy(&largeAutoArray);
+  virtual_array_destroy(&largeVirtualArray);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+void allocator_benchmarks_run();
+
+void array_benchmarks_run();
+
+/**
+ * @param glbPath A GLB whose JSON chunk is parsed, or NULL to parse a
+ * generated one.
+ */
+void json_benchmarks_run(const char* glbPath);
+
+void log_benchmarks_run();
+
+void profiler_benchmarks_run();
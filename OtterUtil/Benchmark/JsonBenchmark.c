@@ -0,0 +1,416 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Benchmarks.h"
+#include "Otter/Util/Benchmark.h"
+#include "Otter/Util/File.h"
+#include "Otter/Util/Json/Json.h"
+#include "Otter/Util/Json/JsonCursor.h"
+#include "Otter/Util/Json/JsonDocument.h"
+#include "Otter/Util/Json/JsonStructural.h"
+#include "Otter/Util/Json/JsonWriter.h"
+#include "Otter/Util/Memory/TrackingAllocator.h"
+#include "Otter/Util/String/Number.h"
+#include "Otter/Util/String/StringBuilder.h"
+
+#define JSON_BENCHMARK_NODES   4096
+#define JSON_BENCHMARK_NUMBERS 4096
+
+#define GLB_MAGIC           0x46546C67
+#define GLB_CHUNK_TYPE_JSON 0x4E4F534A
+#define GLB_HEADER_SIZE     12
+#define GLB_CHUNK_DATA      20
+
+typedef struct JsonBenchmarkSource
+{
+  const char* data;
+  size_t length;
+} JsonBenchmarkSource;
+
+typedef struct JsonStructuralBenchmark
+{
+  JsonBenchmarkSource* source;
+  CpuSimdLevel level;
+} JsonStructuralBenchmark;
+
+// Shaped like the JSON chunk of a large scene GLB.
+static StringView json_benchmark_build_gltf()
+{
+  StringBuilder builder;
+  string_builder_create(&builder, NULL);
+
+  string_builder_append(&builder, STRING_VIEW_LITERAL("{\"nodes\": ["));
+  for (int i = 0; i < JSON_BENCHMARK_NODES; i++)
+  {
+    string_builder_append_format(&builder,
+        "%s{\"name\": \"Node_%d\", \"mesh\": %d, \"translation\": [%d.25, "
+        "0.5, -%d.125], \"rotation\": [0, 0.7071068, 0, 0.7071068], "
+        "\"children\": [%d, %d]}",
+        i > 0 ? "," : "", i, i, i, i, i * 2 + 1, i * 2 + 2);
+  }
+
+  string_builder_append(&builder, STRING_VIEW_LITERAL("], \"accessors\": ["));
+  for (int i = 0; i < JSON_BENCHMARK_NODES * 3; i++)
+  {
+    string_builder_append_format(&builder,
+        "%s{\"bufferView\": %d, \"componentType\": 5126, \"count\": %d, "
+        "\"type\": \"VEC3\", \"max\": [1.5, 2.25, 3.125], "
+        "\"min\": [-1.5, -2.25, -3.125]}",
+        i > 0 ? "," : "", i, 24 + i);
+  }
+  string_builder_append(&builder, STRING_VIEW_LITERAL("]}"));
+
+  return string_builder_finish(&builder);
+}
+
+// A GLB starts with a 12 byte header followed by its JSON chunk.
+static bool json_benchmark_load_glb(
+    const char* path, char** file, JsonBenchmarkSource* source)
+{
+  uint64_t fileLength = 0;
+  *file               = file_load(path, &fileLength);
+  if (*file == NULL)
+  {
+    return false;
+  }
+
+  uint32_t magic     = 0;
+  uint32_t chunkSize = 0;
+  uint32_t chunkType = 0;
+  if (fileLength >= GLB_CHUNK_DATA)
+  {
+    memcpy(&magic, *file, sizeof(magic));
+    memcpy(&chunkSize, *file + GLB_HEADER_SIZE, sizeof(chunkSize));
+    memcpy(&chunkType, *file + GLB_HEADER_SIZE + 4, sizeof(chunkType));
+  }
+
+  if (magic != GLB_MAGIC || chunkType != GLB_CHUNK_TYPE_JSON
+      || chunkSize > fileLength - GLB_CHUNK_DATA)
+  {
+    printf("%s is not a GLB with a JSON chunk\n", path);
+    free(*file);
+    return false;
+  }
+
+  source->data   = *file + GLB_CHUNK_DATA;
+  source->length = chunkSize;
+  return true;
+}
+
+static void json_structural_benchmark(void* userData, uint64_t iterations)
+{
+  JsonStructuralBenchmark* benchmark = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    JsonStructuralIndex index;
+    json_structural_index_build(&index, benchmark->source->data,
+        benchmark->source->length, benchmark->level, NULL);
+    benchmark_do_not_optimize(index.positions);
+    json_structural_index_destroy(&index);
+  }
+}
+
+static void json_benchmark_report_throughput(
+    JsonBenchmarkSource* source, BenchmarkResult result)
+{
+  // Bytes per nanosecond is GB/s, so scale by 1000 for MB/s.
+  printf("  %.0f MB/s\n",
+      (double) source->length / result.nanosecondsPerIteration * 1000.0);
+}
+
+// Accessor bounds and node transforms, the numbers a glTF is mostly made of.
+static StringView json_benchmark_build_numbers()
+{
+  StringBuilder builder;
+  string_builder_create(&builder, NULL);
+  for (int i = 0; i < JSON_BENCHMARK_NUMBERS; i++)
+  {
+    string_builder_append_format(&builder, "%d %.7g %.17g ", i * 7919,
+        (float) i * 0.3183099f - 100.0f, (double) i / 3.0);
+  }
+  return string_builder_finish(&builder);
+}
+
+static void number_strtod_benchmark(void* userData, uint64_t iterations)
+{
+  const char* numbers = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    char* cursor = (char*) numbers;
+    double sum   = 0.0;
+    while (*cursor != '\0')
+    {
+      char* end = NULL;
+      sum += strtod(cursor, &end);
+      cursor = end + 1;
+    }
+    benchmark_do_not_optimize(&sum);
+  }
+}
+
+static void number_parse_benchmark(void* userData, uint64_t iterations)
+{
+  StringView* numbers = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    size_t cursor = 0;
+    double sum    = 0.0;
+    while (cursor < numbers->length)
+    {
+      ParsedNumber number;
+      size_t length = number_parse(
+          &numbers->data[cursor], numbers->length - cursor, &number);
+      cursor += length + 1;
+      sum += number.type == NUMBER_INTEGER ? (double) number.integer
+                                           : number.floatingPoint;
+    }
+    benchmark_do_not_optimize(&sum);
+  }
+}
+
+// Timestamps and durations in microseconds, like a trace is full of.
+static double json_benchmark_number(int i)
+{
+  return (double) i * 16.6667 + (double) (i % 7) / 3.0;
+}
+
+static void number_snprintf_benchmark(void* userData, uint64_t iterations)
+{
+  (void) userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    size_t length = 0;
+    for (int n = 0; n < JSON_BENCHMARK_NUMBERS; n++)
+    {
+      char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+      length += snprintf(
+          buffer, sizeof(buffer), "%.17g", json_benchmark_number(n));
+    }
+    benchmark_do_not_optimize(&length);
+  }
+}
+
+static void number_format_benchmark(void* userData, uint64_t iterations)
+{
+  (void) userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    size_t length = 0;
+    for (int n = 0; n < JSON_BENCHMARK_NUMBERS; n++)
+    {
+      char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+      length += number_format_double(json_benchmark_number(n), buffer);
+    }
+    benchmark_do_not_optimize(&length);
+  }
+}
+
+static size_t json_benchmark_write_trace(enum JsonWriterStyle style)
+{
+  JsonWriter writer;
+  json_writer_create(&writer, style, NULL);
+
+  json_writer_begin_object(&writer);
+  json_writer_key(&writer, STRING_VIEW_LITERAL("traceEvents"));
+  json_writer_begin_array(&writer);
+  for (int i = 0; i < JSON_BENCHMARK_NODES * 4; i++)
+  {
+    json_writer_begin_object(&writer);
+    json_writer_key(&writer, STRING_VIEW_LITERAL("name"));
+    json_writer_string(&writer, STRING_VIEW_LITERAL("render_draw \"scene\""));
+    json_writer_key(&writer, STRING_VIEW_LITERAL("ph"));
+    json_writer_string(&writer, STRING_VIEW_LITERAL("X"));
+    json_writer_key(&writer, STRING_VIEW_LITERAL("ts"));
+    json_writer_double(&writer, json_benchmark_number(i));
+    json_writer_key(&writer, STRING_VIEW_LITERAL("dur"));
+    json_writer_double(&writer, json_benchmark_number(i % 97));
+    json_writer_key(&writer, STRING_VIEW_LITERAL("tid"));
+    json_writer_integer(&writer, i % 8);
+    json_writer_end_object(&writer);
+  }
+  json_writer_end_array(&writer);
+  json_writer_end_object(&writer);
+
+  size_t length = json_writer_get_output(&writer).length;
+  json_writer_close(&writer);
+  return length;
+}
+
+static void json_writer_benchmark(void* userData, uint64_t iterations)
+{
+  enum JsonWriterStyle* style = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    size_t length = json_benchmark_write_trace(*style);
+    benchmark_do_not_optimize(&length);
+  }
+}
+
+static void json_value_parse_benchmark(void* userData, uint64_t iterations)
+{
+  JsonBenchmarkSource* source = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    size_t cursor   = 0;
+    JsonValue* root = json_parse(source->data, source->length, &cursor);
+    benchmark_do_not_optimize(root);
+    json_destroy(root);
+  }
+}
+
+static void json_document_parse_benchmark(void* userData, uint64_t iterations)
+{
+  JsonBenchmarkSource* source = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    JsonDocument document;
+    json_document_parse(&document, source->data, source->length, NULL);
+    benchmark_do_not_optimize(&document.root);
+    json_document_destroy(&document);
+  }
+}
+
+// Reads accessors the way the glTF loader does and skips everything else.
+static int64_t json_cursor_read_accessors(
+    JsonBenchmarkSource* source, Allocator* allocator)
+{
+  JsonCursor cursor;
+  if (!json_cursor_create(&cursor, source->data, source->length, allocator))
+  {
+    return 0;
+  }
+
+  int64_t total = 0;
+  StringView key;
+  json_cursor_enter_object(&cursor);
+  while (json_cursor_next_member(&cursor, &key))
+  {
+    if (!string_view_equals_cstr(key, "accessors")
+        || !json_cursor_enter_array(&cursor))
+    {
+      json_cursor_skip(&cursor);
+      continue;
+    }
+
+    while (json_cursor_next_element(&cursor)
+           && json_cursor_enter_object(&cursor))
+    {
+      while (json_cursor_next_member(&cursor, &key))
+      {
+        int64_t value;
+        if ((string_view_equals_cstr(key, "count")
+                || string_view_equals_cstr(key, "bufferView"))
+            && json_cursor_get_integer(&cursor, &value))
+        {
+          total += value;
+        }
+        else
+        {
+          json_cursor_skip(&cursor);
+        }
+      }
+    }
+  }
+
+  json_cursor_finish(&cursor);
+  json_cursor_destroy(&cursor);
+  return total;
+}
+
+static void json_cursor_benchmark(void* userData, uint64_t iterations)
+{
+  JsonBenchmarkSource* source = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    int64_t total = json_cursor_read_accessors(source, NULL);
+    benchmark_do_not_optimize(&total);
+  }
+}
+
+static void json_benchmark_report_memory(JsonBenchmarkSource* source)
+{
+  TrackingAllocator valueTracker;
+  tracking_allocator_create(&valueTracker, NULL);
+  size_t cursor   = 0;
+  JsonValue* root = json_parse_with_allocator(
+      source->data, source->length, &cursor, &valueTracker.allocator);
+  printf("json_parse peak %lld bytes in %lld allocations\n",
+      (long long) valueTracker.peakBytes,
+      (long long) valueTracker.totalAllocations);
+  json_destroy_with_allocator(root, &valueTracker.allocator);
+
+  TrackingAllocator documentTracker;
+  tracking_allocator_create(&documentTracker, NULL);
+  JsonDocument document;
+  json_document_parse(&document, source->data, source->length,
+      &documentTracker.allocator);
+  printf("JsonDocument peak %lld bytes in %lld allocations\n",
+      (long long) documentTracker.peakBytes,
+      (long long) documentTracker.totalAllocations);
+  json_document_destroy(&document);
+
+  TrackingAllocator cursorTracker;
+  tracking_allocator_create(&cursorTracker, NULL);
+  json_cursor_read_accessors(source, &cursorTracker.allocator);
+  printf("JsonCursor peak %lld bytes in %lld allocations\n",
+      (long long) cursorTracker.peakBytes,
+      (long long) cursorTracker.totalAllocations);
+}
+
+void json_benchmarks_run(const char* glbPath)
+{
+  char* file                 = NULL;
+  JsonBenchmarkSource source = {NULL, 0};
+  if (glbPath == NULL || !json_benchmark_load_glb(glbPath, &file, &source))
+  {
+    StringView gltf = json_benchmark_build_gltf();
+    file            = (char*) gltf.data;
+    source.data     = gltf.data;
+    source.length   = gltf.length;
+  }
+  printf("glTF JSON source is %zd bytes\n", source.length);
+
+  StringView numbers = json_benchmark_build_numbers();
+  benchmark_run(
+      "strtod glTF numbers", number_strtod_benchmark, (void*) numbers.data);
+  benchmark_run("number_parse glTF numbers", number_parse_benchmark, &numbers);
+  free((char*) numbers.data);
+
+  benchmark_run("snprintf %.17g trace numbers", number_snprintf_benchmark,
+      NULL);
+  benchmark_run(
+      "number_format_double trace numbers", number_format_benchmark, NULL);
+
+  enum JsonWriterStyle styles[] = {JSON_WRITER_COMPACT, JSON_WRITER_PRETTY};
+  for (int i = 0; i < 2; i++)
+  {
+    JsonBenchmarkSource trace = {NULL, json_benchmark_write_trace(styles[i])};
+    json_benchmark_report_throughput(&trace,
+        benchmark_run(i == 0 ? "JsonWriter compact trace"
+                             : "JsonWriter pretty trace",
+            json_writer_benchmark, &styles[i]));
+  }
+
+  json_benchmark_report_memory(&source);
+  benchmark_run("json_parse glTF", json_value_parse_benchmark, &source);
+
+  for (int level = CPU_SIMD_SCALAR; level <= cpu_get_simd_level(); level++)
+  {
+    char name[64];
+    snprintf(name, sizeof(name), "JSON structural index (%s)",
+        cpu_simd_level_name((CpuSimdLevel) level));
+
+    JsonStructuralBenchmark benchmark = {&source, (CpuSimdLevel) level};
+    json_benchmark_report_throughput(&source,
+        benchmark_run(name, json_structural_benchmark, &benchmark));
+  }
+
+  json_benchmark_report_throughput(&source,
+      benchmark_run(
+          "JsonDocument glTF", json_document_parse_benchmark, &source));
+  json_benchmark_report_throughput(&source,
+      benchmark_run("JsonCursor glTF accessors", json_cursor_benchmark,
+          &source));
+
+  free(file);
+}
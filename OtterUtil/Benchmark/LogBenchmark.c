@@ -0,0 +1,132 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "Benchmarks.h"
+#include "Otter/Util/Benchmark.h"
+#include "Otter/Util/Log.h"
+
+// Messages logged between flushes, few enough to fit a thread's ring.
+#define LOG_BENCHMARK_BATCH 256
+
+// The logger this replaced, which formatted and wrote on the calling thread.
+static void log_benchmark_synchronous(FILE* output, int sourceLine,
+    const char* sourceFile, const char* message, ...)
+{
+  va_list args;
+  va_start(args, message);
+
+  time_t now = time(NULL);
+  struct tm timeinfo;
+  localtime_s(&timeinfo, &now);
+  fprintf(output, "%02d:%02d:%02d ", timeinfo.tm_hour, timeinfo.tm_min,
+      timeinfo.tm_sec);
+  fprintf(output, "\x1b[38;5;%dm", 11);
+  fprintf(output, "WARN  ");
+  fprintf(output, "\x1b[38;5;%dm", 249);
+  fprintf(output, "%s:%d: ", sourceFile, sourceLine);
+  fprintf(output, "\x1b[0m");
+  vfprintf(output, message, args);
+  fprintf(output, "\n");
+
+  va_end(args);
+}
+
+static void log_synchronous_benchmark(void* userData, uint64_t iterations)
+{
+  FILE* output = userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    log_benchmark_synchronous(output, __LINE__, __FILE__,
+        "Out of bounds read of index %zd on array of size %zd", (size_t) i,
+        (size_t) 16);
+  }
+}
+
+static void log_message_benchmark(void* userData, uint64_t iterations)
+{
+  (void) userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    LOG_WARNING("Out of bounds read of index %zd on array of size %zd",
+        (size_t) i, (size_t) 16);
+    if (i % LOG_BENCHMARK_BATCH == LOG_BENCHMARK_BATCH - 1)
+    {
+      log_flush();
+    }
+  }
+  log_flush();
+}
+
+static void log_repeat_benchmark(void* userData, uint64_t iterations)
+{
+  (void) userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    LOG_WARNING("Out of bounds read of index %zd on array of size %zd",
+        (size_t) i, (size_t) 16);
+  }
+  log_flush();
+}
+
+// What logging costs the thread that logs, leaving out the formatting and
+// writing done for it.
+static void log_caller_benchmark()
+{
+  LARGE_INTEGER frequency;
+  QueryPerformanceFrequency(&frequency);
+
+  int64_t ticks       = 0;
+  uint64_t iterations = 0;
+  while (ticks < frequency.QuadPart / 4)
+  {
+    LARGE_INTEGER start;
+    LARGE_INTEGER end;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < LOG_BENCHMARK_BATCH; i++)
+    {
+      LOG_WARNING("Out of bounds read of index %zd on array of size %zd",
+          (size_t) i, (size_t) 16);
+    }
+    QueryPerformanceCounter(&end);
+
+    ticks += end.QuadPart - start.QuadPart;
+    iterations += LOG_BENCHMARK_BATCH;
+    log_flush();
+  }
+
+  printf("%-48s %12llu iterations %12.2f ns/iter\n",
+      "log_message on the calling thread", (unsigned long long) iterations,
+      (double) ticks * 1e9 / frequency.QuadPart / iterations);
+}
+
+void log_benchmarks_run()
+{
+  FILE* output;
+  if (fopen_s(&output, "NUL", "wb") != 0)
+  {
+    printf("Unable to open NUL for the log benchmarks\n");
+    return;
+  }
+
+  benchmark_run("fprintf log line on the calling thread",
+      log_synchronous_benchmark, output);
+
+  log_set_output(output);
+  log_set_rate_limit(0);
+  benchmark_run("log_message written every 256", log_message_benchmark, NULL);
+  log_caller_benchmark();
+
+  if (log_set_binary_output(output))
+  {
+    benchmark_run(
+        "log_message binary written every 256", log_message_benchmark, NULL);
+    log_set_output(output);
+  }
+
+  log_set_rate_limit(LOG_RATE_LIMIT);
+  benchmark_run("log_message rate limited repeat", log_repeat_benchmark, NULL);
+
+  log_set_output(NULL);
+  fclose(output);
+}
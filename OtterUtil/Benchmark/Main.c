@@ -0,0 +1,11 @@
+#include "Benchmarks.h"
+
+int main(int argc, char** argv)
+{
+  allocator_benchmarks_run();
+  array_benchmarks_run();
+  json_benchmarks_run(argc > 1 ? argv[1] : NULL);
+  log_benchmarks_run();
+  profiler_benchmarks_run();
+  return 0;
+}
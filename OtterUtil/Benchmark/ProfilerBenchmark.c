@@ -0,0 +1,74 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "Benchmarks.h"
+#include "Otter/Util/Benchmark.h"
+#include "Otter/Util/Histogram.h"
+#include "Otter/Util/Profiler.h"
+
+// Zones finished between collections, few enough to fit a thread's buffer.
+#define PROFILER_BENCHMARK_BATCH 1024
+
+static void profiler_zone_benchmark(void* userData, uint64_t iterations)
+{
+  (void) userData;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    PROFILE_ZONE("benchmark_zone");
+    PROFILE_ZONE_END();
+    if (i % PROFILER_BENCHMARK_BATCH == PROFILER_BENCHMARK_BATCH - 1)
+    {
+      profiler_update();
+    }
+  }
+  profiler_update();
+}
+
+static void profiler_nested_benchmark(void* userData, uint64_t iterations)
+{
+  (void) userData;
+  PROFILE_ZONE("benchmark_parent");
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    PROFILE_ZONE("benchmark_child");
+    PROFILE_ZONE_END();
+    if (i % PROFILER_BENCHMARK_BATCH == PROFILER_BENCHMARK_BATCH - 1)
+    {
+      profiler_update();
+    }
+  }
+  PROFILE_ZONE_END();
+  profiler_update();
+}
+
+static void histogram_record_benchmark(void* userData, uint64_t iterations)
+{
+  Histogram* histogram = userData;
+  // Zone-like times in nanoseconds spread over several powers of two.
+  uint64_t value = 12345;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    value = value * 6364136223846793005ull + 1442695040888963407ull;
+    histogram_record(histogram, (value >> 40) & 0xfffff);
+  }
+}
+
+void profiler_benchmarks_run()
+{
+  LARGE_INTEGER frequency;
+  QueryPerformanceFrequency(&frequency);
+  profiler_init(frequency);
+
+  benchmark_run("PROFILE_ZONE begin and end", profiler_zone_benchmark, NULL);
+  benchmark_run(
+      "PROFILE_ZONE nested begin and end", profiler_nested_benchmark, NULL);
+
+  profiler_destroy();
+
+  Histogram* histogram = calloc(1, sizeof(Histogram));
+  if (histogram != NULL)
+  {
+    benchmark_run("histogram_record", histogram_record_benchmark, histogram);
+    free(histogram);
+  }
+}
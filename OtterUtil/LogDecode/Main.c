@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "Otter/Util/BinaryLog.h"
+#include "Otter/Util/File.h"
+#include "Otter/Util/Json/JsonWriter.h"
+#include "Otter/Util/Log.h"
+
+#define MESSAGE_SIZE 2048
+
+static const char* level_name(int32_t verbosity)
+{
+  switch (verbosity)
+  {
+  case LOG_DEBUG:
+    return "DEBUG";
+  case LOG_WARNING:
+    return "WARN";
+  case LOG_ERROR:
+    return "ERROR";
+  default:
+    return "UKNWN";
+  }
+}
+
+// Lines as the text log writes them, without colors.
+static void write_text(BinaryLogReader* reader, FILE* output)
+{
+  BinaryLogEntry entry;
+  char message[MESSAGE_SIZE];
+  while (binary_log_reader_next(reader, &entry))
+  {
+    binary_log_format_message(&entry, message, sizeof(message));
+    if (entry.site == NULL)
+    {
+      fprintf(output, "%10.4f %-5s %s\n", entry.time, level_name(LOG_WARNING),
+          message);
+      continue;
+    }
+
+    fprintf(output, "%10.4f %-5s %s:%d: %s", entry.time,
+        level_name(entry.site->verbosity), entry.site->file, entry.site->line,
+        message);
+    if (entry.count > 0)
+    {
+      fprintf(output, " (repeated %u more times)", entry.count);
+    }
+    fputc('\n', output);
+  }
+}
+
+// Each argument as its own JSON value, going by the types the site was
+// written with.
+static void write_json_arguments(
+    JsonWriter* writer, const BinaryLogEntry* entry)
+{
+  const char* slot = entry->arguments;
+  const char* end  = entry->arguments + entry->argumentsSize;
+
+  json_writer_begin_array(writer);
+  for (uint32_t i = 0;
+       i < entry->site->argumentCount && end - slot >= sizeof(uint64_t); i++)
+  {
+    uint64_t value;
+    memcpy(&value, slot, sizeof(value));
+    slot += sizeof(value);
+
+    double number;
+    char character;
+    switch (entry->site->arguments[i])
+    {
+    case LA_SIGNED:
+    case LA_POINTER:
+      json_writer_integer(writer, (int64_t) value);
+      break;
+    case LA_UNSIGNED:
+      if (value > INT64_MAX)
+      {
+        json_writer_double(writer, (double) value);
+      }
+      else
+      {
+        json_writer_integer(writer, (int64_t) value);
+      }
+      break;
+    case LA_CHARACTER:
+      character = (char) value;
+      json_writer_string(writer, string_view_create(&character, 1));
+      break;
+    case LA_DOUBLE:
+      memcpy(&number, &value, sizeof(number));
+      json_writer_double(writer, number);
+      break;
+    case LA_STRING:
+      if (value > (uint64_t) (end - slot))
+      {
+        i = entry->site->argumentCount;
+        break;
+      }
+      json_writer_string(writer, string_view_create(slot, (size_t) value));
+      slot += (value + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+      break;
+    default:
+      json_writer_null(writer);
+      break;
+    }
+  }
+  json_writer_end_array(writer);
+}
+
+// An array with an object per message.
+static void write_json(BinaryLogReader* reader, JsonWriter* writer)
+{
+  BinaryLogEntry entry;
+  char message[MESSAGE_SIZE];
+
+  json_writer_begin_array(writer);
+  while (binary_log_reader_next(reader, &entry))
+  {
+    json_writer_begin_object(writer);
+    json_writer_key(writer, STRING_VIEW_LITERAL("time"));
+    json_writer_double(writer, entry.time);
+
+    if (entry.site == NULL)
+    {
+      json_writer_key(writer, STRING_VIEW_LITERAL("dropped"));
+      json_writer_integer(writer, entry.count);
+      json_writer_end_object(writer);
+      continue;
+    }
+
+    const char* level = level_name(entry.site->verbosity);
+    json_writer_key(writer, STRING_VIEW_LITERAL("level"));
+    json_writer_string(writer, string_view_create(level, strlen(level)));
+    json_writer_key(writer, STRING_VIEW_LITERAL("file"));
+    json_writer_string(writer,
+        string_view_create(entry.site->file, strlen(entry.site->file)));
+    json_writer_key(writer, STRING_VIEW_LITERAL("line"));
+    json_writer_integer(writer, entry.site->line);
+
+    size_t length =
+        binary_log_format_message(&entry, message, sizeof(message));
+    json_writer_key(writer, STRING_VIEW_LITERAL("message"));
+    json_writer_string(writer, string_view_create(message, length));
+    json_writer_key(writer, STRING_VIEW_LITERAL("arguments"));
+    write_json_arguments(writer, &entry);
+
+    if (entry.count > 0)
+    {
+      json_writer_key(writer, STRING_VIEW_LITERAL("repeated"));
+      json_writer_integer(writer, entry.count);
+    }
+    json_writer_end_object(writer);
+  }
+  json_writer_end_array(writer);
+}
+
+static bool decode(BinaryLogReader* reader, bool json, const char* outputPath)
+{
+  if (json)
+  {
+    JsonWriter writer;
+    if (outputPath == NULL)
+    {
+      json_writer_create(&writer, JSON_WRITER_PRETTY, NULL);
+      write_json(reader, &writer);
+      StringView output = json_writer_get_output(&writer);
+      fwrite(output.data, 1, output.length, stdout);
+      fputc('\n', stdout);
+    }
+    else if (json_writer_open(&writer, outputPath, JSON_WRITER_PRETTY))
+    {
+      write_json(reader, &writer);
+    }
+    else
+    {
+      return false;
+    }
+    return json_writer_close(&writer);
+  }
+
+  FILE* output = stdout;
+  if (outputPath != NULL && fopen_s(&output, outputPath, "w") != 0)
+  {
+    LOG_ERROR("Failed to open file for writing: %s", outputPath);
+    return false;
+  }
+  write_text(reader, output);
+  return output == stdout || fclose(output) == 0;
+}
+
+int main(int argc, char** argv)
+{
+  bool json              = argc > 1 && strcmp(argv[1], "--json") == 0;
+  int first              = json ? 2 : 1;
+  const char* inputPath  = argc > first ? argv[first] : NULL;
+  const char* outputPath = argc > first + 1 ? argv[first + 1] : NULL;
+  if (inputPath == NULL || argc > first + 2)
+  {
+    fprintf(stderr, "Usage: otter-logdecode [--json] <log> [<output>]\n");
+    return 2;
+  }
+
+  // Decoded text can go to stdout, so the tool's own messages don't.
+  log_set_output(stderr);
+
+  FileView input;
+  if (!file_map(inputPath, &input))
+  {
+    return 1;
+  }
+
+  BinaryLogReader reader;
+  bool decoded = binary_log_reader_open(&reader, input.data, input.length);
+  if (decoded)
+  {
+    decoded = decode(&reader, json, outputPath);
+    if (reader.offset != reader.length)
+    {
+      LOG_WARNING("%s ends with %llu bytes that couldn't be read.", inputPath,
+          (unsigned long long) (reader.length - reader.offset));
+    }
+    binary_log_reader_close(&reader);
+  }
+
+  file_unmap(&input);
+  return decoded ? 0 : 1;
+}
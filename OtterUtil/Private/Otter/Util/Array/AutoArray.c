@@ -5,16 +5,24 @@
 #define ARRAY_INCREMENT_SIZE 32
 
 void auto_array_create(AutoArray* array, size_t elementSize)
+{
+  auto_array_create_with_allocator(array, elementSize, NULL);
+}
+
+void auto_array_create_with_allocator(
+    AutoArray* array, size_t elementSize, Allocator* allocator)
 {
   array->buffer        = NULL;
   array->capacity      = 0;
   array->size          = 0;
   array->sizeOfElement = elementSize;
+  array->allocator     = allocator;
 }
 
 void auto_array_destroy(AutoArray* array)
 {
-  free(array->buffer);
+  allocator_deallocate(array->allocator, array->buffer,
+      array->capacity * array->sizeOfElement);
 }
 
 static bool auto_array_resize(AutoArray* array, size_t requestedSize)
@@ -25,8 +33,9 @@ static bool auto_array_resize(AutoArray* array, size_t requestedSize)
     requestedSize += ARRAY_INCREMENT_SIZE - capacityOverrun;
   }
 
-  void* newBuffer =
-      realloc(array->buffer, requestedSize * array->sizeOfElement);
+  void* newBuffer = allocator_reallocate(array->allocator, array->buffer,
+      array->capacity * array->sizeOfElement,
+      requestedSize * array->sizeOfElement);
   if (newBuffer == NULL)
   {
     LOG_WARNING("Unable to increase array size. Not allocating element.");
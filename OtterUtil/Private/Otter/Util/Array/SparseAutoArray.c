@@ -2,14 +2,44 @@
 
 void sparse_auto_array_create(SparseAutoArray* list, uint64_t componentSize)
 {
-  bit_map_create(&list->usedMask);
-  auto_array_create(&list->components, componentSize);
+  sparse_auto_array_create_with_allocator(list, componentSize, NULL);
+}
+
+void sparse_auto_array_create_with_allocator(
+    SparseAutoArray* list, uint64_t componentSize, Allocator* allocator)
+{
+  bit_map_create_with_allocator(&list->usedMask, allocator);
+  auto_array_create_with_allocator(
+      &list->components, componentSize, allocator);
+  list->reserved = false;
+}
+
+void sparse_auto_array_create_reserved(SparseAutoArray* list,
+    uint64_t componentSize, uint64_t maxElements, Allocator* allocator)
+{
+  if (!virtual_array_create(
+          &list->reservedComponents, componentSize, maxElements, VAF_NONE))
+  {
+    LOG_WARNING("Unable to reserve sparse array. Elements may move.");
+    sparse_auto_array_create_with_allocator(list, componentSize, allocator);
+    return;
+  }
+
+  bit_map_create_with_allocator(&list->usedMask, allocator);
+  list->reserved = true;
 }
 
 void sparse_auto_array_destroy(SparseAutoArray* list)
 {
   bit_map_destroy(&list->usedMask);
-  auto_array_destroy(&list->components);
+  if (list->reserved)
+  {
+    virtual_array_destroy(&list->reservedComponents);
+  }
+  else
+  {
+    auto_array_destroy(&list->components);
+  }
 }
 
 uint64_t sparse_auto_array_allocate(SparseAutoArray* list)
@@ -19,7 +49,14 @@ uint64_t sparse_auto_array_allocate(SparseAutoArray* list)
   {
     index               = list->components.size;
     uint64_t newEntries = bit_map_expand(&list->usedMask);
-    auto_array_allocate_many(&list->components, newEntries);
+    if (list->reserved)
+    {
+      virtual_array_allocate_many(&list->reservedComponents, newEntries);
+    }
+    else
+    {
+      auto_array_allocate_many(&list->components, newEntries);
+    }
   }
 
   bit_map_set(&list->usedMask, index, true);
@@ -33,7 +70,11 @@ uint64_t sparse_auto_array_deallocate(SparseAutoArray* list, uint64_t index)
 
   uint64_t compactedEntries = bit_map_compact(&list->usedMask);
 
-  if (compactedEntries > 0)
+  if (compactedEntries > 0 && list->reserved)
+  {
+    virtual_array_pop_many(&list->reservedComponents, compactedEntries);
+  }
+  else if (compactedEntries > 0)
   {
     auto_array_pop_many(&list->components, compactedEntries);
   }
@@ -48,5 +89,9 @@ void* sparse_auto_array_get(SparseAutoArray* list, uint64_t index)
     return NULL;
   }
 
+  if (list->reserved)
+  {
+    return virtual_array_get(&list->reservedComponents, index);
+  }
   return auto_array_get(&list->components, index);
 }
@@ -3,6 +3,13 @@
 void stable_auto_array_create(
     StableAutoArray* array, uint32_t elementSize, uint32_t chunkSize)
 {
+  stable_auto_array_create_with_allocator(array, elementSize, chunkSize, NULL);
+}
+
+void stable_auto_array_create_with_allocator(StableAutoArray* array,
+    uint32_t elementSize, uint32_t chunkSize, Allocator* allocator)
+{
+  array->allocator     = allocator;
   array->sizeOfElement = elementSize;
   array->chunkSize     = chunkSize;
   array->chunks        = NULL;
@@ -10,12 +17,19 @@ void stable_auto_array_create(
   array->size          = 0;
 }
 
+static size_t stable_auto_array_chunk_size(StableAutoArray* array)
+{
+  return sizeof(StableAutoArrayChunk)
+       + (size_t) array->sizeOfElement * array->chunkSize;
+}
+
 void stable_auto_array_destroy(StableAutoArray* array)
 {
   while (array->chunks != NULL)
   {
     StableAutoArrayChunk* next = array->chunks->nextChunk;
-    free(array->chunks);
+    allocator_deallocate(
+        array->allocator, array->chunks, stable_auto_array_chunk_size(array));
     array->chunks = next;
   }
 }
@@ -24,8 +38,8 @@ void* stable_auto_array_allocate(StableAutoArray* array)
 {
   if (array->size == array->capacity)
   {
-    StableAutoArrayChunk* newChunk = malloc(
-        sizeof(StableAutoArrayChunk) + array->sizeOfElement * array->chunkSize);
+    StableAutoArrayChunk* newChunk = allocator_allocate(
+        array->allocator, stable_auto_array_chunk_size(array));
     if (newChunk == NULL)
     {
       LOG_WARNING("Out of memory. Not allocating element.");
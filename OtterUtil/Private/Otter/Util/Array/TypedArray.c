@@ -0,0 +1,76 @@
+#include "Otter/Util/Array/TypedArray.h"
+
+size_t typed_array_next_capacity(size_t capacity, size_t required)
+{
+  size_t newCapacity =
+      capacity < TYPED_ARRAY_MIN_CAPACITY ? TYPED_ARRAY_MIN_CAPACITY : capacity;
+  while (newCapacity < required)
+  {
+    newCapacity *= 2;
+  }
+  return newCapacity;
+}
+
+bool typed_array_set_capacity(void* storage, size_t elementSize, size_t size,
+    size_t* capacity, size_t newCapacity, size_t inlineCapacity)
+{
+  if (newCapacity < size)
+  {
+    newCapacity = size;
+  }
+
+  bool isInline   = *capacity <= inlineCapacity;
+  bool willInline = newCapacity <= inlineCapacity;
+  void** heap     = storage;
+
+  if (willInline)
+  {
+    if (!isInline)
+    {
+      // The inline elements overlap the heap pointer, so hold on to it until
+      // the elements are copied out.
+      void* oldBuffer = *heap;
+      memcpy(storage, oldBuffer, size * elementSize);
+      free(oldBuffer);
+    }
+
+    if (inlineCapacity == 0)
+    {
+      *heap = NULL;
+    }
+    *capacity = inlineCapacity;
+    return true;
+  }
+
+  void* newBuffer;
+  if (isInline)
+  {
+    newBuffer = malloc(newCapacity * elementSize);
+    if (newBuffer != NULL)
+    {
+      memcpy(newBuffer, storage, size * elementSize);
+    }
+  }
+  else
+  {
+    newBuffer = realloc(*heap, newCapacity * elementSize);
+  }
+
+  if (newBuffer == NULL)
+  {
+    LOG_WARNING("Unable to resize array to %zd elements.", newCapacity);
+    return false;
+  }
+
+  *heap     = newBuffer;
+  *capacity = newCapacity;
+  return true;
+}
+
+void typed_array_release(void* storage, size_t capacity, size_t inlineCapacity)
+{
+  if (capacity > inlineCapacity)
+  {
+    free(*(void**) storage);
+  }
+}
@@ -0,0 +1,172 @@
+#include "Otter/Util/Array/VirtualArray.h"
+
+#include "Otter/Util/Log.h"
+
+static size_t virtual_array_round_up(size_t size, size_t granularity)
+{
+  return (size + granularity - 1) / granularity * granularity;
+}
+
+static void virtual_array_set_committed(VirtualArray* array, size_t bytes)
+{
+  array->committedBytes = bytes;
+  array->capacity       = min(bytes / array->sizeOfElement, array->maxCapacity);
+}
+
+static bool virtual_array_create_large_pages(VirtualArray* array)
+{
+  size_t largePageSize = GetLargePageMinimum();
+  if (largePageSize == 0)
+  {
+    return false;
+  }
+
+  size_t bytes = virtual_array_round_up(array->reservedBytes, largePageSize);
+  array->buffer =
+      VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+          PAGE_READWRITE);
+  if (array->buffer == NULL)
+  {
+    return false;
+  }
+
+  array->reservedBytes = bytes;
+  array->largePages    = true;
+  virtual_array_set_committed(array, bytes);
+  return true;
+}
+
+bool virtual_array_create(VirtualArray* array, size_t elementSize,
+    size_t maxElements, VirtualArrayFlags flags)
+{
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+
+  array->sizeOfElement  = elementSize;
+  array->size           = 0;
+  array->capacity       = 0;
+  array->buffer         = NULL;
+  array->maxCapacity    = maxElements;
+  array->committedBytes = 0;
+  array->reservedBytes  = virtual_array_round_up(
+      elementSize * maxElements, systemInfo.dwAllocationGranularity);
+  array->largePages     = false;
+
+  if (flags & VAF_LARGE_PAGES)
+  {
+    if (virtual_array_create_large_pages(array))
+    {
+      return true;
+    }
+    LOG_WARNING("Large pages are unavailable. Using normal pages.");
+  }
+
+  array->buffer =
+      VirtualAlloc(NULL, array->reservedBytes, MEM_RESERVE, PAGE_NOACCESS);
+  if (array->buffer == NULL)
+  {
+    LOG_ERROR("Unable to reserve %zd bytes for array", array->reservedBytes);
+    return false;
+  }
+
+  return true;
+}
+
+void virtual_array_destroy(VirtualArray* array)
+{
+  if (array->buffer != NULL)
+  {
+    VirtualFree(array->buffer, 0, MEM_RELEASE);
+  }
+  array->buffer   = NULL;
+  array->size     = 0;
+  array->capacity = 0;
+}
+
+bool virtual_array_reserve(VirtualArray* array, size_t elementCount)
+{
+  if (elementCount <= array->capacity)
+  {
+    return true;
+  }
+
+  if (elementCount > array->maxCapacity)
+  {
+    LOG_WARNING("Array reservation of %zd elements is exhausted",
+        array->maxCapacity);
+    return false;
+  }
+
+  // Commit geometrically so a steadily growing array makes few system calls.
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  size_t bytes = max(elementCount * array->sizeOfElement,
+      max(array->committedBytes * 2, VIRTUAL_ARRAY_MIN_COMMIT));
+  bytes        = virtual_array_round_up(bytes, systemInfo.dwPageSize);
+  bytes        = min(bytes, array->reservedBytes);
+
+  char* start = (char*) array->buffer + array->committedBytes;
+  if (VirtualAlloc(start, bytes - array->committedBytes, MEM_COMMIT,
+          PAGE_READWRITE)
+      == NULL)
+  {
+    LOG_WARNING("Unable to commit memory. Not allocating element.");
+    return false;
+  }
+
+  virtual_array_set_committed(array, bytes);
+  return true;
+}
+
+void* virtual_array_allocate(VirtualArray* array)
+{
+  return virtual_array_allocate_many(array, 1);
+}
+
+void* virtual_array_allocate_many(VirtualArray* array, size_t elementCount)
+{
+  if (elementCount == 0)
+  {
+    return NULL;
+  }
+
+  size_t newSize = array->size + elementCount;
+  if (newSize > array->capacity && !virtual_array_reserve(array, newSize))
+  {
+    return NULL;
+  }
+  array->size = newSize;
+  return virtual_array_get(array, array->size - elementCount);
+}
+
+void virtual_array_clear(VirtualArray* array)
+{
+  array->size = 0;
+}
+
+void virtual_array_pop_many(VirtualArray* array, size_t elementCount)
+{
+  if (array->size >= elementCount)
+  {
+    array->size -= elementCount;
+  }
+}
+
+void virtual_array_shrink_to_fit(VirtualArray* array)
+{
+  if (array->largePages)
+  {
+    return;
+  }
+
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  size_t bytes = virtual_array_round_up(
+      array->size * array->sizeOfElement, systemInfo.dwPageSize);
+  if (bytes < array->committedBytes)
+  {
+    VirtualFree((char*) array->buffer + bytes, array->committedBytes - bytes,
+        MEM_DECOMMIT);
+    virtual_array_set_committed(array, bytes);
+  }
+}
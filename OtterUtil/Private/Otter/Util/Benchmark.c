@@ -0,0 +1,81 @@
+#include "Otter/Util/Benchmark.h"
+
+#include "Otter/Util/Counter.h"
+
+#define BENCHMARK_MIN_SECONDS    0.25
+#define BENCHMARK_MAX_ITERATIONS (1ull << 32)
+
+void benchmark_do_not_optimize(const void* value)
+{
+  // Calling through the DLL boundary is enough to make the value escape.
+  (void) value;
+}
+
+static double benchmark_time(
+    BenchmarkFunction function, void* userData, uint64_t iterations)
+{
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER start;
+  LARGE_INTEGER end;
+  QueryPerformanceFrequency(&frequency);
+
+  // Counters are summed around each run, so they're left holding what the
+  // last one added.
+  counter_update();
+  QueryPerformanceCounter(&start);
+  function(userData, iterations);
+  QueryPerformanceCounter(&end);
+  counter_update();
+
+  return (double) (end.QuadPart - start.QuadPart) / frequency.QuadPart;
+}
+
+static void benchmark_print_counter(
+    const char* name, const CounterSummary* summary, void* iterations)
+{
+  if (summary->frame != 0.0)
+  {
+    printf("  %-46s %12.2f per iteration\n", name,
+        summary->frame / *(uint64_t*) iterations);
+  }
+}
+
+BenchmarkResult benchmark_run(
+    const char* name, BenchmarkFunction function, void* userData)
+{
+  // Warm up caches and the allocator before timing.
+  function(userData, 1);
+
+  uint64_t iterations = 1;
+  double seconds      = benchmark_time(function, userData, iterations);
+  while (seconds < BENCHMARK_MIN_SECONDS
+         && iterations < BENCHMARK_MAX_ITERATIONS)
+  {
+    // Aim past the minimum so the final run usually isn't the short one.
+    double scale = seconds > 0.0 ? BENCHMARK_MIN_SECONDS * 1.5 / seconds : 10.0;
+    if (scale > 10.0)
+    {
+      scale = 10.0;
+    }
+    else if (scale < 2.0)
+    {
+      scale = 2.0;
+    }
+
+    iterations = (uint64_t) (iterations * scale);
+    seconds    = benchmark_time(function, userData, iterations);
+  }
+
+  BenchmarkResult result = {
+      .name                    = name,
+      .iterations              = iterations,
+      .totalSeconds            = seconds,
+      .nanosecondsPerIteration = seconds * 1e9 / iterations,
+  };
+
+  printf("%-48s %12llu iterations %12.2f ns/iter\n", name,
+      (unsigned long long) iterations, result.nanosecondsPerIteration);
+  counter_iterate(benchmark_print_counter, &iterations);
+
+  return result;
+}
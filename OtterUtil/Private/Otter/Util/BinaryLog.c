@@ -0,0 +1,175 @@
+#include "Otter/Util/BinaryLog.h"
+
+#include "Otter/Util/Log.h"
+#include "Otter/Util/LogFormat.h"
+
+bool binary_log_reader_open(
+    BinaryLogReader* reader, const char* data, uint64_t length)
+{
+  BinaryLogHeader header;
+  if (length < sizeof(header))
+  {
+    LOG_WARNING("Binary log is too short for its header.");
+    return false;
+  }
+
+  memcpy(&header, data, sizeof(header));
+  if (memcmp(header.magic, BINARY_LOG_MAGIC, sizeof(header.magic)) != 0
+      || header.version != BINARY_LOG_VERSION || header.frequency <= 0)
+  {
+    LOG_WARNING("Not a binary log, or one of a different version.");
+    return false;
+  }
+
+  reader->data      = data;
+  reader->length    = length;
+  reader->offset    = sizeof(header);
+  reader->frequency = header.frequency;
+  reader->start     = header.start;
+  auto_array_create(&reader->sites, sizeof(BinaryLogSite));
+  return true;
+}
+
+// Read a site record into the reader's table. Its id has to be the next one,
+// as the logger numbers them in the order it writes them.
+static bool binary_log_reader_add_site(
+    BinaryLogReader* reader, const char* data, uint32_t size)
+{
+  BinaryLogSiteRecord record;
+  memcpy(&record, data, sizeof(record));
+
+  uint64_t required = (uint64_t) sizeof(record) + record.fileLength
+                    + record.formatLength + record.argumentCount;
+  if (required > size || record.id != reader->sites.size
+      || record.fileLength == 0 || record.formatLength == 0)
+  {
+    return false;
+  }
+
+  const char* file      = data + sizeof(record);
+  const char* format    = file + record.fileLength;
+  const char* arguments = format + record.formatLength;
+  if (file[record.fileLength - 1] != '\0'
+      || format[record.formatLength - 1] != '\0')
+  {
+    return false;
+  }
+
+  BinaryLogSite* site = auto_array_allocate(&reader->sites);
+  if (site == NULL)
+  {
+    return false;
+  }
+  site->file          = file;
+  site->format        = format;
+  site->arguments     = (const uint8_t*) arguments;
+  site->argumentCount = record.argumentCount;
+  site->line          = record.line;
+  site->verbosity     = record.verbosity;
+  return true;
+}
+
+bool binary_log_reader_next(BinaryLogReader* reader, BinaryLogEntry* entry)
+{
+  while (reader->length - reader->offset >= sizeof(BinaryLogRecord))
+  {
+    const char* data = &reader->data[reader->offset];
+    BinaryLogRecord record;
+    memcpy(&record, data, sizeof(record));
+    if (record.size < sizeof(record)
+        || record.size > reader->length - reader->offset)
+    {
+      return false;
+    }
+    reader->offset += record.size;
+
+    switch (record.type)
+    {
+    case BLR_SITE:
+      if (record.size < sizeof(BinaryLogSiteRecord)
+          || !binary_log_reader_add_site(reader, data, record.size))
+      {
+        return false;
+      }
+      break;
+    case BLR_EVENT:
+    {
+      BinaryLogEventRecord event;
+      if (record.size < sizeof(event))
+      {
+        return false;
+      }
+      memcpy(&event, data, sizeof(event));
+      if (event.site >= reader->sites.size)
+      {
+        return false;
+      }
+
+      entry->site = auto_array_get(&reader->sites, event.site);
+      entry->time = (double) (event.timestamp - reader->start)
+                  / (double) reader->frequency;
+      entry->count         = event.suppressed;
+      entry->arguments     = data + sizeof(event);
+      entry->argumentsSize = record.size - sizeof(event);
+      return true;
+    }
+    case BLR_DROPPED:
+    {
+      BinaryLogDroppedRecord dropped;
+      if (record.size < sizeof(dropped))
+      {
+        return false;
+      }
+      memcpy(&dropped, data, sizeof(dropped));
+
+      entry->site = NULL;
+      entry->time = (double) (dropped.timestamp - reader->start)
+                  / (double) reader->frequency;
+      entry->count         = dropped.count;
+      entry->arguments     = NULL;
+      entry->argumentsSize = 0;
+      return true;
+    }
+    default:
+      // Records from newer writers are skipped.
+      break;
+    }
+  }
+
+  return false;
+}
+
+void binary_log_reader_close(BinaryLogReader* reader)
+{
+  auto_array_destroy(&reader->sites);
+}
+
+size_t binary_log_format_message(
+    const BinaryLogEntry* entry, char* buffer, size_t capacity)
+{
+  if (capacity == 0)
+  {
+    return 0;
+  }
+
+  char line[LOG_LINE_SIZE];
+  size_t length = 0;
+  if (entry->site != NULL)
+  {
+    log_format_arguments(entry->site->format, entry->arguments,
+        entry->argumentsSize, line, &length);
+  }
+  else
+  {
+    log_append_formatted(line, &length,
+        snprintf(line, sizeof(line),
+            "%u messages were dropped because a thread logged faster than "
+            "they could be written.",
+            entry->count));
+  }
+
+  length = min(length, capacity - 1);
+  memcpy(buffer, line, length);
+  buffer[length] = '\0';
+  return length;
+}
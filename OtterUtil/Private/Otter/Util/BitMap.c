@@ -5,6 +5,11 @@ void bit_map_create(BitMap* map)
   auto_array_create(map, sizeof(BitMapSlot));
 }
 
+void bit_map_create_with_allocator(BitMap* map, Allocator* allocator)
+{
+  auto_array_create_with_allocator(map, sizeof(BitMapSlot), allocator);
+}
+
 void bit_map_destroy(BitMap* map)
 {
   auto_array_destroy(map);
@@ -0,0 +1,299 @@
+#include "Otter/Util/Counter.h"
+
+#include "Otter/Util/Log.h"
+
+typedef union CounterValue
+{
+  int64_t integer;
+  double floatingPoint;
+} CounterValue;
+
+// Owned by one thread, which is the only one to write it. Shards of threads
+// that exit are picked up by new threads and keep adding to what's there, so
+// sums over every shard only ever grow.
+typedef struct CounterShard
+{
+  struct CounterShard* next;
+  volatile LONG active;
+  char padding[52];
+  volatile CounterValue values[COUNTER_MAX];
+} CounterShard;
+
+typedef struct Counter
+{
+  const char* name;
+  enum CounterType type;
+  // Summed over every shard at the last update.
+  CounterValue total;
+  double frame;
+  // Added so far in the current window, and the frames it's had.
+  double window;
+  uint32_t windowFrames;
+  double perFrame;
+  double perSecond;
+} Counter;
+
+// Names are only ever added. Everything but the name and type is only touched
+// under the lock.
+static Counter g_counters[COUNTER_MAX];
+static volatile LONG g_counterCount;
+static SRWLOCK g_counterLock = SRWLOCK_INIT;
+
+static CounterShard* volatile g_counterShards;
+static _Thread_local CounterShard* g_counterShard;
+static DWORD g_counterFlsIndex = FLS_OUT_OF_INDEXES;
+
+// Where the performance counter was when the current window started.
+static int64_t g_counterWindowStart;
+
+static void NTAPI counter_release_thread(void* shard)
+{
+  if (shard != NULL)
+  {
+    InterlockedExchange(&((CounterShard*) shard)->active, 0);
+  }
+}
+
+static CounterShard* counter_register_thread()
+{
+  CounterShard* shard =
+      ReadPointerAcquire((void* volatile*) &g_counterShards);
+  while (shard != NULL
+         && InterlockedCompareExchange(&shard->active, 1, 0) != 0)
+  {
+    shard = shard->next;
+  }
+
+  if (shard == NULL)
+  {
+    shard = calloc(1, sizeof(CounterShard));
+    if (shard == NULL)
+    {
+      return NULL;
+    }
+
+    shard->active = 1;
+    do
+    {
+      shard->next = g_counterShards;
+    } while (InterlockedCompareExchangePointer(
+                 (void* volatile*) &g_counterShards, shard, shard->next)
+             != shard->next);
+  }
+
+  // Exiting threads hand their shard back through fiber local storage, which
+  // runs a callback where thread locals don't.
+  if (g_counterFlsIndex == FLS_OUT_OF_INDEXES)
+  {
+    AcquireSRWLockExclusive(&g_counterLock);
+    if (g_counterFlsIndex == FLS_OUT_OF_INDEXES)
+    {
+      g_counterFlsIndex = FlsAlloc(counter_release_thread);
+    }
+    ReleaseSRWLockExclusive(&g_counterLock);
+  }
+  if (g_counterFlsIndex != FLS_OUT_OF_INDEXES)
+  {
+    FlsSetValue(g_counterFlsIndex, shard);
+  }
+  g_counterShard = shard;
+  return shard;
+}
+
+static Counter* counter_find(const char* name)
+{
+  LONG count = ReadAcquire(&g_counterCount);
+  for (LONG i = 0; i < count; i++)
+  {
+    if (strcmp(g_counters[i].name, name) == 0)
+    {
+      return &g_counters[i];
+    }
+  }
+  return NULL;
+}
+
+// Give the site the index of the counter with its name, making the counter
+// if it's new.
+static LONG counter_register_site(CounterSite* site)
+{
+  AcquireSRWLockExclusive(&g_counterLock);
+  Counter* counter = counter_find(site->name);
+  if (counter == NULL && g_counterCount < COUNTER_MAX)
+  {
+    counter       = &g_counters[g_counterCount];
+    counter->name = site->name;
+    counter->type = site->type;
+    WriteRelease(&g_counterCount, g_counterCount + 1);
+  }
+  ReleaseSRWLockExclusive(&g_counterLock);
+
+  LONG index = -1;
+  if (counter == NULL)
+  {
+    LOG_WARNING("Too many counter names to count %s", site->name);
+  }
+  else if (counter->type != site->type)
+  {
+    LOG_WARNING("Counter %s is added to as both an integer and a float.",
+        site->name);
+  }
+  else
+  {
+    index = (LONG) (counter - g_counters) + 1;
+  }
+  InterlockedExchange(&site->index, index);
+  return index;
+}
+
+// The value in the calling thread's shard the site adds to, or NULL if it
+// isn't counted.
+static volatile CounterValue* counter_get_value(CounterSite* site)
+{
+  LONG index = site->index;
+  if (index == 0)
+  {
+    index = counter_register_site(site);
+  }
+
+  CounterShard* shard = g_counterShard;
+  if (index < 0
+      || (shard == NULL && (shard = counter_register_thread()) == NULL))
+  {
+    return NULL;
+  }
+  return &shard->values[index - 1];
+}
+
+void counter_add(CounterSite* site, int64_t value)
+{
+  volatile CounterValue* counterValue = counter_get_value(site);
+  if (counterValue != NULL)
+  {
+    counterValue->integer += value;
+  }
+}
+
+void counter_add_float(CounterSite* site, double value)
+{
+  volatile CounterValue* counterValue = counter_get_value(site);
+  if (counterValue != NULL)
+  {
+    counterValue->floatingPoint += value;
+  }
+}
+
+void counter_update()
+{
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER now;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&now);
+
+  AcquireSRWLockExclusive(&g_counterLock);
+  if (g_counterWindowStart == 0)
+  {
+    g_counterWindowStart = now.QuadPart;
+  }
+  int64_t elapsed = now.QuadPart - g_counterWindowStart;
+  bool windowEnded =
+      elapsed >= frequency.QuadPart * COUNTER_WINDOW_MS / 1000;
+
+  for (LONG i = 0; i < g_counterCount; i++)
+  {
+    Counter* counter = &g_counters[i];
+
+    // Each shard's value is written whole by its owner, so a sum can miss
+    // something added during it but can't tear.
+    CounterValue total = {0};
+    for (CounterShard* shard =
+             ReadPointerAcquire((void* volatile*) &g_counterShards);
+         shard != NULL; shard = shard->next)
+    {
+      if (counter->type == CT_INTEGER)
+      {
+        total.integer += shard->values[i].integer;
+      }
+      else
+      {
+        total.floatingPoint += shard->values[i].floatingPoint;
+      }
+    }
+
+    counter->frame =
+        counter->type == CT_INTEGER
+            ? (double) (total.integer - counter->total.integer)
+            : total.floatingPoint - counter->total.floatingPoint;
+    counter->total = total;
+    counter->window += counter->frame;
+    counter->windowFrames++;
+
+    if (windowEnded)
+    {
+      counter->perFrame     = counter->window / counter->windowFrames;
+      counter->perSecond    = counter->window * frequency.QuadPart / elapsed;
+      counter->window       = 0.0;
+      counter->windowFrames = 0;
+    }
+  }
+
+  if (windowEnded)
+  {
+    g_counterWindowStart = now.QuadPart;
+  }
+  ReleaseSRWLockExclusive(&g_counterLock);
+}
+
+static void counter_summarize(
+    const Counter* counter, CounterSummary* summary)
+{
+  summary->frame     = counter->frame;
+  summary->perFrame  = counter->perFrame;
+  summary->perSecond = counter->perSecond;
+  summary->total     = counter->type == CT_INTEGER
+                         ? (double) counter->total.integer
+                         : counter->total.floatingPoint;
+}
+
+bool counter_summary_get(const char* name, CounterSummary* summary)
+{
+  AcquireSRWLockShared(&g_counterLock);
+  const Counter* counter = counter_find(name);
+  if (counter != NULL)
+  {
+    counter_summarize(counter, summary);
+  }
+  ReleaseSRWLockShared(&g_counterLock);
+  return counter != NULL;
+}
+
+void counter_iterate(CounterFunction function, void* userData)
+{
+  AcquireSRWLockShared(&g_counterLock);
+  for (LONG i = 0; i < g_counterCount; i++)
+  {
+    CounterSummary summary;
+    counter_summarize(&g_counters[i], &summary);
+    function(g_counters[i].name, &summary, userData);
+  }
+  ReleaseSRWLockShared(&g_counterLock);
+}
+
+static void counter_report_line(
+    const char* name, const CounterSummary* summary, void* output)
+{
+  if (summary->total == 0.0)
+  {
+    return;
+  }
+
+  fprintf((FILE*) output, "%-32s %14.1f %14.1f %16.0f\n", name,
+      summary->perFrame, summary->perSecond, summary->total);
+}
+
+void counter_report(FILE* output)
+{
+  fprintf(output, "%-32s %14s %14s %16s\n", "counter", "per frame",
+      "per second", "total");
+  counter_iterate(counter_report_line, output);
+}
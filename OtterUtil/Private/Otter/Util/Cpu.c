@@ -0,0 +1,91 @@
+#include "Otter/Util/Cpu.h"
+
+#if !defined(_MSC_VER) || defined(__clang__)
+#include <cpuid.h>
+#endif
+
+#define CPU_LEAF1_ECX_SSE42   (1 << 20)
+#define CPU_LEAF1_ECX_OSXSAVE (1 << 27)
+#define CPU_LEAF1_ECX_AVX     (1 << 28)
+#define CPU_LEAF7_EBX_AVX2    (1 << 5)
+#define CPU_XCR0_SSE_AVX      0x6
+
+static volatile long g_simdLevel = -1;
+
+static void cpu_query(int leaf, int subleaf, int registers[4])
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  __cpuidex(registers, leaf, subleaf);
+#else
+  __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2],
+      registers[3]);
+#endif
+}
+
+static uint64_t cpu_get_enabled_state()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  return _xgetbv(0);
+#else
+  uint32_t low;
+  uint32_t high;
+  __asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+  return ((uint64_t) high << 32) | low;
+#endif
+}
+
+static CpuSimdLevel cpu_detect_simd_level()
+{
+  int registers[4];
+  cpu_query(0, 0, registers);
+  int maxLeaf = registers[0];
+
+  cpu_query(1, 0, registers);
+  int leaf1Ecx = registers[2];
+  if (!(leaf1Ecx & CPU_LEAF1_ECX_SSE42))
+  {
+    return CPU_SIMD_SCALAR;
+  }
+
+  // The OS has to save the upper halves of the YMM registers on a context
+  // switch or AVX code will have them clobbered.
+  if (!(leaf1Ecx & CPU_LEAF1_ECX_OSXSAVE) || !(leaf1Ecx & CPU_LEAF1_ECX_AVX)
+      || (cpu_get_enabled_state() & CPU_XCR0_SSE_AVX) != CPU_XCR0_SSE_AVX
+      || maxLeaf < 7)
+  {
+    return CPU_SIMD_SSE42;
+  }
+
+  cpu_query(7, 0, registers);
+  if (!(registers[1] & CPU_LEAF7_EBX_AVX2))
+  {
+    return CPU_SIMD_SSE42;
+  }
+
+  return CPU_SIMD_AVX2;
+}
+
+CpuSimdLevel cpu_get_simd_level()
+{
+  // Racing threads all detect the same answer, so no lock is needed.
+  if (g_simdLevel < 0)
+  {
+    g_simdLevel = cpu_detect_simd_level();
+  }
+  return (CpuSimdLevel) g_simdLevel;
+}
+
+const char* cpu_simd_level_name(CpuSimdLevel level)
+{
+  switch (level)
+  {
+  case CPU_SIMD_SCALAR:
+    return "scalar";
+  case CPU_SIMD_SSE42:
+    return "SSE4.2";
+  case CPU_SIMD_AVX2:
+    return "AVX2";
+  default:
+    return "unknown";
+  }
+}
@@ -45,10 +45,87 @@ char* file_load(const char* path, uint64_t* fileLength)
   return text;
 }
 
+bool file_map(const char* path, FileView* view)
+{
+  view->data   = NULL;
+  view->length = 0;
+
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    LOG_ERROR("Failed to open file for mapping: %s", path);
+    return false;
+  }
+
+  LARGE_INTEGER length;
+  if (!GetFileSizeEx(file, &length))
+  {
+    LOG_ERROR("Failed to get file length: %s", path);
+    CloseHandle(file);
+    return false;
+  }
+
+  // Empty files can't be mapped, but there's nothing to read anyway.
+  if (length.QuadPart == 0)
+  {
+    CloseHandle(file);
+    view->data = "";
+    return true;
+  }
+
+  // The view keeps the mapping and the file open on its own, so neither
+  // handle outlives this function.
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+  if (mapping == NULL)
+  {
+    LOG_ERROR("Failed to map file: %s", path);
+    return false;
+  }
+
+  view->data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (view->data == NULL)
+  {
+    LOG_ERROR("Failed to map a view of file: %s", path);
+    return false;
+  }
+
+  view->length = length.QuadPart;
+
+  LOG_DEBUG("Mapped file: %s (%llu)", path, view->length);
+
+  return true;
+}
+
+void file_prefetch(const FileView* view, uint64_t offset, uint64_t length)
+{
+  if (offset >= view->length)
+  {
+    return;
+  }
+
+  WIN32_MEMORY_RANGE_ENTRY range = {
+      .VirtualAddress = (void*) &view->data[offset],
+      .NumberOfBytes  = min(length, view->length - offset)};
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+void file_unmap(FileView* view)
+{
+  if (view->length > 0)
+  {
+    UnmapViewOfFile(view->data);
+  }
+  view->data   = NULL;
+  view->length = 0;
+}
+
 void file_write(const char* path, const char* data, uint64_t length)
 {
   FILE* file;
-  if (fopen_s(&file, path, "w") != 0)
+  if (fopen_s(&file, path, "wb") != 0)
   {
     LOG_ERROR("Failed to open file for writing: %s", path);
     return;
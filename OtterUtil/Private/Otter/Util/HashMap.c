@@ -2,12 +2,23 @@
 
 #include <math.h>
 
+#include "Otter/Util/Memory/MemoryTag.h"
+
 bool hash_map_create(HashMap* map, size_t numOfBuckets, size_t coefficient)
+{
+  return hash_map_create_with_allocator(map, numOfBuckets, coefficient,
+      memory_tag_get_allocator(MEMORY_TAG_HASH_MAP));
+}
+
+bool hash_map_create_with_allocator(HashMap* map, size_t numOfBuckets,
+    size_t coefficient, Allocator* allocator)
 {
   map->numOfBuckets = numOfBuckets;
   map->coefficient  = coefficient;
+  map->allocator    = allocator;
 
-  map->buckets = malloc(numOfBuckets * sizeof(StableAutoArray));
+  map->buckets =
+      allocator_allocate(allocator, numOfBuckets * sizeof(StableAutoArray));
   if (map->buckets == NULL)
   {
     return false;
@@ -15,8 +26,8 @@ bool hash_map_create(HashMap* map, size_t numOfBuckets, size_t coefficient)
 
   for (int i = 0; i < numOfBuckets; i++)
   {
-    stable_auto_array_create(
-        &map->buckets[i], sizeof(KeyValue), SAA_DEFAULT_CHUNK_SIZE);
+    stable_auto_array_create_with_allocator(
+        &map->buckets[i], sizeof(KeyValue), SAA_DEFAULT_CHUNK_SIZE, allocator);
   }
 
   return true;
@@ -29,7 +40,8 @@ void hash_map_destroy(HashMap* map, HashMapDestroyFn destructor)
     for (uint32_t e = 0; e < map->buckets[i].size; e++)
     {
       KeyValue* keyValue = stable_auto_array_get(&map->buckets[i], e);
-      free(keyValue->key.key);
+      allocator_deallocate(
+          map->allocator, keyValue->key.key, keyValue->key.keyLength);
 
       if (destructor != NULL)
       {
@@ -39,7 +51,8 @@ void hash_map_destroy(HashMap* map, HashMapDestroyFn destructor)
 
     stable_auto_array_destroy(&map->buckets[i]);
   }
-  free(map->buckets);
+  allocator_deallocate(map->allocator, map->buckets,
+      map->numOfBuckets * sizeof(StableAutoArray));
 }
 
 static StableAutoArray* hash_map_get_bucket(
@@ -83,7 +96,7 @@ bool hash_map_set_value(
     return false;
   }
 
-  keyValue->key.key = malloc(keyLength);
+  keyValue->key.key = allocator_allocate(map->allocator, keyLength);
   if (keyValue->key.key == NULL)
   {
     return false;
@@ -124,7 +137,7 @@ bool hash_map_set_value_float(
     return false;
   }
 
-  keyValue->key.key = malloc(keyLength);
+  keyValue->key.key = allocator_allocate(map->allocator, keyLength);
   if (keyValue->key.key == NULL)
   {
     return false;
@@ -147,6 +160,16 @@ float hash_map_get_value_float(HashMap* map, const void* key, size_t keyLength)
   return NAN;
 }
 
+const void* hash_map_get_key(HashMap* map, const void* key, size_t keyLength)
+{
+  KeyValue* keyValue = hash_map_get_key_value(map, key, keyLength);
+  if (keyValue != NULL)
+  {
+    return keyValue->key.key;
+  }
+  return NULL;
+}
+
 void hash_map_iterate(HashMap* map, HashMapIterateFn iterator, void* userData)
 {
   for (size_t i = 0; i < map->numOfBuckets; i++)
@@ -0,0 +1,124 @@
+#include "Otter/Util/Histogram.h"
+
+#include "Otter/Util/Cpu.h"
+
+// Values under `HISTOGRAM_SUB_BUCKET_COUNT` each have a bucket. Above that,
+// each power of two gets `HISTOGRAM_SUB_BUCKET_COUNT` buckets of equal width
+// right after the ones before it.
+static inline uint32_t histogram_bucket(uint64_t value)
+{
+  if (value < HISTOGRAM_SUB_BUCKET_COUNT)
+  {
+    return (uint32_t) value;
+  }
+
+  uint32_t highestBit = 63 - cpu_leading_zeros(value);
+  if (highestBit >= HISTOGRAM_MAX_BITS)
+  {
+    return HISTOGRAM_BUCKET_COUNT - 1;
+  }
+
+  uint32_t shift = highestBit - HISTOGRAM_SUB_BUCKET_BITS;
+  return ((shift + 1) << HISTOGRAM_SUB_BUCKET_BITS)
+       + (uint32_t) ((value >> shift) - HISTOGRAM_SUB_BUCKET_COUNT);
+}
+
+// The largest value counted in `bucket`.
+static uint64_t histogram_bucket_highest(uint32_t bucket)
+{
+  if (bucket < HISTOGRAM_SUB_BUCKET_COUNT)
+  {
+    return bucket;
+  }
+  if (bucket == HISTOGRAM_BUCKET_COUNT - 1)
+  {
+    return UINT64_MAX;
+  }
+
+  uint32_t shift = (bucket >> HISTOGRAM_SUB_BUCKET_BITS) - 1;
+  uint64_t lowest =
+      (uint64_t) ((bucket & (HISTOGRAM_SUB_BUCKET_COUNT - 1))
+                  + HISTOGRAM_SUB_BUCKET_COUNT)
+      << shift;
+  return lowest + ((uint64_t) 1 << shift) - 1;
+}
+
+void histogram_clear(Histogram* histogram)
+{
+  memset(histogram, 0, sizeof(Histogram));
+}
+
+void histogram_record(Histogram* histogram, uint64_t value)
+{
+  if (histogram->count == 0 || value < histogram->min)
+  {
+    histogram->min = value;
+  }
+  if (value > histogram->max)
+  {
+    histogram->max = value;
+  }
+  histogram->count++;
+  histogram->total += value;
+  histogram->buckets[histogram_bucket(value)]++;
+}
+
+void histogram_merge(Histogram* into, const Histogram* from)
+{
+  if (from->count == 0)
+  {
+    return;
+  }
+
+  if (into->count == 0 || from->min < into->min)
+  {
+    into->min = from->min;
+  }
+  if (from->max > into->max)
+  {
+    into->max = from->max;
+  }
+  into->count += from->count;
+  into->total += from->total;
+  for (uint32_t i = 0; i < HISTOGRAM_BUCKET_COUNT; i++)
+  {
+    into->buckets[i] += from->buckets[i];
+  }
+}
+
+uint64_t histogram_percentile(const Histogram* histogram, double percentile)
+{
+  if (histogram->count == 0)
+  {
+    return 0;
+  }
+
+  // The first value at or past the percentile, counting from 1.
+  double rank = ceil(percentile / 100.0 * histogram->count);
+  uint64_t target =
+      rank < 1.0 ? 1 : (rank >= histogram->count ? histogram->count : rank);
+
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < HISTOGRAM_BUCKET_COUNT; i++)
+  {
+    seen += histogram->buckets[i];
+    if (seen >= target)
+    {
+      // The exact extremes are known, so buckets never reach past them.
+      uint64_t value = histogram_bucket_highest(i);
+      if (value > histogram->max)
+      {
+        value = histogram->max;
+      }
+      return value < histogram->min ? histogram->min : value;
+    }
+  }
+  return histogram->max;
+}
+
+double histogram_mean(const Histogram* histogram)
+{
+  return histogram->count > 0
+           ? (double) histogram->total / (double) histogram->count
+           : 0.0;
+}
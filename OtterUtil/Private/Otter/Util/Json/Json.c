@@ -4,6 +4,9 @@
 
 #include "Otter/Util/Json/JsonArray.h"
 #include "Otter/Util/Json/JsonObject.h"
+#include "Otter/Util/Json/JsonString.h"
+#include "Otter/Util/Memory/MemoryTag.h"
+#include "Otter/Util/String/Number.h"
 
 // TODO: There are not alot of bounds checks here.
 bool json_get_token(JsonToken* token, const char* document,
@@ -20,8 +23,9 @@ bool json_get_token(JsonToken* token, const char* document,
     return false;
   }
 
-  token->tokenString       = NULL;
-  token->tokenStringLength = 0;
+  token->tokenString        = NULL;
+  token->tokenStringLength  = 0;
+  token->tokenStringEscaped = false;
 
   char tokenStart = document[*cursor];
   *cursor += 1;
@@ -55,6 +59,12 @@ bool json_get_token(JsonToken* token, const char* document,
     token->tokenString = &document[*cursor];
     while (*cursor < documentLength && document[*cursor] != '\"')
     {
+      if (document[*cursor] == '\\' && *cursor + 1 < documentLength)
+      {
+        token->tokenStringEscaped = true;
+        *cursor += 1;
+        token->tokenStringLength += 1;
+      }
       *cursor += 1;
       token->tokenStringLength += 1;
     }
@@ -67,23 +77,26 @@ bool json_get_token(JsonToken* token, const char* document,
   }
   else if (tokenStart == '-' || isdigit(tokenStart))
   {
-    // TODO: Please don't do it like this.
-    char* endOfFloat     = NULL;
-    char* endOfInteger   = NULL;
-    double floatingPoint = strtod(&document[*cursor - 1], &endOfFloat);
-    int64_t integer      = strtoll(&document[*cursor - 1], &endOfInteger, 10);
-    if (endOfFloat > endOfInteger)
+    ParsedNumber number;
+    size_t length = number_parse(
+        &document[*cursor - 1], documentLength - (*cursor - 1), &number);
+    if (length == 0)
+    {
+      token->type = JTT_ERROR;
+      return false;
+    }
+
+    if (number.type == NUMBER_FLOAT)
     {
       token->type       = JTT_FLOAT;
-      token->tokenFloat = floatingPoint;
-      *cursor += (endOfFloat - &document[*cursor - 1]) - 1;
+      token->tokenFloat = number.floatingPoint;
     }
     else
     {
       token->type         = JTT_INTEGER;
-      token->tokenInteger = integer;
-      *cursor += (endOfInteger - &document[*cursor - 1]) - 1;
+      token->tokenInteger = (uint64_t) number.integer;
     }
+    *cursor += length - 1;
   }
   else if (strncmp(&document[*cursor - 1], "true", strlen("true")) == 0)
   {
@@ -155,19 +168,20 @@ void json_peek_token(JsonToken* token, const char* document,
   }
   else if (tokenStart == '-' || isdigit(tokenStart))
   {
-    // TODO: Again, please don't
-    char* endOfFloat     = NULL;
-    char* endOfInteger   = NULL;
-    double floatingPoint = strtod(&document[cursor], &endOfFloat);
-    int64_t integer      = strtoll(&document[cursor], &endOfInteger, 10);
-    if (endOfFloat > endOfInteger)
+    ParsedNumber number;
+    number_parse(&document[cursor], documentLength - cursor, &number);
+    if (number.type == NUMBER_FLOAT)
     {
       token->type = JTT_FLOAT;
     }
-    else
+    else if (number.type == NUMBER_INTEGER)
     {
       token->type = JTT_INTEGER;
     }
+    else
+    {
+      token->type = JTT_ERROR;
+    }
   }
   else if (strncmp(&document[cursor], "true", strlen("true")) == 0)
   {
@@ -189,6 +203,13 @@ void json_peek_token(JsonToken* token, const char* document,
 
 JsonValue* json_parse(
     const char* document, size_t documentLength, size_t* const cursor)
+{
+  return json_parse_with_allocator(document, documentLength, cursor,
+      memory_tag_get_allocator(MEMORY_TAG_JSON));
+}
+
+JsonValue* json_parse_with_allocator(const char* document,
+    size_t documentLength, size_t* const cursor, Allocator* allocator)
 {
   JsonToken token;
   if (!json_get_token(&token, document, documentLength, cursor))
@@ -199,29 +220,31 @@ JsonValue* json_parse(
   switch (token.type)
   {
   case JTT_LDRAGON:
-    return json_parse_object_value(document, documentLength, cursor);
+    return json_parse_object_value(document, documentLength, cursor, allocator);
   case JTT_LBRACKET:
-    return json_parse_array_value(document, documentLength, cursor);
+    return json_parse_array_value(document, documentLength, cursor, allocator);
   case JTT_STRING:
     {
-      JsonValue* stringValue = malloc(sizeof(JsonValue));
+      JsonValue* stringValue = allocator_allocate(allocator, sizeof(JsonValue));
       if (stringValue == NULL)
       {
         return NULL;
       }
-      stringValue->type   = JT_STRING;
-      stringValue->string = malloc(token.tokenStringLength + 1);
-      if (stringValue->string == NULL)
+      stringValue->type       = JT_STRING;
+      stringValue->ownsString = token.tokenStringEscaped;
+      stringValue->string =
+          string_view_create(token.tokenString, token.tokenStringLength);
+      if (token.tokenStringEscaped
+          && !json_unescape_string(&stringValue->string, allocator))
       {
+        allocator_deallocate(allocator, stringValue, sizeof(JsonValue));
         return NULL;
       }
-      strncpy_s(stringValue->string, token.tokenStringLength + 1,
-          token.tokenString, token.tokenStringLength);
       return stringValue;
     }
   case JTT_INTEGER:
     {
-      JsonValue* numberValue = malloc(sizeof(JsonValue));
+      JsonValue* numberValue = allocator_allocate(allocator, sizeof(JsonValue));
       if (numberValue == NULL)
       {
         return NULL;
@@ -232,7 +255,7 @@ JsonValue* json_parse(
     }
   case JTT_FLOAT:
     {
-      JsonValue* numberValue = malloc(sizeof(JsonValue));
+      JsonValue* numberValue = allocator_allocate(allocator, sizeof(JsonValue));
       if (numberValue == NULL)
       {
         return NULL;
@@ -243,7 +266,7 @@ JsonValue* json_parse(
     }
   case JTT_TRUE:
     {
-      JsonValue* boolValue = malloc(sizeof(JsonValue));
+      JsonValue* boolValue = allocator_allocate(allocator, sizeof(JsonValue));
       if (boolValue == NULL)
       {
         return NULL;
@@ -254,7 +277,7 @@ JsonValue* json_parse(
     }
   case JTT_FALSE:
     {
-      JsonValue* boolValue = malloc(sizeof(JsonValue));
+      JsonValue* boolValue = allocator_allocate(allocator, sizeof(JsonValue));
       if (boolValue == NULL)
       {
         return NULL;
@@ -273,6 +296,12 @@ JsonValue* json_parse(
 }
 
 void json_destroy(JsonValue* value)
+{
+  json_destroy_with_allocator(
+      value, memory_tag_get_allocator(MEMORY_TAG_JSON));
+}
+
+void json_destroy_with_allocator(JsonValue* value, Allocator* allocator)
 {
   if (value == NULL)
   {
@@ -288,12 +317,15 @@ void json_destroy(JsonValue* value)
     json_destroy_array(value);
     break;
   case JT_STRING:
-    free(value->string);
+    if (value->ownsString)
+    {
+      allocator_deallocate(
+          allocator, (char*) value->string.data, value->string.length + 1);
+    }
     break;
   default:
     break;
   }
 
-  free(value);
+  allocator_deallocate(allocator, value, sizeof(JsonValue));
 }
-
@@ -2,17 +2,18 @@
 
 #include "Otter/Util/Log.h"
 
-JsonValue* json_parse_array_value(
-    const char* document, size_t documentLength, size_t* const cursor)
+JsonValue* json_parse_array_value(const char* document, size_t documentLength,
+    size_t* const cursor, Allocator* allocator)
 {
-  JsonValue* jsonArray = malloc(sizeof(JsonValue));
+  JsonValue* jsonArray = allocator_allocate(allocator, sizeof(JsonValue));
   if (jsonArray == NULL)
   {
     LOG_ERROR("Out of memory");
     return NULL;
   }
   jsonArray->type = JT_ARRAY;
-  auto_array_create(&jsonArray->array, sizeof(JsonValue*));
+  auto_array_create_with_allocator(
+      &jsonArray->array, sizeof(JsonValue*), allocator);
 
   JsonToken token;
   do
@@ -27,21 +28,22 @@ JsonValue* json_parse_array_value(
     JsonValue** arrayElement = auto_array_allocate(&jsonArray->array);
     if (arrayElement == NULL)
     {
-      json_destroy_array(jsonArray);
+      json_destroy_with_allocator(jsonArray, allocator);
       return NULL;
     }
-    *arrayElement = json_parse(document, documentLength, cursor);
+    *arrayElement =
+        json_parse_with_allocator(document, documentLength, cursor, allocator);
 
     if (!json_get_token(&token, document, documentLength, cursor))
     {
-      json_destroy_array(jsonArray);
+      json_destroy_with_allocator(jsonArray, allocator);
       return NULL;
     }
   } while (token.type == JTT_COMMA);
 
   if (token.type != JTT_RBRACKET)
   {
-    json_destroy_array(jsonArray);
+    json_destroy_with_allocator(jsonArray, allocator);
     return NULL;
   }
 
@@ -52,7 +54,8 @@ void json_destroy_array(JsonValue* value)
 {
   for (uint32_t i = 0; i < value->array.size; i++)
   {
-    json_destroy(*(JsonValue**) auto_array_get(&value->array, i));
+    json_destroy_with_allocator(*(JsonValue**) auto_array_get(&value->array, i),
+        value->array.allocator);
   }
   auto_array_destroy(&value->array);
 }
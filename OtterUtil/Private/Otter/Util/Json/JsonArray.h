@@ -3,6 +3,7 @@
 #include "Otter/Util/Json/Json.h"
 
 JsonValue* json_parse_array_value(
-    const char* document, size_t documentLength, size_t* const cursor);
+    const char* document, size_t documentLength, size_t* const cursor,
+    Allocator* allocator);
 
 void json_destroy_array(JsonValue* value);
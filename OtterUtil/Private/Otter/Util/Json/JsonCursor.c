@@ -0,0 +1,387 @@
+#include "Otter/Util/Json/JsonCursor.h"
+
+#include "Otter/Util/Json/JsonString.h"
+#include "Otter/Util/Log.h"
+#include "Otter/Util/String/Number.h"
+
+// Decoded strings are rare and short, such as a glTF mime type.
+#define JSON_CURSOR_STRINGS_BLOCK_SIZE 1024
+
+static bool json_cursor_fail(JsonCursor* cursor)
+{
+  if (!cursor->failed)
+  {
+    size_t offset = cursor->next < cursor->index.count
+                      ? cursor->index.positions[cursor->next]
+                      : cursor->sourceLength;
+    LOG_WARNING("Malformed JSON near offset %zu.", offset);
+    cursor->failed = true;
+  }
+  return false;
+}
+
+// The first character of the next token, or '\0' at the end of the document
+// or after an error.
+static char json_cursor_peek(JsonCursor* cursor)
+{
+  if (cursor->failed || cursor->next >= cursor->index.count)
+  {
+    return '\0';
+  }
+  return cursor->source[cursor->index.positions[cursor->next]];
+}
+
+static char json_cursor_advance(JsonCursor* cursor, size_t* start)
+{
+  char token = json_cursor_peek(cursor);
+  if (token != '\0')
+  {
+    *start = cursor->index.positions[cursor->next++];
+  }
+  return token;
+}
+
+// A token runs up to the start of the next one, less the whitespace between
+// them. Only valid straight after the token was taken.
+static size_t json_cursor_token_end(JsonCursor* cursor)
+{
+  size_t end = cursor->next < cursor->index.count
+                 ? cursor->index.positions[cursor->next]
+                 : cursor->sourceLength;
+  while (json_is_whitespace(cursor->source[end - 1]))
+  {
+    end--;
+  }
+  return end;
+}
+
+static bool json_cursor_read_string(JsonCursor* cursor, StringView* string)
+{
+  size_t start = 0;
+  if (json_cursor_advance(cursor, &start) != '"')
+  {
+    return json_cursor_fail(cursor);
+  }
+
+  size_t end = json_cursor_token_end(cursor);
+  if (end < start + 2 || cursor->source[end - 1] != '"')
+  {
+    return json_cursor_fail(cursor);
+  }
+
+  *string = string_view_create(&cursor->source[start + 1], end - start - 2);
+  return true;
+}
+
+static bool json_cursor_read_number(JsonCursor* cursor, ParsedNumber* number)
+{
+  char token = json_cursor_peek(cursor);
+  if (token != '-' && (token < '0' || token > '9'))
+  {
+    json_cursor_skip(cursor);
+    return false;
+  }
+
+  size_t start = 0;
+  json_cursor_advance(cursor, &start);
+  size_t length = json_cursor_token_end(cursor) - start;
+  if (number_parse(&cursor->source[start], length, number) != length)
+  {
+    return json_cursor_fail(cursor);
+  }
+  return true;
+}
+
+static bool json_cursor_read_literal(JsonCursor* cursor, const char* literal)
+{
+  size_t start = 0;
+  json_cursor_advance(cursor, &start);
+
+  StringView token = string_view_create(
+      &cursor->source[start], json_cursor_token_end(cursor) - start);
+  return string_view_equals_cstr(token, literal) || json_cursor_fail(cursor);
+}
+
+bool json_cursor_create(JsonCursor* cursor, const char* source,
+    size_t sourceLength, Allocator* allocator)
+{
+  if (!json_structural_index_build(&cursor->index, source, sourceLength,
+          cpu_get_simd_level(), allocator))
+  {
+    return false;
+  }
+
+  cursor->source         = source;
+  cursor->sourceLength   = sourceLength;
+  cursor->next           = 0;
+  cursor->containerStart = false;
+  cursor->failed         = false;
+  cursor->allocator      = allocator;
+  cursor->hasStrings     = false;
+  return true;
+}
+
+void json_cursor_destroy(JsonCursor* cursor)
+{
+  json_structural_index_destroy(&cursor->index);
+  if (cursor->hasStrings)
+  {
+    arena_destroy(&cursor->strings);
+  }
+}
+
+bool json_cursor_finish(JsonCursor* cursor)
+{
+  if (!cursor->failed && cursor->next != cursor->index.count)
+  {
+    json_cursor_fail(cursor);
+  }
+  return !cursor->failed;
+}
+
+bool json_cursor_peek_type(JsonCursor* cursor, enum JsonType* type)
+{
+  switch (json_cursor_peek(cursor))
+  {
+  case '{':
+    *type = JT_OBJECT;
+    return true;
+  case '[':
+    *type = JT_ARRAY;
+    return true;
+  case '"':
+    *type = JT_STRING;
+    return true;
+  case 't':
+  case 'f':
+    *type = JT_BOOLEAN;
+    return true;
+  case 'n':
+    *type = JT_NULL;
+    return true;
+  case '\0':
+    return false;
+  default:
+    {
+      size_t start = cursor->index.positions[cursor->next];
+      size_t end   = cursor->next + 1 < cursor->index.count
+                       ? cursor->index.positions[cursor->next + 1]
+                       : cursor->sourceLength;
+      ParsedNumber number;
+      if (number_parse(&cursor->source[start], end - start, &number) == 0)
+      {
+        return false;
+      }
+      *type = number.type == NUMBER_INTEGER ? JT_INTEGER : JT_FLOAT;
+      return true;
+    }
+  }
+}
+
+bool json_cursor_enter_object(JsonCursor* cursor)
+{
+  if (json_cursor_peek(cursor) != '{')
+  {
+    json_cursor_skip(cursor);
+    return false;
+  }
+
+  size_t start = 0;
+  json_cursor_advance(cursor, &start);
+  cursor->containerStart = true;
+  return true;
+}
+
+bool json_cursor_next_member(JsonCursor* cursor, StringView* key)
+{
+  size_t start = 0;
+  if (cursor->containerStart)
+  {
+    cursor->containerStart = false;
+    if (json_cursor_peek(cursor) == '}')
+    {
+      json_cursor_advance(cursor, &start);
+      return false;
+    }
+  }
+  else
+  {
+    char token = json_cursor_advance(cursor, &start);
+    if (token == '}')
+    {
+      return false;
+    }
+    if (token != ',')
+    {
+      return json_cursor_fail(cursor);
+    }
+  }
+
+  if (!json_cursor_read_string(cursor, key))
+  {
+    return false;
+  }
+  return json_cursor_advance(cursor, &start) == ':'
+      || json_cursor_fail(cursor);
+}
+
+bool json_cursor_enter_array(JsonCursor* cursor)
+{
+  if (json_cursor_peek(cursor) != '[')
+  {
+    json_cursor_skip(cursor);
+    return false;
+  }
+
+  size_t start = 0;
+  json_cursor_advance(cursor, &start);
+  cursor->containerStart = true;
+  return true;
+}
+
+bool json_cursor_next_element(JsonCursor* cursor)
+{
+  size_t start = 0;
+  if (cursor->containerStart)
+  {
+    cursor->containerStart = false;
+    if (json_cursor_peek(cursor) == ']')
+    {
+      json_cursor_advance(cursor, &start);
+      return false;
+    }
+  }
+  else
+  {
+    char token = json_cursor_advance(cursor, &start);
+    if (token == ']')
+    {
+      return false;
+    }
+    if (token != ',')
+    {
+      return json_cursor_fail(cursor);
+    }
+  }
+
+  char next = json_cursor_peek(cursor);
+  if (next == ']' || next == '\0')
+  {
+    return json_cursor_fail(cursor);
+  }
+  return true;
+}
+
+bool json_cursor_skip(JsonCursor* cursor)
+{
+  size_t start   = 0;
+  uint32_t depth = 0;
+  do
+  {
+    switch (json_cursor_advance(cursor, &start))
+    {
+    case '{':
+    case '[':
+      depth++;
+      break;
+    case '}':
+    case ']':
+      if (depth == 0)
+      {
+        return json_cursor_fail(cursor);
+      }
+      depth--;
+      break;
+    case ',':
+    case ':':
+      if (depth == 0)
+      {
+        return json_cursor_fail(cursor);
+      }
+      break;
+    case '\0':
+      return json_cursor_fail(cursor);
+    default:
+      break;
+    }
+  } while (depth > 0);
+
+  return true;
+}
+
+bool json_cursor_get_integer(JsonCursor* cursor, int64_t* value)
+{
+  ParsedNumber number;
+  if (!json_cursor_read_number(cursor, &number)
+      || number.type != NUMBER_INTEGER)
+  {
+    return false;
+  }
+
+  *value = number.integer;
+  return true;
+}
+
+bool json_cursor_get_number(JsonCursor* cursor, double* value)
+{
+  ParsedNumber number;
+  if (!json_cursor_read_number(cursor, &number))
+  {
+    return false;
+  }
+
+  *value = number.type == NUMBER_INTEGER ? (double) number.integer
+                                         : number.floatingPoint;
+  return true;
+}
+
+bool json_cursor_get_string(JsonCursor* cursor, StringView* value)
+{
+  if (json_cursor_peek(cursor) != '"')
+  {
+    json_cursor_skip(cursor);
+    return false;
+  }
+  return json_cursor_read_string(cursor, value);
+}
+
+bool json_cursor_get_unescaped_string(JsonCursor* cursor, StringView* value)
+{
+  if (!json_cursor_get_string(cursor, value))
+  {
+    return false;
+  }
+  if (memchr(value->data, '\\', value->length) == NULL)
+  {
+    return true;
+  }
+
+  if (!cursor->hasStrings)
+  {
+    if (!arena_create(&cursor->strings, JSON_CURSOR_STRINGS_BLOCK_SIZE,
+            cursor->allocator))
+    {
+      return json_cursor_fail(cursor);
+    }
+    cursor->hasStrings = true;
+  }
+
+  if (!json_unescape_string(value, &cursor->strings.allocator))
+  {
+    return json_cursor_fail(cursor);
+  }
+  return true;
+}
+
+bool json_cursor_get_boolean(JsonCursor* cursor, bool* value)
+{
+  char token = json_cursor_peek(cursor);
+  if (token != 't' && token != 'f')
+  {
+    json_cursor_skip(cursor);
+    return false;
+  }
+
+  *value = token == 't';
+  return json_cursor_read_literal(cursor, *value ? "true" : "false");
+}
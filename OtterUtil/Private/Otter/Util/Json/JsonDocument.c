@@ -0,0 +1,447 @@
+#include "Otter/Util/Json/JsonDocument.h"
+
+#include "Otter/Util/Array/TypedArray.h"
+#include "Otter/Util/Hash.h"
+#include "Otter/Util/HashMap.h"
+#include "Otter/Util/Json/JsonString.h"
+#include "Otter/Util/Json/JsonStructural.h"
+#include "Otter/Util/Log.h"
+#include "Otter/Util/Memory/MemoryTag.h"
+#include "Otter/Util/String/Number.h"
+
+TYPED_ARRAY_DEFINE(JsonNodeStack, json_node_stack, JsonNode);
+TYPED_ARRAY_DEFINE(JsonMemberStack, json_member_stack, JsonMember);
+
+// Tokens are visited straight from the structural index, so the only
+// characters looked at again are those of strings, numbers and literals.
+//
+// Children are collected on the stacks while their container is open and
+// moved into the arena in one piece when it closes. Nested containers push
+// on top and have popped their children again by the time the parent pushes
+// its next one.
+typedef struct JsonDocumentParser
+{
+  const char* source;
+  size_t sourceLength;
+  const uint32_t* positions;
+  size_t positionCount;
+  size_t next;
+  Arena* arena;
+  JsonNodeStack elements;
+  JsonMemberStack members;
+  uint32_t depth;
+} JsonDocumentParser;
+
+static bool json_document_parse_value(
+    JsonDocumentParser* parser, char token, size_t start, JsonNode* node);
+
+// Move to the next token. Returns its first character, or '\0' once the
+// document runs out.
+static char json_document_next_token(JsonDocumentParser* parser, size_t* start)
+{
+  if (parser->next >= parser->positionCount)
+  {
+    return '\0';
+  }
+
+  *start = parser->positions[parser->next++];
+  return parser->source[*start];
+}
+
+// A token runs up to the start of the next one, less the whitespace between
+// them. Only valid straight after the token was taken.
+static size_t json_document_token_end(JsonDocumentParser* parser)
+{
+  size_t end = parser->next < parser->positionCount
+                 ? parser->positions[parser->next]
+                 : parser->sourceLength;
+  while (json_is_whitespace(parser->source[end - 1]))
+  {
+    end--;
+  }
+  return end;
+}
+
+static size_t json_object_index_size(uint32_t length)
+{
+  size_t size = 1;
+  while (size < (size_t) length * 2)
+  {
+    size *= 2;
+  }
+  return size;
+}
+
+static size_t json_object_hash(StringView key)
+{
+  // hash_key pushes the early characters into the high bits, so fold them
+  // back down before the hash gets masked.
+  size_t hash = hash_key(key.data, key.length, HASH_MAP_DEFAULT_COEF);
+  return hash ^ (hash >> (sizeof(size_t) * 4));
+}
+
+// The index of a large object sits directly after its members.
+static uint32_t* json_object_get_index(JsonNode* object)
+{
+  return (uint32_t*) &object->members[object->length];
+}
+
+// Open addressing with linear probing. Slots hold a member index plus one so
+// that zero marks an empty slot. Earlier members are inserted first, so a
+// duplicate key resolves to its first occurrence just like a scan would.
+static void json_object_build_index(JsonNode* object)
+{
+  uint32_t* index = json_object_get_index(object);
+  size_t mask     = json_object_index_size(object->length) - 1;
+  memset(index, 0, (mask + 1) * sizeof(uint32_t));
+
+  for (uint32_t i = 0; i < object->length; i++)
+  {
+    size_t slot = json_object_hash(object->members[i].key) & mask;
+    while (index[slot] != 0)
+    {
+      slot = (slot + 1) & mask;
+    }
+    index[slot] = i + 1;
+  }
+}
+
+static bool json_document_parse_string(
+    JsonDocumentParser* parser, size_t start, StringView* string)
+{
+  // The index only ends a string token after its closing quote, but a quote
+  // directly followed by a number or literal still has to be caught here.
+  size_t end = json_document_token_end(parser);
+  if (end < start + 2 || parser->source[end - 1] != '"')
+  {
+    return false;
+  }
+
+  const char* data = &parser->source[start + 1];
+  size_t length    = end - start - 2;
+  *string          = string_view_create(data, length);
+  return memchr(data, '\\', length) == NULL
+      || json_unescape_string(string, &parser->arena->allocator);
+}
+
+static bool json_document_parse_number(
+    JsonDocumentParser* parser, size_t start, JsonNode* node)
+{
+  size_t length = json_document_token_end(parser) - start;
+
+  ParsedNumber number;
+  if (number_parse(&parser->source[start], length, &number) != length)
+  {
+    return false;
+  }
+
+  node->length = 0;
+  if (number.type == NUMBER_FLOAT)
+  {
+    node->type          = JT_FLOAT;
+    node->floatingPoint = number.floatingPoint;
+  }
+  else
+  {
+    node->type    = JT_INTEGER;
+    node->integer = number.integer;
+  }
+  return true;
+}
+
+static bool json_document_token_equals(
+    JsonDocumentParser* parser, size_t start, const char* literal)
+{
+  StringView token = string_view_create(
+      &parser->source[start], json_document_token_end(parser) - start);
+  return string_view_equals_cstr(token, literal);
+}
+
+static bool json_document_close_array(
+    JsonDocumentParser* parser, JsonNode* node, size_t start)
+{
+  size_t count   = parser->elements.size - start;
+  node->type     = JT_ARRAY;
+  node->length   = (uint32_t) count;
+  node->elements = NULL;
+  if (count == 0)
+  {
+    return true;
+  }
+
+  node->elements = arena_allocate(parser->arena, count * sizeof(JsonNode));
+  if (node->elements == NULL)
+  {
+    return false;
+  }
+  memcpy(node->elements, json_node_stack_get(&parser->elements, start),
+      count * sizeof(JsonNode));
+  json_node_stack_pop_many(&parser->elements, count);
+  return true;
+}
+
+static bool json_document_parse_array(
+    JsonDocumentParser* parser, JsonNode* node)
+{
+  size_t start = parser->elements.size;
+
+  size_t offset = 0;
+  char token    = json_document_next_token(parser, &offset);
+  while (token != ']')
+  {
+    JsonNode element;
+    if (!json_document_parse_value(parser, token, offset, &element))
+    {
+      return false;
+    }
+
+    if (!json_node_stack_push(&parser->elements, element))
+    {
+      return false;
+    }
+
+    token = json_document_next_token(parser, &offset);
+    if (token == ',')
+    {
+      token = json_document_next_token(parser, &offset);
+      if (token == ']')
+      {
+        return false;
+      }
+    }
+    else if (token != ']')
+    {
+      return false;
+    }
+  }
+
+  return json_document_close_array(parser, node, start);
+}
+
+static bool json_document_close_object(
+    JsonDocumentParser* parser, JsonNode* node, size_t start)
+{
+  size_t count  = parser->members.size - start;
+  node->type    = JT_OBJECT;
+  node->length  = (uint32_t) count;
+  node->members = NULL;
+  if (count == 0)
+  {
+    return true;
+  }
+
+  size_t size = count * sizeof(JsonMember);
+  if (count > JSON_OBJECT_INDEX_THRESHOLD)
+  {
+    size += json_object_index_size(node->length) * sizeof(uint32_t);
+  }
+
+  node->members = arena_allocate(parser->arena, size);
+  if (node->members == NULL)
+  {
+    return false;
+  }
+  memcpy(node->members, json_member_stack_get(&parser->members, start),
+      count * sizeof(JsonMember));
+  json_member_stack_pop_many(&parser->members, count);
+
+  if (count > JSON_OBJECT_INDEX_THRESHOLD)
+  {
+    json_object_build_index(node);
+  }
+  return true;
+}
+
+static bool json_document_parse_object(
+    JsonDocumentParser* parser, JsonNode* node)
+{
+  size_t start = parser->members.size;
+
+  size_t offset = 0;
+  char token    = json_document_next_token(parser, &offset);
+  while (token != '}')
+  {
+    JsonMember member;
+    if (token != '"'
+        || !json_document_parse_string(parser, offset, &member.key))
+    {
+      return false;
+    }
+
+    if (json_document_next_token(parser, &offset) != ':')
+    {
+      return false;
+    }
+    token = json_document_next_token(parser, &offset);
+    if (!json_document_parse_value(parser, token, offset, &member.value))
+    {
+      return false;
+    }
+
+    if (!json_member_stack_push(&parser->members, member))
+    {
+      return false;
+    }
+
+    token = json_document_next_token(parser, &offset);
+    if (token == ',')
+    {
+      token = json_document_next_token(parser, &offset);
+      if (token == '}')
+      {
+        return false;
+      }
+    }
+    else if (token != '}')
+    {
+      return false;
+    }
+  }
+
+  return json_document_close_object(parser, node, start);
+}
+
+static bool json_document_parse_value(
+    JsonDocumentParser* parser, char token, size_t start, JsonNode* node)
+{
+  switch (token)
+  {
+  case '{':
+  case '[':
+    {
+      if (parser->depth >= JSON_DOCUMENT_MAX_DEPTH)
+      {
+        LOG_WARNING("JSON is nested deeper than %d levels.",
+            JSON_DOCUMENT_MAX_DEPTH);
+        return false;
+      }
+
+      parser->depth += 1;
+      bool result = token == '{' ? json_document_parse_object(parser, node)
+                                 : json_document_parse_array(parser, node);
+      parser->depth -= 1;
+      return result;
+    }
+  case '"':
+    {
+      StringView string;
+      if (!json_document_parse_string(parser, start, &string))
+      {
+        return false;
+      }
+      node->type   = JT_STRING;
+      node->length = (uint32_t) string.length;
+      node->string = string.data;
+      return true;
+    }
+  case 't':
+  case 'f':
+    node->type    = JT_BOOLEAN;
+    node->length  = 0;
+    node->boolean = token == 't';
+    return json_document_token_equals(
+        parser, start, node->boolean ? "true" : "false");
+  case 'n':
+    node->type    = JT_NULL;
+    node->length  = 0;
+    node->integer = 0;
+    return json_document_token_equals(parser, start, "null");
+  default:
+    if (token == '-' || (token >= '0' && token <= '9'))
+    {
+      return json_document_parse_number(parser, start, node);
+    }
+    return false;
+  }
+}
+
+bool json_document_parse(JsonDocument* document, const char* source,
+    size_t sourceLength, Allocator* allocator)
+{
+  if (allocator == NULL)
+  {
+    allocator = memory_tag_get_allocator(MEMORY_TAG_JSON);
+  }
+
+  JsonStructuralIndex index;
+  if (!json_structural_index_build(
+          &index, source, sourceLength, cpu_get_simd_level(), allocator))
+  {
+    return false;
+  }
+
+  // Size the first block from the source so even large documents only take
+  // a few blocks.
+  if (!arena_create(&document->arena,
+          max(sourceLength, ARENA_DEFAULT_BLOCK_SIZE), allocator))
+  {
+    json_structural_index_destroy(&index);
+    return false;
+  }
+
+  JsonDocumentParser parser;
+  parser.source        = source;
+  parser.sourceLength  = sourceLength;
+  parser.positions     = index.positions;
+  parser.positionCount = index.count;
+  parser.next          = 0;
+  parser.arena         = &document->arena;
+  parser.depth         = 0;
+  json_node_stack_create(&parser.elements);
+  json_member_stack_create(&parser.members);
+
+  size_t offset = 0;
+  char token    = json_document_next_token(&parser, &offset);
+  bool result =
+      json_document_parse_value(&parser, token, offset, &document->root)
+      && parser.next == parser.positionCount;
+
+  json_node_stack_destroy(&parser.elements);
+  json_member_stack_destroy(&parser.members);
+  json_structural_index_destroy(&index);
+
+  if (!result)
+  {
+    arena_destroy(&document->arena);
+  }
+  return result;
+}
+
+void json_document_destroy(JsonDocument* document)
+{
+  arena_destroy(&document->arena);
+}
+
+JsonNode* json_node_find_member(JsonNode* object, StringView key)
+{
+  if (object->type != JT_OBJECT)
+  {
+    return NULL;
+  }
+
+  if (object->length <= JSON_OBJECT_INDEX_THRESHOLD)
+  {
+    for (uint32_t i = 0; i < object->length; i++)
+    {
+      if (string_view_equals(object->members[i].key, key))
+      {
+        return &object->members[i].value;
+      }
+    }
+    return NULL;
+  }
+
+  uint32_t* index = json_object_get_index(object);
+  size_t mask     = json_object_index_size(object->length) - 1;
+  size_t slot     = json_object_hash(key) & mask;
+  while (index[slot] != 0)
+  {
+    JsonMember* member = &object->members[index[slot] - 1];
+    if (string_view_equals(member->key, key))
+    {
+      return &member->value;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return NULL;
+}
@@ -1,19 +1,19 @@
 #include "Otter/Util/Json/JsonObject.h"
 
-JsonValue* json_parse_object_value(
-    const char* document, size_t documentLength, size_t* const cursor)
+JsonValue* json_parse_object_value(const char* document, size_t documentLength,
+    size_t* const cursor, Allocator* allocator)
 {
-  JsonValue* jsonObject = malloc(sizeof(JsonValue));
+  JsonValue* jsonObject = allocator_allocate(allocator, sizeof(JsonValue));
   if (jsonObject == NULL)
   {
     LOG_ERROR("Out of memory");
     return NULL;
   }
   jsonObject->type = JT_OBJECT;
-  if (!hash_map_create(
-          &jsonObject->object, HASH_MAP_DEFAULT_BUCKETS, HASH_MAP_DEFAULT_COEF))
+  if (!hash_map_create_with_allocator(&jsonObject->object,
+          HASH_MAP_DEFAULT_BUCKETS, HASH_MAP_DEFAULT_COEF, allocator))
   {
-    free(jsonObject);
+    allocator_deallocate(allocator, jsonObject, sizeof(JsonValue));
     return NULL;
   }
 
@@ -27,7 +27,7 @@ JsonValue* json_parse_object_value(
       if (token.type != JTT_COMMA
           || !json_get_token(&token, document, documentLength, cursor))
       {
-        json_destroy_object(jsonObject);
+        json_destroy_with_allocator(jsonObject, allocator);
         return NULL;
       }
     }
@@ -35,48 +35,50 @@ JsonValue* json_parse_object_value(
 
     if (token.type != JTT_STRING)
     {
-      json_destroy_object(jsonObject);
+      json_destroy_with_allocator(jsonObject, allocator);
       return NULL;
     }
-    char* key = malloc(token.tokenStringLength + 1);
-    if (key == NULL)
-    {
-      json_destroy_object(jsonObject);
-      return NULL;
-    }
-    strncpy_s(key, token.tokenStringLength + 1, token.tokenString,
-        token.tokenStringLength);
+
+    // The map keeps its own copy of the key so it can point into the document.
+    const char* key  = token.tokenString;
+    size_t keyLength = token.tokenStringLength;
 
     if (!json_get_token(&token, document, documentLength, cursor)
         || token.type != JTT_COLON)
     {
-      json_destroy_object(jsonObject);
-      free(key);
+      json_destroy_with_allocator(jsonObject, allocator);
       return NULL;
     }
 
-    JsonValue* value = json_parse(document, documentLength, cursor);
+    JsonValue* value =
+        json_parse_with_allocator(document, documentLength, cursor, allocator);
     if (value == NULL)
     {
-      json_destroy_object(jsonObject);
-      free(key);
+      json_destroy_with_allocator(jsonObject, allocator);
       return NULL;
     }
 
-    hash_map_set_value(&jsonObject->object, key, strlen(key), value);
-    free(key);
+    hash_map_set_value(&jsonObject->object, key, keyLength, value);
   }
 
   if (token.type == JTT_ERROR)
   {
-    json_destroy_object(jsonObject);
+    json_destroy_with_allocator(jsonObject, allocator);
     return NULL;
   }
 
   return jsonObject;
 }
 
+static void json_destroy_object_value(
+    void* key, size_t keyLength, void* value, void* allocator)
+{
+  json_destroy_with_allocator(value, allocator);
+}
+
 void json_destroy_object(JsonValue* value)
 {
-  hash_map_destroy(&value->object, (void (*)(void*)) json_destroy);
+  hash_map_iterate(
+      &value->object, json_destroy_object_value, value->object.allocator);
+  hash_map_destroy(&value->object, NULL);
 }
@@ -0,0 +1,119 @@
+#include "Otter/Util/Json/JsonString.h"
+
+#include "Otter/Util/String/StringBuilder.h"
+
+static void json_append_utf8(StringBuilder* builder, uint32_t codePoint)
+{
+  if (codePoint < 0x80)
+  {
+    string_builder_append_char(builder, (char) codePoint);
+  }
+  else if (codePoint < 0x800)
+  {
+    string_builder_append_char(builder, (char) (0xC0 | (codePoint >> 6)));
+    string_builder_append_char(builder, (char) (0x80 | (codePoint & 0x3F)));
+  }
+  else if (codePoint < 0x10000)
+  {
+    string_builder_append_char(builder, (char) (0xE0 | (codePoint >> 12)));
+    string_builder_append_char(
+        builder, (char) (0x80 | ((codePoint >> 6) & 0x3F)));
+    string_builder_append_char(builder, (char) (0x80 | (codePoint & 0x3F)));
+  }
+  else
+  {
+    string_builder_append_char(builder, (char) (0xF0 | (codePoint >> 18)));
+    string_builder_append_char(
+        builder, (char) (0x80 | ((codePoint >> 12) & 0x3F)));
+    string_builder_append_char(
+        builder, (char) (0x80 | ((codePoint >> 6) & 0x3F)));
+    string_builder_append_char(builder, (char) (0x80 | (codePoint & 0x3F)));
+  }
+}
+
+static bool json_parse_hex(StringView string, size_t index, uint32_t* value)
+{
+  if (index + 4 > string.length)
+  {
+    return false;
+  }
+
+  *value = 0;
+  for (size_t i = index; i < index + 4; i++)
+  {
+    char c = string.data[i];
+    if (!isxdigit(c))
+    {
+      return false;
+    }
+    *value = (*value << 4)
+           | (uint32_t) (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+  }
+  return true;
+}
+
+bool json_unescape_string(StringView* string, Allocator* allocator)
+{
+  StringBuilder builder;
+  string_builder_create(&builder, allocator);
+
+  for (size_t i = 0; i < string->length; i++)
+  {
+    char c = string->data[i];
+    if (c != '\\' || i + 1 >= string->length)
+    {
+      string_builder_append_char(&builder, c);
+      continue;
+    }
+
+    c = string->data[++i];
+    switch (c)
+    {
+    case 'b':
+      string_builder_append_char(&builder, '\b');
+      break;
+    case 'f':
+      string_builder_append_char(&builder, '\f');
+      break;
+    case 'n':
+      string_builder_append_char(&builder, '\n');
+      break;
+    case 'r':
+      string_builder_append_char(&builder, '\r');
+      break;
+    case 't':
+      string_builder_append_char(&builder, '\t');
+      break;
+    case 'u':
+      {
+        uint32_t codePoint;
+        if (!json_parse_hex(*string, i + 1, &codePoint))
+        {
+          string_builder_destroy(&builder);
+          return false;
+        }
+        i += 4;
+
+        uint32_t lowSurrogate;
+        if (codePoint >= 0xD800 && codePoint < 0xDC00 && i + 2 < string->length
+            && string->data[i + 1] == '\\' && string->data[i + 2] == 'u'
+            && json_parse_hex(*string, i + 3, &lowSurrogate)
+            && lowSurrogate >= 0xDC00 && lowSurrogate < 0xE000)
+        {
+          codePoint =
+              0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+          i += 6;
+        }
+        json_append_utf8(&builder, codePoint);
+      }
+      break;
+    default:
+      // Covers \", \\ and \/.
+      string_builder_append_char(&builder, c);
+      break;
+    }
+  }
+
+  *string = string_builder_finish(&builder);
+  return string->data != NULL;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Otter/Util/Memory/Allocator.h"
+#include "Otter/Util/String/StringView.h"
+
+/**
+ * @brief Replace `string` with a copy that has its escape sequences decoded.
+ * The copy is `string->length + 1` bytes from `allocator`.
+ */
+bool json_unescape_string(StringView* string, Allocator* allocator);
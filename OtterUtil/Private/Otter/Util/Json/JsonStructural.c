@@ -0,0 +1,366 @@
+#include "Otter/Util/Json/JsonStructural.h"
+
+#include <immintrin.h>
+
+#include "Otter/Util/Log.h"
+
+#define JSON_CLASS_QUOTE      0x1
+#define JSON_CLASS_BACKSLASH  0x2
+#define JSON_CLASS_STRUCTURAL 0x4
+#define JSON_CLASS_WHITESPACE 0x8
+
+#define JSON_EVEN_BITS 0x5555555555555555ULL
+
+// Bit i of each mask describes byte i of the block.
+typedef struct JsonBlockMasks
+{
+  uint64_t quote;
+  uint64_t backslash;
+  uint64_t structural;
+  uint64_t whitespace;
+} JsonBlockMasks;
+
+// What carries over from one block into the next.
+typedef struct JsonScanState
+{
+  uint64_t previousEscaped;
+  uint64_t previousInString;
+  uint64_t previousScalar;
+} JsonScanState;
+
+typedef void (*JsonClassifyFunction)(const char* block, JsonBlockMasks* masks);
+
+static const uint8_t g_jsonCharacterClass[256] = {
+    ['"']  = JSON_CLASS_QUOTE,
+    ['\\'] = JSON_CLASS_BACKSLASH,
+    ['{']  = JSON_CLASS_STRUCTURAL,
+    ['}']  = JSON_CLASS_STRUCTURAL,
+    ['[']  = JSON_CLASS_STRUCTURAL,
+    [']']  = JSON_CLASS_STRUCTURAL,
+    [':']  = JSON_CLASS_STRUCTURAL,
+    [',']  = JSON_CLASS_STRUCTURAL,
+    [' ']  = JSON_CLASS_WHITESPACE,
+    ['\t'] = JSON_CLASS_WHITESPACE,
+    ['\n'] = JSON_CLASS_WHITESPACE,
+    ['\r'] = JSON_CLASS_WHITESPACE,
+};
+
+static void json_classify_scalar(const char* block, JsonBlockMasks* masks)
+{
+  masks->quote      = 0;
+  masks->backslash  = 0;
+  masks->structural = 0;
+  masks->whitespace = 0;
+
+  for (uint32_t i = 0; i < JSON_STRUCTURAL_BLOCK_SIZE; i++)
+  {
+    uint8_t characterClass = g_jsonCharacterClass[(uint8_t) block[i]];
+    uint64_t bit           = 1ULL << i;
+    if (characterClass & JSON_CLASS_QUOTE)
+    {
+      masks->quote |= bit;
+    }
+    if (characterClass & JSON_CLASS_BACKSLASH)
+    {
+      masks->backslash |= bit;
+    }
+    if (characterClass & JSON_CLASS_STRUCTURAL)
+    {
+      masks->structural |= bit;
+    }
+    if (characterClass & JSON_CLASS_WHITESPACE)
+    {
+      masks->whitespace |= bit;
+    }
+  }
+}
+
+CPU_TARGET_SSE42 static void json_classify_sse42(
+    const char* block, JsonBlockMasks* masks)
+{
+  const __m128i structuralSet = _mm_setr_epi8(
+      '{', '}', '[', ']', ':', ',', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i whitespaceSet = _mm_setr_epi8(
+      ' ', '\t', '\n', '\r', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i quote     = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+
+  masks->quote      = 0;
+  masks->backslash  = 0;
+  masks->structural = 0;
+  masks->whitespace = 0;
+
+  for (uint32_t i = 0; i < JSON_STRUCTURAL_BLOCK_SIZE; i += 16)
+  {
+    __m128i chunk = _mm_loadu_si128((const __m128i*) &block[i]);
+
+    // Explicit lengths keep a NUL in the document from ending the compare.
+    __m128i structural = _mm_cmpestrm(structuralSet, 6, chunk, 16,
+        _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK);
+    __m128i whitespace = _mm_cmpestrm(whitespaceSet, 4, chunk, 16,
+        _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK);
+
+    uint64_t quoteBits =
+        (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote));
+    uint64_t backslashBits =
+        (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash));
+    uint64_t structuralBits = (uint16_t) _mm_cvtsi128_si32(structural);
+    uint64_t whitespaceBits = (uint16_t) _mm_cvtsi128_si32(whitespace);
+
+    masks->quote |= quoteBits << i;
+    masks->backslash |= backslashBits << i;
+    masks->structural |= structuralBits << i;
+    masks->whitespace |= whitespaceBits << i;
+  }
+}
+
+CPU_TARGET_AVX2 static uint64_t json_movemask_avx2(__m256i low, __m256i high)
+{
+  return (uint64_t) (uint32_t) _mm256_movemask_epi8(low)
+       | (uint64_t) (uint32_t) _mm256_movemask_epi8(high) << 32;
+}
+
+CPU_TARGET_AVX2 static __m256i json_structural_avx2(__m256i chunk)
+{
+  // Setting 0x20 folds '[' onto '{' and ']' onto '}' so four compares find
+  // all six structural characters.
+  __m256i folded = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+  return _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')),
+          _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+      _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(':')),
+          _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(','))));
+}
+
+CPU_TARGET_AVX2 static __m256i json_whitespace_avx2(__m256i chunk)
+{
+  return _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+          _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t'))),
+      _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')),
+          _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\r'))));
+}
+
+CPU_TARGET_AVX2 static void json_classify_avx2(
+    const char* block, JsonBlockMasks* masks)
+{
+  __m256i low  = _mm256_loadu_si256((const __m256i*) block);
+  __m256i high = _mm256_loadu_si256((const __m256i*) &block[32]);
+
+  __m256i quote     = _mm256_set1_epi8('"');
+  __m256i backslash = _mm256_set1_epi8('\\');
+
+  masks->quote = json_movemask_avx2(
+      _mm256_cmpeq_epi8(low, quote), _mm256_cmpeq_epi8(high, quote));
+  masks->backslash = json_movemask_avx2(
+      _mm256_cmpeq_epi8(low, backslash), _mm256_cmpeq_epi8(high, backslash));
+  masks->structural =
+      json_movemask_avx2(json_structural_avx2(low), json_structural_avx2(high));
+  masks->whitespace =
+      json_movemask_avx2(json_whitespace_avx2(low), json_whitespace_avx2(high));
+}
+
+// Characters escaped by a backslash. Only an odd run of backslashes escapes
+// the character after it, so runs are split by whether they start on an even
+// or odd bit and the carry out of the add tracks runs crossing blocks.
+static uint64_t json_find_escaped(uint64_t backslash, uint64_t* previousEscaped)
+{
+  backslash &= ~*previousEscaped;
+  uint64_t followsEscape     = backslash << 1 | *previousEscaped;
+  uint64_t oddSequenceStarts = backslash & ~JSON_EVEN_BITS & ~followsEscape;
+
+  uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+  *previousEscaped = sequencesStartingOnEvenBits < oddSequenceStarts;
+
+  uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+  return (JSON_EVEN_BITS ^ invertMask) & followsEscape;
+}
+
+// Bit i of the result is the XOR of bits 0 through i.
+static uint64_t json_prefix_xor(uint64_t bits)
+{
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+static uint64_t json_find_token_starts(
+    JsonScanState* state, const JsonBlockMasks* masks)
+{
+  uint64_t escaped =
+      json_find_escaped(masks->backslash, &state->previousEscaped);
+  uint64_t quote = masks->quote & ~escaped;
+
+  // Set from an opening quote up to, but not including, its closing quote.
+  uint64_t inString       = json_prefix_xor(quote) ^ state->previousInString;
+  state->previousInString = (uint64_t) ((int64_t) inString >> 63);
+  uint64_t stringTail     = inString ^ quote;
+
+  // Anything that is neither structural nor whitespace belongs to a string,
+  // number or literal. Only the first character of each run is a token.
+  uint64_t scalar         = ~(masks->structural | masks->whitespace);
+  uint64_t nonQuoteScalar = scalar & ~quote;
+  uint64_t followsScalar  = nonQuoteScalar << 1 | state->previousScalar;
+  state->previousScalar   = nonQuoteScalar >> 63;
+
+  return (masks->structural | (scalar & ~followsScalar)) & ~stringTail;
+}
+
+static bool json_structural_index_reserve(
+    JsonStructuralIndex* index, size_t capacity)
+{
+  if (capacity <= index->capacity)
+  {
+    return true;
+  }
+
+  capacity = max(capacity, index->capacity * 2);
+  uint32_t* positions =
+      allocator_reallocate(index->allocator, index->positions,
+          index->capacity * sizeof(uint32_t), capacity * sizeof(uint32_t));
+  if (positions == NULL)
+  {
+    LOG_WARNING("Out of memory. Unable to grow JSON structural index.");
+    return false;
+  }
+
+  index->positions = positions;
+  index->capacity  = capacity;
+  return true;
+}
+
+static bool json_structural_index_append(
+    JsonStructuralIndex* index, uint64_t starts, uint32_t offset)
+{
+  if (!json_structural_index_reserve(
+          index, index->count + JSON_STRUCTURAL_BLOCK_SIZE))
+  {
+    return false;
+  }
+
+  uint32_t* positions = index->positions;
+  size_t count        = index->count;
+  while (starts != 0)
+  {
+    positions[count++] = offset + cpu_trailing_zeros(starts);
+    starts &= starts - 1;
+  }
+  index->count = count;
+  return true;
+}
+
+static inline bool json_structural_scan(JsonStructuralIndex* index,
+    const char* source, size_t sourceLength, JsonClassifyFunction classify)
+{
+  JsonScanState state = {0};
+  JsonBlockMasks masks;
+
+  size_t offset = 0;
+  while (offset + JSON_STRUCTURAL_BLOCK_SIZE <= sourceLength)
+  {
+    classify(&source[offset], &masks);
+    if (!json_structural_index_append(index,
+            json_find_token_starts(&state, &masks), (uint32_t) offset))
+    {
+      return false;
+    }
+    offset += JSON_STRUCTURAL_BLOCK_SIZE;
+  }
+
+  if (offset < sourceLength)
+  {
+    // Pad the tail with whitespace so it can't produce tokens of its own.
+    char tail[JSON_STRUCTURAL_BLOCK_SIZE];
+    memset(tail, ' ', sizeof(tail));
+    memcpy(tail, &source[offset], sourceLength - offset);
+
+    classify(tail, &masks);
+    if (!json_structural_index_append(index,
+            json_find_token_starts(&state, &masks), (uint32_t) offset))
+    {
+      return false;
+    }
+  }
+
+  if (state.previousInString)
+  {
+    LOG_WARNING("JSON string was not terminated.");
+    return false;
+  }
+  return true;
+}
+
+static bool json_structural_scan_scalar(
+    JsonStructuralIndex* index, const char* source, size_t sourceLength)
+{
+  return json_structural_scan(
+      index, source, sourceLength, json_classify_scalar);
+}
+
+CPU_TARGET_SSE42 static bool json_structural_scan_sse42(
+    JsonStructuralIndex* index, const char* source, size_t sourceLength)
+{
+  return json_structural_scan(index, source, sourceLength, json_classify_sse42);
+}
+
+CPU_TARGET_AVX2 static bool json_structural_scan_avx2(
+    JsonStructuralIndex* index, const char* source, size_t sourceLength)
+{
+  return json_structural_scan(index, source, sourceLength, json_classify_avx2);
+}
+
+bool json_structural_index_build(JsonStructuralIndex* index,
+    const char* source, size_t sourceLength, CpuSimdLevel level,
+    Allocator* allocator)
+{
+  index->positions = NULL;
+  index->count     = 0;
+  index->capacity  = 0;
+  index->allocator = allocator;
+
+  if (sourceLength > UINT32_MAX)
+  {
+    LOG_WARNING("JSON documents over 4GB are not supported.");
+    return false;
+  }
+
+  // Dense JSON like glTF has a token every few bytes.
+  if (!json_structural_index_reserve(
+          index, sourceLength / 4 + JSON_STRUCTURAL_BLOCK_SIZE))
+  {
+    return false;
+  }
+
+  bool result;
+  switch (min(level, cpu_get_simd_level()))
+  {
+  case CPU_SIMD_AVX2:
+    result = json_structural_scan_avx2(index, source, sourceLength);
+    break;
+  case CPU_SIMD_SSE42:
+    result = json_structural_scan_sse42(index, source, sourceLength);
+    break;
+  default:
+    result = json_structural_scan_scalar(index, source, sourceLength);
+    break;
+  }
+
+  if (!result)
+  {
+    json_structural_index_destroy(index);
+  }
+  return result;
+}
+
+void json_structural_index_destroy(JsonStructuralIndex* index)
+{
+  allocator_deallocate(index->allocator, index->positions,
+      index->capacity * sizeof(uint32_t));
+  index->positions = NULL;
+  index->count     = 0;
+  index->capacity  = 0;
+}
@@ -0,0 +1,439 @@
+#include "Otter/Util/Json/JsonWriter.h"
+
+#include "Otter/Util/Log.h"
+#include "Otter/Util/String/Number.h"
+
+#define JSON_WRITER_INDENT 2
+
+// Strings are escaped this many characters at a time. Escaping grows a
+// character to at most six.
+#define JSON_WRITER_ESCAPE_PIECE  1024
+#define JSON_WRITER_ESCAPE_GROWTH 6
+
+// What follows the backslash for each control character. 'u' means it has no
+// short form and is written as \u00XX.
+static const char g_controlEscapes[32] = {'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u'};
+
+static const char g_hexDigits[] = "0123456789abcdef";
+
+static bool json_writer_fail(JsonWriter* writer, const char* reason)
+{
+  if (!writer->failed)
+  {
+    LOG_WARNING("%s Dropping the rest of the JSON output.", reason);
+    writer->failed = true;
+  }
+  return false;
+}
+
+bool json_writer_flush(JsonWriter* writer)
+{
+  if (writer->file == NULL || writer->length == 0 || writer->failed)
+  {
+    return !writer->failed;
+  }
+
+  size_t length  = writer->length;
+  writer->length = 0;
+  return fwrite(writer->buffer, 1, length, writer->file) == length
+      || json_writer_fail(writer, "Unable to write to the JSON file.");
+}
+
+static char* json_writer_grow(JsonWriter* writer, size_t required)
+{
+  if (writer->failed)
+  {
+    return NULL;
+  }
+
+  if (writer->file != NULL)
+  {
+    // Nothing reserves more than a flushed file buffer holds.
+    return json_writer_flush(writer) ? writer->buffer : NULL;
+  }
+
+  size_t capacity = max(writer->capacity * 2, JSON_WRITER_MIN_CAPACITY);
+  while (capacity < required)
+  {
+    capacity *= 2;
+  }
+
+  char* buffer = allocator_reallocate(
+      writer->allocator, writer->buffer, writer->capacity, capacity);
+  if (buffer == NULL)
+  {
+    json_writer_fail(writer, "Unable to grow the JSON output.");
+    return NULL;
+  }
+
+  writer->buffer   = buffer;
+  writer->capacity = capacity;
+  return &writer->buffer[writer->length];
+}
+
+// Make room for up to `length` more characters and one for the terminator.
+// Returns where they go, or NULL after a failure. The caller moves `length`
+// along by what it actually wrote.
+static inline char* json_writer_reserve(JsonWriter* writer, size_t length)
+{
+  size_t required = writer->length + length + 1;
+  if (required <= writer->capacity && !writer->failed)
+  {
+    return &writer->buffer[writer->length];
+  }
+  return json_writer_grow(writer, required);
+}
+
+static inline void json_writer_commit(JsonWriter* writer, char* end)
+{
+  writer->length = (size_t) (end - writer->buffer);
+}
+
+static inline char* json_writer_new_line(JsonWriter* writer, char* destination)
+{
+  size_t indent  = (size_t) writer->depth * JSON_WRITER_INDENT;
+  destination[0] = '\n';
+  memset(&destination[1], ' ', indent);
+  return &destination[indent + 1];
+}
+
+// Write what separates the next value from the one before it and make room
+// for `length` characters of the value. Returns where the value goes.
+static char* json_writer_begin_value(JsonWriter* writer, size_t length)
+{
+  size_t separator = writer->style == JSON_WRITER_PRETTY
+                       ? 2 + (size_t) writer->depth * JSON_WRITER_INDENT
+                       : 1;
+  char* destination = json_writer_reserve(writer, separator + length);
+  if (destination == NULL || writer->afterKey)
+  {
+    writer->afterKey = false;
+    return destination;
+  }
+
+  if (writer->needsComma)
+  {
+    *destination++ = ',';
+  }
+  if (writer->style == JSON_WRITER_PRETTY && writer->depth > 0)
+  {
+    destination = json_writer_new_line(writer, destination);
+  }
+  writer->needsComma = true;
+  json_writer_commit(writer, destination);
+  return destination;
+}
+
+// Whether any of eight characters is a quote, a backslash or a control
+// character. Each test leaves a byte's top bit set when it matches, and
+// masking with ~chunk drops bytes above 0x7F. Borrows between bytes can only
+// cause false positives, which the caller checks one character at a time.
+static inline bool json_writer_needs_escape(uint64_t chunk)
+{
+  const uint64_t ones = 0x0101010101010101;
+  uint64_t quote      = chunk ^ (ones * '"');
+  uint64_t backslash  = chunk ^ (ones * '\\');
+  uint64_t candidates =
+      (chunk - ones * 0x20) | (quote - ones) | (backslash - ones);
+  return (candidates & ~chunk & (ones * 0x80)) != 0;
+}
+
+// Escapes `string` in quotes at `destination`, which must have room for
+// `JSON_WRITER_ESCAPE_PIECE` escaped characters. Longer strings are written a
+// piece at a time so they still fit a file writer's buffer. Leaves room for
+// `trailing` more characters after the closing quote.
+static char* json_writer_escape(JsonWriter* writer, char* destination,
+    StringView string, size_t trailing)
+{
+  *destination++ = '"';
+
+  size_t i = 0;
+  while (true)
+  {
+    size_t end = min(string.length, i + JSON_WRITER_ESCAPE_PIECE);
+    while (i < end)
+    {
+      uint64_t chunk;
+      while (end - i >= sizeof(chunk))
+      {
+        memcpy(&chunk, &string.data[i], sizeof(chunk));
+        if (json_writer_needs_escape(chunk))
+        {
+          break;
+        }
+        memcpy(destination, &chunk, sizeof(chunk));
+        destination += sizeof(chunk);
+        i += sizeof(chunk);
+      }
+      if (i == end)
+      {
+        break;
+      }
+
+      unsigned char c = (unsigned char) string.data[i++];
+      if (c >= 0x20 && c != '"' && c != '\\')
+      {
+        *destination++ = (char) c;
+        continue;
+      }
+
+      *destination++ = '\\';
+      if (c >= 0x20)
+      {
+        *destination++ = (char) c;
+      }
+      else if (g_controlEscapes[c] != 'u')
+      {
+        *destination++ = g_controlEscapes[c];
+      }
+      else
+      {
+        memcpy(destination, "u00", 3);
+        destination[3] = g_hexDigits[c >> 4];
+        destination[4] = g_hexDigits[c & 0xF];
+        destination += 5;
+      }
+    }
+
+    if (i == string.length)
+    {
+      break;
+    }
+
+    json_writer_commit(writer, destination);
+    destination = json_writer_reserve(
+        writer, JSON_WRITER_ESCAPE_PIECE * JSON_WRITER_ESCAPE_GROWTH
+                    + 1 + trailing);
+    if (destination == NULL)
+    {
+      return NULL;
+    }
+  }
+
+  *destination++ = '"';
+  return destination;
+}
+
+// Room for `length` characters once escaped and quoted, capped at one piece.
+static inline size_t json_writer_escaped_size(size_t length)
+{
+  return min(length, JSON_WRITER_ESCAPE_PIECE) * JSON_WRITER_ESCAPE_GROWTH + 2;
+}
+
+void json_writer_create(
+    JsonWriter* writer, enum JsonWriterStyle style, Allocator* allocator)
+{
+  writer->buffer     = NULL;
+  writer->length     = 0;
+  writer->capacity   = 0;
+  writer->allocator  = allocator;
+  writer->file       = NULL;
+  writer->style      = style;
+  writer->depth      = 0;
+  writer->needsComma = false;
+  writer->afterKey   = false;
+  writer->failed     = false;
+}
+
+bool json_writer_open(
+    JsonWriter* writer, const char* path, enum JsonWriterStyle style)
+{
+  json_writer_create(writer, style, NULL);
+
+  writer->buffer = allocator_allocate(NULL, JSON_WRITER_FILE_BUFFER_SIZE);
+  if (writer->buffer == NULL)
+  {
+    LOG_ERROR("Unable to allocate a buffer for writing %s", path);
+    return false;
+  }
+
+  if (fopen_s(&writer->file, path, "wb") != 0)
+  {
+    LOG_ERROR("Failed to open file for writing: %s", path);
+    allocator_deallocate(NULL, writer->buffer, JSON_WRITER_FILE_BUFFER_SIZE);
+    return false;
+  }
+
+  writer->capacity = JSON_WRITER_FILE_BUFFER_SIZE;
+  return true;
+}
+
+bool json_writer_close(JsonWriter* writer)
+{
+  if (writer->file != NULL)
+  {
+    json_writer_flush(writer);
+    if (fclose(writer->file) != 0)
+    {
+      json_writer_fail(writer, "Unable to finish the JSON file.");
+    }
+    writer->file = NULL;
+  }
+
+  allocator_deallocate(writer->allocator, writer->buffer, writer->capacity);
+  writer->buffer   = NULL;
+  writer->length   = 0;
+  writer->capacity = 0;
+  return !writer->failed;
+}
+
+StringView json_writer_get_output(JsonWriter* writer)
+{
+  if (writer->buffer == NULL)
+  {
+    return string_view_create("", 0);
+  }
+
+  writer->buffer[writer->length] = '\0';
+  return string_view_create(writer->buffer, writer->length);
+}
+
+void json_writer_begin_object(JsonWriter* writer)
+{
+  char* destination = json_writer_begin_value(writer, 1);
+  if (destination != NULL)
+  {
+    *destination = '{';
+    writer->length++;
+  }
+  writer->depth++;
+  writer->needsComma = false;
+}
+
+// Containers with something in them close on their own line.
+static void json_writer_end_container(JsonWriter* writer, char end)
+{
+  writer->depth--;
+  char* destination = json_writer_reserve(
+      writer, 2 + (size_t) writer->depth * JSON_WRITER_INDENT);
+  if (destination == NULL)
+  {
+    return;
+  }
+
+  if (writer->style == JSON_WRITER_PRETTY && writer->needsComma)
+  {
+    destination = json_writer_new_line(writer, destination);
+  }
+  *destination++ = end;
+  json_writer_commit(writer, destination);
+  writer->needsComma = true;
+}
+
+void json_writer_end_object(JsonWriter* writer)
+{
+  json_writer_end_container(writer, '}');
+}
+
+void json_writer_begin_array(JsonWriter* writer)
+{
+  char* destination = json_writer_begin_value(writer, 1);
+  if (destination != NULL)
+  {
+    *destination = '[';
+    writer->length++;
+  }
+  writer->depth++;
+  writer->needsComma = false;
+}
+
+void json_writer_end_array(JsonWriter* writer)
+{
+  json_writer_end_container(writer, ']');
+}
+
+void json_writer_key(JsonWriter* writer, StringView key)
+{
+  char* destination =
+      json_writer_begin_value(writer, json_writer_escaped_size(key.length) + 2);
+  if (destination != NULL)
+  {
+    destination = json_writer_escape(writer, destination, key, 2);
+  }
+  if (destination == NULL)
+  {
+    return;
+  }
+
+  *destination++ = ':';
+  if (writer->style == JSON_WRITER_PRETTY)
+  {
+    *destination++ = ' ';
+  }
+  json_writer_commit(writer, destination);
+  writer->afterKey = true;
+}
+
+void json_writer_string(JsonWriter* writer, StringView value)
+{
+  char* destination =
+      json_writer_begin_value(writer, json_writer_escaped_size(value.length));
+  if (destination != NULL)
+  {
+    destination = json_writer_escape(writer, destination, value, 0);
+  }
+  if (destination != NULL)
+  {
+    json_writer_commit(writer, destination);
+  }
+}
+
+void json_writer_integer(JsonWriter* writer, int64_t value)
+{
+  char* destination =
+      json_writer_begin_value(writer, NUMBER_FORMAT_BUFFER_SIZE);
+  if (destination != NULL)
+  {
+    writer->length += number_format_integer(value, destination);
+  }
+}
+
+void json_writer_double(JsonWriter* writer, double value)
+{
+  char* destination =
+      json_writer_begin_value(writer, NUMBER_FORMAT_BUFFER_SIZE);
+  if (destination == NULL)
+  {
+    return;
+  }
+
+  size_t length = number_format_double(value, destination);
+  if (length == 0)
+  {
+    memcpy(destination, "null", 4);
+    length = 4;
+  }
+  writer->length += length;
+}
+
+void json_writer_boolean(JsonWriter* writer, bool value)
+{
+  char* destination = json_writer_begin_value(writer, 5);
+  if (destination == NULL)
+  {
+    return;
+  }
+
+  if (value)
+  {
+    memcpy(destination, "true", 4);
+    writer->length += 4;
+  }
+  else
+  {
+    memcpy(destination, "false", 5);
+    writer->length += 5;
+  }
+}
+
+void json_writer_null(JsonWriter* writer)
+{
+  char* destination = json_writer_begin_value(writer, 4);
+  if (destination != NULL)
+  {
+    memcpy(destination, "null", 4);
+    writer->length += 4;
+  }
+}
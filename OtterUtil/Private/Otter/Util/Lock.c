@@ -0,0 +1,266 @@
+#include "Otter/Util/Lock.h"
+
+#include "Otter/Util/Log.h"
+
+struct LockStatistics
+{
+  const char* name;
+  volatile LONG64 acquisitions;
+  volatile LONG64 contended;
+  volatile LONG64 waitTicks;
+  volatile LONG64 maxWaitTicks;
+};
+
+// Names are only ever added, so statistics outlive the locks counted in them.
+static LockStatistics g_lockStatistics[LOCK_MAX_NAMES];
+static volatile LONG g_lockStatisticsCount;
+static SRWLOCK g_lockStatisticsLock = SRWLOCK_INIT;
+
+// Sites are added once and never removed, so the list can be walked without
+// a lock.
+static LockSite* volatile g_lockSites;
+
+static int64_t lock_now()
+{
+  LARGE_INTEGER counter;
+  QueryPerformanceCounter(&counter);
+  return counter.QuadPart;
+}
+
+static void lock_store_max(volatile LONG64* max, int64_t value)
+{
+  int64_t current = *max;
+  while (value > current)
+  {
+    int64_t previous = InterlockedCompareExchange64(max, value, current);
+    if (previous == current)
+    {
+      break;
+    }
+    current = previous;
+  }
+}
+
+static LockStatistics* lock_find_statistics(const char* name)
+{
+  LONG count = ReadAcquire(&g_lockStatisticsCount);
+  for (LONG i = 0; i < count; i++)
+  {
+    if (strcmp(g_lockStatistics[i].name, name) == 0)
+    {
+      return &g_lockStatistics[i];
+    }
+  }
+  return NULL;
+}
+
+void lock_create(Lock* lock, const char* name)
+{
+  InitializeCriticalSection(&lock->section);
+  lock->acquiredAt = 0;
+  lock->holder     = NULL;
+
+  AcquireSRWLockExclusive(&g_lockStatisticsLock);
+  lock->statistics = lock_find_statistics(name);
+  if (lock->statistics == NULL)
+  {
+    if (g_lockStatisticsCount < LOCK_MAX_NAMES)
+    {
+      lock->statistics       = &g_lockStatistics[g_lockStatisticsCount];
+      lock->statistics->name = name;
+      WriteRelease(&g_lockStatisticsCount, g_lockStatisticsCount + 1);
+    }
+    else
+    {
+      LOG_WARNING("Too many lock names to count %s", name);
+    }
+  }
+  ReleaseSRWLockExclusive(&g_lockStatisticsLock);
+}
+
+void lock_destroy(Lock* lock)
+{
+  DeleteCriticalSection(&lock->section);
+}
+
+static void lock_register_site(LockSite* site, LockStatistics* statistics)
+{
+  // Every thread that gets here first writes the same values, so the site is
+  // ready whichever of them adds it.
+  site->statistics = statistics;
+  site->wait.name  = statistics->name;
+  site->wait.file  = site->file;
+  site->wait.line  = site->line;
+  if (InterlockedCompareExchange(&site->registered, 1, 0) != 0)
+  {
+    return;
+  }
+
+  do
+  {
+    site->next = g_lockSites;
+  } while (InterlockedCompareExchangePointer(
+               (void* volatile*) &g_lockSites, site, site->next)
+           != site->next);
+}
+
+void lock_acquire_at(Lock* lock, LockSite* site)
+{
+  LockStatistics* statistics = lock->statistics;
+  if (statistics == NULL)
+  {
+    EnterCriticalSection(&lock->section);
+    return;
+  }
+
+  if (!site->registered)
+  {
+    lock_register_site(site, statistics);
+  }
+
+  if (TryEnterCriticalSection(&lock->section))
+  {
+    lock->acquiredAt = lock_now();
+  }
+  else
+  {
+    profiler_zone_begin(&site->wait);
+    int64_t start = lock_now();
+    EnterCriticalSection(&lock->section);
+    lock->acquiredAt = lock_now();
+    profiler_zone_end();
+
+    int64_t waited = lock->acquiredAt - start;
+    InterlockedIncrement64(&statistics->contended);
+    InterlockedAdd64(&statistics->waitTicks, waited);
+    lock_store_max(&statistics->maxWaitTicks, waited);
+  }
+  lock->holder = site;
+  InterlockedIncrement64(&statistics->acquisitions);
+}
+
+void lock_release(Lock* lock)
+{
+  LockSite* site = lock->holder;
+  int64_t held   = lock_now() - lock->acquiredAt;
+  lock->holder   = NULL;
+  LeaveCriticalSection(&lock->section);
+
+  // Sites can be shared by locks with the same name, so they're counted
+  // outside of the one just released.
+  if (site != NULL)
+  {
+    InterlockedIncrement64(&site->holds);
+    InterlockedAdd64(&site->holdTicks, held);
+    lock_store_max(&site->maxHoldTicks, held);
+  }
+}
+
+static double lock_seconds_per_tick()
+{
+  LARGE_INTEGER frequency;
+  QueryPerformanceFrequency(&frequency);
+  return 1.0 / (double) frequency.QuadPart;
+}
+
+bool lock_summary_get(const char* name, LockSummary* summary)
+{
+  LockStatistics* statistics = lock_find_statistics(name);
+  if (statistics == NULL)
+  {
+    return false;
+  }
+
+  double secondsPerTick = lock_seconds_per_tick();
+  summary->acquisitions = ReadAcquire64(&statistics->acquisitions);
+  summary->contended    = ReadAcquire64(&statistics->contended);
+  summary->waitTime =
+      (float) (ReadAcquire64(&statistics->waitTicks) * secondsPerTick);
+  summary->maxWaitTime =
+      (float) (ReadAcquire64(&statistics->maxWaitTicks) * secondsPerTick);
+  return true;
+}
+
+static const char* lock_file_name(const char* path)
+{
+  const char* name = path;
+  for (const char* c = path; *c != '\0'; c++)
+  {
+    if (*c == '/' || *c == '\\')
+    {
+      name = c + 1;
+    }
+  }
+  return name;
+}
+
+static void lock_report_holders(FILE* output,
+    const LockStatistics* statistics, double millisecondsPerTick)
+{
+  // Sites already listed, so each pass finds the next longest held.
+  const LockSite* listed[LOCK_REPORT_HOLDERS];
+  for (int i = 0; i < LOCK_REPORT_HOLDERS; i++)
+  {
+    const LockSite* longest = NULL;
+    for (const LockSite* site =
+             ReadPointerAcquire((void* volatile*) &g_lockSites);
+         site != NULL; site = site->next)
+    {
+      bool seen = false;
+      for (int j = 0; j < i; j++)
+      {
+        seen |= listed[j] == site;
+      }
+      if (!seen && site->statistics == statistics && site->holds > 0
+          && (longest == NULL || site->holdTicks > longest->holdTicks))
+      {
+        longest = site;
+      }
+    }
+    if (longest == NULL)
+    {
+      return;
+    }
+    listed[i] = longest;
+
+    char location[64];
+    snprintf(location, sizeof(location), "%s:%d",
+        lock_file_name(longest->file), longest->line);
+    fprintf(output, "  %-30s %10llu %10.3f %9.3f\n", location,
+        (unsigned long long) longest->holds,
+        longest->holdTicks * millisecondsPerTick,
+        longest->maxHoldTicks * millisecondsPerTick);
+  }
+}
+
+void lock_report(FILE* output)
+{
+  double millisecondsPerTick = lock_seconds_per_tick() * 1e3;
+  bool header                = false;
+
+  LONG count = ReadAcquire(&g_lockStatisticsCount);
+  for (LONG i = 0; i < count; i++)
+  {
+    const LockStatistics* statistics = &g_lockStatistics[i];
+    uint64_t acquisitions = ReadAcquire64(&statistics->acquisitions);
+    if (acquisitions == 0)
+    {
+      continue;
+    }
+
+    if (!header)
+    {
+      fprintf(output, "%-32s %10s %10s %9s %9s\n", "lock (ms)", "acquired",
+          "contended", "wait", "max wait");
+      fprintf(output, "  %-30s %10s %10s %9s\n", "held at", "holds", "held",
+          "max held");
+      header = true;
+    }
+    fprintf(output, "%-32s %10llu %10llu %9.3f %9.3f\n", statistics->name,
+        (unsigned long long) acquisitions,
+        (unsigned long long) statistics->contended,
+        statistics->waitTicks * millisecondsPerTick,
+        statistics->maxWaitTicks * millisecondsPerTick);
+    lock_report_holders(output, statistics, millisecondsPerTick);
+  }
+}
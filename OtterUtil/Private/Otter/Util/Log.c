@@ -1,51 +1,874 @@
 #include "Otter/Util/Log.h"
 
-#include <time.h>
+#include <stddef.h>
 
-static void log_set_foreground_color(int color)
+#include "Otter/Util/HashMap.h"
+#include "Otter/Util/LogFormat.h"
+
+// Each thread that logs gets a ring of this many bytes. Messages logged while
+// its ring is full are dropped and counted.
+#define LOG_RING_SIZE (64 * 1024)
+
+// Largest record a message is captured into. Long strings are cut short to
+// fit.
+#define LOG_MAX_RECORD 1024
+
+#define LOG_OUTPUT_BUFFER_SIZE (16 * 1024)
+
+// The logging thread writes out at least this often.
+#define LOG_FLUSH_INTERVAL_MS 10
+
+// How long shutdown and crash handling wait for the logging thread to let go
+// of the output, in case it died holding it.
+#define LOG_LOCK_TIMEOUT_MS 100
+
+// Messages are rate limited by their format string, hashed into
+// 2^LOG_RATE_LIMIT_BITS slots.
+#define LOG_RATE_LIMIT_BITS 10
+
+// A captured message. Its arguments follow in 8 byte slots, in the order the
+// format string uses them. Strings are a length slot followed by their
+// characters, padded to a slot.
+typedef struct LogRecord
+{
+  // Bytes up to the next record. A record without a format is padding up to
+  // the end of the ring.
+  uint32_t size;
+  uint32_t suppressed;
+  int64_t timestamp;
+  const char* file;
+  const char* format;
+  int32_t line;
+  int32_t verbosity;
+} LogRecord;
+
+// Written by one thread and read by the logging thread. `head` and `tail`
+// count bytes ever read and written, and sit on separate cache lines.
+typedef struct LogRing
+{
+  struct LogRing* next;
+  // Whether a live thread owns the ring. Rings of threads that exit are
+  // picked up by new threads.
+  volatile LONG active;
+  // Dropped messages already reported, owned by the logging thread.
+  int64_t reportedDropped;
+  char headPadding[40];
+  volatile LONG64 head;
+  char tailPadding[56];
+  volatile LONG64 tail;
+  // The producer's last look at `head`.
+  LONG64 cachedHead;
+  volatile LONG64 dropped;
+  char dataPadding[40];
+  char data[LOG_RING_SIZE];
+} LogRing;
+
+// What makes a call site for the binary output. Each macro use has its own
+// level, so it's part of the key.
+typedef struct LogSiteKey
+{
+  const char* file;
+  const char* format;
+  int32_t line;
+  int32_t verbosity;
+} LogSiteKey;
+
+typedef struct LogRateLimit
+{
+  const char* volatile format;
+  volatile LONG64 windowStart;
+  volatile LONG64 windowCount;
+  volatile LONG64 suppressed;
+} LogRateLimit;
+
+static INIT_ONCE g_logInitOnce = INIT_ONCE_STATIC_INIT;
+static DWORD g_logFlsIndex     = FLS_OUT_OF_INDEXES;
+static LogRing* volatile g_logRings;
+static _Thread_local LogRing* g_threadRing;
+
+static LogRateLimit g_logRateLimits[1 << LOG_RATE_LIMIT_BITS];
+static volatile LONG64 g_logRateLimit = LOG_RATE_LIMIT;
+
+static int64_t g_logFrequency;
+static int64_t g_logStart;
+
+// Held by whoever is formatting and writing records.
+static CRITICAL_SECTION g_logOutputLock;
+static FILE* g_logOutput;
+// Records go out as binary rather than text lines.
+static bool g_logBinary;
+// Call sites already written to the binary output, keyed by LogSiteKey, with
+// their id plus one.
+static HashMap g_logSites;
+static bool g_logSitesCreated;
+static uint32_t g_logSiteCount;
+static char g_logOutputBuffer[LOG_OUTPUT_BUFFER_SIZE];
+static size_t g_logOutputLength;
+
+static HANDLE g_logThread;
+static HANDLE g_logWake;
+static volatile LONG g_logStopping;
+
+static LPTOP_LEVEL_EXCEPTION_FILTER g_previousExceptionFilter;
+
+static int64_t log_read_signed(va_list* args, enum LogLength length)
+{
+  switch (length)
+  {
+  case LL_CHAR:
+    return (signed char) va_arg(*args, int);
+  case LL_SHORT:
+    return (short) va_arg(*args, int);
+  case LL_LONG:
+    return va_arg(*args, long);
+  case LL_LONG_LONG:
+    return va_arg(*args, long long);
+  case LL_SIZE:
+    return (int64_t) va_arg(*args, size_t);
+  case LL_MAX:
+    return va_arg(*args, intmax_t);
+  case LL_PTRDIFF:
+    return va_arg(*args, ptrdiff_t);
+  default:
+    return va_arg(*args, int);
+  }
+}
+
+static uint64_t log_read_unsigned(va_list* args, enum LogLength length)
+{
+  switch (length)
+  {
+  case LL_CHAR:
+    return (unsigned char) va_arg(*args, unsigned int);
+  case LL_SHORT:
+    return (unsigned short) va_arg(*args, unsigned int);
+  case LL_LONG:
+    return va_arg(*args, unsigned long);
+  case LL_LONG_LONG:
+    return va_arg(*args, unsigned long long);
+  case LL_SIZE:
+    return va_arg(*args, size_t);
+  case LL_MAX:
+    return va_arg(*args, uintmax_t);
+  case LL_PTRDIFF:
+    return (uint64_t) va_arg(*args, ptrdiff_t);
+  default:
+    return va_arg(*args, unsigned int);
+  }
+}
+
+// Copy the arguments `format` uses into the slots after `record`. Stops at
+// anything it can't capture, and the formatter stops at the same place.
+static size_t log_capture(
+    LogRecord* record, size_t capacity, const char* format, va_list* args)
+{
+  char* payload = (char*) (record + 1);
+  size_t size   = sizeof(LogRecord);
+
+  while ((format = strchr(format, '%')) != NULL)
+  {
+    LogSpec spec;
+    format = log_parse_spec(format + 1, &spec);
+    if (spec.argument == LA_UNSUPPORTED)
+    {
+      break;
+    }
+
+    int64_t widthAndPrecision[2];
+    size_t starCount = 0;
+    if (spec.widthStar)
+    {
+      widthAndPrecision[starCount++] = va_arg(*args, int);
+    }
+    if (spec.precisionStar)
+    {
+      widthAndPrecision[starCount++] = va_arg(*args, int);
+      spec.precision = (int) widthAndPrecision[starCount - 1];
+    }
+    if (size + (starCount + 1) * sizeof(uint64_t) > capacity)
+    {
+      break;
+    }
+    memcpy(&payload[size - sizeof(LogRecord)], widthAndPrecision,
+        starCount * sizeof(uint64_t));
+    size += starCount * sizeof(uint64_t);
+
+    char* slot = &payload[size - sizeof(LogRecord)];
+    switch (spec.argument)
+    {
+    case LA_SIGNED:
+    {
+      int64_t value = log_read_signed(args, spec.length);
+      memcpy(slot, &value, sizeof(value));
+      break;
+    }
+    case LA_UNSIGNED:
+    {
+      uint64_t value = log_read_unsigned(args, spec.length);
+      memcpy(slot, &value, sizeof(value));
+      break;
+    }
+    case LA_CHARACTER:
+    {
+      int64_t value = va_arg(*args, int);
+      memcpy(slot, &value, sizeof(value));
+      break;
+    }
+    case LA_DOUBLE:
+    {
+      double value = spec.length == LL_LONG_DOUBLE
+                       ? (double) va_arg(*args, long double)
+                       : va_arg(*args, double);
+      memcpy(slot, &value, sizeof(value));
+      break;
+    }
+    case LA_POINTER:
+    {
+      uint64_t value = (uintptr_t) va_arg(*args, void*);
+      memcpy(slot, &value, sizeof(value));
+      break;
+    }
+    case LA_STRING:
+    {
+      const char* string = va_arg(*args, const char*);
+      if (string == NULL)
+      {
+        string = "(null)";
+      }
+
+      size_t room    = capacity - size - sizeof(uint64_t);
+      uint64_t count = spec.hasPrecision && spec.precision >= 0
+                         ? strnlen(string, min((size_t) spec.precision, room))
+                         : strnlen(string, room);
+      memcpy(slot, &count, sizeof(count));
+      memcpy(slot + sizeof(count), string, count);
+      size += (count + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+      break;
+    }
+    default:
+      continue;
+    }
+    size += sizeof(uint64_t);
+  }
+
+  return size;
+}
+
+static void log_write_output()
 {
-  printf("\x1b[38;5;%dm", color);
+  if (g_logOutputLength > 0)
+  {
+    fwrite(g_logOutputBuffer, 1, g_logOutputLength, g_logOutput);
+    g_logOutputLength = 0;
+  }
+}
+
+static char* log_begin_line()
+{
+  if (LOG_OUTPUT_BUFFER_SIZE - g_logOutputLength < LOG_LINE_SIZE)
+  {
+    log_write_output();
+  }
+  return &g_logOutputBuffer[g_logOutputLength];
+}
+
+// Seconds since the logger started, to a tenth of a millisecond, then the
+// level.
+static void log_write_header(
+    char* line, size_t* length, int64_t timestamp, int verbosity)
+{
+  static const char* names[] = {"DEBUG ", "WARN  ", "ERROR "};
+  static const char* colors[] = {
+      "\x1b[38;5;14m", "\x1b[38;5;11m", "\x1b[38;5;9m"};
+
+  int64_t elapsed = (timestamp - g_logStart) / (g_logFrequency / 10000);
+  char digits[NUMBER_FORMAT_BUFFER_SIZE];
+  size_t count = number_format_integer(elapsed / 10000, digits);
+  if (count < 5)
+  {
+    log_append(line, length, "     ", 5 - count);
+  }
+  log_append(line, length, digits, count);
+
+  char fraction[6] = {'.', '0', '0', '0', '0', ' '};
+  int64_t remainder = elapsed % 10000;
+  for (int i = 4; i > 0; i--)
+  {
+    fraction[i] = (char) ('0' + remainder % 10);
+    remainder /= 10;
+  }
+  log_append(line, length, fraction, sizeof(fraction));
+
+  bool known = verbosity >= LOG_DEBUG && verbosity <= LOG_ERROR;
+  if (g_logOutput == stdout)
+  {
+    const char* color = known ? colors[verbosity] : "\x1b[38;5;5m";
+    log_append(line, length, color, strlen(color));
+  }
+  log_append(line, length, known ? names[verbosity] : "UKNWN ", 6);
 }
 
-static void log_reset_foreground_color()
+// Copy `size` bytes to the output, writing it out first if they don't fit.
+static void log_write_bytes(const void* data, size_t size)
 {
-  printf("\x1b[0m");
+  if (LOG_OUTPUT_BUFFER_SIZE - g_logOutputLength < size)
+  {
+    log_write_output();
+    if (size > LOG_OUTPUT_BUFFER_SIZE)
+    {
+      fwrite(data, 1, size, g_logOutput);
+      return;
+    }
+  }
+  memcpy(&g_logOutputBuffer[g_logOutputLength], data, size);
+  g_logOutputLength += size;
+}
+
+// Id of the call site `record` came from, writing the site out the first time
+// it's seen.
+static uint32_t log_write_site(const LogRecord* record)
+{
+  LogSiteKey key = {
+      record->file, record->format, record->line, record->verbosity};
+  void* known = hash_map_get_value(&g_logSites, &key, sizeof(key));
+  if (known != NULL)
+  {
+    return (uint32_t) ((uintptr_t) known - 1);
+  }
+
+  // A record can't capture more slots than this, so neither can a site.
+  uint8_t arguments[LOG_MAX_RECORD / sizeof(uint64_t)];
+  uint32_t argumentCount = 0;
+  const char* format     = record->format;
+  while ((format = strchr(format, '%')) != NULL
+         && argumentCount + 3 <= sizeof(arguments))
+  {
+    LogSpec spec;
+    format = log_parse_spec(format + 1, &spec);
+    if (spec.argument == LA_UNSUPPORTED)
+    {
+      break;
+    }
+    if (spec.widthStar)
+    {
+      arguments[argumentCount++] = LA_SIGNED;
+    }
+    if (spec.precisionStar)
+    {
+      arguments[argumentCount++] = LA_SIGNED;
+    }
+    if (spec.argument != LA_LITERAL)
+    {
+      arguments[argumentCount++] = (uint8_t) spec.argument;
+    }
+  }
+
+  BinaryLogSiteRecord site;
+  site.id            = g_logSiteCount++;
+  site.line          = record->line;
+  site.verbosity     = record->verbosity;
+  site.fileLength    = (uint32_t) strlen(record->file) + 1;
+  site.formatLength  = (uint32_t) strlen(record->format) + 1;
+  site.argumentCount = argumentCount;
+
+  size_t size =
+      sizeof(site) + site.fileLength + site.formatLength + argumentCount;
+  size_t padded    = (size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+  site.record.type = BLR_SITE;
+  site.record.size = (uint32_t) padded;
+
+  uint64_t zero = 0;
+  log_write_bytes(&site, sizeof(site));
+  log_write_bytes(record->file, site.fileLength);
+  log_write_bytes(record->format, site.formatLength);
+  log_write_bytes(arguments, argumentCount);
+  log_write_bytes(&zero, padded - size);
+
+  // If the site can't be remembered it's written again next time, under a
+  // new id.
+  hash_map_set_value(
+      &g_logSites, &key, sizeof(key), (void*) ((uintptr_t) site.id + 1));
+  return site.id;
+}
+
+// The captured arguments are written as they are, so a message costs about
+// a copy of its record.
+static void log_write_binary_record(const LogRecord* record)
+{
+  BinaryLogEventRecord event;
+  event.site        = log_write_site(record);
+  event.suppressed  = record->suppressed;
+  event.timestamp   = record->timestamp;
+  size_t arguments  = record->size - sizeof(LogRecord);
+  event.record.type = BLR_EVENT;
+  event.record.size = (uint32_t) (sizeof(event) + arguments);
+
+  log_write_bytes(&event, sizeof(event));
+  log_write_bytes(record + 1, arguments);
+}
+
+static void log_write_record(const LogRecord* record)
+{
+  if (g_logBinary)
+  {
+    log_write_binary_record(record);
+    return;
+  }
+
+  char* line    = log_begin_line();
+  size_t length = 0;
+  log_write_header(line, &length, record->timestamp, record->verbosity);
+
+  bool colored = g_logOutput == stdout;
+  if (colored)
+  {
+    log_append(line, &length, "\x1b[38;5;249m", 11);
+  }
+  log_append(line, &length, record->file, strlen(record->file));
+  log_append(line, &length, ":", 1);
+  log_append_integer(line, &length, record->line);
+  log_append(line, &length, ": ", 2);
+  if (colored)
+  {
+    log_append(line, &length, "\x1b[0m", 4);
+  }
+
+  log_format_arguments(record->format, (const char*) (record + 1),
+      record->size - sizeof(LogRecord), line, &length);
+  if (record->suppressed > 0)
+  {
+    log_append(line, &length, " (repeated ", 11);
+    log_append_integer(line, &length, record->suppressed);
+    log_append(line, &length, " more times)", 12);
+  }
+
+  line[length++] = '\n';
+  g_logOutputLength += length;
+}
+
+static void log_write_dropped(LogRing* ring)
+{
+  int64_t dropped = ReadAcquire64(&ring->dropped);
+  if (dropped == ring->reportedDropped)
+  {
+    return;
+  }
+
+  LARGE_INTEGER now;
+  QueryPerformanceCounter(&now);
+
+  if (g_logBinary)
+  {
+    BinaryLogDroppedRecord record;
+    record.record.type = BLR_DROPPED;
+    record.record.size = sizeof(record);
+    record.count       = (uint32_t) (dropped - ring->reportedDropped);
+    record.reserved    = 0;
+    record.timestamp   = now.QuadPart;
+    log_write_bytes(&record, sizeof(record));
+    ring->reportedDropped = dropped;
+    return;
+  }
+
+  char* line    = log_begin_line();
+  size_t length = 0;
+  log_write_header(line, &length, now.QuadPart, LOG_WARNING);
+  if (g_logOutput == stdout)
+  {
+    log_append(line, &length, "\x1b[0m", 4);
+  }
+  log_append_formatted(line, &length,
+      snprintf(&line[length], LOG_LINE_SIZE - length,
+          "%lld messages were dropped because a thread logged faster than "
+          "they could be written.",
+          (long long) (dropped - ring->reportedDropped)));
+  line[length++] = '\n';
+  g_logOutputLength += length;
+
+  ring->reportedDropped = dropped;
+}
+
+// The oldest record in `ring` not yet written, skipping padding.
+static const LogRecord* log_ring_peek(LogRing* ring)
+{
+  while (true)
+  {
+    int64_t head = ring->head;
+    if (head == ReadAcquire64(&ring->tail))
+    {
+      return NULL;
+    }
+
+    size_t offset           = head & (LOG_RING_SIZE - 1);
+    size_t contiguous       = LOG_RING_SIZE - offset;
+    const LogRecord* record = (const LogRecord*) &ring->data[offset];
+    if (contiguous >= sizeof(LogRecord) && record->format != NULL)
+    {
+      return record;
+    }
+    WriteRelease64(&ring->head, head + contiguous);
+  }
+}
+
+// Write out every record in the rings, oldest first. The output lock must be
+// held.
+static void log_drain()
+{
+  while (true)
+  {
+    LogRing* oldestRing       = NULL;
+    const LogRecord* oldest   = NULL;
+    for (LogRing* ring = ReadPointerAcquire((void* volatile*) &g_logRings);
+         ring != NULL; ring = ring->next)
+    {
+      log_write_dropped(ring);
+
+      const LogRecord* record = log_ring_peek(ring);
+      if (record != NULL
+          && (oldest == NULL || record->timestamp < oldest->timestamp))
+      {
+        oldestRing = ring;
+        oldest     = record;
+      }
+    }
+
+    if (oldest == NULL)
+    {
+      break;
+    }
+
+    log_write_record(oldest);
+    WriteRelease64(&oldestRing->head, oldestRing->head + oldest->size);
+  }
+
+  log_write_output();
+  fflush(g_logOutput);
+}
+
+// Take the output lock, giving up after a while if `patient` is false.
+static bool log_lock_output(bool patient)
+{
+  if (patient)
+  {
+    EnterCriticalSection(&g_logOutputLock);
+    return true;
+  }
+
+  for (int i = 0; i < LOG_LOCK_TIMEOUT_MS; i++)
+  {
+    if (TryEnterCriticalSection(&g_logOutputLock))
+    {
+      return true;
+    }
+    Sleep(1);
+  }
+  return false;
+}
+
+static void log_drain_now(bool patient)
+{
+  if (log_lock_output(patient))
+  {
+    log_drain();
+    LeaveCriticalSection(&g_logOutputLock);
+  }
+}
+
+static DWORD WINAPI log_thread(void* unused)
+{
+  (void) unused;
+
+  while (!ReadAcquire(&g_logStopping))
+  {
+    WaitForSingleObject(g_logWake, LOG_FLUSH_INTERVAL_MS);
+    log_drain_now(true);
+  }
+
+  return 0;
+}
+
+static LONG WINAPI log_crash_filter(EXCEPTION_POINTERS* exception)
+{
+  // The logging thread may be the one that crashed, holding the output.
+  log_drain_now(false);
+
+  return g_previousExceptionFilter != NULL
+           ? g_previousExceptionFilter(exception)
+           : EXCEPTION_CONTINUE_SEARCH;
+}
+
+static void NTAPI log_release_thread(void* ring)
+{
+  if (ring != NULL)
+  {
+    InterlockedExchange(&((LogRing*) ring)->active, 0);
+  }
+}
+
+static BOOL CALLBACK log_init(INIT_ONCE* once, void* parameter, void** context)
+{
+  (void) once;
+  (void) parameter;
+  (void) context;
+
+  LARGE_INTEGER counter;
+  QueryPerformanceFrequency(&counter);
+  g_logFrequency = counter.QuadPart;
+  QueryPerformanceCounter(&counter);
+  g_logStart = counter.QuadPart;
+
+  InitializeCriticalSection(&g_logOutputLock);
+  if (g_logOutput == NULL)
+  {
+    g_logOutput = stdout;
+  }
+
+  g_logFlsIndex = FlsAlloc(log_release_thread);
+  g_logWake     = CreateEvent(NULL, false, false, NULL);
+  g_logThread   = CreateThread(NULL, 0, log_thread, NULL, 0, NULL);
+
+  g_previousExceptionFilter = SetUnhandledExceptionFilter(log_crash_filter);
+  atexit(log_shutdown);
+
+  return true;
+}
+
+static LogRing* log_register_thread()
+{
+  InitOnceExecuteOnce(&g_logInitOnce, log_init, NULL, NULL);
+
+  LogRing* ring = ReadPointerAcquire((void* volatile*) &g_logRings);
+  while (ring != NULL && InterlockedCompareExchange(&ring->active, 1, 0) != 0)
+  {
+    ring = ring->next;
+  }
+
+  if (ring == NULL)
+  {
+    ring = malloc(sizeof(LogRing));
+    if (ring == NULL)
+    {
+      return NULL;
+    }
+
+    ring->active          = 1;
+    ring->reportedDropped = 0;
+    ring->head            = 0;
+    ring->tail            = 0;
+    ring->cachedHead      = 0;
+    ring->dropped         = 0;
+    do
+    {
+      ring->next = g_logRings;
+    } while (InterlockedCompareExchangePointer(
+                 (void* volatile*) &g_logRings, ring, ring->next)
+             != ring->next);
+  }
+
+  if (g_logFlsIndex != FLS_OUT_OF_INDEXES)
+  {
+    FlsSetValue(g_logFlsIndex, ring);
+  }
+  g_threadRing = ring;
+  return ring;
+}
+
+// Whether `format` is still under its rate limit. Returns how many repeats
+// were held back since it last was through `suppressed`.
+static bool log_allow(const char* format, int64_t now, uint32_t* suppressed)
+{
+  *suppressed       = 0;
+  int64_t rateLimit = g_logRateLimit;
+  if (rateLimit == 0)
+  {
+    return true;
+  }
+
+  uint64_t hash = (uint64_t) (uintptr_t) format * 0x9E3779B97F4A7C15ull;
+  LogRateLimit* limit =
+      &g_logRateLimits[hash >> (64 - LOG_RATE_LIMIT_BITS)];
+
+  // A message that shares a slot takes it over, starting a new window.
+  if (limit->format != format)
+  {
+    InterlockedExchangePointer(
+        (void* volatile*) &limit->format, (void*) format);
+    InterlockedExchange64(&limit->suppressed, 0);
+    InterlockedExchange64(&limit->windowStart, 0);
+  }
+
+  int64_t windowStart = limit->windowStart;
+  if (now - windowStart >= g_logFrequency
+      && InterlockedCompareExchange64(&limit->windowStart, now, windowStart)
+             == windowStart)
+  {
+    InterlockedExchange64(&limit->windowCount, 0);
+    *suppressed = (uint32_t) InterlockedExchange64(&limit->suppressed, 0);
+  }
+
+  if (InterlockedIncrement64(&limit->windowCount) > rateLimit)
+  {
+    InterlockedIncrement64(&limit->suppressed);
+    return false;
+  }
+  return true;
+}
+
+static void log_push(LogRing* ring, const LogRecord* record)
+{
+  int64_t tail      = ring->tail;
+  size_t offset     = tail & (LOG_RING_SIZE - 1);
+  size_t contiguous = LOG_RING_SIZE - offset;
+  size_t required   = contiguous < record->size
+                      ? contiguous + record->size
+                      : record->size;
+
+  if (tail + required - ring->cachedHead > LOG_RING_SIZE)
+  {
+    ring->cachedHead = ReadAcquire64(&ring->head);
+    if (tail + required - ring->cachedHead > LOG_RING_SIZE)
+    {
+      InterlockedIncrement64(&ring->dropped);
+      SetEvent(g_logWake);
+      return;
+    }
+  }
+
+  if (contiguous < record->size)
+  {
+    if (contiguous >= sizeof(LogRecord))
+    {
+      ((LogRecord*) &ring->data[offset])->format = NULL;
+    }
+    tail  += contiguous;
+    offset = 0;
+  }
+
+  memcpy(&ring->data[offset], record, record->size);
+  WriteRelease64(&ring->tail, tail + record->size);
+
+  // Past half full the logging thread is woken early rather than at its next
+  // interval, as are errors so they show up promptly.
+  if (record->verbosity >= LOG_ERROR
+      || tail + record->size - ring->cachedHead > LOG_RING_SIZE / 2)
+  {
+    SetEvent(g_logWake);
+  }
 }
 
 void log_message(int sourceLine, const char* sourceFile, LogVerbosity verbosity,
     const char* message, ...)
 {
+  LogRing* ring = g_threadRing;
+  if (ring == NULL && (ring = log_register_thread()) == NULL)
+  {
+    return;
+  }
+
+  LARGE_INTEGER now;
+  QueryPerformanceCounter(&now);
+
+  uint32_t suppressed;
+  if (!log_allow(message, now.QuadPart, &suppressed))
+  {
+    return;
+  }
+
+  uint64_t buffer[LOG_MAX_RECORD / sizeof(uint64_t)];
+  LogRecord* record  = (LogRecord*) buffer;
+  record->suppressed = suppressed;
+  record->timestamp  = now.QuadPart;
+  record->file       = sourceFile;
+  record->format     = message;
+  record->line       = sourceLine;
+  record->verbosity  = verbosity;
+
   va_list args;
   va_start(args, message);
+  record->size = (uint32_t) log_capture(record, sizeof(buffer), message, &args);
+  va_end(args);
 
-  time_t now = time(NULL);
-  struct tm timeinfo;
-  localtime_s(&timeinfo, &now);
-  printf("%02d:%02d:%02d ", timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
-  switch (verbosity)
-  {
-  case LOG_DEBUG:
-    log_set_foreground_color(14);
-    printf("DEBUG ");
-    break;
-  case LOG_WARNING:
-    log_set_foreground_color(11);
-    printf("WARN  ");
-    break;
-  case LOG_ERROR:
-    log_set_foreground_color(9);
-    printf("ERROR ");
-    break;
-  default:
-    log_set_foreground_color(5);
-    printf("UKNWN ");
-    break;
+  log_push(ring, record);
+
+  if (ReadAcquire(&g_logStopping))
+  {
+    log_drain_now(false);
   }
-  log_set_foreground_color(249);
-  printf("%s:%d: ", sourceFile, sourceLine);
-  log_reset_foreground_color();
-  vprintf(message, args);
-  printf("\n");
+}
 
-  va_end(args);
+void log_flush()
+{
+  InitOnceExecuteOnce(&g_logInitOnce, log_init, NULL, NULL);
+  log_drain_now(true);
+}
+
+void log_set_output(FILE* file)
+{
+  InitOnceExecuteOnce(&g_logInitOnce, log_init, NULL, NULL);
+
+  log_lock_output(true);
+  log_drain();
+  g_logOutput = file != NULL ? file : stdout;
+  g_logBinary = false;
+  LeaveCriticalSection(&g_logOutputLock);
+}
+
+bool log_set_binary_output(FILE* file)
+{
+  InitOnceExecuteOnce(&g_logInitOnce, log_init, NULL, NULL);
+
+  log_lock_output(true);
+  log_drain();
+
+  // Sites are written again to each new file.
+  if (g_logSitesCreated)
+  {
+    hash_map_destroy(&g_logSites, NULL);
+  }
+  g_logSitesCreated = hash_map_create(
+      &g_logSites, HASH_MAP_DEFAULT_BUCKETS, HASH_MAP_DEFAULT_COEF);
+  g_logSiteCount = 0;
+
+  if (g_logSitesCreated)
+  {
+    BinaryLogHeader header;
+    memcpy(header.magic, BINARY_LOG_MAGIC, sizeof(header.magic));
+    header.version   = BINARY_LOG_VERSION;
+    header.reserved  = 0;
+    header.frequency = g_logFrequency;
+    header.start     = g_logStart;
+    g_logOutput      = file;
+    g_logBinary      = true;
+    log_write_bytes(&header, sizeof(header));
+  }
+  LeaveCriticalSection(&g_logOutputLock);
+
+  if (!g_logSitesCreated)
+  {
+    LOG_ERROR("Unable to track log sites. Logging stays as text.");
+  }
+  return g_logSitesCreated;
+}
+
+void log_set_rate_limit(uint32_t messagesPerSecond)
+{
+  InterlockedExchange64(&g_logRateLimit, messagesPerSecond);
+}
+
+void log_shutdown()
+{
+  if (g_logThread == NULL
+      || InterlockedExchange(&g_logStopping, 1) != 0)
+  {
+    return;
+  }
+
+  // At exit the thread may already have been ended, which counts as having
+  // stopped.
+  SetEvent(g_logWake);
+  WaitForSingleObject(g_logThread, LOG_LOCK_TIMEOUT_MS);
+  CloseHandle(g_logThread);
+  g_logThread = NULL;
+
+  log_drain_now(false);
 }
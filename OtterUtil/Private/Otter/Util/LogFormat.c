@@ -0,0 +1,299 @@
+#include "Otter/Util/LogFormat.h"
+
+const char* log_parse_spec(const char* format, LogSpec* spec)
+{
+  spec->flags = format;
+  while (*format != '\0' && strchr("-+ #0", *format) != NULL)
+  {
+    format++;
+  }
+  spec->flagsLength = (size_t) (format - spec->flags);
+  if (spec->flagsLength > LOG_SPEC_MAX_FLAGS)
+  {
+    spec->argument = LA_UNSUPPORTED;
+    return format;
+  }
+
+  spec->width     = 0;
+  spec->widthStar = *format == '*';
+  spec->hasWidth  = spec->widthStar || isdigit((unsigned char) *format);
+  if (spec->widthStar)
+  {
+    format++;
+  }
+  while (isdigit((unsigned char) *format))
+  {
+    spec->width = spec->width * 10 + (*format++ - '0');
+  }
+
+  spec->precision     = 0;
+  spec->hasPrecision  = *format == '.';
+  spec->precisionStar = false;
+  if (spec->hasPrecision)
+  {
+    format++;
+    spec->precisionStar = *format == '*';
+    if (spec->precisionStar)
+    {
+      format++;
+    }
+    while (isdigit((unsigned char) *format))
+    {
+      spec->precision = spec->precision * 10 + (*format++ - '0');
+    }
+  }
+
+  spec->length = LL_NONE;
+  switch (*format)
+  {
+  case 'h':
+    spec->length = format[1] == 'h' ? LL_CHAR : LL_SHORT;
+    format += format[1] == 'h' ? 2 : 1;
+    break;
+  case 'l':
+    spec->length = format[1] == 'l' ? LL_LONG_LONG : LL_LONG;
+    format += format[1] == 'l' ? 2 : 1;
+    break;
+  case 'z':
+    spec->length = LL_SIZE;
+    format++;
+    break;
+  case 'j':
+    spec->length = LL_MAX;
+    format++;
+    break;
+  case 't':
+    spec->length = LL_PTRDIFF;
+    format++;
+    break;
+  case 'L':
+    spec->length = LL_LONG_DOUBLE;
+    format++;
+    break;
+  }
+
+  spec->conversion = *format;
+  switch (spec->conversion)
+  {
+  case '%':
+    spec->argument = LA_LITERAL;
+    break;
+  case 'd':
+  case 'i':
+    spec->argument = LA_SIGNED;
+    break;
+  case 'u':
+  case 'o':
+  case 'x':
+  case 'X':
+    spec->argument = LA_UNSIGNED;
+    break;
+  case 'c':
+    spec->argument =
+        spec->length == LL_NONE ? LA_CHARACTER : LA_UNSUPPORTED;
+    break;
+  case 'f':
+  case 'F':
+  case 'e':
+  case 'E':
+  case 'g':
+  case 'G':
+  case 'a':
+  case 'A':
+    spec->argument = LA_DOUBLE;
+    break;
+  case 'p':
+    spec->argument = LA_POINTER;
+    break;
+  case 's':
+    // Wide strings aren't captured.
+    spec->argument = spec->length == LL_NONE ? LA_STRING : LA_UNSUPPORTED;
+    break;
+  default:
+    spec->argument = LA_UNSUPPORTED;
+    return format;
+  }
+
+  return format + 1;
+}
+
+// Rebuild `spec` with stars resolved and with `length` in place of its own
+// length modifier.
+static void log_build_spec(
+    char* buffer, const LogSpec* spec, const char* length)
+{
+  size_t written    = 0;
+  buffer[written++] = '%';
+  memcpy(&buffer[written], spec->flags, spec->flagsLength);
+  written += spec->flagsLength;
+  if (spec->hasWidth)
+  {
+    written += number_format_integer(spec->width, &buffer[written]);
+  }
+  if (spec->argument == LA_STRING)
+  {
+    memcpy(&buffer[written], ".*", 2);
+    written += 2;
+  }
+  else if (spec->hasPrecision && spec->precision >= 0)
+  {
+    buffer[written++] = '.';
+    written += number_format_integer(spec->precision, &buffer[written]);
+  }
+  size_t lengthSize = strlen(length);
+  memcpy(&buffer[written], length, lengthSize);
+  written += lengthSize;
+  buffer[written++] = spec->conversion;
+  buffer[written]   = '\0';
+}
+
+// Write one captured argument. Plain integers, characters and strings are
+// written directly, everything else through snprintf.
+static void log_format_argument(
+    const LogSpec* spec, const char* payload, char* line, size_t* length)
+{
+  int64_t value;
+  memcpy(&value, payload, sizeof(value));
+
+  bool plain =
+      spec->flagsLength == 0 && !spec->hasWidth && !spec->hasPrecision;
+  if (plain)
+  {
+    switch (spec->argument)
+    {
+    case LA_SIGNED:
+      log_append_integer(line, length, value);
+      return;
+    case LA_UNSIGNED:
+      if (spec->conversion == 'u' && value >= 0)
+      {
+        log_append_integer(line, length, value);
+        return;
+      }
+      break;
+    case LA_CHARACTER:
+    {
+      char character = (char) value;
+      log_append(line, length, &character, 1);
+      return;
+    }
+    case LA_STRING:
+      log_append(line, length, payload + sizeof(value), (size_t) value);
+      return;
+    default:
+      break;
+    }
+  }
+
+  // Room for a `%`, five flags, two numbers and a modifier.
+  char specText[48];
+  char* destination = &line[*length];
+  size_t room       = LOG_LINE_SIZE - *length;
+  double number;
+  switch (spec->argument)
+  {
+  case LA_SIGNED:
+    log_build_spec(specText, spec, "ll");
+    log_append_formatted(line, length,
+        snprintf(destination, room, specText, (long long) value));
+    break;
+  case LA_UNSIGNED:
+    log_build_spec(specText, spec, "ll");
+    log_append_formatted(line, length,
+        snprintf(destination, room, specText, (unsigned long long) value));
+    break;
+  case LA_CHARACTER:
+    log_build_spec(specText, spec, "");
+    log_append_formatted(
+        line, length, snprintf(destination, room, specText, (int) value));
+    break;
+  case LA_DOUBLE:
+    log_build_spec(specText, spec, "");
+    memcpy(&number, &value, sizeof(number));
+    log_append_formatted(
+        line, length, snprintf(destination, room, specText, number));
+    break;
+  case LA_POINTER:
+    log_build_spec(specText, spec, "");
+    log_append_formatted(line, length,
+        snprintf(destination, room, specText, (void*) (uintptr_t) value));
+    break;
+  case LA_STRING:
+    log_build_spec(specText, spec, "");
+    log_append_formatted(line, length,
+        snprintf(destination, room, specText, (int) value,
+            payload + sizeof(value)));
+    break;
+  default:
+    break;
+  }
+}
+
+void log_format_arguments(const char* format, const char* arguments,
+    size_t argumentsSize, char* line, size_t* length)
+{
+  const char* payload    = arguments;
+  const char* payloadEnd = arguments + argumentsSize;
+
+  while (true)
+  {
+    const char* percent = strchr(format, '%');
+    if (percent == NULL)
+    {
+      log_append(line, length, format, strlen(format));
+      return;
+    }
+    log_append(line, length, format, (size_t) (percent - format));
+
+    LogSpec spec;
+    const char* next = log_parse_spec(percent + 1, &spec);
+    size_t slots     = spec.widthStar + spec.precisionStar
+                 + (spec.argument != LA_LITERAL);
+    if (spec.argument == LA_UNSUPPORTED
+        || payload + slots * sizeof(uint64_t) > payloadEnd)
+    {
+      // Whatever wasn't captured is written as is.
+      log_append(line, length, percent, strlen(percent));
+      return;
+    }
+    format = next;
+
+    if (spec.argument == LA_LITERAL)
+    {
+      log_append(line, length, "%", 1);
+      continue;
+    }
+
+    int64_t star;
+    if (spec.widthStar)
+    {
+      memcpy(&star, payload, sizeof(star));
+      payload += sizeof(star);
+      // A negative width left aligns, which its minus sign still does.
+      spec.width = (int) star;
+    }
+    if (spec.precisionStar)
+    {
+      memcpy(&star, payload, sizeof(star));
+      payload += sizeof(star);
+      spec.precision = (int) star;
+    }
+
+    size_t characters = 0;
+    if (spec.argument == LA_STRING)
+    {
+      uint64_t count;
+      memcpy(&count, payload, sizeof(count));
+      // Only a damaged binary log gets this wrong.
+      if (count > (size_t) (payloadEnd - payload) - sizeof(count))
+      {
+        log_append(line, length, percent, strlen(percent));
+        return;
+      }
+      characters = (count + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+    }
+
+    log_format_argument(&spec, payload, line, length);
+    payload += sizeof(uint64_t) + characters;
+  }
+}
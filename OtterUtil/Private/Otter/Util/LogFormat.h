@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Otter/Util/BinaryLog.h"
+#include "Otter/Util/String/Number.h"
+
+// Longest line the logger writes, including its newline.
+#define LOG_LINE_SIZE 2048
+
+enum LogLength
+{
+  LL_NONE,
+  LL_CHAR,
+  LL_SHORT,
+  LL_LONG,
+  LL_LONG_LONG,
+  LL_SIZE,
+  LL_MAX,
+  LL_PTRDIFF,
+  LL_LONG_DOUBLE
+};
+
+// Each of `-+ #0` only means something once. Longer flag runs are unsupported.
+#define LOG_SPEC_MAX_FLAGS 5
+
+// One parsed conversion of a format string.
+typedef struct LogSpec
+{
+  const char* flags;
+  size_t flagsLength;
+  int width;
+  bool hasWidth;
+  bool widthStar;
+  int precision;
+  bool hasPrecision;
+  bool precisionStar;
+  enum LogLength length;
+  char conversion;
+  enum LogArgument argument;
+} LogSpec;
+
+// Parse the conversion after a `%`. Returns where the format continues.
+const char* log_parse_spec(const char* format, LogSpec* spec);
+
+/**
+ * @brief Format the arguments `format` captured into slots at `line`, which
+ * holds `LOG_LINE_SIZE` characters. Conversions the arguments run out for are
+ * written as is.
+ */
+void log_format_arguments(const char* format, const char* arguments,
+    size_t argumentsSize, char* line, size_t* length);
+
+static inline void log_append(
+    char* line, size_t* length, const char* text, size_t textLength)
+{
+  size_t count = min(textLength, LOG_LINE_SIZE - 1 - *length);
+  memcpy(&line[*length], text, count);
+  *length += count;
+}
+
+static inline void log_append_integer(char* line, size_t* length, int64_t value)
+{
+  char digits[NUMBER_FORMAT_BUFFER_SIZE];
+  log_append(line, length, digits, number_format_integer(value, digits));
+}
+
+static inline void log_append_formatted(char* line, size_t* length, int written)
+{
+  if (written > 0)
+  {
+    *length = min(*length + written, LOG_LINE_SIZE - 1);
+  }
+}
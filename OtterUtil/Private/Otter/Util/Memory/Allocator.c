@@ -0,0 +1,30 @@
+#include "Otter/Util/Memory/Allocator.h"
+
+static void* allocator_default_allocate(void* context, size_t size)
+{
+  return malloc(size);
+}
+
+static void* allocator_default_reallocate(
+    void* context, void* memory, size_t oldSize, size_t newSize)
+{
+  return realloc(memory, newSize);
+}
+
+static void allocator_default_deallocate(
+    void* context, void* memory, size_t size)
+{
+  free(memory);
+}
+
+static Allocator g_defaultAllocator = {
+    .allocate   = allocator_default_allocate,
+    .reallocate = allocator_default_reallocate,
+    .deallocate = allocator_default_deallocate,
+    .context    = NULL,
+};
+
+Allocator* allocator_get_default()
+{
+  return &g_defaultAllocator;
+}
@@ -0,0 +1,181 @@
+#include "Otter/Util/Memory/Arena.h"
+
+#include "Otter/Util/Log.h"
+
+struct ArenaBlock
+{
+  ArenaBlock* previous;
+  size_t capacity;
+  size_t used;
+};
+
+static size_t arena_align(size_t size)
+{
+  if (size == 0)
+  {
+    return ARENA_ALIGNMENT;
+  }
+  return (size + ARENA_ALIGNMENT - 1) & ~((size_t) ARENA_ALIGNMENT - 1);
+}
+
+static char* arena_block_data(ArenaBlock* block)
+{
+  return (char*) block + arena_align(sizeof(ArenaBlock));
+}
+
+static bool arena_push_block(Arena* arena, size_t capacity)
+{
+  ArenaBlock* block = allocator_allocate(
+      arena->parent, arena_align(sizeof(ArenaBlock)) + capacity);
+  if (block == NULL)
+  {
+    LOG_WARNING("Out of memory. Unable to grow arena.");
+    return false;
+  }
+
+  block->previous = arena->current;
+  block->capacity = capacity;
+  block->used     = 0;
+  arena->current  = block;
+  return true;
+}
+
+static void arena_release_blocks(Arena* arena)
+{
+  while (arena->current != NULL)
+  {
+    ArenaBlock* previous = arena->current->previous;
+    allocator_deallocate(arena->parent, arena->current,
+        arena_align(sizeof(ArenaBlock)) + arena->current->capacity);
+    arena->current = previous;
+  }
+}
+
+// Only true for the most recent allocation, which can grow, shrink or be
+// freed in place.
+static bool arena_is_last_allocation(Arena* arena, void* memory, size_t size)
+{
+  return arena->current != NULL
+      && (char*) memory + arena_align(size)
+             == arena_block_data(arena->current) + arena->current->used;
+}
+
+static void* arena_allocator_allocate(void* context, size_t size)
+{
+  return arena_allocate(context, size);
+}
+
+static void* arena_allocator_reallocate(
+    void* context, void* memory, size_t oldSize, size_t newSize)
+{
+  Arena* arena = context;
+  if (memory == NULL)
+  {
+    return arena_allocate(arena, newSize);
+  }
+
+  if (arena_is_last_allocation(arena, memory, oldSize))
+  {
+    size_t start = arena->current->used - arena_align(oldSize);
+    if (start + arena_align(newSize) <= arena->current->capacity)
+    {
+      arena->current->used = start + arena_align(newSize);
+      return memory;
+    }
+  }
+  else if (newSize <= oldSize)
+  {
+    return memory;
+  }
+
+  void* newMemory = arena_allocate(arena, newSize);
+  if (newMemory != NULL)
+  {
+    memcpy(newMemory, memory, min(oldSize, newSize));
+  }
+  return newMemory;
+}
+
+static void arena_allocator_deallocate(void* context, void* memory, size_t size)
+{
+  Arena* arena = context;
+  if (arena_is_last_allocation(arena, memory, size))
+  {
+    arena->current->used -= arena_align(size);
+  }
+}
+
+bool arena_create(Arena* arena, size_t blockSize, Allocator* parent)
+{
+  arena->allocator.allocate   = arena_allocator_allocate;
+  arena->allocator.reallocate = arena_allocator_reallocate;
+  arena->allocator.deallocate = arena_allocator_deallocate;
+  arena->allocator.context    = arena;
+  arena->parent               = parent;
+  arena->current              = NULL;
+  arena->blockSize            = arena_align(blockSize);
+
+  return arena_push_block(arena, arena->blockSize);
+}
+
+void arena_destroy(Arena* arena)
+{
+  arena_release_blocks(arena);
+}
+
+void* arena_allocate(Arena* arena, size_t size)
+{
+  size = arena_align(size);
+  if (arena->current == NULL
+      || arena->current->used + size > arena->current->capacity)
+  {
+    if (!arena_push_block(arena, max(arena->blockSize, size)))
+    {
+      return NULL;
+    }
+  }
+
+  void* memory = arena_block_data(arena->current) + arena->current->used;
+  arena->current->used += size;
+  return memory;
+}
+
+void arena_reset(Arena* arena)
+{
+  if (arena->current == NULL)
+  {
+    return;
+  }
+
+  if (arena->current->previous == NULL)
+  {
+    arena->current->used = 0;
+    return;
+  }
+
+  // The last cycle overflowed the first block, so coalesce everything into a
+  // single block that would have fit it.
+  size_t capacity   = 0;
+  ArenaBlock* block = arena->current;
+  while (block != NULL)
+  {
+    capacity += block->capacity;
+    block = block->previous;
+  }
+
+  arena_release_blocks(arena);
+  arena->blockSize = capacity;
+  arena_push_block(arena, capacity);
+}
+
+size_t arena_get_used(Arena* arena)
+{
+  size_t used       = 0;
+  ArenaBlock* block = arena->current;
+  while (block != NULL)
+  {
+    used += block->used;
+    block = block->previous;
+  }
+  return used;
+}
@@ -0,0 +1,187 @@
+#include "Otter/Util/Memory/MemoryTag.h"
+
+// Counted from any thread, so each tag is padded to a cache line.
+typedef struct MemoryTagCounters
+{
+  volatile LONG64 currentBytes;
+  volatile LONG64 peakBytes;
+  volatile LONG64 liveAllocations;
+  volatile LONG64 totalAllocations;
+  volatile LONG64 allocationsPerSecond;
+  // `totalAllocations` when the rate was last measured. Owned by
+  // `memory_tag_update`.
+  int64_t sampledAllocations;
+  char padding[16];
+} MemoryTagCounters;
+
+static MemoryTagCounters g_memoryTagCounters[MEMORY_TAG_COUNT];
+
+static LARGE_INTEGER g_memoryTagSampleTime;
+
+static void memory_tag_add_bytes(MemoryTagCounters* counters, int64_t bytes)
+{
+  int64_t current =
+      InterlockedExchangeAdd64(&counters->currentBytes, bytes) + bytes;
+
+  int64_t peak = counters->peakBytes;
+  while (current > peak)
+  {
+    int64_t previous =
+        InterlockedCompareExchange64(&counters->peakBytes, current, peak);
+    if (previous == peak)
+    {
+      break;
+    }
+    peak = previous;
+  }
+}
+
+static void* memory_tag_allocate(void* context, size_t size)
+{
+  void* memory = malloc(size);
+  if (memory != NULL)
+  {
+    MemoryTagCounters* counters = context;
+    memory_tag_add_bytes(counters, (int64_t) size);
+    InterlockedIncrement64(&counters->liveAllocations);
+    InterlockedIncrement64(&counters->totalAllocations);
+  }
+  return memory;
+}
+
+static void* memory_tag_reallocate(
+    void* context, void* memory, size_t oldSize, size_t newSize)
+{
+  void* newMemory = realloc(memory, newSize);
+  if (newMemory != NULL)
+  {
+    MemoryTagCounters* counters = context;
+    memory_tag_add_bytes(counters, (int64_t) newSize - (int64_t) oldSize);
+    if (memory == NULL)
+    {
+      InterlockedIncrement64(&counters->liveAllocations);
+    }
+    InterlockedIncrement64(&counters->totalAllocations);
+  }
+  return newMemory;
+}
+
+static void memory_tag_deallocate(void* context, void* memory, size_t size)
+{
+  MemoryTagCounters* counters = context;
+  free(memory);
+  memory_tag_add_bytes(counters, -(int64_t) size);
+  InterlockedDecrement64(&counters->liveAllocations);
+}
+
+#define MEMORY_TAG_ALLOCATOR(tag)                                            \
+  {memory_tag_allocate, memory_tag_reallocate, memory_tag_deallocate,        \
+      &g_memoryTagCounters[tag]}
+
+static Allocator g_memoryTagAllocators[MEMORY_TAG_COUNT] = {
+    MEMORY_TAG_ALLOCATOR(MEMORY_TAG_GENERAL),
+    MEMORY_TAG_ALLOCATOR(MEMORY_TAG_HASH_MAP),
+    MEMORY_TAG_ALLOCATOR(MEMORY_TAG_JSON),
+    MEMORY_TAG_ALLOCATOR(MEMORY_TAG_ECS),
+    MEMORY_TAG_ALLOCATOR(MEMORY_TAG_ASSET),
+    MEMORY_TAG_ALLOCATOR(MEMORY_TAG_RENDER),
+    MEMORY_TAG_ALLOCATOR(MEMORY_TAG_GPU_BUFFER),
+    MEMORY_TAG_ALLOCATOR(MEMORY_TAG_GPU_IMAGE),
+};
+
+static const char* g_memoryTagNames[MEMORY_TAG_COUNT] = {
+    "general",
+    "hash_map",
+    "json",
+    "ecs",
+    "asset",
+    "render",
+    "gpu_buffer",
+    "gpu_image",
+};
+
+Allocator* memory_tag_get_allocator(MemoryTag tag)
+{
+  return &g_memoryTagAllocators[tag];
+}
+
+void memory_tag_track(MemoryTag tag, int64_t bytes)
+{
+  MemoryTagCounters* counters = &g_memoryTagCounters[tag];
+  memory_tag_add_bytes(counters, bytes);
+  InterlockedIncrement64(&counters->liveAllocations);
+  InterlockedIncrement64(&counters->totalAllocations);
+}
+
+void memory_tag_untrack(MemoryTag tag, int64_t bytes)
+{
+  MemoryTagCounters* counters = &g_memoryTagCounters[tag];
+  memory_tag_add_bytes(counters, -bytes);
+  InterlockedDecrement64(&counters->liveAllocations);
+}
+
+const char* memory_tag_name(MemoryTag tag)
+{
+  return g_memoryTagNames[tag];
+}
+
+void memory_tag_get_statistics(MemoryTag tag, MemoryTagStatistics* statistics)
+{
+  MemoryTagCounters* counters      = &g_memoryTagCounters[tag];
+  statistics->currentBytes         = ReadAcquire64(&counters->currentBytes);
+  statistics->peakBytes            = ReadAcquire64(&counters->peakBytes);
+  statistics->liveAllocations      = ReadAcquire64(&counters->liveAllocations);
+  statistics->totalAllocations     = ReadAcquire64(&counters->totalAllocations);
+  statistics->allocationsPerSecond =
+      (float) ReadAcquire64(&counters->allocationsPerSecond);
+}
+
+void memory_tag_update()
+{
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER now;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&now);
+
+  int64_t elapsed = now.QuadPart - g_memoryTagSampleTime.QuadPart;
+  if (elapsed < frequency.QuadPart)
+  {
+    return;
+  }
+
+  // The first call only marks where the rate is measured from.
+  bool first            = g_memoryTagSampleTime.QuadPart == 0;
+  g_memoryTagSampleTime = now;
+  for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+  {
+    MemoryTagCounters* counters = &g_memoryTagCounters[i];
+    int64_t total = ReadAcquire64(&counters->totalAllocations);
+    if (!first)
+    {
+      WriteRelease64(&counters->allocationsPerSecond,
+          (total - counters->sampledAllocations) * frequency.QuadPart
+              / elapsed);
+    }
+    counters->sampledAllocations = total;
+  }
+}
+
+void memory_tag_report(FILE* output)
+{
+  fprintf(output, "%-12s %12s %12s %10s %10s\n", "memory (KiB)", "current",
+      "peak", "live", "allocs/s");
+  for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+  {
+    MemoryTagStatistics statistics;
+    memory_tag_get_statistics(i, &statistics);
+    if (statistics.totalAllocations == 0)
+    {
+      continue;
+    }
+
+    fprintf(output, "%-12s %12.1f %12.1f %10lld %10.0f\n",
+        g_memoryTagNames[i], statistics.currentBytes / 1024.0,
+        statistics.peakBytes / 1024.0, (long long) statistics.liveAllocations,
+        statistics.allocationsPerSecond);
+  }
+}
@@ -0,0 +1,155 @@
+#include "Otter/Util/Memory/PoolAllocator.h"
+
+#include "Otter/Util/Log.h"
+
+static int pool_allocator_get_size_class(size_t size, size_t* blockSize)
+{
+  int sizeClass = 0;
+  *blockSize    = POOL_ALLOCATOR_MIN_BLOCK_SIZE;
+  while (*blockSize < size)
+  {
+    *blockSize <<= 1;
+    sizeClass++;
+  }
+  return sizeClass;
+}
+
+static void* pool_allocator_refill(
+    PoolAllocator* pool, int sizeClass, size_t blockSize)
+{
+  // The start of every slab links it into the pool so it can be freed on
+  // destroy.
+  char* slab = _aligned_malloc(
+      POOL_ALLOCATOR_SLAB_SIZE, MEMORY_ALLOCATION_ALIGNMENT);
+  if (slab == NULL)
+  {
+    LOG_WARNING("Out of memory. Unable to grow pool.");
+    return NULL;
+  }
+  memory_tag_track(pool->tag, POOL_ALLOCATOR_SLAB_SIZE);
+  InterlockedPushEntrySList(&pool->slabs, (PSLIST_ENTRY) slab);
+
+  char* block = slab + sizeof(SLIST_ENTRY);
+  char* end   = slab + POOL_ALLOCATOR_SLAB_SIZE - blockSize;
+
+  // Keep the first block for the caller and hand the rest to the free list.
+  void* result = block;
+  for (block += blockSize; block <= end; block += blockSize)
+  {
+    InterlockedPushEntrySList(
+        &pool->freeBlocks[sizeClass], (PSLIST_ENTRY) block);
+  }
+
+  return result;
+}
+
+static void* pool_allocator_allocate(void* context, size_t size)
+{
+  PoolAllocator* pool = context;
+  if (size > POOL_ALLOCATOR_MAX_BLOCK_SIZE)
+  {
+    return OTTER_ALLOC(pool->tag, size);
+  }
+
+  size_t blockSize;
+  int sizeClass = pool_allocator_get_size_class(size, &blockSize);
+
+  void* block = InterlockedPopEntrySList(&pool->freeBlocks[sizeClass]);
+  if (block == NULL)
+  {
+    block = pool_allocator_refill(pool, sizeClass, blockSize);
+  }
+  return block;
+}
+
+static void pool_allocator_deallocate(void* context, void* memory, size_t size)
+{
+  PoolAllocator* pool = context;
+  if (size > POOL_ALLOCATOR_MAX_BLOCK_SIZE)
+  {
+    OTTER_FREE(pool->tag, memory, size);
+    return;
+  }
+
+  size_t blockSize;
+  int sizeClass = pool_allocator_get_size_class(size, &blockSize);
+  InterlockedPushEntrySList(&pool->freeBlocks[sizeClass], memory);
+}
+
+static void* pool_allocator_reallocate(
+    void* context, void* memory, size_t oldSize, size_t newSize)
+{
+  if (memory == NULL)
+  {
+    return pool_allocator_allocate(context, newSize);
+  }
+
+  if (oldSize > POOL_ALLOCATOR_MAX_BLOCK_SIZE
+      && newSize > POOL_ALLOCATOR_MAX_BLOCK_SIZE)
+  {
+    PoolAllocator* pool = context;
+    return OTTER_REALLOC(pool->tag, memory, oldSize, newSize);
+  }
+
+  size_t oldBlockSize = oldSize;
+  size_t newBlockSize = newSize;
+  if (oldSize <= POOL_ALLOCATOR_MAX_BLOCK_SIZE)
+  {
+    pool_allocator_get_size_class(oldSize, &oldBlockSize);
+  }
+  if (newSize <= POOL_ALLOCATOR_MAX_BLOCK_SIZE)
+  {
+    pool_allocator_get_size_class(newSize, &newBlockSize);
+  }
+
+  if (oldBlockSize == newBlockSize)
+  {
+    return memory;
+  }
+
+  void* newMemory = pool_allocator_allocate(context, newSize);
+  if (newMemory == NULL)
+  {
+    return NULL;
+  }
+  memcpy(newMemory, memory, oldSize < newSize ? oldSize : newSize);
+  pool_allocator_deallocate(context, memory, oldSize);
+  return newMemory;
+}
+
+void pool_allocator_create(PoolAllocator* pool)
+{
+  pool_allocator_create_tagged(pool, MEMORY_TAG_GENERAL);
+}
+
+void pool_allocator_create_tagged(PoolAllocator* pool, MemoryTag tag)
+{
+  pool->allocator.allocate   = pool_allocator_allocate;
+  pool->allocator.reallocate = pool_allocator_reallocate;
+  pool->allocator.deallocate = pool_allocator_deallocate;
+  pool->allocator.context    = pool;
+  pool->tag                  = tag;
+
+  for (int i = 0; i < POOL_ALLOCATOR_SIZE_CLASSES; i++)
+  {
+    InitializeSListHead(&pool->freeBlocks[i]);
+  }
+  InitializeSListHead(&pool->slabs);
+}
+
+void pool_allocator_destroy(PoolAllocator* pool)
+{
+  for (int i = 0; i < POOL_ALLOCATOR_SIZE_CLASSES; i++)
+  {
+    InterlockedFlushSList(&pool->freeBlocks[i]);
+  }
+
+  PSLIST_ENTRY slab = InterlockedFlushSList(&pool->slabs);
+  while (slab != NULL)
+  {
+    PSLIST_ENTRY next = slab->Next;
+    _aligned_free(slab);
+    memory_tag_untrack(pool->tag, POOL_ALLOCATOR_SLAB_SIZE);
+    slab = next;
+  }
+}
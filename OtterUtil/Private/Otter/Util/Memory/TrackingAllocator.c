@@ -0,0 +1,85 @@
+#include "Otter/Util/Memory/TrackingAllocator.h"
+
+#include "Otter/Util/Log.h"
+
+static void tracking_allocator_add_bytes(
+    TrackingAllocator* tracker, int64_t bytes)
+{
+  int64_t current =
+      InterlockedExchangeAdd64(&tracker->currentBytes, bytes) + bytes;
+
+  int64_t peak = tracker->peakBytes;
+  while (current > peak)
+  {
+    int64_t previous =
+        InterlockedCompareExchange64(&tracker->peakBytes, current, peak);
+    if (previous == peak)
+    {
+      break;
+    }
+    peak = previous;
+  }
+}
+
+static void* tracking_allocator_allocate(void* context, size_t size)
+{
+  TrackingAllocator* tracker = context;
+  void* memory               = allocator_allocate(tracker->parent, size);
+  if (memory != NULL)
+  {
+    tracking_allocator_add_bytes(tracker, (int64_t) size);
+    InterlockedIncrement64(&tracker->liveAllocations);
+    InterlockedIncrement64(&tracker->totalAllocations);
+  }
+  return memory;
+}
+
+static void* tracking_allocator_reallocate(
+    void* context, void* memory, size_t oldSize, size_t newSize)
+{
+  TrackingAllocator* tracker = context;
+  void* newMemory =
+      allocator_reallocate(tracker->parent, memory, oldSize, newSize);
+  if (newMemory != NULL)
+  {
+    tracking_allocator_add_bytes(
+        tracker, (int64_t) newSize - (int64_t) oldSize);
+    if (memory == NULL)
+    {
+      InterlockedIncrement64(&tracker->liveAllocations);
+    }
+    InterlockedIncrement64(&tracker->totalAllocations);
+  }
+  return newMemory;
+}
+
+static void tracking_allocator_deallocate(
+    void* context, void* memory, size_t size)
+{
+  TrackingAllocator* tracker = context;
+  allocator_deallocate(tracker->parent, memory, size);
+  tracking_allocator_add_bytes(tracker, -(int64_t) size);
+  InterlockedDecrement64(&tracker->liveAllocations);
+}
+
+void tracking_allocator_create(TrackingAllocator* tracker, Allocator* parent)
+{
+  tracker->allocator.allocate   = tracking_allocator_allocate;
+  tracker->allocator.reallocate = tracking_allocator_reallocate;
+  tracker->allocator.deallocate = tracking_allocator_deallocate;
+  tracker->allocator.context    = tracker;
+  tracker->parent               = parent;
+  tracker->currentBytes         = 0;
+  tracker->peakBytes            = 0;
+  tracker->liveAllocations      = 0;
+  tracker->totalAllocations     = 0;
+}
+
+void tracking_allocator_report(TrackingAllocator* tracker, const char* name)
+{
+  LOG_MSG(LOG_DEBUG,
+      "%s: %lld bytes in %lld allocations (peak %lld bytes, %lld total "
+      "allocations)",
+      name, tracker->currentBytes, tracker->liveAllocations,
+      tracker->peakBytes, tracker->totalAllocations);
+}
@@ -1,85 +1,1094 @@
 #include "Otter/Util/Profiler.h"
 
-#include "Otter/Util/HashMap.h"
+#include "Otter/Util/Counter.h"
+#include "Otter/Util/Cpu.h"
+#include "Otter/Util/Json/JsonWriter.h"
 #include "Otter/Util/Log.h"
+#include "Otter/Util/Memory/MemoryTag.h"
 
-#define PROFILE_TIME_SAMPLE_COUNT 50
+// Zones nested deeper than this on one thread aren't timed.
+#define PROFILER_MAX_DEPTH 64
 
-typedef struct ProfileTime
+// Finished zones each thread holds until `profiler_update` collects them.
+// Zones finished while its buffer is full are dropped and counted.
+#define PROFILER_EVENT_COUNT 4096
+
+// How long the timestamp counter is first measured for against the
+// performance counter. Every `profiler_update` measures it again over the
+// whole time since.
+#define PROFILER_CALIBRATION_MS 1
+
+// Longest thread name kept for captures, including the terminator.
+#define PROFILER_THREAD_NAME_SIZE 32
+
+// Events kept across the last `PROFILE_HITCH_FRAMES` frames. Frames whose
+// events have been written over by the ones after are left out of hitches.
+#define PROFILER_HITCH_EVENT_COUNT 32768
+
+// Least time between two hitches being written, so a long stall such as a
+// load doesn't write one every frame.
+#define PROFILER_HITCH_COOLDOWN_MS 1000
+
+enum ProfileEventType
+{
+  PET_ZONE,
+  // Only pushed while capturing.
+  PET_FLOW_BEGIN,
+  PET_FLOW_END,
+};
+
+// A zone one thread finished, or one end of a flow. Times are in timestamp
+// counter ticks.
+typedef struct ProfileEvent
+{
+  enum ProfileEventType type;
+  uint32_t threadId;
+  ProfileSite* site;
+  const ProfileSite* parent;
+  int64_t start;
+  union
+  {
+    struct
+    {
+      int64_t end;
+      // Time spent in the zone but not in the zones inside it.
+      int64_t selfTicks;
+    };
+    uint64_t flow;
+  };
+} ProfileEvent;
+
+typedef struct ProfileFrame
 {
-  uint32_t cursor;
-  uint32_t numOfSamples;
-  float times[PROFILE_TIME_SAMPLE_COUNT];
-  float totalTime;
-  LARGE_INTEGER startTime;
-} ProfileTime;
+  ProfileSite* site;
+  int64_t start;
+  int64_t childTicks;
+} ProfileFrame;
 
-static HashMap g_clockTimes;
-static bool g_profilingEnabled;
+// Owned by one thread, which pushes events that `profiler_update` pops.
+// `head` and `tail` count events ever popped and pushed, and sit on separate
+// cache lines.
+typedef struct ProfileThread
+{
+  struct ProfileThread* next;
+  // Whether a live thread owns the buffer. Buffers of threads that exit are
+  // picked up by new threads.
+  volatile LONG active;
+  uint32_t depth;
+  DWORD threadId;
+  // Empty until the owner names itself.
+  char name[PROFILER_THREAD_NAME_SIZE];
+  ProfileFrame stack[PROFILER_MAX_DEPTH];
+  // Dropped events already reported, owned by `profiler_update`.
+  int64_t reportedDropped;
+  char headPadding[56];
+  volatile LONG64 head;
+  char tailPadding[56];
+  volatile LONG64 tail;
+  // The owner's last look at `head`.
+  LONG64 cachedHead;
+  volatile LONG64 dropped;
+  char eventPadding[40];
+  ProfileEvent events[PROFILER_EVENT_COUNT];
+} ProfileThread;
+
+static bool g_profilerInitialized;
+static volatile LONG g_profilingEnabled;
 static LARGE_INTEGER g_timerFrequency;
 
-void profiler_init(LARGE_INTEGER frequency)
+// Where both clocks were when profiling started, and how fast the timestamp
+// counter ticks going by them.
+static uint64_t g_calibrationTimestamp;
+static int64_t g_calibrationCounter;
+static double g_timestampFrequency;
+static double g_nanosecondsPerTick;
+
+// Where the performance counter was when the current half of every site's
+// window started.
+static int64_t g_windowCounter;
+
+// Sites with the same name merged, for queries. Only touched under the lock.
+static Histogram g_profileMerged;
+
+static ProfileSite* volatile g_profileSites;
+static ProfileThread* volatile g_profileThreads;
+static _Thread_local ProfileThread* g_profileThread;
+static DWORD g_profileFlsIndex = FLS_OUT_OF_INDEXES;
+
+// Held by whoever is collecting events into the statistics or reading them.
+static CRITICAL_SECTION g_profilerLock;
+
+// The capture in progress, written as events are collected. Only touched
+// under the lock, except `g_capturing` which threads check to skip flows.
+static volatile LONG g_capturing;
+static JsonWriter g_captureWriter;
+static uint32_t g_captureFramesLeft;
+
+static volatile LONG64 g_profileFlowCount;
+
+static DWORD g_profileProcessId;
+
+// A frame kept in case it turns out to be a hitch.
+typedef struct ProfileHitchFrame
+{
+  // Events collected at the end of the frame, counted over every event kept.
+  int64_t firstEvent;
+  int64_t endEvent;
+  // Timestamp the frame ended at.
+  int64_t end;
+  // Nanoseconds since the frame before ended.
+  uint64_t time;
+  // Allocations made under each tag during the frame.
+  int64_t allocations[MEMORY_TAG_COUNT];
+} ProfileHitchFrame;
+
+// Hitch detection, only touched under the lock. `g_hitchEvents` is NULL when
+// it's off, which threads check to keep flows.
+static ProfileEvent* volatile g_hitchEvents;
+static int64_t g_hitchEventCount;
+static ProfileHitchFrame g_hitchFrames[PROFILE_HITCH_FRAMES];
+static uint64_t g_hitchFrameCount;
+static uint64_t g_hitchFrameTimes[PROFILE_HITCH_HISTORY];
+static uint64_t g_hitchTimedFrames;
+static int64_t g_hitchAllocations[MEMORY_TAG_COUNT];
+// Where the performance counter was when the last frame ended and when the
+// last hitch was written.
+static int64_t g_hitchFrameCounter;
+static int64_t g_hitchWriteCounter;
+static float g_hitchBudget;
+static char g_hitchDirectory[MAX_PATH];
+static char g_hitchPath[MAX_PATH];
+
+static void NTAPI profiler_release_thread(void* thread)
+{
+  if (thread != NULL)
+  {
+    InterlockedExchange(&((ProfileThread*) thread)->active, 0);
+  }
+}
+
+static ProfileThread* profiler_register_thread()
+{
+  ProfileThread* thread =
+      ReadPointerAcquire((void* volatile*) &g_profileThreads);
+  while (thread != NULL
+         && InterlockedCompareExchange(&thread->active, 1, 0) != 0)
+  {
+    thread = thread->next;
+  }
+
+  if (thread == NULL)
+  {
+    thread = malloc(sizeof(ProfileThread));
+    if (thread == NULL)
+    {
+      return NULL;
+    }
+
+    thread->active          = 1;
+    thread->reportedDropped = 0;
+    thread->head            = 0;
+    thread->tail            = 0;
+    thread->cachedHead      = 0;
+    thread->dropped         = 0;
+    do
+    {
+      thread->next = g_profileThreads;
+    } while (InterlockedCompareExchangePointer(
+                 (void* volatile*) &g_profileThreads, thread, thread->next)
+             != thread->next);
+  }
+
+  // A reused buffer may have been left inside zones by a thread that exited
+  // in them.
+  thread->depth    = 0;
+  thread->threadId = GetCurrentThreadId();
+  thread->name[0]  = '\0';
+  if (g_profileFlsIndex != FLS_OUT_OF_INDEXES)
+  {
+    FlsSetValue(g_profileFlsIndex, thread);
+  }
+  g_profileThread = thread;
+  return thread;
+}
+
+// Sites are added once and never removed, so the list can be walked without
+// a lock.
+static void profiler_register_site(ProfileSite* site)
 {
-  if (!hash_map_create(
-          &g_clockTimes, HASH_MAP_DEFAULT_BUCKETS, HASH_MAP_DEFAULT_COEF))
+  if (InterlockedCompareExchange(&site->registered, 1, 0) != 0)
   {
-    LOG_WARNING("Profiler did not initialize.");
     return;
   }
 
-  g_profilingEnabled = true;
+  do
+  {
+    site->next = g_profileSites;
+  } while (InterlockedCompareExchangePointer(
+               (void* volatile*) &g_profileSites, site, site->next)
+           != site->next);
+}
+
+// Measure the timestamp counter against the performance counter. A new
+// start waits briefly so there's something to measure. Returns where the
+// performance counter was.
+static int64_t profiler_calibrate(bool restart)
+{
+  LARGE_INTEGER counter;
+  if (restart)
+  {
+    QueryPerformanceCounter(&counter);
+    g_calibrationCounter   = counter.QuadPart;
+    g_calibrationTimestamp = cpu_read_timestamp();
+    int64_t end = counter.QuadPart
+                + g_timerFrequency.QuadPart * PROFILER_CALIBRATION_MS / 1000;
+    do
+    {
+      QueryPerformanceCounter(&counter);
+    } while (counter.QuadPart < end);
+  }
+  else
+  {
+    QueryPerformanceCounter(&counter);
+  }
+
+  uint64_t timestamp = cpu_read_timestamp();
+  int64_t elapsed    = counter.QuadPart - g_calibrationCounter;
+  if (elapsed > 0)
+  {
+    g_timestampFrequency = (double) (timestamp - g_calibrationTimestamp)
+                         * g_timerFrequency.QuadPart / elapsed;
+    g_nanosecondsPerTick = 1e9 / g_timestampFrequency;
+  }
+  return counter.QuadPart;
+}
+
+// Write the members every trace event has. Times are in microseconds since
+// profiling started.
+static void profiler_trace_common(
+    JsonWriter* writer, StringView phase, DWORD threadId, int64_t timestamp)
+{
+  json_writer_key(writer, STRING_VIEW_LITERAL("ph"));
+  json_writer_string(writer, phase);
+  json_writer_key(writer, STRING_VIEW_LITERAL("ts"));
+  json_writer_double(writer,
+      (double) (timestamp - (int64_t) g_calibrationTimestamp) * 1e6
+          / g_timestampFrequency);
+  json_writer_key(writer, STRING_VIEW_LITERAL("pid"));
+  json_writer_integer(writer, g_profileProcessId);
+  json_writer_key(writer, STRING_VIEW_LITERAL("tid"));
+  json_writer_integer(writer, threadId);
+}
+
+// Zones are complete events. Flows are arrows from the zone they begin in to
+// the zone they end in.
+static void profiler_trace_event(JsonWriter* writer, const ProfileEvent* event)
+{
+  json_writer_begin_object(writer);
+  json_writer_key(writer, STRING_VIEW_LITERAL("name"));
+  if (event->type == PET_ZONE)
+  {
+    json_writer_string(writer, string_view_from_cstr(event->site->name));
+    json_writer_key(writer, STRING_VIEW_LITERAL("cat"));
+    json_writer_string(writer, STRING_VIEW_LITERAL("zone"));
+    profiler_trace_common(
+        writer, STRING_VIEW_LITERAL("X"), event->threadId, event->start);
+    json_writer_key(writer, STRING_VIEW_LITERAL("dur"));
+    json_writer_double(
+        writer, (double) (event->end - event->start) * 1e6
+                    / g_timestampFrequency);
+  }
+  else
+  {
+    bool begin = event->type == PET_FLOW_BEGIN;
+    json_writer_string(writer, STRING_VIEW_LITERAL("flow"));
+    json_writer_key(writer, STRING_VIEW_LITERAL("cat"));
+    json_writer_string(writer, STRING_VIEW_LITERAL("flow"));
+    profiler_trace_common(writer,
+        begin ? STRING_VIEW_LITERAL("s") : STRING_VIEW_LITERAL("f"),
+        event->threadId, event->start);
+    json_writer_key(writer, STRING_VIEW_LITERAL("id"));
+    json_writer_integer(writer, (int64_t) event->flow);
+    if (!begin)
+    {
+      // Attach to the zone the flow ended in rather than the next one.
+      json_writer_key(writer, STRING_VIEW_LITERAL("bp"));
+      json_writer_string(writer, STRING_VIEW_LITERAL("e"));
+    }
+  }
+  json_writer_end_object(writer);
+}
+
+// A line across every thread where a frame ended.
+static void profiler_trace_frame(JsonWriter* writer, int64_t timestamp)
+{
+  json_writer_begin_object(writer);
+  json_writer_key(writer, STRING_VIEW_LITERAL("name"));
+  json_writer_string(writer, STRING_VIEW_LITERAL("frame"));
+  profiler_trace_common(
+      writer, STRING_VIEW_LITERAL("i"), GetCurrentThreadId(), timestamp);
+  json_writer_key(writer, STRING_VIEW_LITERAL("s"));
+  json_writer_string(writer, STRING_VIEW_LITERAL("g"));
+  json_writer_end_object(writer);
+}
+
+typedef struct ProfileCounterTrace
+{
+  JsonWriter* writer;
+  int64_t timestamp;
+} ProfileCounterTrace;
+
+// A counter track of what was added to the counter in the frame.
+static void profiler_trace_counter(
+    const char* name, const CounterSummary* summary, void* userData)
+{
+  const ProfileCounterTrace* trace = userData;
+  JsonWriter* writer               = trace->writer;
+  json_writer_begin_object(writer);
+  json_writer_key(writer, STRING_VIEW_LITERAL("name"));
+  json_writer_string(writer, string_view_from_cstr(name));
+  json_writer_key(writer, STRING_VIEW_LITERAL("cat"));
+  json_writer_string(writer, STRING_VIEW_LITERAL("counter"));
+  profiler_trace_common(
+      writer, STRING_VIEW_LITERAL("C"), GetCurrentThreadId(), trace->timestamp);
+  json_writer_key(writer, STRING_VIEW_LITERAL("args"));
+  json_writer_begin_object(writer);
+  json_writer_key(writer, STRING_VIEW_LITERAL("value"));
+  json_writer_double(writer, summary->frame);
+  json_writer_end_object(writer);
+  json_writer_end_object(writer);
+}
+
+// Name the threads that named themselves and end the events.
+static void profiler_trace_thread_names(JsonWriter* writer)
+{
+  for (ProfileThread* thread =
+           ReadPointerAcquire((void* volatile*) &g_profileThreads);
+       thread != NULL; thread = thread->next)
+  {
+    if (thread->name[0] == '\0')
+    {
+      continue;
+    }
+
+    json_writer_begin_object(writer);
+    json_writer_key(writer, STRING_VIEW_LITERAL("name"));
+    json_writer_string(writer, STRING_VIEW_LITERAL("thread_name"));
+    json_writer_key(writer, STRING_VIEW_LITERAL("ph"));
+    json_writer_string(writer, STRING_VIEW_LITERAL("M"));
+    json_writer_key(writer, STRING_VIEW_LITERAL("pid"));
+    json_writer_integer(writer, g_profileProcessId);
+    json_writer_key(writer, STRING_VIEW_LITERAL("tid"));
+    json_writer_integer(writer, thread->threadId);
+    json_writer_key(writer, STRING_VIEW_LITERAL("args"));
+    json_writer_begin_object(writer);
+    json_writer_key(writer, STRING_VIEW_LITERAL("name"));
+    json_writer_string(writer, string_view_from_cstr(thread->name));
+    json_writer_end_object(writer);
+    json_writer_end_object(writer);
+  }
+  json_writer_end_array(writer);
+}
+
+// Finish the events and close the file. Under the lock.
+static void profiler_capture_finish()
+{
+  JsonWriter* writer = &g_captureWriter;
+  profiler_trace_thread_names(writer);
+  json_writer_end_object(writer);
+
+  InterlockedExchange(&g_capturing, 0);
+  if (!json_writer_close(writer))
+  {
+    LOG_ERROR("Unable to write the profile capture.");
+  }
+}
+
+bool profiler_capture_start(const char* path, uint32_t frameCount)
+{
+  if (!g_profilerInitialized || frameCount == 0)
+  {
+    return false;
+  }
+
+  EnterCriticalSection(&g_profilerLock);
+  if (g_capturing)
+  {
+    LeaveCriticalSection(&g_profilerLock);
+    LOG_WARNING("A profile capture is already running.");
+    return false;
+  }
+
+  if (!json_writer_open(&g_captureWriter, path, JSON_WRITER_COMPACT))
+  {
+    LeaveCriticalSection(&g_profilerLock);
+    LOG_ERROR("Unable to open %s for a profile capture.", path);
+    return false;
+  }
+
+  json_writer_begin_object(&g_captureWriter);
+  json_writer_key(&g_captureWriter, STRING_VIEW_LITERAL("traceEvents"));
+  json_writer_begin_array(&g_captureWriter);
+  g_captureFramesLeft = frameCount;
+  InterlockedExchange(&g_capturing, 1);
+  LeaveCriticalSection(&g_profilerLock);
+  return true;
+}
+
+bool profiler_capture_active()
+{
+  return g_capturing != 0;
+}
+
+// How many allocations each tag has made since the last call.
+static void profiler_hitch_count_allocations(int64_t* allocations)
+{
+  for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+  {
+    MemoryTagStatistics statistics;
+    memory_tag_get_statistics(i, &statistics);
+    allocations[i]        = statistics.totalAllocations - g_hitchAllocations[i];
+    g_hitchAllocations[i] = statistics.totalAllocations;
+  }
+}
+
+bool profiler_hitch_detect(const char* directory, float budget)
+{
+  if (!g_profilerInitialized)
+  {
+    return false;
+  }
+
+  EnterCriticalSection(&g_profilerLock);
+  if (budget <= 0.0f)
+  {
+    free(g_hitchEvents);
+    g_hitchEvents = NULL;
+    LeaveCriticalSection(&g_profilerLock);
+    return true;
+  }
+
+  if (!CreateDirectoryA(directory, NULL)
+      && GetLastError() != ERROR_ALREADY_EXISTS)
+  {
+    LeaveCriticalSection(&g_profilerLock);
+    LOG_ERROR("Unable to make %s for hitches.", directory);
+    return false;
+  }
+
+  if (g_hitchEvents == NULL)
+  {
+    ProfileEvent* events =
+        malloc(PROFILER_HITCH_EVENT_COUNT * sizeof(ProfileEvent));
+    if (events == NULL)
+    {
+      LeaveCriticalSection(&g_profilerLock);
+      LOG_ERROR("Out of memory for hitch detection.");
+      return false;
+    }
+
+    g_hitchEventCount   = 0;
+    g_hitchFrameCount   = 0;
+    g_hitchTimedFrames  = 0;
+    g_hitchFrameCounter = 0;
+    g_hitchWriteCounter = 0;
+    int64_t allocations[MEMORY_TAG_COUNT];
+    profiler_hitch_count_allocations(allocations);
+    g_hitchEvents = events;
+  }
+  strncpy_s(
+      g_hitchDirectory, sizeof(g_hitchDirectory), directory, _TRUNCATE);
+  g_hitchBudget = budget;
+  LeaveCriticalSection(&g_profilerLock);
+  return true;
+}
+
+const char* profiler_hitch_get_last_path()
+{
+  return g_hitchPath;
+}
+
+static int profiler_compare_times(const void* a, const void* b)
+{
+  uint64_t first  = *(const uint64_t*) a;
+  uint64_t second = *(const uint64_t*) b;
+  return first < second ? -1 : (first > second ? 1 : 0);
+}
+
+static uint64_t profiler_hitch_median()
+{
+  uint64_t times[PROFILE_HITCH_HISTORY];
+  memcpy(times, g_hitchFrameTimes, sizeof(times));
+  qsort(times, PROFILE_HITCH_HISTORY, sizeof(uint64_t), profiler_compare_times);
+  return times[PROFILE_HITCH_HISTORY / 2];
+}
+
+// A counter track of the frame's allocations under each tag.
+static void profiler_trace_allocations(
+    JsonWriter* writer, const ProfileHitchFrame* frame)
+{
+  json_writer_begin_object(writer);
+  json_writer_key(writer, STRING_VIEW_LITERAL("name"));
+  json_writer_string(writer, STRING_VIEW_LITERAL("allocations"));
+  profiler_trace_common(
+      writer, STRING_VIEW_LITERAL("C"), GetCurrentThreadId(), frame->end);
+  json_writer_key(writer, STRING_VIEW_LITERAL("args"));
+  json_writer_begin_object(writer);
+  for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+  {
+    json_writer_key(writer, string_view_from_cstr(memory_tag_name(i)));
+    json_writer_integer(writer, frame->allocations[i]);
+  }
+  json_writer_end_object(writer);
+  json_writer_end_object(writer);
+}
+
+// What was going on when the hitch happened, beside the trace.
+static void profiler_hitch_write_summary(JsonWriter* writer,
+    const SYSTEMTIME* now, const ProfileHitchFrame* frame, uint64_t median)
+{
+  char time[32];
+  snprintf(time, sizeof(time), "%04u-%02u-%02u %02u:%02u:%02u.%03u",
+      now->wYear, now->wMonth, now->wDay, now->wHour, now->wMinute,
+      now->wSecond, now->wMilliseconds);
+
+  json_writer_key(writer, STRING_VIEW_LITERAL("hitch"));
+  json_writer_begin_object(writer);
+  json_writer_key(writer, STRING_VIEW_LITERAL("time"));
+  json_writer_string(writer, string_view_from_cstr(time));
+  json_writer_key(writer, STRING_VIEW_LITERAL("frame"));
+  json_writer_integer(writer, (int64_t) g_hitchFrameCount);
+  json_writer_key(writer, STRING_VIEW_LITERAL("frameMs"));
+  json_writer_double(writer, frame->time * 1e-6);
+  json_writer_key(writer, STRING_VIEW_LITERAL("medianMs"));
+  json_writer_double(writer, median * 1e-6);
+  json_writer_key(writer, STRING_VIEW_LITERAL("budget"));
+  json_writer_double(writer, g_hitchBudget);
+
+  json_writer_key(writer, STRING_VIEW_LITERAL("memory"));
+  json_writer_begin_object(writer);
+  for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+  {
+    MemoryTagStatistics statistics;
+    memory_tag_get_statistics(i, &statistics);
+    json_writer_key(writer, string_view_from_cstr(memory_tag_name(i)));
+    json_writer_begin_object(writer);
+    json_writer_key(writer, STRING_VIEW_LITERAL("bytes"));
+    json_writer_integer(writer, statistics.currentBytes);
+    json_writer_key(writer, STRING_VIEW_LITERAL("allocations"));
+    json_writer_integer(writer, frame->allocations[i]);
+    json_writer_end_object(writer);
+  }
+  json_writer_end_object(writer);
+  json_writer_end_object(writer);
+}
+
+// Write the frames kept as a Chrome trace, ending with the hitch in
+// `frame`. Under the lock.
+static void profiler_hitch_write(
+    const ProfileHitchFrame* frame, uint64_t median)
+{
+  SYSTEMTIME now;
+  GetLocalTime(&now);
+  snprintf(g_hitchPath, sizeof(g_hitchPath),
+      "%s/hitch-%04u%02u%02u-%02u%02u%02u-%llu.json", g_hitchDirectory,
+      now.wYear, now.wMonth, now.wDay, now.wHour, now.wMinute, now.wSecond,
+      (unsigned long long) g_hitchFrameCount);
+
+  JsonWriter writer;
+  if (!json_writer_open(&writer, g_hitchPath, JSON_WRITER_COMPACT))
+  {
+    LOG_ERROR("Unable to open %s for a hitch.", g_hitchPath);
+    g_hitchPath[0] = '\0';
+    return;
+  }
+
+  json_writer_begin_object(&writer);
+  json_writer_key(&writer, STRING_VIEW_LITERAL("traceEvents"));
+  json_writer_begin_array(&writer);
+  uint64_t frames = min(g_hitchFrameCount, PROFILE_HITCH_FRAMES);
+  for (uint64_t i = g_hitchFrameCount - frames; i < g_hitchFrameCount; i++)
+  {
+    const ProfileHitchFrame* kept = &g_hitchFrames[i % PROFILE_HITCH_FRAMES];
+    if (g_hitchEventCount - kept->firstEvent > PROFILER_HITCH_EVENT_COUNT)
+    {
+      continue;
+    }
+
+    for (int64_t event = kept->firstEvent; event < kept->endEvent; event++)
+    {
+      profiler_trace_event(&writer,
+          &g_hitchEvents[event & (PROFILER_HITCH_EVENT_COUNT - 1)]);
+    }
+    profiler_trace_frame(&writer, kept->end);
+    profiler_trace_allocations(&writer, kept);
+  }
+  profiler_trace_thread_names(&writer);
+  profiler_hitch_write_summary(&writer, &now, frame, median);
+  json_writer_end_object(&writer);
+
+  if (!json_writer_close(&writer))
+  {
+    LOG_ERROR("Unable to write %s for a hitch.", g_hitchPath);
+    g_hitchPath[0] = '\0';
+    return;
+  }
+  LOG_WARNING("A frame took %.1f ms, %.1f times the median. Wrote %s",
+      frame->time * 1e-6, (double) frame->time / median, g_hitchPath);
+}
+
+// Close the frame whose events were just kept and write it out if it's a
+// hitch. Under the lock.
+static void profiler_hitch_end_frame(int64_t counter)
+{
+  ProfileHitchFrame* frame =
+      &g_hitchFrames[g_hitchFrameCount % PROFILE_HITCH_FRAMES];
+  frame->firstEvent =
+      g_hitchFrameCount > 0
+          ? g_hitchFrames[(g_hitchFrameCount - 1) % PROFILE_HITCH_FRAMES]
+                .endEvent
+          : 0;
+  frame->endEvent = g_hitchEventCount;
+  frame->end      = (int64_t) cpu_read_timestamp();
+  frame->time     = 0;
+  profiler_hitch_count_allocations(frame->allocations);
+  g_hitchFrameCount++;
+
+  // The first frame after starting has no start to be timed from.
+  int64_t previous    = g_hitchFrameCounter;
+  g_hitchFrameCounter = counter;
+  if (previous == 0)
+  {
+    return;
+  }
+  frame->time = (uint64_t) ((double) (counter - previous) * 1e9
+                            / g_timerFrequency.QuadPart);
+
+  // Frames are only judged once there are enough before them.
+  if (g_hitchTimedFrames >= PROFILE_HITCH_HISTORY)
+  {
+    uint64_t median = profiler_hitch_median();
+    if (frame->time > median * g_hitchBudget
+        && counter - g_hitchWriteCounter
+               >= g_timerFrequency.QuadPart * PROFILER_HITCH_COOLDOWN_MS
+                      / 1000)
+    {
+      profiler_hitch_write(frame, median);
+      g_hitchWriteCounter = counter;
+    }
+  }
+  g_hitchFrameTimes[g_hitchTimedFrames++ % PROFILE_HITCH_HISTORY] =
+      frame->time;
+}
+
+void profiler_init(LARGE_INTEGER frequency)
+{
+  if (!g_profilerInitialized)
+  {
+    InitializeCriticalSection(&g_profilerLock);
+    g_profileFlsIndex     = FlsAlloc(profiler_release_thread);
+    g_profilerInitialized = true;
+  }
+
   g_timerFrequency   = frequency;
+  g_windowCounter    = profiler_calibrate(true);
+  g_profileProcessId = GetCurrentProcessId();
+  InterlockedExchange(&g_profilingEnabled, 1);
 }
 
 void profiler_destroy()
 {
-  hash_map_destroy(&g_clockTimes, free);
-  g_profilingEnabled = false;
+  // Threads may still be inside zones, so their buffers stay around for the
+  // next time profiling starts.
+  InterlockedExchange(&g_profilingEnabled, 0);
+
+  // A capture cut short still gets a complete file.
+  if (g_capturing)
+  {
+    profiler_update();
+    EnterCriticalSection(&g_profilerLock);
+    if (g_capturing)
+    {
+      profiler_capture_finish();
+    }
+    LeaveCriticalSection(&g_profilerLock);
+  }
+  profiler_hitch_detect(NULL, 0.0f);
+}
+
+void profiler_zone_begin(ProfileSite* site)
+{
+  ProfileThread* thread = g_profileThread;
+  if (!g_profilingEnabled
+      || (thread == NULL && (thread = profiler_register_thread()) == NULL))
+  {
+    return;
+  }
+
+  uint32_t depth = thread->depth++;
+  if (depth >= PROFILER_MAX_DEPTH)
+  {
+    return;
+  }
+
+  if (!site->registered)
+  {
+    profiler_register_site(site);
+  }
+
+  ProfileFrame* frame = &thread->stack[depth];
+  frame->site         = site;
+  frame->childTicks   = 0;
+  frame->start        = cpu_read_timestamp();
 }
 
-void profiler_clock_start(const char* key)
+// The next free event in the owner's buffer, or NULL after counting a drop
+// if it's full. Publish it by moving `tail` on.
+static ProfileEvent* profiler_reserve(ProfileThread* thread)
 {
-  ProfileTime* profileTime =
-      hash_map_get_value(&g_clockTimes, key, strlen(key));
-  if (profileTime == NULL)
+  int64_t tail = thread->tail;
+  if (tail - thread->cachedHead >= PROFILER_EVENT_COUNT)
   {
-    profileTime = calloc(1, sizeof(ProfileTime));
-    if (profileTime == NULL
-        || !hash_map_set_value(&g_clockTimes, key, strlen(key), profileTime))
+    thread->cachedHead = ReadAcquire64(&thread->head);
+    if (tail - thread->cachedHead >= PROFILER_EVENT_COUNT)
     {
-      return;
+      InterlockedIncrement64(&thread->dropped);
+      return NULL;
     }
   }
-  QueryPerformanceCounter(&profileTime->startTime);
+
+  return &thread->events[tail & (PROFILER_EVENT_COUNT - 1)];
 }
 
-void profiler_clock_end(const char* key)
+void profiler_zone_end()
 {
-  ProfileTime* profileTime =
-      hash_map_get_value(&g_clockTimes, key, strlen(key));
-  if (profileTime == NULL)
+  int64_t now = cpu_read_timestamp();
+
+  ProfileThread* thread = g_profileThread;
+  if (thread == NULL || thread->depth == 0)
   {
     return;
   }
-  LARGE_INTEGER endTime;
-  QueryPerformanceCounter(&endTime);
-  profileTime->totalTime -= profileTime->times[profileTime->cursor];
-  profileTime->times[profileTime->cursor] =
-      (float) (endTime.QuadPart - profileTime->startTime.QuadPart)
-      / g_timerFrequency.QuadPart;
-  profileTime->totalTime += profileTime->times[profileTime->cursor];
-  profileTime->cursor = (profileTime->cursor + 1) % PROFILE_TIME_SAMPLE_COUNT;
-  profileTime->numOfSamples =
-      (profileTime->numOfSamples + 1) % PROFILE_TIME_SAMPLE_COUNT;
+
+  uint32_t depth = --thread->depth;
+  if (depth >= PROFILER_MAX_DEPTH)
+  {
+    return;
+  }
+
+  ProfileFrame* frame = &thread->stack[depth];
+  int64_t ticks       = now - frame->start;
+  if (depth > 0)
+  {
+    thread->stack[depth - 1].childTicks += ticks;
+  }
+
+  ProfileEvent* event = profiler_reserve(thread);
+  if (event == NULL)
+  {
+    return;
+  }
+
+  event->type      = PET_ZONE;
+  event->threadId  = thread->threadId;
+  event->site      = frame->site;
+  event->parent    = depth > 0 ? thread->stack[depth - 1].site : NULL;
+  event->start     = frame->start;
+  event->end       = now;
+  event->selfTicks = ticks - frame->childTicks;
+  WriteRelease64(&thread->tail, thread->tail + 1);
 }
 
-float profiler_clock_get(const char* key)
+static void profiler_push_flow(enum ProfileEventType type, uint64_t flow)
+{
+  int64_t now = cpu_read_timestamp();
+
+  ProfileThread* thread = g_profileThread;
+  if (thread == NULL && (thread = profiler_register_thread()) == NULL)
+  {
+    return;
+  }
+
+  ProfileEvent* event = profiler_reserve(thread);
+  if (event == NULL)
+  {
+    return;
+  }
+
+  event->type     = type;
+  event->threadId = thread->threadId;
+  event->site     = NULL;
+  event->parent   = NULL;
+  event->start    = now;
+  event->flow     = flow;
+  WriteRelease64(&thread->tail, thread->tail + 1);
+}
+
+uint64_t profiler_flow_begin()
+{
+  if (!g_capturing && g_hitchEvents == NULL)
+  {
+    return 0;
+  }
+
+  uint64_t flow = (uint64_t) InterlockedIncrement64(&g_profileFlowCount);
+  profiler_push_flow(PET_FLOW_BEGIN, flow);
+  return flow;
+}
+
+void profiler_flow_end(uint64_t flow)
+{
+  if (flow != 0)
+  {
+    profiler_push_flow(PET_FLOW_END, flow);
+  }
+}
+
+void profiler_set_thread_name(const char* name)
+{
+  ProfileThread* thread = g_profileThread;
+  if (thread == NULL && (thread = profiler_register_thread()) == NULL)
+  {
+    return;
+  }
+
+  strncpy_s(thread->name, sizeof(thread->name), name, _TRUNCATE);
+}
+
+static uint64_t profiler_nanoseconds(int64_t ticks)
+{
+  return ticks > 0 ? (uint64_t) (ticks * g_nanosecondsPerTick) : 0;
+}
+
+static void profiler_record(const ProfileEvent* event)
+{
+  ProfileStatistics* statistics = &event->site->statistics;
+  uint64_t time     = profiler_nanoseconds(event->end - event->start);
+  uint64_t selfTime = profiler_nanoseconds(event->selfTicks);
+
+  histogram_record(&statistics->run, time);
+  histogram_record(&statistics->window[statistics->windowIndex], time);
+  statistics->runSelfTime += selfTime;
+  statistics->windowSelfTime[statistics->windowIndex] += selfTime;
+  statistics->parent = event->parent;
+}
+
+// Start a new half of every site's window, forgetting the oldest half.
+static void profiler_advance_windows()
+{
+  for (ProfileSite* site =
+           ReadPointerAcquire((void* volatile*) &g_profileSites);
+       site != NULL; site = site->next)
+  {
+    ProfileStatistics* statistics = &site->statistics;
+    statistics->windowIndex ^= 1;
+    histogram_clear(&statistics->window[statistics->windowIndex]);
+    statistics->windowSelfTime[statistics->windowIndex] = 0;
+  }
+}
+
+void profiler_update()
+{
+  if (!g_profilerInitialized)
+  {
+    return;
+  }
+
+  EnterCriticalSection(&g_profilerLock);
+  int64_t counter = profiler_calibrate(false);
+  if (counter - g_windowCounter
+      >= g_timerFrequency.QuadPart * PROFILE_WINDOW_MS / 1000)
+  {
+    profiler_advance_windows();
+    g_windowCounter = counter;
+  }
+
+  bool capturing = g_capturing != 0;
+  bool detecting = g_hitchEvents != NULL;
+  for (ProfileThread* thread =
+           ReadPointerAcquire((void* volatile*) &g_profileThreads);
+       thread != NULL; thread = thread->next)
+  {
+    int64_t head = thread->head;
+    int64_t tail = ReadAcquire64(&thread->tail);
+    for (; head < tail; head++)
+    {
+      const ProfileEvent* event =
+          &thread->events[head & (PROFILER_EVENT_COUNT - 1)];
+      if (event->type == PET_ZONE)
+      {
+        profiler_record(event);
+      }
+      if (capturing)
+      {
+        profiler_trace_event(&g_captureWriter, event);
+      }
+      if (detecting)
+      {
+        g_hitchEvents[g_hitchEventCount++ & (PROFILER_HITCH_EVENT_COUNT - 1)] =
+            *event;
+      }
+    }
+    WriteRelease64(&thread->head, head);
+
+    int64_t dropped = ReadAcquire64(&thread->dropped);
+    if (dropped != thread->reportedDropped)
+    {
+      LOG_WARNING("%lld profile zones were dropped because a thread finished "
+                  "them faster than they were collected.",
+          (long long) (dropped - thread->reportedDropped));
+      thread->reportedDropped = dropped;
+    }
+  }
+
+  if (detecting)
+  {
+    profiler_hitch_end_frame(counter);
+  }
+
+  if (capturing)
+  {
+    ProfileCounterTrace trace = {
+        &g_captureWriter, (int64_t) cpu_read_timestamp()};
+    profiler_trace_frame(&g_captureWriter, trace.timestamp);
+    counter_iterate(profiler_trace_counter, &trace);
+    if (--g_captureFramesLeft == 0)
+    {
+      profiler_capture_finish();
+    }
+  }
+  LeaveCriticalSection(&g_profilerLock);
+}
+
+// Merge every site named `key` into `g_profileMerged` and total their self
+// times. Under the lock.
+static uint64_t profiler_merge(const char* key, enum ProfileRange range)
 {
-  ProfileTime* profileTime =
-      hash_map_get_value(&g_clockTimes, key, strlen(key));
-  if (profileTime == NULL)
+  histogram_clear(&g_profileMerged);
+  uint64_t selfTime = 0;
+  for (ProfileSite* site =
+           ReadPointerAcquire((void* volatile*) &g_profileSites);
+       site != NULL; site = site->next)
+  {
+    if (strcmp(site->name, key) != 0)
+    {
+      continue;
+    }
+
+    const ProfileStatistics* statistics = &site->statistics;
+    if (range == PR_RUN)
+    {
+      histogram_merge(&g_profileMerged, &statistics->run);
+      selfTime += statistics->runSelfTime;
+    }
+    else
+    {
+      histogram_merge(&g_profileMerged, &statistics->window[0]);
+      histogram_merge(&g_profileMerged, &statistics->window[1]);
+      selfTime += statistics->windowSelfTime[0];
+      selfTime += statistics->windowSelfTime[1];
+    }
+  }
+  return selfTime;
+}
+
+// `g_profileMerged` in seconds. Under the lock.
+static void profiler_summarize(uint64_t selfTime, ProfileSummary* summary)
+{
+  const Histogram* merged = &g_profileMerged;
+  summary->count          = merged->count;
+  summary->min            = merged->min * 1e-9f;
+  summary->max            = merged->max * 1e-9f;
+  summary->mean           = (float) (histogram_mean(merged) * 1e-9);
+  summary->selfMean = (float) ((double) selfTime / merged->count * 1e-9);
+  summary->p50      = histogram_percentile(merged, 50.0) * 1e-9f;
+  summary->p95      = histogram_percentile(merged, 95.0) * 1e-9f;
+  summary->p99      = histogram_percentile(merged, 99.0) * 1e-9f;
+}
+
+bool profiler_summary_get(
+    const char* key, enum ProfileRange range, ProfileSummary* summary)
+{
+  if (!g_profilerInitialized)
+  {
+    return false;
+  }
+
+  EnterCriticalSection(&g_profilerLock);
+  uint64_t selfTime = profiler_merge(key, range);
+  bool found        = g_profileMerged.count > 0;
+  if (found)
+  {
+    profiler_summarize(selfTime, summary);
+  }
+  LeaveCriticalSection(&g_profilerLock);
+  return found;
+}
+
+float profiler_percentile_get(
+    const char* key, enum ProfileRange range, double percentile)
+{
+  if (!g_profilerInitialized)
   {
     return INFINITY;
   }
-  return profileTime->totalTime / profileTime->numOfSamples;
+
+  float time = INFINITY;
+  EnterCriticalSection(&g_profilerLock);
+  profiler_merge(key, range);
+  if (g_profileMerged.count > 0)
+  {
+    time = histogram_percentile(&g_profileMerged, percentile) * 1e-9f;
+  }
+  LeaveCriticalSection(&g_profilerLock);
+  return time;
+}
+
+float profiler_clock_get(const char* key)
+{
+  ProfileSummary summary;
+  return profiler_summary_get(key, PR_WINDOW, &summary) ? summary.mean
+                                                        : INFINITY;
+}
+
+float profiler_clock_get_self(const char* key)
+{
+  ProfileSummary summary;
+  return profiler_summary_get(key, PR_WINDOW, &summary) ? summary.selfMean
+                                                        : INFINITY;
+}
+
+void profiler_report(FILE* output)
+{
+  if (!g_profilerInitialized)
+  {
+    return;
+  }
+
+  EnterCriticalSection(&g_profilerLock);
+  fprintf(output, "%-32s %8s %9s %9s %9s %9s %9s\n", "zone (ms)", "count",
+      "mean", "p50", "p95", "p99", "max");
+  for (ProfileSite* site =
+           ReadPointerAcquire((void* volatile*) &g_profileSites);
+       site != NULL; site = site->next)
+  {
+    const ProfileStatistics* statistics = &site->statistics;
+    histogram_clear(&g_profileMerged);
+    histogram_merge(&g_profileMerged, &statistics->window[0]);
+    histogram_merge(&g_profileMerged, &statistics->window[1]);
+    if (g_profileMerged.count == 0)
+    {
+      continue;
+    }
+
+    ProfileSummary summary;
+    profiler_summarize(
+        statistics->windowSelfTime[0] + statistics->windowSelfTime[1],
+        &summary);
+    fprintf(output, "%-32s %8llu %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+        site->name, (unsigned long long) summary.count, summary.mean * 1e3f,
+        summary.p50 * 1e3f, summary.p95 * 1e3f, summary.p99 * 1e3f,
+        summary.max * 1e3f);
+  }
+  LeaveCriticalSection(&g_profilerLock);
 }
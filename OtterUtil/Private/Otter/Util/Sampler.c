@@ -0,0 +1,518 @@
+#include "Otter/Util/Sampler.h"
+
+#include <TlHelp32.h>
+
+#include "Otter/Util/Log.h"
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+#define SAMPLER_THREAD_NAME_SIZE 32
+
+#define SAMPLER_MAX_MODULES 512
+
+typedef struct SampledThread
+{
+  HANDLE handle;
+  DWORD threadId;
+  char name[SAMPLER_THREAD_NAME_SIZE];
+  // The thread's stack. A walk never reads outside it.
+  ULONG_PTR stackLow;
+  ULONG_PTR stackHigh;
+  // The run the thread's record was last written in. Owned by the sampler.
+  uint32_t writtenRun;
+  struct SampledThread* next;
+} SampledThread;
+
+// Threads are added once and kept after they exit, so the list can be walked
+// without a lock.
+static SampledThread* volatile g_sampledThreads;
+
+static volatile LONG g_samplerRunning;
+static HANDLE g_samplerThread;
+static HANDLE g_samplerStop;
+static FILE* g_sampleFile;
+static uint32_t g_samplerRate;
+static uint32_t g_samplerRun;
+
+typedef struct SampledModule
+{
+  DWORD64 start;
+  DWORD64 end;
+} SampledModule;
+
+// Where modules are loaded, sorted by start. Only the sampler thread uses it.
+static SampledModule g_sampledModules[SAMPLER_MAX_MODULES];
+static uint32_t g_sampledModuleCount;
+
+static uint32_t sampler_padded(uint32_t size)
+{
+  return (size + sizeof(uint64_t) - 1) & ~(uint32_t) (sizeof(uint64_t) - 1);
+}
+
+// A record followed by a null terminated string, padded to 8 bytes.
+static void sampler_write_named(
+    const void* record, size_t recordSize, const char* name, uint32_t length)
+{
+  static const char padding[sizeof(uint64_t)];
+  uint32_t size = (uint32_t) recordSize + length;
+  fwrite(record, 1, recordSize, g_sampleFile);
+  fwrite(name, 1, length, g_sampleFile);
+  fwrite(padding, 1, sampler_padded(size) - size, g_sampleFile);
+}
+
+static void sampler_write_thread(const SampledThread* thread)
+{
+  uint32_t length           = (uint32_t) strlen(thread->name) + 1;
+  SampleThreadRecord record = {
+      .record     = {SR_THREAD, sampler_padded(sizeof(record) + length)},
+      .threadId   = thread->threadId,
+      .nameLength = length};
+  sampler_write_named(&record, sizeof(record), thread->name, length);
+}
+
+// Modules are written when sampling stops so the ones loaded while it ran
+// are there too.
+static void sampler_write_modules()
+{
+  HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE, 0);
+  if (snapshot == INVALID_HANDLE_VALUE)
+  {
+    LOG_WARNING("Unable to list modules. Samples can't be symbolized.");
+    return;
+  }
+
+  MODULEENTRY32W module = {.dwSize = sizeof(module)};
+  for (BOOL found = Module32FirstW(snapshot, &module); found;
+       found      = Module32NextW(snapshot, &module))
+  {
+    char path[MAX_PATH * 3];
+    int length = WideCharToMultiByte(CP_UTF8, 0, module.szExePath, -1, path,
+        sizeof(path), NULL, NULL);
+    if (length <= 0)
+    {
+      continue;
+    }
+
+    SampleModuleRecord record = {
+        .record     = {SR_MODULE, sampler_padded(sizeof(record) + length)},
+        .base       = (uint64_t) (uintptr_t) module.modBaseAddr,
+        .size       = module.modBaseSize,
+        .pathLength = length};
+    sampler_write_named(&record, sizeof(record), path, length);
+  }
+  CloseHandle(snapshot);
+}
+
+static int sampler_compare_modules(const void* a, const void* b)
+{
+  const SampledModule* first  = a;
+  const SampledModule* second = b;
+  return (first->start > second->start) - (first->start < second->start);
+}
+
+// Called between samples, while no thread is suspended, as listing modules
+// takes the loader lock.
+static void sampler_refresh_modules()
+{
+  HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE, 0);
+  if (snapshot == INVALID_HANDLE_VALUE)
+  {
+    return;
+  }
+
+  uint32_t count        = 0;
+  MODULEENTRY32W module = {.dwSize = sizeof(module)};
+  for (BOOL found = Module32FirstW(snapshot, &module);
+       found && count < SAMPLER_MAX_MODULES;
+       found = Module32NextW(snapshot, &module))
+  {
+    SampledModule* range = &g_sampledModules[count++];
+    range->start         = (DWORD64) (uintptr_t) module.modBaseAddr;
+    range->end           = range->start + module.modBaseSize;
+  }
+  CloseHandle(snapshot);
+
+  qsort(g_sampledModules, count, sizeof(SampledModule),
+      sampler_compare_modules);
+  g_sampledModuleCount = count;
+}
+
+static bool sampler_in_module(DWORD64 address)
+{
+  uint32_t low  = 0;
+  uint32_t high = g_sampledModuleCount;
+  while (low < high)
+  {
+    uint32_t middle = low + (high - low) / 2;
+    if (address < g_sampledModules[middle].start)
+    {
+      high = middle;
+    }
+    else if (address >= g_sampledModules[middle].end)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Walk a suspended thread's stack with the unwind tables. Nothing here can
+// allocate or take a lock, as the thread may be holding it.
+static uint32_t sampler_walk(const SampledThread* thread, uint64_t* addresses)
+{
+  CONTEXT context;
+  context.ContextFlags = CONTEXT_CONTROL | CONTEXT_INTEGER;
+  if (!GetThreadContext(thread->handle, &context))
+  {
+    return 0;
+  }
+
+  uint32_t depth = 0;
+  while (depth < SAMPLER_MAX_DEPTH && context.Rip != 0)
+  {
+    addresses[depth++] = context.Rip;
+
+    // Unwinding reads the stack, so a walk that has wandered off it ends
+    // before anything is read.
+    if (context.Rsp < thread->stackLow
+        || context.Rsp >= thread->stackHigh - sizeof(DWORD64)
+        || context.Rsp % sizeof(DWORD64) != 0)
+    {
+      break;
+    }
+
+    // Unwind data for code outside modules, such as what the C# runtime
+    // generates, is kept in dynamic function tables. Searching them takes a
+    // lock the suspended thread may hold, so the walk ends there instead.
+    // Modules loaded since the last refresh end it early too.
+    if (!sampler_in_module(context.Rip))
+    {
+      break;
+    }
+
+    DWORD64 stackPointer = context.Rsp;
+    DWORD64 imageBase;
+    PRUNTIME_FUNCTION function =
+        RtlLookupFunctionEntry(context.Rip, &imageBase, NULL);
+    if (function == NULL)
+    {
+      // Leaf functions have no unwind data and leave the return address on
+      // top of the stack.
+      context.Rip = *(DWORD64*) context.Rsp;
+      context.Rsp += sizeof(DWORD64);
+    }
+    else
+    {
+      void* handlerData;
+      DWORD64 establisherFrame;
+      RtlVirtualUnwind(UNW_FLAG_NHANDLER, imageBase, context.Rip, function,
+          &context, &handlerData, &establisherFrame, NULL);
+    }
+
+    // A function without unwind data that isn't a leaf sends the walk off
+    // somewhere else.
+    if (context.Rsp <= stackPointer)
+    {
+      break;
+    }
+  }
+  return depth;
+}
+
+static void sampler_sample(SampledThread* thread, uint64_t* addresses)
+{
+  if (WaitForSingleObject(thread->handle, 0) == WAIT_OBJECT_0
+      || SuspendThread(thread->handle) == (DWORD) -1)
+  {
+    return;
+  }
+  LARGE_INTEGER now;
+  QueryPerformanceCounter(&now);
+  uint32_t depth = sampler_walk(thread, addresses);
+  ResumeThread(thread->handle);
+
+  if (depth == 0)
+  {
+    return;
+  }
+
+  if (thread->writtenRun != g_samplerRun)
+  {
+    sampler_write_thread(thread);
+    thread->writtenRun = g_samplerRun;
+  }
+
+  uint32_t addressesSize   = depth * sizeof(uint64_t);
+  SampleStackRecord record = {
+      .record    = {SR_STACK, sizeof(record) + addressesSize},
+      .threadId  = thread->threadId,
+      .depth     = depth,
+      .timestamp = now.QuadPart};
+  fwrite(&record, 1, sizeof(record), g_sampleFile);
+  fwrite(addresses, 1, addressesSize, g_sampleFile);
+}
+
+static DWORD WINAPI sampler_run(void* unused)
+{
+  (void) unused;
+
+  // Regular timers only fire every 15.6 ms or so.
+  HANDLE timer = CreateWaitableTimerExW(NULL, NULL,
+      CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+  if (timer == NULL)
+  {
+    LOG_WARNING("High resolution timers are unavailable. Sampling will be "
+                "coarse.");
+    timer = CreateWaitableTimerW(NULL, false, NULL);
+  }
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+
+  LARGE_INTEGER period = {.QuadPart = -10000000LL / g_samplerRate};
+  HANDLE events[]      = {g_samplerStop, timer};
+  uint64_t addresses[SAMPLER_MAX_DEPTH];
+  uint32_t ticks = 0;
+  sampler_refresh_modules();
+  while (SetWaitableTimer(timer, &period, 0, NULL, NULL, false)
+         && WaitForMultipleObjects(2, events, false, INFINITE)
+                == WAIT_OBJECT_0 + 1)
+  {
+    // About once a second, to see modules loaded since.
+    if (++ticks % g_samplerRate == 0)
+    {
+      sampler_refresh_modules();
+    }
+
+    for (SampledThread* thread =
+             ReadPointerAcquire((void* volatile*) &g_sampledThreads);
+         thread != NULL; thread = thread->next)
+    {
+      sampler_sample(thread, addresses);
+    }
+  }
+
+  CloseHandle(timer);
+  return 0;
+}
+
+bool sampler_start(const char* path, uint32_t rate)
+{
+  if (InterlockedCompareExchange(&g_samplerRunning, 1, 0) != 0)
+  {
+    LOG_WARNING("The sampler is already running.");
+    return false;
+  }
+
+  if (fopen_s(&g_sampleFile, path, "wb") != 0)
+  {
+    LOG_ERROR("Failed to open file for writing: %s", path);
+    InterlockedExchange(&g_samplerRunning, 0);
+    return false;
+  }
+  setvbuf(g_sampleFile, NULL, _IOFBF, 1 << 20);
+
+  g_samplerRate = rate > 0 ? rate : SAMPLER_DEFAULT_RATE;
+  g_samplerRun++;
+
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER start;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&start);
+  SampleFileHeader header = {
+      .version   = SAMPLE_FILE_VERSION,
+      .rate      = g_samplerRate,
+      .frequency = frequency.QuadPart,
+      .start     = start.QuadPart};
+  memcpy(header.magic, SAMPLE_FILE_MAGIC, sizeof(header.magic));
+  fwrite(&header, 1, sizeof(header), g_sampleFile);
+
+  g_samplerStop   = CreateEvent(NULL, true, false, NULL);
+  g_samplerThread = CreateThread(NULL, 0, sampler_run, NULL, 0, NULL);
+  if (g_samplerThread == NULL)
+  {
+    LOG_ERROR("Unable to start the sampler thread.");
+    CloseHandle(g_samplerStop);
+    fclose(g_sampleFile);
+    InterlockedExchange(&g_samplerRunning, 0);
+    return false;
+  }
+
+  return true;
+}
+
+void sampler_stop()
+{
+  if (!g_samplerRunning)
+  {
+    return;
+  }
+
+  SetEvent(g_samplerStop);
+  WaitForSingleObject(g_samplerThread, INFINITE);
+  CloseHandle(g_samplerThread);
+  CloseHandle(g_samplerStop);
+
+  sampler_write_modules();
+  if (fclose(g_sampleFile) != 0)
+  {
+    LOG_ERROR("Failed to finish the sample file.");
+  }
+  InterlockedExchange(&g_samplerRunning, 0);
+}
+
+bool sampler_active()
+{
+  return g_samplerRunning != 0;
+}
+
+void sampler_register_thread(const char* name)
+{
+  SampledThread* thread = malloc(sizeof(SampledThread));
+  if (thread == NULL)
+  {
+    LOG_WARNING("Out of memory registering %s with the sampler.", name);
+    return;
+  }
+
+  thread->threadId = GetCurrentThreadId();
+  thread->handle =
+      OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | SYNCHRONIZE,
+          false, thread->threadId);
+  if (thread->handle == NULL)
+  {
+    LOG_WARNING("Unable to open thread %s for sampling.", name);
+    free(thread);
+    return;
+  }
+  strncpy_s(thread->name, sizeof(thread->name), name, _TRUNCATE);
+  GetCurrentThreadStackLimits(&thread->stackLow, &thread->stackHigh);
+  thread->writtenRun = 0;
+
+  do
+  {
+    thread->next = g_sampledThreads;
+  } while (InterlockedCompareExchangePointer(
+               (void* volatile*) &g_sampledThreads, thread, thread->next)
+           != thread->next);
+}
+
+bool sample_reader_open(SampleReader* reader, const char* data, uint64_t length)
+{
+  SampleFileHeader header;
+  if (length < sizeof(header))
+  {
+    LOG_WARNING("Sample file is too short for its header.");
+    return false;
+  }
+
+  memcpy(&header, data, sizeof(header));
+  if (memcmp(header.magic, SAMPLE_FILE_MAGIC, sizeof(header.magic)) != 0
+      || header.version != SAMPLE_FILE_VERSION || header.frequency <= 0)
+  {
+    LOG_WARNING("Not a sample file, or one of a different version.");
+    return false;
+  }
+
+  reader->data      = data;
+  reader->length    = length;
+  reader->offset    = sizeof(header);
+  reader->rate      = header.rate;
+  reader->frequency = header.frequency;
+  reader->start     = header.start;
+  return true;
+}
+
+// The string after a record, which has to fit in it and be terminated.
+static const char* sample_reader_name(const char* data, uint32_t size,
+    uint32_t recordSize, uint32_t length)
+{
+  if (length == 0 || (uint64_t) recordSize + length > size
+      || data[recordSize + length - 1] != '\0')
+  {
+    return NULL;
+  }
+  return data + recordSize;
+}
+
+bool sample_reader_next(SampleReader* reader, SampleEntry* entry)
+{
+  if (reader->length - reader->offset < sizeof(SampleRecord))
+  {
+    return false;
+  }
+
+  const char* data = &reader->data[reader->offset];
+  SampleRecord record;
+  memcpy(&record, data, sizeof(record));
+  if (record.size < sizeof(record) || record.size % sizeof(uint64_t) != 0
+      || record.size > reader->length - reader->offset)
+  {
+    return false;
+  }
+
+  memset(entry, 0, sizeof(SampleEntry));
+  entry->type = record.type;
+  switch (record.type)
+  {
+  case SR_THREAD:
+  {
+    SampleThreadRecord thread;
+    if (record.size < sizeof(thread))
+    {
+      return false;
+    }
+    memcpy(&thread, data, sizeof(thread));
+    entry->threadId = thread.threadId;
+    entry->name     = sample_reader_name(
+        data, record.size, sizeof(thread), thread.nameLength);
+    break;
+  }
+  case SR_MODULE:
+  {
+    SampleModuleRecord module;
+    if (record.size < sizeof(module))
+    {
+      return false;
+    }
+    memcpy(&module, data, sizeof(module));
+    entry->base = module.base;
+    entry->size = module.size;
+    entry->name = sample_reader_name(
+        data, record.size, sizeof(module), module.pathLength);
+    break;
+  }
+  case SR_STACK:
+  {
+    SampleStackRecord stack;
+    if (record.size < sizeof(stack))
+    {
+      return false;
+    }
+    memcpy(&stack, data, sizeof(stack));
+    if (stack.depth > (record.size - sizeof(stack)) / sizeof(uint64_t))
+    {
+      return false;
+    }
+    entry->threadId = stack.threadId;
+    entry->time     = (double) (stack.timestamp - reader->start)
+                / (double) reader->frequency;
+    entry->depth     = stack.depth;
+    entry->addresses = (const uint64_t*) (data + sizeof(stack));
+    break;
+  }
+  default:
+    return false;
+  }
+
+  if (record.type != SR_STACK && entry->name == NULL)
+  {
+    return false;
+  }
+  reader->offset += record.size;
+  return true;
+}
@@ -0,0 +1,361 @@
+#include "Otter/Util/String/Number.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "Otter/Util/Cpu.h"
+#include "Otter/Util/Log.h"
+#include "Otter/Util/String/PowersOfFive.h"
+
+// Any 19 digit decimal fits in a uint64_t.
+#define NUMBER_MAX_DIGITS 19
+
+#define NUMBER_SLOW_PATH_BUFFER_SIZE 64
+
+#define DOUBLE_MANTISSA_BITS  52
+#define DOUBLE_MIN_EXPONENT   -1023
+#define DOUBLE_INFINITE_POWER 0x7FF
+
+// Powers of ten up to here are exact doubles, and so is any mantissa up to
+// 2^53, so a single multiply or divide rounds correctly.
+#define NUMBER_FAST_PATH_MAX_EXPONENT 22
+#define NUMBER_FAST_PATH_MAX_MANTISSA (1ull << 53)
+
+static const double g_exactPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5,
+    1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+    1e19, 1e20, 1e21, 1e22};
+
+static inline bool number_is_digit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// Adding 6 carries any byte above '9' into the next nibble, so both halves
+// of the test only keep their 3 for bytes in '0' to '9'.
+static inline bool number_is_eight_digits(uint64_t chunk)
+{
+  return ((chunk & 0xF0F0F0F0F0F0F0F0)
+             | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+      == 0x3333333333333333;
+}
+
+// Combines neighbouring digits into pairs, then pairs into fours and fours
+// into the final eight with two multiplies. The first digit is in the lowest
+// byte since Windows targets are little endian.
+static inline uint32_t number_parse_eight_digits(uint64_t chunk)
+{
+  const uint64_t mask       = 0x000000FF000000FF;
+  const uint64_t multiplier = 100 + (1000000ull << 32);
+  const uint64_t shifted    = 1 + (10000ull << 32);
+
+  chunk -= 0x3030303030303030;
+  chunk = chunk * 10 + (chunk >> 8);
+  chunk = ((chunk & mask) * multiplier + ((chunk >> 16) & mask) * shifted)
+       >> 32;
+  return (uint32_t) chunk;
+}
+
+// Append a run of digits to `mantissa`. Wraps silently past 19 digits, which
+// the caller checks for.
+static const char* number_parse_digits(
+    const char* cursor, const char* end, uint64_t* mantissa)
+{
+  while (end - cursor >= 8)
+  {
+    uint64_t chunk;
+    memcpy(&chunk, cursor, sizeof(chunk));
+    if (!number_is_eight_digits(chunk))
+    {
+      break;
+    }
+
+    *mantissa = *mantissa * 100000000 + number_parse_eight_digits(chunk);
+    cursor += 8;
+  }
+
+  while (cursor < end && number_is_digit(*cursor))
+  {
+    *mantissa = *mantissa * 10 + (uint64_t) (*cursor - '0');
+    cursor++;
+  }
+  return cursor;
+}
+
+static inline uint64_t number_multiply(uint64_t a, uint64_t b, uint64_t* low)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  uint64_t high;
+  *low = _umul128(a, b, &high);
+  return high;
+#else
+  unsigned __int128 product = (unsigned __int128) a * b;
+  *low                      = (uint64_t) product;
+  return (uint64_t) (product >> 64);
+#endif
+}
+
+static inline double number_make_double(uint64_t mantissa, int32_t power2)
+{
+  uint64_t bits = mantissa | (uint64_t) power2 << DOUBLE_MANTISSA_BITS;
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Eisel-Lemire: multiply the normalized mantissa by a 128 bit approximation
+// of 5^exponent and keep the top 54 bits. With at most 19 digits that is
+// always enough to round correctly (Mushtak and Lemire, "Fast Number Parsing
+// Without Fallback").
+static double number_eisel_lemire(uint64_t mantissa, int32_t exponent)
+{
+  if (mantissa == 0 || exponent < POWERS_OF_FIVE_MIN_EXPONENT)
+  {
+    return 0.0;
+  }
+  if (exponent > POWERS_OF_FIVE_MAX_EXPONENT)
+  {
+    return INFINITY;
+  }
+
+  uint32_t leadingZeros = cpu_leading_zeros(mantissa);
+  mantissa <<= leadingZeros;
+
+  size_t index  = 2 * (size_t) (exponent - POWERS_OF_FIVE_MIN_EXPONENT);
+  uint64_t low  = 0;
+  uint64_t high = number_multiply(mantissa, g_powersOfFive[index], &low);
+
+  // The low word of the power only matters when it could carry into the
+  // bits that are kept.
+  const uint64_t precisionMask = UINT64_MAX >> (DOUBLE_MANTISSA_BITS + 3);
+  if ((high & precisionMask) == precisionMask)
+  {
+    uint64_t secondLow  = 0;
+    uint64_t secondHigh = number_multiply(
+        mantissa, g_powersOfFive[index + 1], &secondLow);
+    low += secondHigh;
+    if (secondHigh > low)
+    {
+      high++;
+    }
+  }
+
+  uint32_t upperBit = (uint32_t) (high >> 63);
+  uint32_t shift    = upperBit + 64 - DOUBLE_MANTISSA_BITS - 3;
+  uint64_t bits     = high >> shift;
+
+  // floor(log2(10^exponent)) approximated with fixed point.
+  int32_t power2 = (((152170 + 65536) * exponent) >> 16) + 63
+                 + (int32_t) upperBit - (int32_t) leadingZeros
+                 - DOUBLE_MIN_EXPONENT;
+
+  if (power2 <= 0)
+  {
+    // Subnormal, or too small to represent at all.
+    if (-power2 + 1 >= 64)
+    {
+      return 0.0;
+    }
+    bits >>= -power2 + 1;
+    bits += bits & 1;
+    bits >>= 1;
+    power2 = bits < (1ull << DOUBLE_MANTISSA_BITS) ? 0 : 1;
+    return number_make_double(bits, power2);
+  }
+
+  // A product that is exactly halfway between two doubles has to round to
+  // the even one. That can only happen for powers of five that fit in the
+  // 64 bits of the mantissa.
+  if (low <= 1 && exponent >= -4 && exponent <= 23 && (bits & 3) == 1
+      && (bits << shift) == high)
+  {
+    bits &= ~1ull;
+  }
+
+  bits += bits & 1;
+  bits >>= 1;
+  if (bits >= (2ull << DOUBLE_MANTISSA_BITS))
+  {
+    bits = 1ull << DOUBLE_MANTISSA_BITS;
+    power2++;
+  }
+  bits &= ~(1ull << DOUBLE_MANTISSA_BITS);
+
+  if (power2 >= DOUBLE_INFINITE_POWER)
+  {
+    return INFINITY;
+  }
+  return number_make_double(bits, power2);
+}
+
+static double number_compute_double(uint64_t mantissa, int64_t exponent)
+{
+  if (exponent >= -NUMBER_FAST_PATH_MAX_EXPONENT
+      && exponent <= NUMBER_FAST_PATH_MAX_EXPONENT
+      && mantissa <= NUMBER_FAST_PATH_MAX_MANTISSA)
+  {
+    double value = (double) mantissa;
+    return exponent < 0 ? value / g_exactPowersOfTen[-exponent]
+                        : value * g_exactPowersOfTen[exponent];
+  }
+
+  // Clamp so the cast can't wrap. Both ends are far outside a double's range.
+  exponent = max(exponent, POWERS_OF_FIVE_MIN_EXPONENT - 1);
+  exponent = min(exponent, POWERS_OF_FIVE_MAX_EXPONENT + 1);
+  return number_eisel_lemire(mantissa, (int32_t) exponent);
+}
+
+// More than 19 significant digits don't fit the mantissa. Those are rare
+// enough in practice to hand to the C library. The syntax has already been
+// checked, so `strtod` reads exactly the same characters.
+static bool number_parse_slow(const char* text, size_t length, double* value)
+{
+  char buffer[NUMBER_SLOW_PATH_BUFFER_SIZE];
+  char* copy = length < sizeof(buffer) ? buffer : malloc(length + 1);
+  if (copy == NULL)
+  {
+    LOG_WARNING("Unable to allocate space to parse a %zu digit number.",
+        length);
+    return false;
+  }
+
+  memcpy(copy, text, length);
+  copy[length] = '\0';
+  *value       = strtod(copy, NULL);
+
+  if (copy != buffer)
+  {
+    free(copy);
+  }
+  return true;
+}
+
+size_t number_parse(const char* text, size_t length, ParsedNumber* number)
+{
+  const char* cursor = text;
+  const char* end    = text + length;
+  number->type       = NUMBER_INVALID;
+
+  bool negative = cursor < end && *cursor == '-';
+  if (negative)
+  {
+    cursor++;
+  }
+
+  const char* integerStart = cursor;
+  uint64_t mantissa        = 0;
+  cursor = number_parse_digits(cursor, end, &mantissa);
+
+  size_t digits = (size_t) (cursor - integerStart);
+  if (digits == 0 || (digits > 1 && *integerStart == '0'))
+  {
+    return 0;
+  }
+
+  int64_t exponent = 0;
+  bool isFloat     = false;
+  if (cursor < end && *cursor == '.')
+  {
+    cursor++;
+    const char* fractionStart = cursor;
+    cursor = number_parse_digits(cursor, end, &mantissa);
+
+    size_t fractionDigits = (size_t) (cursor - fractionStart);
+    if (fractionDigits == 0)
+    {
+      return 0;
+    }
+    digits += fractionDigits;
+    exponent -= (int64_t) fractionDigits;
+    isFloat = true;
+  }
+
+  if (cursor < end && (*cursor == 'e' || *cursor == 'E'))
+  {
+    cursor++;
+    bool negativeExponent = cursor < end && *cursor == '-';
+    if (cursor < end && (*cursor == '-' || *cursor == '+'))
+    {
+      cursor++;
+    }
+    if (cursor >= end || !number_is_digit(*cursor))
+    {
+      return 0;
+    }
+
+    int64_t explicitExponent = 0;
+    while (cursor < end && number_is_digit(*cursor))
+    {
+      // Past this the result is zero or infinity anyway.
+      if (explicitExponent < 0x10000)
+      {
+        explicitExponent = explicitExponent * 10 + (*cursor - '0');
+      }
+      cursor++;
+    }
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    isFloat = true;
+  }
+
+  size_t consumed = (size_t) (cursor - text);
+
+  if (digits > NUMBER_MAX_DIGITS)
+  {
+    // Leading zeros don't add to the mantissa.
+    for (const char* c = integerStart;
+         c < cursor && (*c == '0' || *c == '.'); c++)
+    {
+      digits -= *c == '0';
+    }
+  }
+
+  if (digits > NUMBER_MAX_DIGITS)
+  {
+    if (!number_parse_slow(text, consumed, &number->floatingPoint))
+    {
+      return 0;
+    }
+    number->type = NUMBER_FLOAT;
+    return consumed;
+  }
+
+  if (!isFloat && mantissa <= (uint64_t) INT64_MAX + negative)
+  {
+    number->type    = NUMBER_INTEGER;
+    number->integer = negative ? -(int64_t) (mantissa - 1) - 1
+                               : (int64_t) mantissa;
+    return consumed;
+  }
+
+  double value          = number_compute_double(mantissa, exponent);
+  number->type          = NUMBER_FLOAT;
+  number->floatingPoint = negative ? -value : value;
+  return consumed;
+}
+
+bool number_parse_integer(StringView text, int64_t* value)
+{
+  ParsedNumber number;
+  size_t consumed = number_parse(text.data, text.length, &number);
+  if (consumed == 0 || consumed != text.length
+      || number.type != NUMBER_INTEGER)
+  {
+    return false;
+  }
+
+  *value = number.integer;
+  return true;
+}
+
+bool number_parse_double(StringView text, double* value)
+{
+  ParsedNumber number;
+  size_t consumed = number_parse(text.data, text.length, &number);
+  if (consumed == 0 || consumed != text.length)
+  {
+    return false;
+  }
+
+  *value = number.type == NUMBER_INTEGER ? (double) number.integer
+                                         : number.floatingPoint;
+  return true;
+}
@@ -0,0 +1,401 @@
+#include "Otter/Util/String/Number.h"
+
+#include "Otter/Util/Cpu.h"
+#include "Otter/Util/String/PowersOfFive.h"
+
+#define DOUBLE_MANTISSA_BITS 52
+#define DOUBLE_EXPONENT_BITS 11
+#define DOUBLE_BIAS          1023
+
+// Past these the shortest digits are written in exponent form, matching how
+// JavaScript prints numbers.
+#define NUMBER_FORMAT_MAX_FIXED_POINT 21
+#define NUMBER_FORMAT_MIN_FIXED_POINT -5
+
+static const char g_digitPairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+typedef struct ShortestDecimal
+{
+  uint64_t mantissa;
+  int32_t exponent;
+} ShortestDecimal;
+
+static const uint64_t g_powersOfTen[20] = {1ull, 10ull, 100ull, 1000ull,
+    10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+    1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull,
+    10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+    10000000000000000000ull};
+
+// 1233 / 4096 is just over log10(2), so the guess from the bit length is
+// either right or one short.
+static inline uint32_t number_decimal_length(uint64_t value)
+{
+  value |= 1;
+  uint32_t guess = ((64 - cpu_leading_zeros(value)) * 1233) >> 12;
+  return guess + (value >= g_powersOfTen[guess]);
+}
+
+// Write the digits of a value below 10^8 so they end right before `end`.
+// 32 bit division is cheaper than 64 bit, so the long form splits into these.
+static inline void number_write_small_digits(char* end, uint32_t value)
+{
+  while (value >= 100)
+  {
+    uint32_t pair = (value % 100) * 2;
+    value /= 100;
+    end -= 2;
+    memcpy(end, &g_digitPairs[pair], 2);
+  }
+
+  if (value >= 10)
+  {
+    memcpy(end - 2, &g_digitPairs[value * 2], 2);
+  }
+  else
+  {
+    *(end - 1) = (char) ('0' + value);
+  }
+}
+
+// Write the digits of `value` so they end right before `end`.
+static inline void number_write_digits(char* end, uint64_t value)
+{
+  while (value >= 100000000)
+  {
+    uint32_t block = (uint32_t) (value % 100000000);
+    value /= 100000000;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+      end -= 2;
+      memcpy(end, &g_digitPairs[(block % 100) * 2], 2);
+      block /= 100;
+    }
+  }
+  number_write_small_digits(end, (uint32_t) value);
+}
+
+// ceil(log2(5^e)) for e in [0, 3528].
+static inline int32_t number_pow5_bits(int32_t e)
+{
+  return (int32_t) (((uint32_t) e * 1217359) >> 19) + 1;
+}
+
+// floor(log10(2^e)) for e in [0, 1650].
+static inline uint32_t number_log10_pow2(int32_t e)
+{
+  return ((uint32_t) e * 78913) >> 18;
+}
+
+// floor(log10(5^e)) for e in [0, 2620].
+static inline uint32_t number_log10_pow5(int32_t e)
+{
+  return ((uint32_t) e * 732923) >> 20;
+}
+
+static inline bool number_is_multiple_of_pow5(uint64_t value, uint32_t power)
+{
+  uint32_t count = 0;
+  while (value % 5 == 0)
+  {
+    value /= 5;
+    count++;
+  }
+  return count >= power;
+}
+
+static inline bool number_is_multiple_of_pow2(uint64_t value, uint32_t power)
+{
+  return (value & ((1ull << power) - 1)) == 0;
+}
+
+// (m * multiplier) >> shift, where the multiplier is a 128 bit table entry
+// and the shift is at least 64.
+static inline uint64_t number_multiply_shift(
+    uint64_t m, const uint64_t* multiplier, int32_t shift)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  uint64_t lowHigh  = 0;
+  uint64_t highHigh = 0;
+  _umul128(m, multiplier[0], &lowHigh);
+  uint64_t highLow = _umul128(m, multiplier[1], &highHigh);
+  uint64_t sum     = lowHigh + highLow;
+  if (sum < lowHigh)
+  {
+    highHigh++;
+  }
+  return __shiftright128(sum, highHigh, (unsigned char) (shift - 64));
+#else
+  unsigned __int128 low  = (unsigned __int128) m * multiplier[0];
+  unsigned __int128 high = (unsigned __int128) m * multiplier[1];
+  return (uint64_t) (((low >> 64) + high) >> (shift - 64));
+#endif
+}
+
+// Ryu (Adams, "Ryu: Fast Float-to-String Conversion"). Computes the decimal
+// interval of values that round to the double, then drops digits while both
+// ends still differ. What is left is the shortest decimal that reads back as
+// the same double, rounded to the nearest where there is a choice.
+static ShortestDecimal number_shortest_decimal(
+    uint64_t ieeeMantissa, uint32_t ieeeExponent)
+{
+  int32_t e2  = 0;
+  uint64_t m2 = 0;
+  if (ieeeExponent == 0)
+  {
+    e2 = 1 - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+    m2 = ieeeMantissa;
+  }
+  else
+  {
+    e2 = (int32_t) ieeeExponent - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+    m2 = (1ull << DOUBLE_MANTISSA_BITS) | ieeeMantissa;
+  }
+
+  bool acceptBounds = (m2 & 1) == 0;
+  uint64_t mv       = 4 * m2;
+  // The gap below is half as wide at the bottom of a binade.
+  uint32_t mmShift  = ieeeMantissa != 0 || ieeeExponent <= 1;
+
+  uint64_t vr            = 0;
+  uint64_t vp            = 0;
+  uint64_t vm            = 0;
+  int32_t e10            = 0;
+  bool vmIsTrailingZeros = false;
+  bool vrIsTrailingZeros = false;
+  if (e2 >= 0)
+  {
+    uint32_t q = number_log10_pow2(e2) - (e2 > 3);
+    e10        = (int32_t) q;
+    int32_t k  = POWERS_OF_FIVE_INVERSE_SPLIT_BITS
+              + number_pow5_bits((int32_t) q) - 1;
+    int32_t i  = -e2 + (int32_t) q + k;
+
+    const uint64_t* power = &g_powersOfFiveInverseSplit[2 * q];
+    vr = number_multiply_shift(4 * m2, power, i);
+    vp = number_multiply_shift(4 * m2 + 2, power, i);
+    vm = number_multiply_shift(4 * m2 - 1 - mmShift, power, i);
+
+    // Only small powers can divide the bounds exactly.
+    if (q <= 21)
+    {
+      if (mv % 5 == 0)
+      {
+        vrIsTrailingZeros = number_is_multiple_of_pow5(mv, q);
+      }
+      else if (acceptBounds)
+      {
+        vmIsTrailingZeros = number_is_multiple_of_pow5(mv - 1 - mmShift, q);
+      }
+      else
+      {
+        vp -= number_is_multiple_of_pow5(mv + 2, q);
+      }
+    }
+  }
+  else
+  {
+    uint32_t q = number_log10_pow5(-e2) - (-e2 > 1);
+    e10        = (int32_t) q + e2;
+    int32_t i  = -e2 - (int32_t) q;
+    int32_t k  = number_pow5_bits(i) - POWERS_OF_FIVE_SPLIT_BITS;
+    int32_t j  = (int32_t) q - k;
+
+    const uint64_t* power = &g_powersOfFiveSplit[2 * i];
+    vr = number_multiply_shift(4 * m2, power, j);
+    vp = number_multiply_shift(4 * m2 + 2, power, j);
+    vm = number_multiply_shift(4 * m2 - 1 - mmShift, power, j);
+
+    if (q <= 1)
+    {
+      vrIsTrailingZeros = true;
+      if (acceptBounds)
+      {
+        vmIsTrailingZeros = mmShift == 1;
+      }
+      else
+      {
+        vp--;
+      }
+    }
+    else if (q < 63)
+    {
+      vrIsTrailingZeros = number_is_multiple_of_pow2(mv, q);
+    }
+  }
+
+  int32_t removed          = 0;
+  uint8_t lastRemovedDigit = 0;
+  uint64_t output          = 0;
+  if (vmIsTrailingZeros || vrIsTrailingZeros)
+  {
+    // Rare: the interval ends exactly on a decimal, so ties need tracking.
+    while (vp / 10 > vm / 10)
+    {
+      vmIsTrailingZeros &= vm % 10 == 0;
+      vrIsTrailingZeros &= lastRemovedDigit == 0;
+      lastRemovedDigit = (uint8_t) (vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      removed++;
+    }
+
+    if (vmIsTrailingZeros)
+    {
+      while (vm % 10 == 0)
+      {
+        vrIsTrailingZeros &= lastRemovedDigit == 0;
+        lastRemovedDigit = (uint8_t) (vr % 10);
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        removed++;
+      }
+    }
+
+    if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0)
+    {
+      // Exactly halfway, so round to even.
+      lastRemovedDigit = 4;
+    }
+    output = vr
+           + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros))
+               || lastRemovedDigit >= 5);
+  }
+  else
+  {
+    bool roundUp = false;
+    if (vp / 100 > vm / 100)
+    {
+      roundUp = vr % 100 >= 50;
+      vr /= 100;
+      vp /= 100;
+      vm /= 100;
+      removed += 2;
+    }
+
+    while (vp / 10 > vm / 10)
+    {
+      roundUp = vr % 10 >= 5;
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      removed++;
+    }
+    output = vr + (vr == vm || roundUp);
+  }
+
+  ShortestDecimal result = {output, e10 + removed};
+  return result;
+}
+
+size_t number_format_integer(int64_t value, char* buffer)
+{
+  char* cursor = buffer;
+  uint64_t magnitude;
+  if (value < 0)
+  {
+    *cursor++ = '-';
+    magnitude = 0 - (uint64_t) value;
+  }
+  else
+  {
+    magnitude = (uint64_t) value;
+  }
+
+  uint32_t length = number_decimal_length(magnitude);
+  number_write_digits(cursor + length, magnitude);
+  return (size_t) (cursor - buffer) + length;
+}
+
+size_t number_format_double(double value, char* buffer)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+
+  uint64_t ieeeMantissa = bits & ((1ull << DOUBLE_MANTISSA_BITS) - 1);
+  uint32_t ieeeExponent = (uint32_t) (bits >> DOUBLE_MANTISSA_BITS)
+                        & ((1u << DOUBLE_EXPONENT_BITS) - 1);
+  if (ieeeExponent == (1u << DOUBLE_EXPONENT_BITS) - 1)
+  {
+    return 0;
+  }
+
+  char* cursor = buffer;
+  if (bits >> 63)
+  {
+    *cursor++ = '-';
+  }
+
+  if (ieeeExponent == 0 && ieeeMantissa == 0)
+  {
+    *cursor++ = '0';
+    return (size_t) (cursor - buffer);
+  }
+
+  ShortestDecimal decimal =
+      number_shortest_decimal(ieeeMantissa, ieeeExponent);
+  while (decimal.mantissa % 10 == 0)
+  {
+    decimal.mantissa /= 10;
+    decimal.exponent++;
+  }
+
+  // The digits are d1 d2 ... dn, and the decimal point goes after `point` of
+  // them.
+  int32_t length = (int32_t) number_decimal_length(decimal.mantissa);
+  int32_t point  = length + decimal.exponent;
+
+  if (decimal.exponent >= 0 && point <= NUMBER_FORMAT_MAX_FIXED_POINT)
+  {
+    number_write_digits(cursor + length, decimal.mantissa);
+    memset(cursor + length, '0', (size_t) decimal.exponent);
+    cursor += point;
+  }
+  else if (point > 0 && point <= NUMBER_FORMAT_MAX_FIXED_POINT)
+  {
+    // Write the digits one place to the right, then pull the integer part
+    // back over the gap for the point.
+    number_write_digits(cursor + length + 1, decimal.mantissa);
+    memmove(cursor, cursor + 1, (size_t) point);
+    cursor[point] = '.';
+    cursor += length + 1;
+  }
+  else if (point >= NUMBER_FORMAT_MIN_FIXED_POINT && point <= 0)
+  {
+    cursor[0] = '0';
+    cursor[1] = '.';
+    memset(cursor + 2, '0', (size_t) -point);
+    cursor += 2 - point;
+    number_write_digits(cursor + length, decimal.mantissa);
+    cursor += length;
+  }
+  else
+  {
+    number_write_digits(cursor + length + 1, decimal.mantissa);
+    cursor[0] = cursor[1];
+    if (length > 1)
+    {
+      cursor[1] = '.';
+      cursor += length + 1;
+    }
+    else
+    {
+      cursor++;
+    }
+
+    int32_t exponent = point - 1;
+    *cursor++        = 'e';
+    *cursor++        = exponent < 0 ? '-' : '+';
+    cursor += number_format_integer(exponent < 0 ? -exponent : exponent,
+        cursor);
+  }
+
+  return (size_t) (cursor - buffer);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+#define POWERS_OF_FIVE_MIN_EXPONENT -342
+#define POWERS_OF_FIVE_MAX_EXPONENT 308
+
+#define POWERS_OF_FIVE_SPLIT_COUNT         326
+#define POWERS_OF_FIVE_INVERSE_SPLIT_COUNT 342
+#define POWERS_OF_FIVE_SPLIT_BITS          125
+#define POWERS_OF_FIVE_INVERSE_SPLIT_BITS  125
+
+/**
+ * @brief 5^q for q in [-342, 308], normalized so the top bit is set and
+ * truncated to 128 bits. Stored as pairs of high and low words, so 5^q
+ * starts at `2 * (q + 342)`.
+ *
+ * Negative powers are rounded up rather than truncated, which keeps the
+ * product of a decimal mantissa and the table entry a tight lower bound.
+ */
+extern const uint64_t g_powersOfFive[
+    2 * (POWERS_OF_FIVE_MAX_EXPONENT - POWERS_OF_FIVE_MIN_EXPONENT + 1)];
+
+/**
+ * @brief 5^q for q in [0, 326), shifted to exactly 125 bits. Stored as pairs
+ * of low and high words for Ryu's shortest double printing.
+ */
+extern const uint64_t g_powersOfFiveSplit[2 * POWERS_OF_FIVE_SPLIT_COUNT];
+
+/**
+ * @brief floor(2^k / 5^q) + 1 for q in [0, 342), with k picked so the result
+ * has 125 or 126 bits. Stored as pairs of low and high words.
+ */
+extern const uint64_t g_powersOfFiveInverseSplit[
+    2 * POWERS_OF_FIVE_INVERSE_SPLIT_COUNT];
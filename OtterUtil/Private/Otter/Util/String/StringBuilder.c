@@ -0,0 +1,114 @@
+#include "Otter/Util/String/StringBuilder.h"
+
+#include <stdarg.h>
+
+#include "Otter/Util/Log.h"
+
+void string_builder_create(StringBuilder* builder, Allocator* allocator)
+{
+  builder->buffer    = NULL;
+  builder->length    = 0;
+  builder->capacity  = 0;
+  builder->allocator = allocator;
+}
+
+void string_builder_destroy(StringBuilder* builder)
+{
+  allocator_deallocate(builder->allocator, builder->buffer, builder->capacity);
+  string_builder_create(builder, builder->allocator);
+}
+
+// Make room for `length` more characters and the terminator.
+static bool string_builder_grow(StringBuilder* builder, size_t length)
+{
+  size_t required = builder->length + length + 1;
+  if (required <= builder->capacity)
+  {
+    return true;
+  }
+
+  size_t capacity = max(builder->capacity * 2, STRING_BUILDER_MIN_CAPACITY);
+  while (capacity < required)
+  {
+    capacity *= 2;
+  }
+
+  char* buffer = allocator_reallocate(
+      builder->allocator, builder->buffer, builder->capacity, capacity);
+  if (buffer == NULL)
+  {
+    LOG_WARNING("Unable to grow string. Not appending.");
+    return false;
+  }
+
+  builder->buffer   = buffer;
+  builder->capacity = capacity;
+  return true;
+}
+
+bool string_builder_append(StringBuilder* builder, StringView string)
+{
+  if (!string_builder_grow(builder, string.length))
+  {
+    return false;
+  }
+
+  memcpy(&builder->buffer[builder->length], string.data, string.length);
+  builder->length += string.length;
+  builder->buffer[builder->length] = '\0';
+  return true;
+}
+
+bool string_builder_append_char(StringBuilder* builder, char c)
+{
+  if (!string_builder_grow(builder, 1))
+  {
+    return false;
+  }
+
+  builder->buffer[builder->length++] = c;
+  builder->buffer[builder->length]   = '\0';
+  return true;
+}
+
+bool string_builder_append_format(
+    StringBuilder* builder, const char* format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(NULL, 0, format, args);
+  va_end(args);
+
+  if (length < 0 || !string_builder_grow(builder, (size_t) length))
+  {
+    return false;
+  }
+
+  va_start(args, format);
+  vsnprintf(&builder->buffer[builder->length],
+      builder->capacity - builder->length, format, args);
+  va_end(args);
+
+  builder->length += length;
+  return true;
+}
+
+StringView string_builder_finish(StringBuilder* builder)
+{
+  if (!string_builder_grow(builder, 0))
+  {
+    return string_view_create(NULL, 0);
+  }
+
+  char* buffer = allocator_reallocate(builder->allocator, builder->buffer,
+      builder->capacity, builder->length + 1);
+  if (buffer == NULL)
+  {
+    buffer = builder->buffer;
+  }
+  buffer[builder->length] = '\0';
+
+  StringView result = string_view_create(buffer, builder->length);
+  string_builder_create(builder, builder->allocator);
+  return result;
+}
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "Otter/Util/Log.h"
+#include "Otter/Util/Memory/Allocator.h"
 #include "Otter/Util/export.h"
 
 typedef struct AutoArray
@@ -11,10 +12,14 @@ typedef struct AutoArray
   size_t size;
   size_t capacity;
   void* buffer;
+  Allocator* allocator;
 } AutoArray;
 
 OTTERUTIL_API void auto_array_create(AutoArray* array, size_t elementSize);
 
+OTTERUTIL_API void auto_array_create_with_allocator(
+    AutoArray* array, size_t elementSize, Allocator* allocator);
+
 OTTERUTIL_API void auto_array_destroy(AutoArray* array);
 
 OTTERUTIL_API void* auto_array_allocate(AutoArray* array);
@@ -3,6 +3,7 @@
 #include <stdint.h>
 
 #include "Otter/Util/Array/AutoArray.h"
+#include "Otter/Util/Array/VirtualArray.h"
 #include "Otter/Util/BitMap.h"
 #include "Otter/Util/export.h"
 
@@ -11,13 +12,39 @@
 typedef struct SparseAutoArray
 {
   BitMap usedMask;
-  AutoArray components;
+  bool reserved;
+  union
+  {
+    AutoArray components;
+    // Used instead of `components` when `reserved` is set. Reading
+    // `components.size` is still valid.
+    VirtualArray reservedComponents;
+  };
 } SparseAutoArray;
 
 /** @brief Create a sparse auto array. */
 OTTERUTIL_API void sparse_auto_array_create(
     SparseAutoArray* list, uint64_t componentSize);
 
+/** @brief Create a sparse auto array that allocates from `allocator`. */
+OTTERUTIL_API void sparse_auto_array_create_with_allocator(
+    SparseAutoArray* list, uint64_t componentSize, Allocator* allocator);
+
+/**
+ * @brief Create a sparse auto array whose elements never move.
+ *
+ * Address space for `maxElements` is reserved up front, so pointers returned
+ * by `sparse_auto_array_get` stay valid as the array grows. Falls back to a
+ * regular array if the reservation fails.
+ *
+ * @param list The sparse auto array.
+ * @param componentSize The size of each element.
+ * @param maxElements The most elements the array can ever hold.
+ * @param allocator The allocator for the bookkeeping, or NULL for the heap.
+ */
+OTTERUTIL_API void sparse_auto_array_create_reserved(SparseAutoArray* list,
+    uint64_t componentSize, uint64_t maxElements, Allocator* allocator);
+
 /** @brief Destroy a sparse auto array. */
 OTTERUTIL_API void sparse_auto_array_destroy(SparseAutoArray* list);
 
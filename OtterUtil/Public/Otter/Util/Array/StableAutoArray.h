@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Otter/Util/Log.h"
+#include "Otter/Util/Memory/Allocator.h"
 #include "Otter/Util/export.h"
 
 #define SAA_DEFAULT_CHUNK_SIZE 32
@@ -18,11 +19,16 @@ typedef struct StableAutoArray
   uint32_t size;
   uint32_t capacity;
   StableAutoArrayChunk* chunks;
+  Allocator* allocator;
 } StableAutoArray;
 
 OTTERUTIL_API void stable_auto_array_create(
     StableAutoArray* array, uint32_t elementSize, uint32_t chunkSize);
 
+OTTERUTIL_API void stable_auto_array_create_with_allocator(
+    StableAutoArray* array, uint32_t elementSize, uint32_t chunkSize,
+    Allocator* allocator);
+
 OTTERUTIL_API void stable_auto_array_destroy(StableAutoArray* array);
 
 OTTERUTIL_API void* stable_auto_array_allocate(StableAutoArray* array);
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "Otter/Util/Log.h"
+#include "Otter/Util/export.h"
+
+/** @brief Smallest heap capacity a typed array will allocate. */
+#define TYPED_ARRAY_MIN_CAPACITY 8
+
+/**
+ * @brief Compute the capacity to grow to so that `required` elements fit.
+ *
+ * Capacity doubles so that appending N elements costs amortized O(N) copies.
+ *
+ * @param capacity The current capacity.
+ * @param required The number of elements that must fit.
+ * @return The new capacity.
+ */
+OTTERUTIL_API size_t typed_array_next_capacity(
+    size_t capacity, size_t required);
+
+/**
+ * @brief Move a typed array's storage to a new capacity.
+ *
+ * `storage` points at the union of the heap pointer and the inline elements.
+ * While `capacity <= inlineCapacity` the elements live inline, otherwise they
+ * live on the heap behind the pointer.
+ *
+ * @param storage The array storage union.
+ * @param elementSize The size of a single element.
+ * @param size The number of live elements to preserve.
+ * @param capacity The current capacity, updated on success.
+ * @param newCapacity The requested capacity. Must be at least `size`.
+ * @param inlineCapacity The number of inline elements, 0 for heap only.
+ * @return true if the storage was moved, false if out of memory.
+ */
+OTTERUTIL_API bool typed_array_set_capacity(void* storage, size_t elementSize,
+    size_t size, size_t* capacity, size_t newCapacity, size_t inlineCapacity);
+
+/**
+ * @brief Free the heap storage of a typed array if it has any.
+ *
+ * @param storage The array storage union.
+ * @param capacity The current capacity.
+ * @param inlineCapacity The number of inline elements, 0 for heap only.
+ */
+OTTERUTIL_API void typed_array_release(
+    void* storage, size_t capacity, size_t inlineCapacity);
+
+#ifdef _DEBUG
+#define TYPED_ARRAY_BOUNDS_CHECK(array, index)                             \
+  if ((index) >= (array)->size)                                            \
+  {                                                                        \
+    LOG_WARNING("Out of bounds read of index %zd on array of size %zd",    \
+        (size_t) (index), (array)->size);                                  \
+    return NULL;                                                           \
+  }
+#else
+#define TYPED_ARRAY_BOUNDS_CHECK(array, index)
+#endif
+
+#define TYPED_ARRAY_FUNCTIONS(Name, prefix, Type, InlineCapacity)             \
+  static inline Type* prefix##_data(Name* array)                              \
+  {                                                                           \
+    if ((InlineCapacity) == 0 || array->capacity > (InlineCapacity))          \
+    {                                                                         \
+      return array->heap;                                                     \
+    }                                                                         \
+    return (Type*) &array->heap;                                              \
+  }                                                                           \
+                                                                              \
+  static inline void prefix##_create(Name* array)                             \
+  {                                                                           \
+    array->heap     = NULL;                                                   \
+    array->size     = 0;                                                      \
+    array->capacity = (InlineCapacity);                                       \
+  }                                                                           \
+                                                                              \
+  static inline void prefix##_destroy(Name* array)                            \
+  {                                                                           \
+    typed_array_release(&array->heap, array->capacity, (InlineCapacity));     \
+    prefix##_create(array);                                                   \
+  }                                                                           \
+                                                                              \
+  static inline bool prefix##_reserve(Name* array, size_t capacity)           \
+  {                                                                           \
+    if (capacity <= array->capacity)                                          \
+    {                                                                         \
+      return true;                                                            \
+    }                                                                         \
+    return typed_array_set_capacity(&array->heap, sizeof(Type), array->size,  \
+        &array->capacity, capacity, (InlineCapacity));                        \
+  }                                                                           \
+                                                                              \
+  static inline void prefix##_shrink_to_fit(Name* array)                      \
+  {                                                                           \
+    typed_array_set_capacity(&array->heap, sizeof(Type), array->size,         \
+        &array->capacity, array->size, (InlineCapacity));                     \
+  }                                                                           \
+                                                                              \
+  static inline Type* prefix##_allocate_many(Name* array, size_t count)       \
+  {                                                                           \
+    size_t newSize = array->size + count;                                     \
+    if (newSize > array->capacity                                             \
+        && !typed_array_set_capacity(&array->heap, sizeof(Type), array->size, \
+            &array->capacity,                                                 \
+            typed_array_next_capacity(array->capacity, newSize),              \
+            (InlineCapacity)))                                                \
+    {                                                                         \
+      LOG_WARNING("Unable to increase array size. Not allocating element.");  \
+      return NULL;                                                            \
+    }                                                                         \
+    Type* elements = prefix##_data(array) + array->size;                      \
+    array->size    = newSize;                                                 \
+    return elements;                                                          \
+  }                                                                           \
+                                                                              \
+  static inline Type* prefix##_allocate(Name* array)                          \
+  {                                                                           \
+    if (array->size < array->capacity)                                        \
+    {                                                                         \
+      return prefix##_data(array) + array->size++;                            \
+    }                                                                         \
+    return prefix##_allocate_many(array, 1);                                  \
+  }                                                                           \
+                                                                              \
+  static inline bool prefix##_push(Name* array, Type value)                   \
+  {                                                                           \
+    Type* element = prefix##_allocate(array);                                 \
+    if (element == NULL)                                                      \
+    {                                                                         \
+      return false;                                                           \
+    }                                                                         \
+    *element = value;                                                         \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  static inline Type* prefix##_get(Name* array, size_t index)                 \
+  {                                                                           \
+    TYPED_ARRAY_BOUNDS_CHECK(array, index);                                   \
+    return prefix##_data(array) + index;                                      \
+  }                                                                           \
+                                                                              \
+  static inline void prefix##_clear(Name* array)                              \
+  {                                                                           \
+    array->size = 0;                                                          \
+  }                                                                           \
+                                                                              \
+  static inline void prefix##_pop_many(Name* array, size_t count)             \
+  {                                                                           \
+    if (count > array->size)                                                  \
+    {                                                                         \
+      return;                                                                 \
+    }                                                                         \
+    array->size -= count;                                                     \
+                                                                              \
+    /* Only shrink once a quarter full so push/pop at a boundary doesn't      \
+     * thrash the allocator. */                                               \
+    if (array->capacity > (InlineCapacity)                                    \
+        && array->capacity > TYPED_ARRAY_MIN_CAPACITY                         \
+        && array->size <= array->capacity / 4)                                \
+    {                                                                         \
+      typed_array_set_capacity(&array->heap, sizeof(Type), array->size,       \
+          &array->capacity, array->capacity / 2, (InlineCapacity));           \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  static inline void prefix##_pop(Name* array)                                \
+  {                                                                           \
+    prefix##_pop_many(array, 1);                                              \
+  }
+
+/**
+ * @brief Declare a growable array of `Type` named `Name` with accessors
+ * prefixed by `prefix`.
+ *
+ * Unlike `AutoArray` the element size is known at compile time, so `get`
+ * compiles down to a pointer add. Capacity grows geometrically and only
+ * shrinks once the array drops to a quarter full.
+ */
+#define TYPED_ARRAY_DEFINE(Name, prefix, Type) \
+  typedef struct Name                          \
+  {                                            \
+    size_t size;                               \
+    size_t capacity;                           \
+    Type* heap;                                \
+  } Name;                                      \
+  TYPED_ARRAY_FUNCTIONS(Name, prefix, Type, 0)
+
+/**
+ * @brief Declare a growable array that stores up to `InlineCapacity` elements
+ * inside the struct before spilling to the heap.
+ *
+ * The inline elements share storage with the heap pointer, so the struct can
+ * be moved with `memcpy` (e.g. when it lives inside another array).
+ */
+#define TYPED_ARRAY_DEFINE_SMALL(Name, prefix, Type, InlineCapacity) \
+  typedef struct Name                                                \
+  {                                                                  \
+    size_t size;                                                     \
+    size_t capacity;                                                 \
+    union                                                            \
+    {                                                                \
+      Type* heap;                                                    \
+      Type inlineElements[InlineCapacity];                           \
+    };                                                               \
+  } Name;                                                            \
+  TYPED_ARRAY_FUNCTIONS(Name, prefix, Type, InlineCapacity)
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "Otter/Util/Log.h"
+#include "Otter/Util/export.h"
+
+#define VIRTUAL_ARRAY_MIN_COMMIT (64 * 1024)
+
+typedef enum VirtualArrayFlags
+{
+  VAF_NONE = 0,
+  // Back the whole reservation with large pages up front. Needs the "Lock
+  // pages in memory" privilege, otherwise the array falls back to normal
+  // pages.
+  VAF_LARGE_PAGES = 1 << 0,
+} VirtualArrayFlags;
+
+/**
+ * @brief A growable array that reserves address space for its largest size up
+ * front and commits pages as it grows.
+ *
+ * Growing never copies, so pointers to elements stay valid for the lifetime
+ * of the array. The first four members match `AutoArray`.
+ */
+typedef struct VirtualArray
+{
+  size_t sizeOfElement;
+  size_t size;
+  size_t capacity;
+  void* buffer;
+  size_t maxCapacity;
+  size_t committedBytes;
+  size_t reservedBytes;
+  bool largePages;
+} VirtualArray;
+
+/**
+ * @brief Create a virtual array.
+ *
+ * @param array The array to create.
+ * @param elementSize The size of each element.
+ * @param maxElements The most elements the array can ever hold.
+ * @param flags Options for the backing memory.
+ * @return true if the address space could be reserved, false otherwise.
+ */
+OTTERUTIL_API bool virtual_array_create(VirtualArray* array, size_t elementSize,
+    size_t maxElements, VirtualArrayFlags flags);
+
+OTTERUTIL_API void virtual_array_destroy(VirtualArray* array);
+
+/**
+ * @brief Make sure at least `elementCount` elements are committed.
+ *
+ * @return false if that is more than the array reserved or the pages could
+ * not be committed.
+ */
+OTTERUTIL_API bool virtual_array_reserve(
+    VirtualArray* array, size_t elementCount);
+
+OTTERUTIL_API void* virtual_array_allocate(VirtualArray* array);
+
+OTTERUTIL_API void* virtual_array_allocate_many(
+    VirtualArray* array, size_t elementCount);
+
+OTTERUTIL_API void virtual_array_clear(VirtualArray* array);
+
+OTTERUTIL_API void virtual_array_pop_many(
+    VirtualArray* array, size_t elementCount);
+
+/** @brief Give the pages past the last element back to the system. */
+OTTERUTIL_API void virtual_array_shrink_to_fit(VirtualArray* array);
+
+OTTERUTIL_API inline void* virtual_array_get(VirtualArray* array, size_t index)
+{
+#ifdef _DEBUG
+  if (index >= array->size)
+  {
+    LOG_WARNING("Out of bounds read of index %zd on array of size %zd", index,
+        array->size);
+    return NULL;
+  }
+#endif
+  return (char*) array->buffer + index * array->sizeOfElement;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Otter/Util/export.h"
+
+/**
+ * @brief Body of a benchmark. Must run the measured operation `iterations`
+ * times.
+ */
+typedef void (*BenchmarkFunction)(void* userData, uint64_t iterations);
+
+typedef struct BenchmarkResult
+{
+  const char* name;
+  uint64_t iterations;
+  double totalSeconds;
+  double nanosecondsPerIteration;
+} BenchmarkResult;
+
+/**
+ * @brief Run a benchmark, growing the iteration count until a run takes long
+ * enough to time reliably, and print the result. Counters added to by the
+ * final run are printed under it per iteration.
+ *
+ * @param name The name printed alongside the result.
+ * @param function The benchmark body.
+ * @param userData Passed through to `function`.
+ * @return The timing of the final run.
+ */
+OTTERUTIL_API BenchmarkResult benchmark_run(
+    const char* name, BenchmarkFunction function, void* userData);
+
+/**
+ * @brief Keep the compiler from optimizing away a value a benchmark computes.
+ */
+OTTERUTIL_API void benchmark_do_not_optimize(const void* value);
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Otter/Util/Array/AutoArray.h"
+#include "Otter/Util/export.h"
+
+// Files start with these eight characters, then the version.
+#define BINARY_LOG_MAGIC   "OTTERLOG"
+#define BINARY_LOG_VERSION 1
+
+// How each argument slot of an event is read. A format's `*` widths and
+// precisions take a slot of their own and read as LA_SIGNED.
+enum LogArgument
+{
+  LA_LITERAL,
+  LA_SIGNED,
+  LA_UNSIGNED,
+  LA_CHARACTER,
+  LA_DOUBLE,
+  LA_POINTER,
+  LA_STRING,
+  LA_UNSUPPORTED
+};
+
+enum BinaryLogRecordType
+{
+  BLR_SITE = 1,
+  BLR_EVENT,
+  BLR_DROPPED
+};
+
+// Everything in the file is little endian and 8 byte aligned. The header is
+// followed by records, each starting with its type and its size in bytes.
+typedef struct BinaryLogHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  // Ticks a second of the event timestamps.
+  int64_t frequency;
+  // Timestamp the logger started at.
+  int64_t start;
+} BinaryLogHeader;
+
+typedef struct BinaryLogRecord
+{
+  uint32_t type;
+  uint32_t size;
+} BinaryLogRecord;
+
+// Written once per call site before its first event. Followed by the file
+// name and the format, each null terminated and counted in their lengths,
+// then `argumentCount` LogArgument bytes, padded to 8 bytes.
+typedef struct BinaryLogSiteRecord
+{
+  BinaryLogRecord record;
+  uint32_t id;
+  int32_t line;
+  int32_t verbosity;
+  uint32_t fileLength;
+  uint32_t formatLength;
+  uint32_t argumentCount;
+} BinaryLogSiteRecord;
+
+// Followed by the arguments in 8 byte slots. Strings are a length slot then
+// their characters, padded to a slot.
+typedef struct BinaryLogEventRecord
+{
+  BinaryLogRecord record;
+  uint32_t site;
+  // Repeats held back by the rate limit since the last one written.
+  uint32_t suppressed;
+  int64_t timestamp;
+} BinaryLogEventRecord;
+
+typedef struct BinaryLogDroppedRecord
+{
+  BinaryLogRecord record;
+  uint32_t count;
+  uint32_t reserved;
+  int64_t timestamp;
+} BinaryLogDroppedRecord;
+
+typedef struct BinaryLogSite
+{
+  const char* file;
+  const char* format;
+  const uint8_t* arguments;
+  uint32_t argumentCount;
+  int32_t line;
+  int32_t verbosity;
+} BinaryLogSite;
+
+typedef struct BinaryLogEntry
+{
+  // NULL when messages were dropped rather than logged.
+  const BinaryLogSite* site;
+  // Seconds since the logger started.
+  double time;
+  // Repeats held back before this message, or messages dropped.
+  uint32_t count;
+  const char* arguments;
+  uint32_t argumentsSize;
+} BinaryLogEntry;
+
+/**
+ * @brief Reads a log written with `log_set_binary_output` back one message at
+ * a time. Sites and arguments point into the data, which has to outlive the
+ * reader.
+ */
+typedef struct BinaryLogReader
+{
+  const char* data;
+  uint64_t length;
+  uint64_t offset;
+  int64_t frequency;
+  int64_t start;
+  // BinaryLogSite indexed by id.
+  AutoArray sites;
+} BinaryLogReader;
+
+/** @return False if `data` doesn't start with a binary log header. */
+OTTERUTIL_API bool binary_log_reader_open(
+    BinaryLogReader* reader, const char* data, uint64_t length);
+
+/**
+ * @brief Read the next message into `entry`.
+ *
+ * @return False at the end of the log, or at a record that is cut short or
+ * names a site it hasn't seen, as the tail of a crashed run's log can be.
+ */
+OTTERUTIL_API bool binary_log_reader_next(
+    BinaryLogReader* reader, BinaryLogEntry* entry);
+
+OTTERUTIL_API void binary_log_reader_close(BinaryLogReader* reader);
+
+/**
+ * @brief Format `entry` the way the text log writes its message, without the
+ * time, level and location. The result is always null terminated.
+ *
+ * @return Characters written, not counting the terminator.
+ */
+OTTERUTIL_API size_t binary_log_format_message(
+    const BinaryLogEntry* entry, char* buffer, size_t capacity);
@@ -11,6 +11,8 @@ typedef uint64_t BitMapSlot;
 #define BIT_MAP_MASK_ENTRY_SIZE (sizeof(BitMapSlot) * 8)
 
 OTTERUTIL_API void bit_map_create(BitMap* map);
+OTTERUTIL_API void bit_map_create_with_allocator(
+    BitMap* map, Allocator* allocator);
 OTTERUTIL_API void bit_map_destroy(BitMap* map);
 
 OTTERUTIL_API void bit_map_set_bit(
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Otter/Util/Profiler.h"
+#include "Otter/Util/export.h"
+
+// How many counters with different names can be kept.
+#define COUNTER_MAX 128
+
+// How long the per frame and per second averages are taken over.
+#define COUNTER_WINDOW_MS 1000
+
+enum CounterType
+{
+  CT_INTEGER,
+  CT_FLOAT
+};
+
+/**
+ * @brief Where a counter is added to in the code. Made by `COUNTER_ADD`.
+ * Sites with the same name add to the same counter.
+ */
+typedef struct CounterSite
+{
+  const char* name;
+  enum CounterType type;
+  // One more than the counter's index once registered, or -1 if it couldn't
+  // be.
+  volatile LONG index;
+} CounterSite;
+
+/**
+ * @brief Add `value` to the integer counter `name`, such as
+ * `COUNTER_ADD(draw_calls, 1)`. Each thread adds to its own copy of every
+ * counter, so it costs a thread local lookup and an add. The copies are
+ * summed by `counter_update`.
+ */
+#define COUNTER_ADD(name, value)                                             \
+  static CounterSite PROFILE_CONCAT(g_counterSite, __LINE__) = {             \
+      #name, CT_INTEGER};                                                    \
+  counter_add(&PROFILE_CONCAT(g_counterSite, __LINE__), (int64_t) (value))
+
+/** @brief Add `value` to the floating point counter `name`. */
+#define COUNTER_ADD_FLOAT(name, value)                                       \
+  static CounterSite PROFILE_CONCAT(g_counterSite, __LINE__) = {             \
+      #name, CT_FLOAT};                                                      \
+  counter_add_float(&PROFILE_CONCAT(g_counterSite, __LINE__), (double) (value))
+
+typedef struct CounterSummary
+{
+  // Added between the last two calls to `counter_update`.
+  double frame;
+  // Averages over the last full window.
+  double perFrame;
+  double perSecond;
+  // Added since the program started.
+  double total;
+} CounterSummary;
+
+typedef void (*CounterFunction)(
+    const char* name, const CounterSummary* summary, void* userData);
+
+OTTERUTIL_API void counter_add(CounterSite* site, int64_t value);
+
+OTTERUTIL_API void counter_add_float(CounterSite* site, double value);
+
+/**
+ * @brief Sum every thread's copy of each counter to get what was added since
+ * the last call. Call it once a frame.
+ */
+OTTERUTIL_API void counter_update();
+
+/** @return False if nothing has been added to `name`. */
+OTTERUTIL_API bool counter_summary_get(
+    const char* name, CounterSummary* summary);
+
+/** @brief Call `function` with every counter, in the order they were made. */
+OTTERUTIL_API void counter_iterate(CounterFunction function, void* userData);
+
+/**
+ * @brief Write a line for every counter that's been added to, with its
+ * average per frame and per second and its total.
+ */
+OTTERUTIL_API void counter_report(FILE* output);
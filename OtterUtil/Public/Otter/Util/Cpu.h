@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Otter/Util/export.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+
+// MSVC lets any function use any intrinsic, so kernels need no annotation.
+#define CPU_TARGET_SSE42
+#define CPU_TARGET_AVX2
+#else
+// GCC and Clang only emit an instruction set in functions that ask for it.
+#define CPU_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+#define CPU_TARGET_AVX2  __attribute__((target("avx2,bmi,popcnt")))
+#endif
+
+/**
+ * @brief Instruction sets that kernels with runtime dispatch are written
+ * for. Each level implies the ones before it.
+ */
+typedef enum CpuSimdLevel
+{
+  CPU_SIMD_SCALAR,
+  CPU_SIMD_SSE42,
+  CPU_SIMD_AVX2,
+  CPU_SIMD_COUNT
+} CpuSimdLevel;
+
+/**
+ * @brief Get the widest instruction set that both the CPU and the OS support.
+ * It is detected on the first call and cached.
+ */
+OTTERUTIL_API CpuSimdLevel cpu_get_simd_level();
+
+OTTERUTIL_API const char* cpu_simd_level_name(CpuSimdLevel level);
+
+/** @brief Index of the lowest set bit. `value` must not be 0. */
+static inline uint32_t cpu_trailing_zeros(uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return index;
+#else
+  return (uint32_t) __builtin_ctzll(value);
+#endif
+}
+
+/** @brief Zero bits above the highest set bit. `value` must not be 0. */
+static inline uint32_t cpu_leading_zeros(uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return 63 - index;
+#else
+  return (uint32_t) __builtin_clzll(value);
+#endif
+}
+
+/**
+ * @brief Read the CPU's timestamp counter, which is far cheaper than
+ * QueryPerformanceCounter. It ticks at a constant rate on the CPUs the game
+ * supports, but that rate has to be measured against a clock.
+ */
+static inline uint64_t cpu_read_timestamp()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  return __rdtsc();
+#else
+  return __builtin_ia32_rdtsc();
+#endif
+}
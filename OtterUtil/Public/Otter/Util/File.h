@@ -1,9 +1,43 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "Otter/Util/export.h"
 
+/**
+ * @brief A read-only view of a whole file, mapped into memory.
+ *
+ * Pages are read from disk as they're touched rather than copied up front, so
+ * parsing straight out of `data` costs no heap memory beyond what the OS
+ * caches. Unlike `file_load` the data isn't null terminated.
+ */
+typedef struct FileView
+{
+  const char* data;
+  uint64_t length;
+} FileView;
+
 OTTERUTIL_API char* file_load(const char* path, uint64_t* fileLength);
 
+/**
+ * @brief Map `path` for reading. The file is opened for sequential access so
+ * the OS reads ahead of whoever walks through it.
+ *
+ * @return False if the file couldn't be opened or mapped.
+ */
+OTTERUTIL_API bool file_map(const char* path, FileView* view);
+
+/**
+ * @brief Ask the OS to start reading `length` bytes from `offset` into memory
+ * ahead of their use. Only a hint; it returns without waiting.
+ */
+OTTERUTIL_API void file_prefetch(
+    const FileView* view, uint64_t offset, uint64_t length);
+
+/** @brief Unmap the view. Pointers into it are invalid afterwards. */
+OTTERUTIL_API void file_unmap(FileView* view);
+
 OTTERUTIL_API void file_write(
     const char* path, const char* data, uint64_t length);
 
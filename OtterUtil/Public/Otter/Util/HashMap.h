@@ -2,6 +2,7 @@
 
 #include "Otter/Util/Array/StableAutoArray.h"
 #include "Otter/Util/Hash.h"
+#include "Otter/Util/Memory/Allocator.h"
 #include "Otter/Util/export.h"
 
 #define HASH_MAP_DEFAULT_BUCKETS 512
@@ -22,14 +23,19 @@ typedef struct HashMap
   StableAutoArray* buckets;
   size_t numOfBuckets;
   size_t coefficient;
+  Allocator* allocator;
 } HashMap;
 
 typedef void (*HashMapDestroyFn)(void*);
 typedef void (*HashMapIterateFn)(void*, size_t, void*, void*);
 
+// Maps made without an allocator are counted under `MEMORY_TAG_HASH_MAP`.
 OTTERUTIL_API bool hash_map_create(
     HashMap* map, size_t numOfBuckets, size_t coefficient);
 
+OTTERUTIL_API bool hash_map_create_with_allocator(HashMap* map,
+    size_t numOfBuckets, size_t coefficient, Allocator* allocator);
+
 OTTERUTIL_API void hash_map_destroy(HashMap* map, HashMapDestroyFn destructor);
 
 OTTERUTIL_API bool hash_map_set_value(
@@ -44,5 +50,14 @@ OTTERUTIL_API bool hash_map_set_value_float(
 OTTERUTIL_API float hash_map_get_value_float(
     HashMap* map, const void* key, size_t keyLength);
 
+/**
+ * @brief Get the map's own copy of `key`. It stays valid until the map is
+ * destroyed, so callers can share it rather than keeping another copy.
+ *
+ * @return The stored key, or NULL if `key` is not in the map.
+ */
+OTTERUTIL_API const void* hash_map_get_key(
+    HashMap* map, const void* key, size_t keyLength);
+
 OTTERUTIL_API void hash_map_iterate(
     HashMap* map, HashMapIterateFn iterator, void* userData);
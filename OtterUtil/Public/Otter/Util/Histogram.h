@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Otter/Util/export.h"
+
+// Each power of two is split into this many linear buckets, so a value is
+// known to within 1 / 32 of itself.
+#define HISTOGRAM_SUB_BUCKET_BITS  5
+#define HISTOGRAM_SUB_BUCKET_COUNT (1 << HISTOGRAM_SUB_BUCKET_BITS)
+
+// Values from 2^40 up share the last bucket. In nanoseconds that's over 18
+// minutes.
+#define HISTOGRAM_MAX_BITS 40
+#define HISTOGRAM_BUCKET_COUNT                                               \
+  ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BUCKET_BITS + 1)                      \
+      << HISTOGRAM_SUB_BUCKET_BITS)
+
+/**
+ * @brief Counts of values in log-linear buckets, in the style of
+ * HdrHistogram. Values below `HISTOGRAM_SUB_BUCKET_COUNT * 2` are counted
+ * exactly and larger ones to within 1 / 32. Recording is a couple of
+ * instructions no matter how many values there are, and histograms of the
+ * same values split any way merge back into the same histogram.
+ *
+ * A zeroed histogram is empty.
+ */
+typedef struct Histogram
+{
+  uint64_t count;
+  uint64_t total;
+  uint64_t min;
+  uint64_t max;
+  uint64_t buckets[HISTOGRAM_BUCKET_COUNT];
+} Histogram;
+
+OTTERUTIL_API void histogram_clear(Histogram* histogram);
+
+OTTERUTIL_API void histogram_record(Histogram* histogram, uint64_t value);
+
+/** @brief Add everything recorded in `from` to `into`. */
+OTTERUTIL_API void histogram_merge(Histogram* into, const Histogram* from);
+
+/**
+ * @brief The value `percentile` percent of values are at or below, as the
+ * largest value in its bucket. 0 is the smallest value and 100 the largest.
+ *
+ * @return 0 if nothing was recorded.
+ */
+OTTERUTIL_API uint64_t histogram_percentile(
+    const Histogram* histogram, double percentile);
+
+/** @brief The exact mean of every value recorded, or 0 if there are none. */
+OTTERUTIL_API double histogram_mean(const Histogram* histogram);
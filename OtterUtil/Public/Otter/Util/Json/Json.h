@@ -2,6 +2,7 @@
 
 #include "Otter/Util/Array/AutoArray.h"
 #include "Otter/Util/HashMap.h"
+#include "Otter/Util/String/StringView.h"
 #include "Otter/Util/export.h"
 
 enum JsonType
@@ -12,16 +13,23 @@ enum JsonType
   JT_FLOAT,
   JT_INTEGER,
   JT_BOOLEAN,
+  // Only produced by `JsonDocument`. `json_parse` returns NULL for null.
+  JT_NULL,
 };
 
 typedef struct JsonValue
 {
   enum JsonType type;
+  // Set when `string` had escape sequences and had to be copied out of the
+  // document.
+  bool ownsString;
   union
   {
     HashMap object;
     AutoArray array;
-    char* string;
+    // Points into the parsed document unless `ownsString` is set. Not null
+    // terminated.
+    StringView string;
     double floatingPoint;
     int64_t integer;
     bool boolean;
@@ -54,6 +62,7 @@ typedef struct JsonToken
     {
       const char* tokenString;
       size_t tokenStringLength;
+      bool tokenStringEscaped;
     };
     uint64_t tokenInteger;
     double tokenFloat;
@@ -66,7 +75,22 @@ bool json_get_token(JsonToken* token, const char* document,
 void json_peek_token(JsonToken* token, const char* document,
     size_t documentLength, size_t cursor);
 
+/**
+ * @brief Parse a document. String values are views into `document`, so it
+ * must outlive the result.
+ */
 OTTERUTIL_API JsonValue* json_parse(
     const char* document, size_t documentLength, size_t* const cursor);
 
+/**
+ * @brief Parse a document, allocating every node, string, object and array
+ * from `allocator`. The result must be released with
+ * `json_destroy_with_allocator` and the same allocator.
+ */
+OTTERUTIL_API JsonValue* json_parse_with_allocator(const char* document,
+    size_t documentLength, size_t* const cursor, Allocator* allocator);
+
 OTTERUTIL_API void json_destroy(JsonValue* value);
+
+OTTERUTIL_API void json_destroy_with_allocator(
+    JsonValue* value, Allocator* allocator);
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Otter/Util/Json/Json.h"
+#include "Otter/Util/Json/JsonStructural.h"
+#include "Otter/Util/Memory/Allocator.h"
+#include "Otter/Util/Memory/Arena.h"
+#include "Otter/Util/String/StringView.h"
+#include "Otter/Util/export.h"
+
+/**
+ * @brief Reads a JSON document on demand, one value at a time in document
+ * order.
+ *
+ * Nothing is built up front besides the structural index, so reading a
+ * document only costs what the reader asks for and skipping a subtree only
+ * costs a walk over its brackets. Every value has to be consumed by exactly
+ * one get, enter or skip call before moving on.
+ *
+ * Errors are sticky. Once the cursor hits malformed JSON every call fails and
+ * loops over members or elements end, so readers only need to check
+ * `json_cursor_finish` once at the end.
+ *
+ * @code
+ * JsonCursor cursor;
+ * json_cursor_create(&cursor, source, sourceLength, NULL);
+ * if (json_cursor_enter_object(&cursor))
+ * {
+ *   StringView key;
+ *   while (json_cursor_next_member(&cursor, &key))
+ *   {
+ *     if (string_view_equals_cstr(key, "count"))
+ *     {
+ *       json_cursor_get_integer(&cursor, &count);
+ *     }
+ *     else
+ *     {
+ *       json_cursor_skip(&cursor);
+ *     }
+ *   }
+ * }
+ * bool valid = json_cursor_finish(&cursor);
+ * json_cursor_destroy(&cursor);
+ * @endcode
+ */
+typedef struct JsonCursor
+{
+  const char* source;
+  size_t sourceLength;
+  JsonStructuralIndex index;
+  size_t next;
+  // Set right after entering a container, before its first member or
+  // element has been asked for.
+  bool containerStart;
+  bool failed;
+  Allocator* allocator;
+  // Holds decoded strings. Only created once a string needs decoding.
+  Arena strings;
+  bool hasStrings;
+} JsonCursor;
+
+/**
+ * @brief Index `source` and point the cursor at its root value.
+ *
+ * @param cursor The cursor to create.
+ * @param source The JSON text. Must outlive the cursor.
+ * @param sourceLength The length of `source`.
+ * @param allocator Backs the structural index and decoded strings. NULL for
+ * the default heap.
+ * @return False if the document couldn't be indexed. Nothing needs destroying
+ * in that case.
+ */
+OTTERUTIL_API bool json_cursor_create(JsonCursor* cursor, const char* source,
+    size_t sourceLength, Allocator* allocator);
+
+OTTERUTIL_API void json_cursor_destroy(JsonCursor* cursor);
+
+/**
+ * @brief Check that every value was consumed without errors.
+ */
+OTTERUTIL_API bool json_cursor_finish(JsonCursor* cursor);
+
+/**
+ * @brief Get the type of the next value without consuming it.
+ *
+ * @return False if there is no valid value.
+ */
+OTTERUTIL_API bool json_cursor_peek_type(
+    JsonCursor* cursor, enum JsonType* type);
+
+/**
+ * @brief Step into an object. Its members are then read with
+ * `json_cursor_next_member`.
+ *
+ * @return False if the value is not an object. It is skipped in that case.
+ */
+OTTERUTIL_API bool json_cursor_enter_object(JsonCursor* cursor);
+
+/**
+ * @brief Move to the next member of the entered object. Its value is next.
+ *
+ * @param cursor The cursor.
+ * @param key Receives the key as written in the source, escapes included.
+ * @return False once the object is done, after stepping out of it.
+ */
+OTTERUTIL_API bool json_cursor_next_member(JsonCursor* cursor, StringView* key);
+
+/**
+ * @brief Step into an array. Its elements are then read with
+ * `json_cursor_next_element`.
+ *
+ * @return False if the value is not an array. It is skipped in that case.
+ */
+OTTERUTIL_API bool json_cursor_enter_array(JsonCursor* cursor);
+
+/**
+ * @brief Move to the next element of the entered array.
+ *
+ * @return False once the array is done, after stepping out of it.
+ */
+OTTERUTIL_API bool json_cursor_next_element(JsonCursor* cursor);
+
+/**
+ * @brief Skip the next value along with anything nested in it.
+ *
+ * Skipped values are only checked for balanced brackets.
+ */
+OTTERUTIL_API bool json_cursor_skip(JsonCursor* cursor);
+
+/**
+ * @brief Read an integer. Other values are skipped and false is returned.
+ */
+OTTERUTIL_API bool json_cursor_get_integer(JsonCursor* cursor, int64_t* value);
+
+/**
+ * @brief Read any number as a double. Other values are skipped and false is
+ * returned.
+ */
+OTTERUTIL_API bool json_cursor_get_number(JsonCursor* cursor, double* value);
+
+/**
+ * @brief Read a string as written in the source, escapes included. Other
+ * values are skipped and false is returned.
+ */
+OTTERUTIL_API bool json_cursor_get_string(
+    JsonCursor* cursor, StringView* value);
+
+/**
+ * @brief Read a string with its escapes decoded. Strings without escapes
+ * still point into the source. The others are decoded into memory that lasts
+ * until the cursor is destroyed. Other values are skipped and false is
+ * returned.
+ */
+OTTERUTIL_API bool json_cursor_get_unescaped_string(
+    JsonCursor* cursor, StringView* value);
+
+/**
+ * @brief Read `true` or `false`. Other values are skipped and false is
+ * returned.
+ */
+OTTERUTIL_API bool json_cursor_get_boolean(JsonCursor* cursor, bool* value);
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Otter/Util/Json/Json.h"
+#include "Otter/Util/Memory/Arena.h"
+#include "Otter/Util/String/StringView.h"
+#include "Otter/Util/export.h"
+
+// Objects with more members than this get a hash index for lookups. Smaller
+// ones are scanned.
+#define JSON_OBJECT_INDEX_THRESHOLD 16
+#define JSON_DOCUMENT_MAX_DEPTH     512
+
+typedef struct JsonMember JsonMember;
+
+/**
+ * @brief A value in a `JsonDocument`.
+ *
+ * Arrays and objects hold their children in one contiguous run, so a node is
+ * only 16 bytes and walking a container never chases pointers.
+ */
+typedef struct JsonNode
+{
+  enum JsonType type;
+  // Characters in a string, elements in an array or members in an object.
+  uint32_t length;
+  union
+  {
+    // Points into the source unless it had escape sequences, in which case
+    // it is a null terminated copy in the document's arena.
+    const char* string;
+    struct JsonNode* elements;
+    JsonMember* members;
+    double floatingPoint;
+    int64_t integer;
+    bool boolean;
+  };
+} JsonNode;
+
+struct JsonMember
+{
+  StringView key;
+  JsonNode value;
+};
+
+/**
+ * @brief A compact, read only DOM. Every node, member, copied string and
+ * object index lives in one arena, so destroying it is a handful of frees no
+ * matter how large the document was.
+ */
+typedef struct JsonDocument
+{
+  Arena arena;
+  JsonNode root;
+} JsonDocument;
+
+/**
+ * @brief Parse `source` into a document. Strings are views into `source`, so
+ * it must outlive the document.
+ *
+ * @param document The document to fill.
+ * @param source The JSON text.
+ * @param sourceLength The length of `source`.
+ * @param allocator Backs the document's arena. NULL for the heap, counted
+ * under `MEMORY_TAG_JSON`.
+ * @return True if the whole value parsed. Nothing needs destroying otherwise.
+ */
+OTTERUTIL_API bool json_document_parse(JsonDocument* document,
+    const char* source, size_t sourceLength, Allocator* allocator);
+
+OTTERUTIL_API void json_document_destroy(JsonDocument* document);
+
+/**
+ * @brief Look up a member of an object.
+ *
+ * @return The value for `key`, or NULL if `object` is not an object or has no
+ * such member.
+ */
+OTTERUTIL_API JsonNode* json_node_find_member(JsonNode* object, StringView key);
+
+static inline JsonNode* json_node_get_member(JsonNode* object, const char* key)
+{
+  return json_node_find_member(object, string_view_from_cstr(key));
+}
+
+/**
+ * @brief Get an element of an array.
+ *
+ * @return The element at `index`, or NULL if `array` is not an array or is
+ * too short.
+ */
+static inline JsonNode* json_node_get_element(JsonNode* array, size_t index)
+{
+  if (array->type != JT_ARRAY || index >= array->length)
+  {
+    return NULL;
+  }
+  return &array->elements[index];
+}
+
+static inline StringView json_node_get_string(JsonNode* node)
+{
+  return string_view_create(node->string, node->length);
+}
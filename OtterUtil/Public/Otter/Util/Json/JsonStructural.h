@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Otter/Util/Cpu.h"
+#include "Otter/Util/Memory/Allocator.h"
+#include "Otter/Util/export.h"
+
+/** @brief Bytes classified per step of the structural scan. */
+#define JSON_STRUCTURAL_BLOCK_SIZE 64
+
+/**
+ * @brief Where every token of a JSON document starts.
+ *
+ * Records the offset of each `{ } [ ] : ,` outside of a string, of each
+ * opening quote and of the first character of each number or literal. The
+ * parser then visits tokens straight from these offsets instead of
+ * classifying the document a character at a time.
+ */
+typedef struct JsonStructuralIndex
+{
+  uint32_t* positions;
+  size_t count;
+  size_t capacity;
+  Allocator* allocator;
+} JsonStructuralIndex;
+
+/**
+ * @brief Find the start of every token in `source`, 64 bytes at a time.
+ *
+ * @param index The index to fill.
+ * @param source The JSON text.
+ * @param sourceLength The length of `source`. Must fit in 32 bits.
+ * @param level The widest kernel to use. Clamped to what the CPU supports.
+ * @param allocator Backs the positions. NULL for the default heap.
+ * @return False if a string is left open or memory runs out. Nothing needs
+ * destroying in that case.
+ */
+OTTERUTIL_API bool json_structural_index_build(JsonStructuralIndex* index,
+    const char* source, size_t sourceLength, CpuSimdLevel level,
+    Allocator* allocator);
+
+OTTERUTIL_API void json_structural_index_destroy(JsonStructuralIndex* index);
+
+static inline bool json_is_whitespace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Otter/Util/Memory/Allocator.h"
+#include "Otter/Util/String/StringView.h"
+#include "Otter/Util/export.h"
+
+// Size of the buffer a file writer fills before handing it to the file.
+#define JSON_WRITER_FILE_BUFFER_SIZE (64 * 1024)
+
+#define JSON_WRITER_MIN_CAPACITY 256
+
+enum JsonWriterStyle
+{
+  JSON_WRITER_COMPACT,
+  // Two space indents and one member or element per line.
+  JSON_WRITER_PRETTY,
+};
+
+/**
+ * @brief Writes JSON as it is produced, into a growing buffer or in chunks to
+ * a file.
+ *
+ * Values are written in document order. Commas, colons and indentation are
+ * added by the writer, and strings are escaped. The caller is trusted to nest
+ * containers properly and to give object members keys.
+ *
+ * @code
+ * JsonWriter writer;
+ * json_writer_open(&writer, "trace.json", JSON_WRITER_COMPACT);
+ * json_writer_begin_object(&writer);
+ * json_writer_key(&writer, STRING_VIEW_LITERAL("ts"));
+ * json_writer_double(&writer, timestamp);
+ * json_writer_end_object(&writer);
+ * bool written = json_writer_close(&writer);
+ * @endcode
+ */
+typedef struct JsonWriter
+{
+  char* buffer;
+  size_t length;
+  size_t capacity;
+  Allocator* allocator;
+  // NULL when writing to memory.
+  FILE* file;
+  enum JsonWriterStyle style;
+  uint32_t depth;
+  // The next value is not the first one in its container.
+  bool needsComma;
+  // The next value belongs to the key just written.
+  bool afterKey;
+  bool failed;
+} JsonWriter;
+
+/**
+ * @brief Create a writer that collects everything in memory.
+ *
+ * @param writer The writer to create.
+ * @param style Compact or pretty output.
+ * @param allocator Backs the output buffer. NULL for the default heap.
+ */
+OTTERUTIL_API void json_writer_create(
+    JsonWriter* writer, enum JsonWriterStyle style, Allocator* allocator);
+
+/**
+ * @brief Create a writer that streams to a file, replacing what was there.
+ * The file is written in binary mode so output is byte for byte.
+ *
+ * @return False if the file couldn't be opened.
+ */
+OTTERUTIL_API bool json_writer_open(
+    JsonWriter* writer, const char* path, enum JsonWriterStyle style);
+
+/**
+ * @brief Finish writing. Flushes and closes the file, or frees the buffer of
+ * a memory writer.
+ *
+ * @return False if anything failed to be written.
+ */
+OTTERUTIL_API bool json_writer_close(JsonWriter* writer);
+
+/**
+ * @brief The output of a memory writer so far, null terminated. Valid until
+ * the next write or close.
+ */
+OTTERUTIL_API StringView json_writer_get_output(JsonWriter* writer);
+
+/** @brief Hand buffered output to the file. Does nothing in memory. */
+OTTERUTIL_API bool json_writer_flush(JsonWriter* writer);
+
+OTTERUTIL_API void json_writer_begin_object(JsonWriter* writer);
+
+OTTERUTIL_API void json_writer_end_object(JsonWriter* writer);
+
+OTTERUTIL_API void json_writer_begin_array(JsonWriter* writer);
+
+OTTERUTIL_API void json_writer_end_array(JsonWriter* writer);
+
+/** @brief Start an object member. Its value is the next thing written. */
+OTTERUTIL_API void json_writer_key(JsonWriter* writer, StringView key);
+
+OTTERUTIL_API void json_writer_string(JsonWriter* writer, StringView value);
+
+OTTERUTIL_API void json_writer_integer(JsonWriter* writer, int64_t value);
+
+/**
+ * @brief Write the shortest form of `value` that reads back exactly.
+ * Infinities and NaN have no JSON form and are written as `null`.
+ */
+OTTERUTIL_API void json_writer_double(JsonWriter* writer, double value);
+
+OTTERUTIL_API void json_writer_boolean(JsonWriter* writer, bool value);
+
+OTTERUTIL_API void json_writer_null(JsonWriter* writer);
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <Windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Otter/Util/Profiler.h"
+#include "Otter/Util/export.h"
+
+// How many locks with different names can be counted.
+#define LOCK_MAX_NAMES 64
+
+// How many call sites `lock_report` lists under each lock.
+#define LOCK_REPORT_HOLDERS 3
+
+typedef struct LockStatistics LockStatistics;
+
+/**
+ * @brief A critical section that can count how it's used. Built with
+ * `OTTER_PROFILE_LOCKS` defined, `LOCK_ACQUIRE` and `LOCK_RELEASE` count
+ * acquisitions, contended acquisitions, the time spent waiting and which call
+ * sites hold it longest. Without it they're a plain enter and leave.
+ */
+typedef struct Lock
+{
+  CRITICAL_SECTION section;
+  // Shared by every lock with the same name.
+  LockStatistics* statistics;
+  // Written by whoever holds the lock.
+  int64_t acquiredAt;
+  struct LockSite* holder;
+} Lock;
+
+/**
+ * @brief Where a lock is taken in the code. Made by `LOCK_ACQUIRE`.
+ * Everything after the location belongs to the lock.
+ */
+typedef struct LockSite
+{
+  const char* file;
+  int32_t line;
+  volatile LONG registered;
+  struct LockSite* next;
+  // Of the first lock taken here.
+  LockStatistics* statistics;
+  volatile LONG64 holds;
+  volatile LONG64 holdTicks;
+  volatile LONG64 maxHoldTicks;
+  // Contended waits are profiled as zones named after the lock.
+  ProfileSite wait;
+} LockSite;
+
+#ifdef OTTER_PROFILE_LOCKS
+// The site lives in its own block so the macro is a single statement, safe
+// as the body of an unbraced `if`.
+#define LOCK_ACQUIRE(lock)                                                   \
+  do                                                                         \
+  {                                                                          \
+    static LockSite lockSite = {__FILE__, __LINE__};                         \
+    lock_acquire_at(lock, &lockSite);                                        \
+  } while (0)
+#define LOCK_RELEASE(lock) lock_release(lock)
+#else
+#define LOCK_ACQUIRE(lock) EnterCriticalSection(&(lock)->section)
+#define LOCK_RELEASE(lock) LeaveCriticalSection(&(lock)->section)
+#endif
+
+// Over every lock with the name, since the program started.
+typedef struct LockSummary
+{
+  uint64_t acquisitions;
+  uint64_t contended;
+  // In seconds.
+  float waitTime;
+  float maxWaitTime;
+} LockSummary;
+
+/**
+ * @brief Make a lock counted under `name`, which has to outlive the program.
+ * Locks with the same name are counted together.
+ */
+OTTERUTIL_API void lock_create(Lock* lock, const char* name);
+
+/** @brief Delete the lock. What it counted is kept for reports. */
+OTTERUTIL_API void lock_destroy(Lock* lock);
+
+OTTERUTIL_API void lock_acquire_at(Lock* lock, LockSite* site);
+
+OTTERUTIL_API void lock_release(Lock* lock);
+
+/** @return False if no lock by that name has been counted. */
+OTTERUTIL_API bool lock_summary_get(const char* name, LockSummary* summary);
+
+/**
+ * @brief Write a line for every lock that's been counted, with how often it
+ * was taken and contended and how long threads waited, followed by the call
+ * sites that held it longest in all.
+ */
+OTTERUTIL_API void lock_report(FILE* output);
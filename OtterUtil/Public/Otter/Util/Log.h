@@ -1,24 +1,92 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
 #include "Otter/Util/export.h"
 
+#define LOG_LEVEL_DEBUG   0
+#define LOG_LEVEL_WARNING 1
+#define LOG_LEVEL_ERROR   2
+
+// Messages below this level are compiled out. Define it before including this
+// header, or for the whole build, to override.
+#ifndef LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#else
+#define LOG_MIN_LEVEL LOG_LEVEL_WARNING
+#endif
+#endif
+
+// How many times a second the same message is written, by default, before
+// repeats are only counted.
+#define LOG_RATE_LIMIT 20
+
 #define LOG_MSG(verbosity, message, ...) \
   log_message(__LINE__, __FILE__, verbosity, message, ##__VA_ARGS__)
 
-#ifdef _DEBUG
+#if LOG_MIN_LEVEL <= LOG_LEVEL_DEBUG
 #define LOG_DEBUG(message, ...) LOG_MSG(LOG_DEBUG, message, ##__VA_ARGS__)
 #else
 #define LOG_DEBUG(message, ...)
 #endif
+#if LOG_MIN_LEVEL <= LOG_LEVEL_WARNING
 #define LOG_WARNING(message, ...) LOG_MSG(LOG_WARNING, message, ##__VA_ARGS__)
-#define LOG_ERROR(message, ...)   LOG_MSG(LOG_ERROR, message, ##__VA_ARGS__)
+#else
+#define LOG_WARNING(message, ...)
+#endif
+#define LOG_ERROR(message, ...) LOG_MSG(LOG_ERROR, message, ##__VA_ARGS__)
 
 typedef enum LogVerbosity
 {
-  LOG_DEBUG,
-  LOG_WARNING,
-  LOG_ERROR
+  LOG_DEBUG   = LOG_LEVEL_DEBUG,
+  LOG_WARNING = LOG_LEVEL_WARNING,
+  LOG_ERROR   = LOG_LEVEL_ERROR
 } LogVerbosity;
 
+/**
+ * @brief Log a printf style message.
+ *
+ * The calling thread only copies the arguments into its own buffer, along with
+ * a timestamp. A background thread formats and writes them later, in
+ * timestamp order across threads. `message` must outlive the logger, which
+ * string literals do. Strings passed for `%s` are copied.
+ *
+ * Each message is written at most `LOG_RATE_LIMIT` times a second unless
+ * `log_set_rate_limit` says otherwise. Repeats past that are counted and
+ * reported with the next one written.
+ */
 OTTERUTIL_API void log_message(int sourceLine, const char* sourceFile,
     LogVerbosity verbosity, const char* message, ...);
+
+/** @brief Write everything logged so far before returning. */
+OTTERUTIL_API void log_flush();
+
+/**
+ * @brief Send log output to `file` instead of stdout. Colors are only used on
+ * stdout. NULL goes back to stdout.
+ */
+OTTERUTIL_API void log_set_output(FILE* file);
+
+/**
+ * @brief Write messages to `file` in the binary format of BinaryLog.h rather
+ * than as text. Each call site is written once, and each message after that
+ * is only its site, timestamp and arguments, so nothing is formatted until
+ * the file is decoded with otter-logdecode. `file` must be opened in binary
+ * mode. `log_set_output` goes back to text.
+ *
+ * @return False if logging couldn't switch and stays as it was.
+ */
+OTTERUTIL_API bool log_set_binary_output(FILE* file);
+
+/** @brief Messages a second written per message. 0 writes them all. */
+OTTERUTIL_API void log_set_rate_limit(uint32_t messagesPerSecond);
+
+/**
+ * @brief Stop the logging thread after writing everything logged so far.
+ * This also happens at exit. Messages logged afterwards are written by the
+ * thread that logs them.
+ */
+OTTERUTIL_API void log_shutdown();
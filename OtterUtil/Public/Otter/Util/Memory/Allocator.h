@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdlib.h>
+
+#include "Otter/Util/export.h"
+
+typedef void* (*AllocatorAllocateFn)(void* context, size_t size);
+typedef void* (*AllocatorReallocateFn)(
+    void* context, void* memory, size_t oldSize, size_t newSize);
+typedef void (*AllocatorDeallocateFn)(void* context, void* memory, size_t size);
+
+/**
+ * @brief An allocation interface containers can be handed in place of
+ * malloc/realloc/free.
+ *
+ * Callers always pass the size of the block back when reallocating or
+ * freeing, so size-class allocators don't need a header per block. A NULL
+ * `Allocator*` anywhere one is accepted means the default heap.
+ */
+typedef struct Allocator
+{
+  AllocatorAllocateFn allocate;
+  AllocatorReallocateFn reallocate;
+  AllocatorDeallocateFn deallocate;
+  void* context;
+} Allocator;
+
+/** @brief Get the allocator that forwards to malloc/realloc/free. */
+OTTERUTIL_API Allocator* allocator_get_default();
+
+static inline void* allocator_allocate(Allocator* allocator, size_t size)
+{
+  if (allocator == NULL)
+  {
+    return malloc(size);
+  }
+  return allocator->allocate(allocator->context, size);
+}
+
+static inline void* allocator_reallocate(
+    Allocator* allocator, void* memory, size_t oldSize, size_t newSize)
+{
+  if (allocator == NULL)
+  {
+    return realloc(memory, newSize);
+  }
+  return allocator->reallocate(allocator->context, memory, oldSize, newSize);
+}
+
+static inline void allocator_deallocate(
+    Allocator* allocator, void* memory, size_t size)
+{
+  if (allocator == NULL)
+  {
+    free(memory);
+  }
+  else if (memory != NULL)
+  {
+    allocator->deallocate(allocator->context, memory, size);
+  }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "Otter/Util/Memory/Allocator.h"
+#include "Otter/Util/export.h"
+
+#define ARENA_ALIGNMENT          16
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+typedef struct ArenaBlock ArenaBlock;
+
+/**
+ * @brief A linear allocator for data that is thrown away all at once.
+ *
+ * Allocating bumps a pointer and freeing only gives memory back if it was the
+ * most recent allocation, which lets a growing `AutoArray` extend in place.
+ * Everything is released together by `arena_reset`. When an arena had to
+ * chain extra blocks, the next reset replaces them with one block big enough
+ * for all of them, so a workload that repeats stops touching the parent
+ * allocator after the first pass.
+ *
+ * An arena is not thread safe.
+ */
+typedef struct Arena
+{
+  Allocator allocator;
+  Allocator* parent;
+  ArenaBlock* current;
+  size_t blockSize;
+} Arena;
+
+/**
+ * @brief Create an arena. Use `&arena->allocator` wherever an `Allocator*`
+ * is accepted.
+ *
+ * @param arena The arena to create.
+ * @param blockSize The size of the first block, allocated up front.
+ * @param parent The allocator blocks come from, or NULL for the heap.
+ * @return true if the first block could be allocated, false otherwise.
+ */
+OTTERUTIL_API bool arena_create(
+    Arena* arena, size_t blockSize, Allocator* parent);
+
+/** @brief Return every block to the parent allocator. */
+OTTERUTIL_API void arena_destroy(Arena* arena);
+
+/**
+ * @brief Allocate `size` bytes aligned to `ARENA_ALIGNMENT`.
+ *
+ * @return The memory, or NULL if a new block could not be allocated.
+ */
+OTTERUTIL_API void* arena_allocate(Arena* arena, size_t size);
+
+/**
+ * @brief Release every allocation made from the arena. All memory handed out
+ * by it becomes invalid.
+ */
+OTTERUTIL_API void arena_reset(Arena* arena);
+
+/** @brief Get the number of bytes currently handed out by the arena. */
+OTTERUTIL_API size_t arena_get_used(Arena* arena);
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Otter/Util/Memory/Allocator.h"
+#include "Otter/Util/export.h"
+
+/** @brief What memory is for, so it can be counted by subsystem. */
+typedef enum MemoryTag
+{
+  MEMORY_TAG_GENERAL,
+  // Buckets, chains and keys of maps made without an allocator.
+  MEMORY_TAG_HASH_MAP,
+  // Parsed JSON, both `json_parse` trees and `JsonDocument`s.
+  MEMORY_TAG_JSON,
+  MEMORY_TAG_ECS,
+  // Models and what's loaded out of them on the CPU.
+  MEMORY_TAG_ASSET,
+  MEMORY_TAG_RENDER,
+  // Device memory behind GPU buffers and images. Counted, not allocated.
+  MEMORY_TAG_GPU_BUFFER,
+  MEMORY_TAG_GPU_IMAGE,
+  MEMORY_TAG_COUNT
+} MemoryTag;
+
+#define OTTER_ALLOC(tag, size) \
+  allocator_allocate(memory_tag_get_allocator(tag), size)
+#define OTTER_REALLOC(tag, memory, oldSize, newSize) \
+  allocator_reallocate(memory_tag_get_allocator(tag), memory, oldSize, newSize)
+#define OTTER_FREE(tag, memory, size) \
+  allocator_deallocate(memory_tag_get_allocator(tag), memory, size)
+
+typedef struct MemoryTagStatistics
+{
+  int64_t currentBytes;
+  int64_t peakBytes;
+  int64_t liveAllocations;
+  int64_t totalAllocations;
+  // Over the last second measured by `memory_tag_update`.
+  float allocationsPerSecond;
+} MemoryTagStatistics;
+
+/**
+ * @brief Get an allocator that takes memory from the default heap and counts
+ * it under `tag`. It can be shared between threads. Containers made with it
+ * are counted along with everything else under the tag.
+ */
+OTTERUTIL_API Allocator* memory_tag_get_allocator(MemoryTag tag);
+
+/**
+ * @brief Count `bytes` that something other than a tag's allocator handed
+ * out, such as a pool's slabs or device memory.
+ */
+OTTERUTIL_API void memory_tag_track(MemoryTag tag, int64_t bytes);
+
+/** @brief Stop counting `bytes` passed to `memory_tag_track`. */
+OTTERUTIL_API void memory_tag_untrack(MemoryTag tag, int64_t bytes);
+
+OTTERUTIL_API const char* memory_tag_name(MemoryTag tag);
+
+OTTERUTIL_API void memory_tag_get_statistics(
+    MemoryTag tag, MemoryTagStatistics* statistics);
+
+/**
+ * @brief Measure each tag's allocation rate once a second has passed since
+ * the last time. Call it once a frame.
+ */
+OTTERUTIL_API void memory_tag_update();
+
+/**
+ * @brief Write a line for every tag that's been used, with its current and
+ * peak bytes, live allocations and allocation rate.
+ */
+OTTERUTIL_API void memory_tag_report(FILE* output);
@@ -0,0 +1,50 @@
+#pragma once
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include "Otter/Util/Memory/Allocator.h"
+#include "Otter/Util/Memory/MemoryTag.h"
+#include "Otter/Util/export.h"
+
+#define POOL_ALLOCATOR_MIN_BLOCK_SIZE 16
+#define POOL_ALLOCATOR_SIZE_CLASSES   8
+#define POOL_ALLOCATOR_MAX_BLOCK_SIZE \
+  (POOL_ALLOCATOR_MIN_BLOCK_SIZE << (POOL_ALLOCATOR_SIZE_CLASSES - 1))
+#define POOL_ALLOCATOR_SLAB_SIZE (64 * 1024)
+
+/**
+ * @brief A fixed-size-block allocator with power of two size classes from
+ * `POOL_ALLOCATOR_MIN_BLOCK_SIZE` to `POOL_ALLOCATOR_MAX_BLOCK_SIZE`.
+ *
+ * Each size class is a lock-free free list, so allocating and freeing from
+ * any thread never takes a lock. Blocks are carved out of slabs that are only
+ * returned to the heap when the pool is destroyed. Requests larger than the
+ * biggest size class go to the heap.
+ */
+typedef struct PoolAllocator
+{
+  Allocator allocator;
+  SLIST_HEADER freeBlocks[POOL_ALLOCATOR_SIZE_CLASSES];
+  SLIST_HEADER slabs;
+  // What slabs and blocks too large for the pool are counted under.
+  MemoryTag tag;
+} PoolAllocator;
+
+/**
+ * @brief Create a pool allocator. Use `&pool->allocator` wherever an
+ * `Allocator*` is accepted.
+ *
+ * The pool must stay at a `MEMORY_ALLOCATION_ALIGNMENT` aligned address.
+ */
+OTTERUTIL_API void pool_allocator_create(PoolAllocator* pool);
+
+/** @brief Create a pool whose memory is counted under `tag`. */
+OTTERUTIL_API void pool_allocator_create_tagged(
+    PoolAllocator* pool, MemoryTag tag);
+
+/**
+ * @brief Release every slab owned by the pool. All blocks allocated from it
+ * become invalid.
+ */
+OTTERUTIL_API void pool_allocator_destroy(PoolAllocator* pool);
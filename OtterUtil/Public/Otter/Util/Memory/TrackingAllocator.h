@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Otter/Util/Memory/Allocator.h"
+#include "Otter/Util/export.h"
+
+/**
+ * @brief Wraps another allocator and counts what goes through it. Counters
+ * are updated atomically so the wrapper can be shared between threads.
+ */
+typedef struct TrackingAllocator
+{
+  Allocator allocator;
+  Allocator* parent;
+  volatile int64_t currentBytes;
+  volatile int64_t peakBytes;
+  volatile int64_t liveAllocations;
+  volatile int64_t totalAllocations;
+} TrackingAllocator;
+
+/**
+ * @brief Create a tracking allocator. Use `&tracker->allocator` wherever an
+ * `Allocator*` is accepted.
+ *
+ * @param tracker The tracking allocator.
+ * @param parent The allocator to forward to, NULL for the default heap.
+ */
+OTTERUTIL_API void tracking_allocator_create(
+    TrackingAllocator* tracker, Allocator* parent);
+
+/** @brief Log the current counters of the tracking allocator. */
+OTTERUTIL_API void tracking_allocator_report(
+    TrackingAllocator* tracker, const char* name);
@@ -1,14 +1,193 @@
 #pragma once
 
-#include "Otter/Util/Array/StableAutoArray.h"
+#include <Windows.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Otter/Util/Histogram.h"
 #include "Otter/Util/export.h"
 
+// How long each half of a site's sliding window lasts. Window statistics
+// cover the zones finished in the last one to two of these.
+#define PROFILE_WINDOW_MS 1000
+
+// Frames written around a hitch, ending with the hitch itself.
+#define PROFILE_HITCH_FRAMES 4
+// Frames whose median length a frame is compared against to find hitches.
+#define PROFILE_HITCH_HISTORY 64
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b)       PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Start timing a zone named `name` on this thread. Zones nest, so
+ * anything started before it and not yet ended is its parent. Every way out
+ * of the zone has to pass through `PROFILE_ZONE_END`.
+ *
+ * The site is a static, so it's registered with the profiler the first time
+ * the zone runs and costs nothing to look up after that.
+ *
+ * @code
+ * PROFILE_ZONE("sort_meshes");
+ * qsort(...);
+ * PROFILE_ZONE_END();
+ * @endcode
+ */
+#define PROFILE_ZONE(name)                                                   \
+  static ProfileSite PROFILE_CONCAT(g_profileSite, __LINE__) = {             \
+      name, __FILE__, __LINE__};                                             \
+  profiler_zone_begin(&PROFILE_CONCAT(g_profileSite, __LINE__))
+
+/** @brief End the zone this thread started most recently. */
+#define PROFILE_ZONE_END() profiler_zone_end()
+
+typedef struct ProfileSite ProfileSite;
+
+// Times of a site's zones in nanoseconds, kept by `profiler_update`.
+typedef struct ProfileStatistics
+{
+  // Every zone the site finished.
+  Histogram run;
+  // The zones finished in the current and previous halves of the window.
+  Histogram window[2];
+  uint64_t runSelfTime;
+  uint64_t windowSelfTime[2];
+  // Which half of the window is current.
+  uint32_t windowIndex;
+  // The zone the site last ran inside of, or NULL at the top of a thread.
+  const ProfileSite* parent;
+} ProfileStatistics;
+
+/**
+ * @brief Where a zone is in the code. Made by `PROFILE_ZONE`. Everything
+ * after the location belongs to the profiler.
+ */
+struct ProfileSite
+{
+  const char* name;
+  const char* file;
+  int32_t line;
+  volatile LONG registered;
+  struct ProfileSite* next;
+  ProfileStatistics statistics;
+};
+
 OTTERUTIL_API void profiler_init(LARGE_INTEGER frequency);
 
 OTTERUTIL_API void profiler_destroy();
 
-OTTERUTIL_API void profiler_clock_start(const char* key);
+OTTERUTIL_API void profiler_zone_begin(ProfileSite* site);
+
+OTTERUTIL_API void profiler_zone_end();
+
+/**
+ * @brief Collect the zones every thread has finished since the last call
+ * into each site's statistics. Call it once a frame. Threads keep profiling
+ * while it runs.
+ */
+OTTERUTIL_API void profiler_update();
+
+enum ProfileRange
+{
+  // Zones finished in the last `PROFILE_WINDOW_MS` or so.
+  PR_WINDOW,
+  // Every zone since the program started.
+  PR_RUN,
+};
 
-OTTERUTIL_API void profiler_clock_end(const char* key);
+// Times in seconds, over every site with the name.
+typedef struct ProfileSummary
+{
+  uint64_t count;
+  float min;
+  float max;
+  float mean;
+  // The mean leaving out time spent in zones inside.
+  float selfMean;
+  float p50;
+  float p95;
+  float p99;
+} ProfileSummary;
 
+/**
+ * @brief Summarize the zones named `key` finished in `range`. Sites with the
+ * same name are merged.
+ *
+ * @return False if none have finished.
+ */
+OTTERUTIL_API bool profiler_summary_get(
+    const char* key, enum ProfileRange range, ProfileSummary* summary);
+
+/**
+ * @brief Seconds that `percentile` percent of zones named `key` finished in,
+ * to within about 3%.
+ *
+ * @return INFINITY if no zone by that name has finished in `range`.
+ */
+OTTERUTIL_API float profiler_percentile_get(
+    const char* key, enum ProfileRange range, double percentile);
+
+/**
+ * @brief Mean seconds zones named `key` took over the window, including the
+ * zones inside them.
+ *
+ * @return INFINITY if no zone by that name has finished in the window.
+ */
 OTTERUTIL_API float profiler_clock_get(const char* key);
+
+/** @brief Like `profiler_clock_get` but leaving out time spent in children. */
+OTTERUTIL_API float profiler_clock_get_self(const char* key);
+
+/**
+ * @brief Write a line for every site with zones in the window, with their
+ * count, mean, median, tail and worst times in milliseconds.
+ */
+OTTERUTIL_API void profiler_report(FILE* output);
+
+/**
+ * @brief Write every zone collected by the next `frameCount` calls to
+ * `profiler_update` to `path` as a Chrome trace, which chrome://tracing and
+ * Perfetto open. Each zone keeps the thread it ran on, flows are drawn as
+ * arrows between threads and each update marks the end of a frame. Counters
+ * are drawn as tracks of what was added to them each frame, as of the last
+ * `counter_update`.
+ *
+ * @return False if a capture is already running or `path` can't be written.
+ */
+OTTERUTIL_API bool profiler_capture_start(
+    const char* path, uint32_t frameCount);
+
+OTTERUTIL_API bool profiler_capture_active();
+
+/**
+ * @brief Watch for hitches, frames between two calls to `profiler_update`
+ * taking more than `budget` times the median of the ones before. Each hitch
+ * is written to `directory` as a Chrome trace of its last
+ * `PROFILE_HITCH_FRAMES` frames, with the allocations made under each memory
+ * tag per frame and a summary named after the local time. At most one is
+ * written a second.
+ *
+ * @param budget 0 or less stops watching.
+ * @return False if `directory` can't be made.
+ */
+OTTERUTIL_API bool profiler_hitch_detect(const char* directory, float budget);
+
+/** @brief The file the last hitch was written to, or an empty string. */
+OTTERUTIL_API const char* profiler_hitch_get_last_path();
+
+/**
+ * @brief Start an arrow from the zone this thread is in to wherever
+ * `profiler_flow_end` is called with the id, such as from where work is
+ * queued to the thread that runs it. Flows are only kept while capturing or
+ * watching for hitches.
+ *
+ * @return The flow's id, or 0 if there's nothing to keep it.
+ */
+OTTERUTIL_API uint64_t profiler_flow_begin();
+
+/** @brief End flow `flow` in the zone this thread is in. 0 is ignored. */
+OTTERUTIL_API void profiler_flow_end(uint64_t flow);
+
+/** @brief Name the calling thread in captures. Longer names are cut short. */
+OTTERUTIL_API void profiler_set_thread_name(const char* name);
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Otter/Util/export.h"
+
+// Files start with these eight characters, then the version.
+#define SAMPLE_FILE_MAGIC   "OTTERSMP"
+#define SAMPLE_FILE_VERSION 1
+
+// Frames kept of each stack, counting from the innermost.
+#define SAMPLER_MAX_DEPTH 64
+
+#define SAMPLER_DEFAULT_RATE 1000
+
+enum SampleRecordType
+{
+  SR_THREAD = 1,
+  SR_MODULE,
+  SR_STACK
+};
+
+// Everything in the file is little endian and 8 byte aligned. The header is
+// followed by records, each starting with its type and its size in bytes.
+typedef struct SampleFileHeader
+{
+  char magic[8];
+  uint32_t version;
+  // Samples a second each thread was meant to get.
+  uint32_t rate;
+  // Ticks a second of the stack timestamps.
+  int64_t frequency;
+  // Timestamp sampling started at.
+  int64_t start;
+} SampleFileHeader;
+
+typedef struct SampleRecord
+{
+  uint32_t type;
+  uint32_t size;
+} SampleRecord;
+
+// Written before a thread's first stack. Followed by its name, null
+// terminated and counted in its length, padded to 8 bytes.
+typedef struct SampleThreadRecord
+{
+  SampleRecord record;
+  uint32_t threadId;
+  uint32_t nameLength;
+} SampleThreadRecord;
+
+// A module loaded when sampling stopped, so addresses can be looked up in its
+// symbols. Followed by its path like a thread's name.
+typedef struct SampleModuleRecord
+{
+  SampleRecord record;
+  uint64_t base;
+  uint64_t size;
+  uint32_t pathLength;
+  uint32_t reserved;
+} SampleModuleRecord;
+
+// Followed by `depth` 8 byte addresses, innermost first. All but the first
+// are return addresses.
+typedef struct SampleStackRecord
+{
+  SampleRecord record;
+  uint32_t threadId;
+  uint32_t depth;
+  int64_t timestamp;
+} SampleStackRecord;
+
+/**
+ * @brief Sample the stacks of every registered thread `rate` times a second
+ * into `path` until `sampler_stop`. A thread of the sampler's own suspends
+ * each registered thread in turn and walks its stack with the unwind tables,
+ * so nothing has to be annotated and code needs no frame pointers. Stacks
+ * end at the first frame outside a loaded module, such as JIT compiled C#.
+ *
+ * Read the file with `otter-samplefold` to get folded stacks for flame
+ * graphs.
+ *
+ * @return False if the sampler is already running or `path` can't be
+ * written.
+ */
+OTTERUTIL_API bool sampler_start(const char* path, uint32_t rate);
+
+/** @brief Stop sampling and finish the file. Does nothing if not running. */
+OTTERUTIL_API void sampler_stop();
+
+OTTERUTIL_API bool sampler_active();
+
+/**
+ * @brief Have the calling thread sampled, now and whenever sampling starts
+ * again, until it exits. `name` is cut short like the profiler's thread
+ * names.
+ */
+OTTERUTIL_API void sampler_register_thread(const char* name);
+
+typedef struct SampleEntry
+{
+  enum SampleRecordType type;
+  uint32_t threadId;
+  // The thread's name or the module's path.
+  const char* name;
+  uint64_t base;
+  uint64_t size;
+  // Seconds since sampling started.
+  double time;
+  uint32_t depth;
+  const uint64_t* addresses;
+} SampleEntry;
+
+/**
+ * @brief Reads a sample file back one record at a time. Names and addresses
+ * point into the data, which has to outlive the reader and be 8 byte
+ * aligned.
+ */
+typedef struct SampleReader
+{
+  const char* data;
+  uint64_t length;
+  uint64_t offset;
+  uint32_t rate;
+  int64_t frequency;
+  int64_t start;
+} SampleReader;
+
+/** @return False if `data` doesn't start with a sample file header. */
+OTTERUTIL_API bool sample_reader_open(
+    SampleReader* reader, const char* data, uint64_t length);
+
+/**
+ * @brief Read the next record into `entry`.
+ *
+ * @return False at the end of the file or at a record that is cut short, as
+ * the tail of a crashed run's file can be.
+ */
+OTTERUTIL_API bool sample_reader_next(SampleReader* reader, SampleEntry* entry);
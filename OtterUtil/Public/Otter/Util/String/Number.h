@@ -0,0 +1,77 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Otter/Util/String/StringView.h"
+#include "Otter/Util/export.h"
+
+// Room for any number written by `number_format_integer` or
+// `number_format_double`.
+#define NUMBER_FORMAT_BUFFER_SIZE 32
+
+enum NumberType
+{
+  NUMBER_INVALID,
+  NUMBER_INTEGER,
+  NUMBER_FLOAT,
+};
+
+typedef struct ParsedNumber
+{
+  enum NumberType type;
+  union
+  {
+    int64_t integer;
+    double floatingPoint;
+  };
+} ParsedNumber;
+
+/**
+ * @brief Parse the JSON number at the start of `text` in a single pass.
+ *
+ * Numbers without a fraction or exponent that fit in 64 bits come back as
+ * integers, everything else as the nearest double. Unlike `strtod` this never
+ * looks at the locale, skips no whitespace and accepts no hex, infinities or
+ * leading `+`.
+ *
+ * @param text The characters to parse. Need not be null terminated.
+ * @param length The number of characters available.
+ * @param number Receives the type and value.
+ * @return How many characters made up the number, or 0 if `text` doesn't
+ * start with one.
+ */
+OTTERUTIL_API size_t number_parse(
+    const char* text, size_t length, ParsedNumber* number);
+
+/**
+ * @brief Parse `text` as an integer, failing unless all of it is consumed.
+ */
+OTTERUTIL_API bool number_parse_integer(StringView text, int64_t* value);
+
+/**
+ * @brief Parse `text` as a double, failing unless all of it is consumed.
+ * Integers are converted.
+ */
+OTTERUTIL_API bool number_parse_double(StringView text, double* value);
+
+/**
+ * @brief Write an integer in decimal. No terminator is added.
+ *
+ * @return The number of characters written, at most 20.
+ */
+OTTERUTIL_API size_t number_format_integer(int64_t value, char* buffer);
+
+/**
+ * @brief Write the shortest decimal that reads back as exactly `value`.
+ *
+ * Uses plain notation for magnitudes between 1e-6 and 1e21 and exponent
+ * notation otherwise, the same as JavaScript. No terminator is added.
+ *
+ * @param value The double to write.
+ * @param buffer At least `NUMBER_FORMAT_BUFFER_SIZE` characters.
+ * @return The number of characters written, or 0 for infinities and NaN,
+ * which JSON can't represent.
+ */
+OTTERUTIL_API size_t number_format_double(double value, char* buffer);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "Otter/Util/Memory/Allocator.h"
+#include "Otter/Util/String/StringView.h"
+#include "Otter/Util/export.h"
+
+#define STRING_BUILDER_MIN_CAPACITY 32
+
+/**
+ * @brief Builds a null terminated string by appending to one buffer.
+ *
+ * Meant to be given an `Arena`'s allocator. As long as nothing else is
+ * allocated from the arena while building, every growth extends the buffer
+ * in place and finishing is free.
+ */
+typedef struct StringBuilder
+{
+  char* buffer;
+  size_t length;
+  size_t capacity;
+  Allocator* allocator;
+} StringBuilder;
+
+OTTERUTIL_API void string_builder_create(
+    StringBuilder* builder, Allocator* allocator);
+
+/** @brief Release the buffer of a builder that was not finished. */
+OTTERUTIL_API void string_builder_destroy(StringBuilder* builder);
+
+OTTERUTIL_API bool string_builder_append(
+    StringBuilder* builder, StringView string);
+
+OTTERUTIL_API bool string_builder_append_char(StringBuilder* builder, char c);
+
+OTTERUTIL_API bool string_builder_append_format(
+    StringBuilder* builder, const char* format, ...);
+
+/**
+ * @brief Take the built string out of the builder, trimming the buffer to
+ * `length + 1` bytes.
+ *
+ * The returned view is null terminated and owned by the caller. Release it by
+ * deallocating `length + 1` bytes from the builder's allocator. The builder is
+ * left empty.
+ */
+OTTERUTIL_API StringView string_builder_finish(StringBuilder* builder);
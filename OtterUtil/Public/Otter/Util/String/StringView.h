@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief A borrowed, not necessarily null terminated, run of characters.
+ *
+ * Views never own their data. Whatever they point into must outlive them.
+ */
+typedef struct StringView
+{
+  const char* data;
+  size_t length;
+} StringView;
+
+static inline StringView string_view_create(const char* data, size_t length)
+{
+  StringView view = {data, length};
+  return view;
+}
+
+/** @brief Make a view of a string literal without calling strlen. */
+#define STRING_VIEW_LITERAL(literal) \
+  string_view_create((literal), sizeof(literal) - 1)
+
+static inline StringView string_view_from_cstr(const char* string)
+{
+  return string_view_create(string, strlen(string));
+}
+
+static inline bool string_view_equals(StringView a, StringView b)
+{
+  return a.length == b.length && memcmp(a.data, b.data, a.length) == 0;
+}
+
+static inline bool string_view_equals_cstr(StringView view, const char* string)
+{
+  return string_view_equals(view, string_view_from_cstr(string));
+}
+
+/**
+ * @brief Find the first occurrence of `needle` in `view`.
+ *
+ * @return The offset of the match, or SIZE_MAX if there is none.
+ */
+static inline size_t string_view_find(StringView view, StringView needle)
+{
+  if (needle.length > view.length)
+  {
+    return SIZE_MAX;
+  }
+
+  for (size_t i = 0; i <= view.length - needle.length; i++)
+  {
+    if (memcmp(&view.data[i], needle.data, needle.length) == 0)
+    {
+      return i;
+    }
+  }
+  return SIZE_MAX;
+}
+
+/**
+ * @brief Find the first `c` in `view`.
+ *
+ * @return The offset of the character, or SIZE_MAX if there is none.
+ */
+static inline size_t string_view_find_char(StringView view, char c)
+{
+  const char* match = (const char*) memchr(view.data, c, view.length);
+  return match != NULL ? (size_t) (match - view.data) : SIZE_MAX;
+}
+
+/** @brief Get the part of `view` from `start` up to `length` characters. */
+static inline StringView string_view_substring(
+    StringView view, size_t start, size_t length)
+{
+  if (start > view.length)
+  {
+    start = view.length;
+  }
+  if (length > view.length - start)
+  {
+    length = view.length - start;
+  }
+  return string_view_create(view.data + start, length);
+}
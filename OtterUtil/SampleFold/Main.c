@@ -0,0 +1,223 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <Windows.h>
+#include <DbgHelp.h>
+
+#include "Otter/Util/File.h"
+#include "Otter/Util/HashMap.h"
+#include "Otter/Util/Log.h"
+#include "Otter/Util/Sampler.h"
+#include "Otter/Util/String/StringBuilder.h"
+
+// Anything other than a real process works as DbgHelp's handle, so symbols
+// are loaded for the recorded modules rather than the tool's own.
+#define SYMBOL_PROCESS ((HANDLE) (uintptr_t) 0x5a4d504c)
+
+#define SYMBOL_NAME_SIZE 256
+
+typedef struct FoldContext
+{
+  // Symbol names by address, each allocated.
+  HashMap symbols;
+  // Folded stacks and the number of samples of each.
+  HashMap stacks;
+  // Thread names by id.
+  HashMap threads;
+  StringBuilder stack;
+} FoldContext;
+
+static void load_modules(SampleReader reader)
+{
+  SampleEntry entry;
+  while (sample_reader_next(&reader, &entry))
+  {
+    if (entry.type == SR_MODULE
+        && SymLoadModuleEx(SYMBOL_PROCESS, NULL, entry.name, NULL, entry.base,
+               (DWORD) entry.size, NULL, 0)
+               == 0
+        && GetLastError() != ERROR_SUCCESS)
+    {
+      LOG_WARNING("Unable to load symbols for %s", entry.name);
+    }
+  }
+}
+
+// The function `address` is in, or the module and offset if it has no
+// symbol.
+static const char* symbolize(FoldContext* context, uint64_t address)
+{
+  const char* cached =
+      hash_map_get_value(&context->symbols, &address, sizeof(address));
+  if (cached != NULL)
+  {
+    return cached;
+  }
+
+  char buffer[sizeof(SYMBOL_INFO) + SYMBOL_NAME_SIZE];
+  SYMBOL_INFO* symbol  = (SYMBOL_INFO*) buffer;
+  symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+  symbol->MaxNameLen   = SYMBOL_NAME_SIZE;
+
+  char name[SYMBOL_NAME_SIZE + 32];
+  DWORD64 displacement;
+  IMAGEHLP_MODULE64 module = {.SizeOfStruct = sizeof(module)};
+  if (SymFromAddr(SYMBOL_PROCESS, address, &displacement, symbol))
+  {
+    snprintf(name, sizeof(name), "%s", symbol->Name);
+  }
+  else if (SymGetModuleInfo64(SYMBOL_PROCESS, address, &module))
+  {
+    snprintf(name, sizeof(name), "%s+0x%llx", module.ModuleName,
+        (unsigned long long) (address - module.BaseOfImage));
+  }
+  else
+  {
+    snprintf(name, sizeof(name), "0x%llx", (unsigned long long) address);
+  }
+
+  // Folded stacks are split on semicolons and the count after a space.
+  for (char* c = name; *c != '\0'; c++)
+  {
+    if (*c == ';' || *c == ' ')
+    {
+      *c = '_';
+    }
+  }
+
+  char* copy = _strdup(name);
+  if (copy == NULL || !hash_map_set_value(&context->symbols, &address,
+                          sizeof(address), copy))
+  {
+    free(copy);
+    return "?";
+  }
+  return copy;
+}
+
+static void fold_stack(FoldContext* context, const SampleEntry* entry)
+{
+  const char* thread = hash_map_get_value(
+      &context->threads, &entry->threadId, sizeof(entry->threadId));
+
+  // Outermost first, under the thread.
+  context->stack.length = 0;
+  string_builder_append_format(&context->stack, "%s",
+      thread != NULL ? thread : "unknown thread");
+  for (uint32_t i = entry->depth; i > 0; i--)
+  {
+    // Return addresses are just past the call, which can be the start of
+    // the next function.
+    uint64_t address = entry->addresses[i - 1] - (i > 1 ? 1 : 0);
+    string_builder_append_format(
+        &context->stack, ";%s", symbolize(context, address));
+  }
+
+  const char* folded = context->stack.buffer;
+  size_t length      = context->stack.length;
+  uintptr_t count =
+      (uintptr_t) hash_map_get_value(&context->stacks, folded, length);
+  hash_map_set_value(&context->stacks, folded, length, (void*) (count + 1));
+}
+
+static void write_folded(
+    void* key, size_t keyLength, void* value, void* output)
+{
+  fprintf((FILE*) output, "%.*s %llu\n", (int) keyLength, (const char*) key,
+      (unsigned long long) (uintptr_t) value);
+}
+
+static bool fold(SampleReader* reader, FILE* output)
+{
+  FoldContext context;
+  if (!hash_map_create(
+          &context.symbols, HASH_MAP_DEFAULT_BUCKETS, HASH_MAP_DEFAULT_COEF)
+      || !hash_map_create(
+          &context.stacks, HASH_MAP_DEFAULT_BUCKETS, HASH_MAP_DEFAULT_COEF)
+      || !hash_map_create(
+          &context.threads, HASH_MAP_DEFAULT_BUCKETS, HASH_MAP_DEFAULT_COEF))
+  {
+    return false;
+  }
+  string_builder_create(&context.stack, NULL);
+
+  uint64_t samples = 0;
+  SampleEntry entry;
+  while (sample_reader_next(reader, &entry))
+  {
+    if (entry.type == SR_THREAD)
+    {
+      hash_map_set_value(&context.threads, &entry.threadId,
+          sizeof(entry.threadId), (void*) entry.name);
+    }
+    else if (entry.type == SR_STACK)
+    {
+      fold_stack(&context, &entry);
+      samples++;
+    }
+  }
+  hash_map_iterate(&context.stacks, write_folded, output);
+  LOG_DEBUG("Folded %llu samples taken at %u Hz.",
+      (unsigned long long) samples, reader->rate);
+
+  string_builder_destroy(&context.stack);
+  hash_map_destroy(&context.threads, NULL);
+  hash_map_destroy(&context.stacks, NULL);
+  hash_map_destroy(&context.symbols, free);
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  const char* inputPath  = argc > 1 ? argv[1] : NULL;
+  const char* outputPath = argc > 2 ? argv[2] : NULL;
+  if (inputPath == NULL || argc > 3)
+  {
+    fprintf(stderr, "Usage: otter-samplefold <samples> [<output>]\n");
+    return 2;
+  }
+
+  // Folded stacks can go to stdout, so the tool's own messages don't.
+  log_set_output(stderr);
+
+  FileView input;
+  if (!file_map(inputPath, &input))
+  {
+    return 1;
+  }
+
+  SampleReader reader;
+  bool folded = sample_reader_open(&reader, input.data, input.length);
+  if (folded)
+  {
+    SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS);
+    if (!SymInitialize(SYMBOL_PROCESS, NULL, false))
+    {
+      LOG_ERROR("Unable to initialize DbgHelp.");
+      file_unmap(&input);
+      return 1;
+    }
+    load_modules(reader);
+
+    FILE* output = stdout;
+    if (outputPath != NULL && fopen_s(&output, outputPath, "w") != 0)
+    {
+      LOG_ERROR("Failed to open file for writing: %s", outputPath);
+      folded = false;
+    }
+    else
+    {
+      folded = fold(&reader, output)
+            && (output == stdout || fclose(output) == 0);
+      if (reader.offset != reader.length)
+      {
+        LOG_WARNING("%s ends with %llu bytes that couldn't be read.",
+            inputPath, (unsigned long long) (reader.length - reader.offset));
+      }
+    }
+    SymCleanup(SYMBOL_PROCESS);
+  }
+
+  file_unmap(&input);
+  return folded ? 0 : 1;
+}
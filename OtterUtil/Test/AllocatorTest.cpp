@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/Array/AutoArray.h"
+#include "Otter/Util/HashMap.h"
+#include "Otter/Util/Json/Json.h"
+#include "Otter/Util/Memory/PoolAllocator.h"
+#include "Otter/Util/Memory/TrackingAllocator.h"
+}
+
+TEST(AllocatorTest, PoolReusesFreedBlocks)
+{
+  PoolAllocator pool;
+  pool_allocator_create(&pool);
+
+  void* first = allocator_allocate(&pool.allocator, 24);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ((uintptr_t) first % MEMORY_ALLOCATION_ALIGNMENT, 0);
+  allocator_deallocate(&pool.allocator, first, 24);
+
+  void* second = allocator_allocate(&pool.allocator, 32);
+  EXPECT_EQ(first, second);
+  allocator_deallocate(&pool.allocator, second, 32);
+
+  pool_allocator_destroy(&pool);
+}
+
+TEST(AllocatorTest, PoolSeparatesSizeClasses)
+{
+  PoolAllocator pool;
+  pool_allocator_create(&pool);
+
+  char* small = (char*) allocator_allocate(&pool.allocator, 16);
+  char* large = (char*) allocator_allocate(&pool.allocator, 1000);
+  char* huge  = (char*) allocator_allocate(
+      &pool.allocator, POOL_ALLOCATOR_MAX_BLOCK_SIZE + 1);
+  ASSERT_NE(small, nullptr);
+  ASSERT_NE(large, nullptr);
+  ASSERT_NE(huge, nullptr);
+
+  memset(small, 0xAA, 16);
+  memset(large, 0xBB, 1000);
+  memset(huge, 0xCC, POOL_ALLOCATOR_MAX_BLOCK_SIZE + 1);
+  EXPECT_EQ((unsigned char) small[15], 0xAA);
+  EXPECT_EQ((unsigned char) large[0], 0xBB);
+
+  allocator_deallocate(&pool.allocator, small, 16);
+  allocator_deallocate(&pool.allocator, large, 1000);
+  allocator_deallocate(
+      &pool.allocator, huge, POOL_ALLOCATOR_MAX_BLOCK_SIZE + 1);
+
+  pool_allocator_destroy(&pool);
+}
+
+TEST(AllocatorTest, PoolReallocateKeepsContents)
+{
+  PoolAllocator pool;
+  pool_allocator_create(&pool);
+
+  int* values = (int*) allocator_allocate(&pool.allocator, 4 * sizeof(int));
+  for (int i = 0; i < 4; i++)
+  {
+    values[i] = i;
+  }
+
+  values = (int*) allocator_reallocate(
+      &pool.allocator, values, 4 * sizeof(int), 4096 * sizeof(int));
+  ASSERT_NE(values, nullptr);
+  for (int i = 0; i < 4; i++)
+  {
+    EXPECT_EQ(values[i], i);
+  }
+
+  values = (int*) allocator_reallocate(
+      &pool.allocator, values, 4096 * sizeof(int), 2 * sizeof(int));
+  ASSERT_NE(values, nullptr);
+  EXPECT_EQ(values[1], 1);
+  allocator_deallocate(&pool.allocator, values, 2 * sizeof(int));
+
+  pool_allocator_destroy(&pool);
+}
+
+TEST(AllocatorTest, TrackingCountsContainerMemory)
+{
+  TrackingAllocator tracker;
+  tracking_allocator_create(&tracker, NULL);
+
+  AutoArray array;
+  auto_array_create_with_allocator(
+      &array, sizeof(uint64_t), &tracker.allocator);
+  for (uint64_t i = 0; i < 100; i++)
+  {
+    *(uint64_t*) auto_array_allocate(&array) = i;
+  }
+  EXPECT_EQ(tracker.currentBytes, array.capacity * sizeof(uint64_t));
+  EXPECT_EQ(tracker.liveAllocations, 1);
+
+  auto_array_destroy(&array);
+  EXPECT_EQ(tracker.currentBytes, 0);
+  EXPECT_EQ(tracker.liveAllocations, 0);
+  EXPECT_GE(tracker.peakBytes, 100 * sizeof(uint64_t));
+}
+
+TEST(AllocatorTest, HashMapReleasesEverythingToAllocator)
+{
+  TrackingAllocator tracker;
+  tracking_allocator_create(&tracker, NULL);
+
+  HashMap map;
+  ASSERT_TRUE(hash_map_create_with_allocator(
+      &map, 16, HASH_MAP_DEFAULT_COEF, &tracker.allocator));
+  for (uint32_t i = 0; i < 200; i++)
+  {
+    ASSERT_TRUE(hash_map_set_value(&map, &i, sizeof(i), (void*) (uintptr_t) i));
+  }
+  for (uint32_t i = 0; i < 200; i++)
+  {
+    EXPECT_EQ(hash_map_get_value(&map, &i, sizeof(i)), (void*) (uintptr_t) i);
+  }
+  EXPECT_GT(tracker.liveAllocations, 200);
+
+  hash_map_destroy(&map, NULL);
+  EXPECT_EQ(tracker.currentBytes, 0);
+  EXPECT_EQ(tracker.liveAllocations, 0);
+}
+
+TEST(AllocatorTest, JsonParsesFromPool)
+{
+  PoolAllocator pool;
+  pool_allocator_create(&pool);
+  TrackingAllocator tracker;
+  tracking_allocator_create(&tracker, &pool.allocator);
+
+  const char document[] = R"({"name": "otter", "values": [1, 2.5, true]})";
+  size_t cursor         = 0;
+  JsonValue* root       = json_parse_with_allocator(
+      document, sizeof(document) - 1, &cursor, &tracker.allocator);
+  ASSERT_NE(root, nullptr);
+  ASSERT_EQ(root->type, JT_OBJECT);
+
+  JsonValue* name =
+      (JsonValue*) hash_map_get_value(&root->object, "name", strlen("name"));
+  ASSERT_NE(name, nullptr);
+  EXPECT_TRUE(string_view_equals_cstr(name->string, "otter"));
+
+  JsonValue* values = (JsonValue*) hash_map_get_value(
+      &root->object, "values", strlen("values"));
+  ASSERT_NE(values, nullptr);
+  ASSERT_EQ(values->array.size, 3);
+  EXPECT_EQ((*(JsonValue**) auto_array_get(&values->array, 1))->floatingPoint,
+      2.5);
+
+  json_destroy_with_allocator(root, &tracker.allocator);
+  EXPECT_EQ(tracker.currentBytes, 0);
+  EXPECT_EQ(tracker.liveAllocations, 0);
+
+  pool_allocator_destroy(&pool);
+}
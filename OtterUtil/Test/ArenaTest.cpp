@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/Array/AutoArray.h"
+#include "Otter/Util/Memory/Arena.h"
+#include "Otter/Util/Memory/TrackingAllocator.h"
+}
+
+TEST(ArenaTest, AllocationsAreAlignedAndDistinct)
+{
+  Arena arena;
+  ASSERT_TRUE(arena_create(&arena, 1024, NULL));
+
+  char* first  = (char*) arena_allocate(&arena, 3);
+  char* second = (char*) arena_allocate(&arena, 40);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ((uintptr_t) first % ARENA_ALIGNMENT, 0);
+  EXPECT_EQ((uintptr_t) second % ARENA_ALIGNMENT, 0);
+  EXPECT_GE(second, first + 3);
+  EXPECT_EQ(arena_get_used(&arena), 16 + 48);
+
+  arena_reset(&arena);
+  EXPECT_EQ(arena_get_used(&arena), 0);
+  EXPECT_EQ(arena_allocate(&arena, 8), first);
+
+  arena_destroy(&arena);
+}
+
+TEST(ArenaTest, LastAllocationGrowsInPlace)
+{
+  Arena arena;
+  ASSERT_TRUE(arena_create(&arena, 4096, NULL));
+
+  AutoArray array;
+  auto_array_create_with_allocator(&array, sizeof(uint64_t), &arena.allocator);
+  *(uint64_t*) auto_array_allocate(&array) = 7;
+  void* buffer                             = array.buffer;
+  for (uint64_t i = 1; i < 256; i++)
+  {
+    *(uint64_t*) auto_array_allocate(&array) = i;
+  }
+  EXPECT_EQ(array.buffer, buffer);
+  EXPECT_EQ(*(uint64_t*) auto_array_get(&array, 0), 7);
+  EXPECT_EQ(*(uint64_t*) auto_array_get(&array, 255), 255);
+
+  auto_array_destroy(&array);
+  EXPECT_EQ(arena_get_used(&arena), 0);
+
+  arena_destroy(&arena);
+}
+
+TEST(ArenaTest, OverflowChainsBlocksAndKeepsContents)
+{
+  Arena arena;
+  ASSERT_TRUE(arena_create(&arena, 256, NULL));
+
+  AutoArray first;
+  AutoArray second;
+  auto_array_create_with_allocator(&first, sizeof(uint32_t), &arena.allocator);
+  auto_array_create_with_allocator(&second, sizeof(uint32_t), &arena.allocator);
+  for (uint32_t i = 0; i < 200; i++)
+  {
+    *(uint32_t*) auto_array_allocate(&first)  = i;
+    *(uint32_t*) auto_array_allocate(&second) = i * 2;
+  }
+
+  for (uint32_t i = 0; i < 200; i++)
+  {
+    ASSERT_EQ(*(uint32_t*) auto_array_get(&first, i), i);
+    ASSERT_EQ(*(uint32_t*) auto_array_get(&second, i), i * 2);
+  }
+
+  arena_destroy(&arena);
+}
+
+TEST(ArenaTest, SteadyStateMakesNoParentAllocations)
+{
+  TrackingAllocator tracker;
+  tracking_allocator_create(&tracker, NULL);
+
+  Arena arena;
+  ASSERT_TRUE(arena_create(&arena, 256, &tracker.allocator));
+
+  int64_t allocationsAfterWarmup = 0;
+  for (int frame = 0; frame < 4; frame++)
+  {
+    AutoArray queue;
+    auto_array_create_with_allocator(&queue, 64, &arena.allocator);
+    auto_array_allocate_many(&queue, 100);
+    EXPECT_NE(arena_allocate(&arena, 1000), nullptr);
+    arena_reset(&arena);
+
+    if (frame == 1)
+    {
+      allocationsAfterWarmup = tracker.totalAllocations;
+    }
+  }
+  EXPECT_EQ(tracker.totalAllocations, allocationsAfterWarmup);
+  EXPECT_EQ(tracker.liveAllocations, 1);
+
+  arena_destroy(&arena);
+  EXPECT_EQ(tracker.currentBytes, 0);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/BinaryLog.h"
+#include "Otter/Util/Log.h"
+}
+
+class BinaryLogTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    output = tmpfile();
+    ASSERT_NE(output, nullptr);
+    ASSERT_TRUE(log_set_binary_output(output));
+  }
+
+  void TearDown() override
+  {
+    log_set_output(NULL);
+    log_set_rate_limit(LOG_RATE_LIMIT);
+    fclose(output);
+  }
+
+  // Everything written so far, after the logger lets go of it.
+  std::string read_log()
+  {
+    log_flush();
+
+    std::string data;
+    char buffer[4096];
+    size_t read;
+    rewind(output);
+    while ((read = fread(buffer, 1, sizeof(buffer), output)) > 0)
+    {
+      data.append(buffer, read);
+    }
+    return data;
+  }
+
+  FILE* output = nullptr;
+};
+
+TEST_F(BinaryLogTest, DecodesLikeTheTextLog)
+{
+  for (int i = 0; i < 3; i++)
+  {
+    LOG_WARNING("%s %d|%5.2f|%c|%.*s", "binary", i, 2.5, 'z', 3, "otters");
+  }
+  LOG_ERROR("%llu then %ls", 18446744073709551615ull, L"wide");
+
+  std::string data = read_log();
+  BinaryLogReader reader;
+  ASSERT_TRUE(binary_log_reader_open(&reader, data.data(), data.size()));
+
+  std::vector<std::string> messages;
+  BinaryLogEntry entry;
+  char message[256];
+  while (binary_log_reader_next(&reader, &entry))
+  {
+    ASSERT_NE(entry.site, nullptr);
+    EXPECT_NE(std::string(entry.site->file).find("BinaryLogTest.cpp"),
+        std::string::npos);
+    EXPECT_GE(entry.time, 0.0);
+    binary_log_format_message(&entry, message, sizeof(message));
+    messages.push_back(message);
+  }
+  EXPECT_EQ(reader.offset, reader.length);
+
+  // Each call site is written once, however often it logs.
+  EXPECT_EQ(reader.sites.size, 2);
+  ASSERT_EQ(messages.size(), 4);
+  EXPECT_EQ(messages[0], "binary 0| 2.50|z|ott");
+  EXPECT_EQ(messages[2], "binary 2| 2.50|z|ott");
+  EXPECT_EQ(messages[3], "18446744073709551615 then %ls");
+
+  const BinaryLogSite* site =
+      (const BinaryLogSite*) auto_array_get(&reader.sites, 0);
+  const uint8_t expected[] = {
+      LA_STRING, LA_SIGNED, LA_DOUBLE, LA_CHARACTER, LA_SIGNED, LA_STRING};
+  ASSERT_EQ(site->argumentCount, sizeof(expected));
+  EXPECT_EQ(memcmp(site->arguments, expected, sizeof(expected)), 0);
+  EXPECT_EQ(site->verbosity, LOG_WARNING);
+
+  binary_log_reader_close(&reader);
+}
+
+TEST_F(BinaryLogTest, StopsAtATruncatedRecord)
+{
+  LOG_WARNING("first %d", 1);
+  LOG_WARNING("second %s", "message");
+  std::string data = read_log();
+
+  BinaryLogReader reader;
+  ASSERT_TRUE(
+      binary_log_reader_open(&reader, data.data(), data.size() - 4));
+  BinaryLogEntry entry;
+  char message[256];
+  ASSERT_TRUE(binary_log_reader_next(&reader, &entry));
+  binary_log_format_message(&entry, message, sizeof(message));
+  EXPECT_STREQ(message, "first 1");
+  EXPECT_FALSE(binary_log_reader_next(&reader, &entry));
+  binary_log_reader_close(&reader);
+
+  EXPECT_FALSE(binary_log_reader_open(&reader, "OTTERLOX", 8));
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/Counter.h"
+}
+
+static void counter_test_add_items(int64_t count)
+{
+  COUNTER_ADD(counter_test_items, count);
+}
+
+TEST(CounterTest, SumsEachFrame)
+{
+  counter_update();
+  counter_test_add_items(3);
+  counter_test_add_items(4);
+  counter_update();
+
+  CounterSummary summary;
+  ASSERT_TRUE(counter_summary_get("counter_test_items", &summary));
+  EXPECT_EQ(summary.frame, 7.0);
+  EXPECT_EQ(summary.total, 7.0);
+
+  counter_update();
+  ASSERT_TRUE(counter_summary_get("counter_test_items", &summary));
+  EXPECT_EQ(summary.frame, 0.0);
+  EXPECT_EQ(summary.total, 7.0);
+  EXPECT_FALSE(counter_summary_get("counter_test_missing", &summary));
+}
+
+TEST(CounterTest, SumsEveryThread)
+{
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++)
+  {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 1000; j++)
+      {
+        COUNTER_ADD(counter_test_threads, 1);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  // Threads that exited still count, and their shards are reused.
+  std::thread([]() { COUNTER_ADD(counter_test_threads, 1); }).join();
+  counter_update();
+
+  CounterSummary summary;
+  ASSERT_TRUE(counter_summary_get("counter_test_threads", &summary));
+  EXPECT_EQ(summary.total, 4001.0);
+}
+
+TEST(CounterTest, KeepsFloats)
+{
+  COUNTER_ADD_FLOAT(counter_test_seconds, 0.25);
+  COUNTER_ADD_FLOAT(counter_test_seconds, 0.5);
+  counter_update();
+
+  CounterSummary summary;
+  ASSERT_TRUE(counter_summary_get("counter_test_seconds", &summary));
+  EXPECT_DOUBLE_EQ(summary.total, 0.75);
+}
+
+TEST(CounterTest, AveragesOverAWindow)
+{
+  counter_update();
+  for (int i = 0; i < 3; i++)
+  {
+    COUNTER_ADD(counter_test_window, 10);
+    counter_update();
+  }
+  Sleep(COUNTER_WINDOW_MS + 50);
+  counter_update();
+
+  CounterSummary summary;
+  ASSERT_TRUE(counter_summary_get("counter_test_window", &summary));
+  EXPECT_GT(summary.perFrame, 0.0);
+  EXPECT_LT(summary.perFrame, 30.0);
+  EXPECT_GT(summary.perSecond, 0.0);
+  EXPECT_LT(summary.perSecond, 30.0);
+}
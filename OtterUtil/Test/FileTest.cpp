@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/File.h"
+}
+
+TEST(FileTest, MapsWholeFile)
+{
+  const char path[] = "FileTest.bin";
+
+  std::string contents;
+  for (int i = 0; i < 100000; i++)
+  {
+    contents += (char) (i * 7);
+  }
+  file_write(path, contents.data(), contents.size());
+
+  FileView view;
+  ASSERT_TRUE(file_map(path, &view));
+  ASSERT_EQ(view.length, contents.size());
+  file_prefetch(&view, 4096, view.length);
+  file_prefetch(&view, view.length, 1);
+  EXPECT_EQ(std::string(view.data, view.length), contents);
+
+  file_unmap(&view);
+  EXPECT_EQ(view.data, nullptr);
+  remove(path);
+}
+
+TEST(FileTest, MapsEmptyFile)
+{
+  const char path[] = "FileTest.empty";
+  file_write(path, "", 0);
+
+  FileView view;
+  ASSERT_TRUE(file_map(path, &view));
+  EXPECT_EQ(view.length, 0);
+  file_unmap(&view);
+  remove(path);
+}
+
+TEST(FileTest, MissingFileFailsToMap)
+{
+  FileView view;
+  EXPECT_FALSE(file_map("FileTest.missing", &view));
+  EXPECT_EQ(view.data, nullptr);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/Histogram.h"
+}
+
+class HistogramTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Too large for the stack alongside gtest's frames.
+    histogram = (Histogram*) calloc(1, sizeof(Histogram));
+    ASSERT_NE(histogram, nullptr);
+  }
+
+  void TearDown() override
+  {
+    free(histogram);
+  }
+
+  Histogram* histogram;
+};
+
+TEST_F(HistogramTest, EmptyHasNoValues)
+{
+  EXPECT_EQ(histogram->count, 0);
+  EXPECT_EQ(histogram_percentile(histogram, 50.0), 0);
+  EXPECT_EQ(histogram_mean(histogram), 0.0);
+}
+
+TEST_F(HistogramTest, SmallValuesAreExact)
+{
+  for (uint64_t i = 1; i <= 50; i++)
+  {
+    histogram_record(histogram, i);
+  }
+
+  EXPECT_EQ(histogram->min, 1);
+  EXPECT_EQ(histogram->max, 50);
+  EXPECT_EQ(histogram_percentile(histogram, 0.0), 1);
+  EXPECT_EQ(histogram_percentile(histogram, 50.0), 25);
+  EXPECT_EQ(histogram_percentile(histogram, 98.0), 49);
+  EXPECT_EQ(histogram_percentile(histogram, 100.0), 50);
+  EXPECT_DOUBLE_EQ(histogram_mean(histogram), 25.5);
+}
+
+TEST_F(HistogramTest, LargeValuesAreClose)
+{
+  // A uniform spread of a million values from 1000 to 1000000 in steps of
+  // about 1.
+  const uint64_t count = 1000000;
+  for (uint64_t i = 0; i < count; i++)
+  {
+    histogram_record(histogram, 1000 + i * 999 / 1000);
+  }
+
+  const double percentiles[] = {10.0, 50.0, 90.0, 99.0, 99.9};
+  for (double percentile : percentiles)
+  {
+    double expected = 1000 + percentile / 100.0 * 999000;
+    double actual   = (double) histogram_percentile(histogram, percentile);
+    EXPECT_NEAR(actual, expected, expected / HISTOGRAM_SUB_BUCKET_COUNT)
+        << percentile;
+  }
+  EXPECT_EQ(histogram_percentile(histogram, 100.0), histogram->max);
+}
+
+TEST_F(HistogramTest, HugeValuesShareTheLastBucket)
+{
+  histogram_record(histogram, UINT64_MAX / 2);
+  histogram_record(histogram, (uint64_t) 1 << HISTOGRAM_MAX_BITS);
+
+  EXPECT_EQ(histogram->buckets[HISTOGRAM_BUCKET_COUNT - 1], 2);
+  EXPECT_EQ(histogram_percentile(histogram, 100.0), UINT64_MAX / 2);
+}
+
+TEST_F(HistogramTest, MergingMatchesRecordingTogether)
+{
+  Histogram* even = (Histogram*) calloc(1, sizeof(Histogram));
+  Histogram* odd  = (Histogram*) calloc(1, sizeof(Histogram));
+  ASSERT_NE(even, nullptr);
+  ASSERT_NE(odd, nullptr);
+
+  for (uint64_t i = 0; i < 10000; i++)
+  {
+    uint64_t value = (i * 7919) % 100003;
+    histogram_record(histogram, value);
+    histogram_record(i % 2 == 0 ? even : odd, value);
+  }
+  histogram_merge(even, odd);
+
+  EXPECT_EQ(memcmp(even, histogram, sizeof(Histogram)), 0);
+
+  // Empty histograms leave the extremes alone.
+  histogram_clear(odd);
+  histogram_merge(even, odd);
+  EXPECT_EQ(even->min, histogram->min);
+
+  free(even);
+  free(odd);
+}
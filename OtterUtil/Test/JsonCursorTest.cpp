@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/Json/JsonCursor.h"
+#include "Otter/Util/Memory/TrackingAllocator.h"
+}
+
+TEST(JsonCursorTest, ReadsValuesInDocumentOrder)
+{
+  const char source[] = R"({"name": "otter", "values": [1, 2.5, true, null],
+      "nested": {"empty": {}, "list": []}})";
+
+  JsonCursor cursor;
+  ASSERT_TRUE(json_cursor_create(&cursor, source, sizeof(source) - 1, NULL));
+  ASSERT_TRUE(json_cursor_enter_object(&cursor));
+
+  StringView key;
+  ASSERT_TRUE(json_cursor_next_member(&cursor, &key));
+  EXPECT_TRUE(string_view_equals_cstr(key, "name"));
+  StringView name;
+  ASSERT_TRUE(json_cursor_get_string(&cursor, &name));
+  EXPECT_TRUE(string_view_equals_cstr(name, "otter"));
+  EXPECT_GE(name.data, source);
+  EXPECT_LT(name.data, source + sizeof(source));
+
+  ASSERT_TRUE(json_cursor_next_member(&cursor, &key));
+  EXPECT_TRUE(string_view_equals_cstr(key, "values"));
+  ASSERT_TRUE(json_cursor_enter_array(&cursor));
+
+  int64_t integer;
+  double number;
+  bool boolean;
+  enum JsonType type;
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+  ASSERT_TRUE(json_cursor_get_integer(&cursor, &integer));
+  EXPECT_EQ(integer, 1);
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+  ASSERT_TRUE(json_cursor_peek_type(&cursor, &type));
+  EXPECT_EQ(type, JT_FLOAT);
+  ASSERT_TRUE(json_cursor_get_number(&cursor, &number));
+  EXPECT_EQ(number, 2.5);
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+  ASSERT_TRUE(json_cursor_get_boolean(&cursor, &boolean));
+  EXPECT_TRUE(boolean);
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+  ASSERT_TRUE(json_cursor_peek_type(&cursor, &type));
+  EXPECT_EQ(type, JT_NULL);
+  ASSERT_TRUE(json_cursor_skip(&cursor));
+  EXPECT_FALSE(json_cursor_next_element(&cursor));
+
+  ASSERT_TRUE(json_cursor_next_member(&cursor, &key));
+  EXPECT_TRUE(string_view_equals_cstr(key, "nested"));
+  ASSERT_TRUE(json_cursor_enter_object(&cursor));
+  ASSERT_TRUE(json_cursor_next_member(&cursor, &key));
+  ASSERT_TRUE(json_cursor_enter_object(&cursor));
+  EXPECT_FALSE(json_cursor_next_member(&cursor, &key));
+  ASSERT_TRUE(json_cursor_next_member(&cursor, &key));
+  ASSERT_TRUE(json_cursor_enter_array(&cursor));
+  EXPECT_FALSE(json_cursor_next_element(&cursor));
+  EXPECT_FALSE(json_cursor_next_member(&cursor, &key));
+
+  EXPECT_FALSE(json_cursor_next_member(&cursor, &key));
+  EXPECT_TRUE(json_cursor_finish(&cursor));
+  json_cursor_destroy(&cursor);
+}
+
+TEST(JsonCursorTest, SkipsSubtreesAndMismatchedValues)
+{
+  const char source[] = R"({"extras": {"a": [1, {"b": [[], {}]}], "c": "]"},
+      "count": "24", "min": 3})";
+
+  JsonCursor cursor;
+  ASSERT_TRUE(json_cursor_create(&cursor, source, sizeof(source) - 1, NULL));
+  ASSERT_TRUE(json_cursor_enter_object(&cursor));
+
+  StringView key;
+  ASSERT_TRUE(json_cursor_next_member(&cursor, &key));
+  ASSERT_TRUE(json_cursor_skip(&cursor));
+
+  // A value of the wrong type is stepped over so the next member still lines
+  // up.
+  int64_t count = -1;
+  ASSERT_TRUE(json_cursor_next_member(&cursor, &key));
+  EXPECT_TRUE(string_view_equals_cstr(key, "count"));
+  EXPECT_FALSE(json_cursor_get_integer(&cursor, &count));
+  EXPECT_EQ(count, -1);
+
+  ASSERT_TRUE(json_cursor_next_member(&cursor, &key));
+  EXPECT_TRUE(string_view_equals_cstr(key, "min"));
+  EXPECT_FALSE(json_cursor_enter_array(&cursor));
+
+  EXPECT_FALSE(json_cursor_next_member(&cursor, &key));
+  EXPECT_TRUE(json_cursor_finish(&cursor));
+  json_cursor_destroy(&cursor);
+}
+
+TEST(JsonCursorTest, MalformedDocumentsFailToFinish)
+{
+  const char* documents[] = {"{\"a\": 1,}", "[1, 2", "{\"a\" 1}", "[1 2]",
+      "{1: 2}", "[,]", "[1] 2", "{\"a\": [}"};
+
+  for (const char* source : documents)
+  {
+    JsonCursor cursor;
+    if (!json_cursor_create(&cursor, source, strlen(source), NULL))
+    {
+      continue;
+    }
+
+    // Walk the root the way a reader that doesn't know the schema would.
+    StringView key;
+    enum JsonType type = JT_NULL;
+    json_cursor_peek_type(&cursor, &type);
+    if (type == JT_OBJECT && json_cursor_enter_object(&cursor))
+    {
+      while (json_cursor_next_member(&cursor, &key))
+      {
+        json_cursor_skip(&cursor);
+      }
+    }
+    else if (type == JT_ARRAY && json_cursor_enter_array(&cursor))
+    {
+      while (json_cursor_next_element(&cursor))
+      {
+        json_cursor_skip(&cursor);
+      }
+    }
+    else
+    {
+      json_cursor_skip(&cursor);
+    }
+
+    EXPECT_FALSE(json_cursor_finish(&cursor)) << source;
+    json_cursor_destroy(&cursor);
+  }
+}
+
+TEST(JsonCursorTest, MalformedScalarsFailWhenRead)
+{
+  // Skipping doesn't look inside scalars, but reading them does.
+  const char source[] = "[tru, 1.5x]";
+
+  JsonCursor cursor;
+  ASSERT_TRUE(json_cursor_create(&cursor, source, sizeof(source) - 1, NULL));
+  ASSERT_TRUE(json_cursor_enter_array(&cursor));
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+
+  bool boolean;
+  EXPECT_FALSE(json_cursor_get_boolean(&cursor, &boolean));
+  EXPECT_FALSE(json_cursor_next_element(&cursor));
+  EXPECT_FALSE(json_cursor_finish(&cursor));
+  json_cursor_destroy(&cursor);
+
+  ASSERT_TRUE(json_cursor_create(&cursor, source, sizeof(source) - 1, NULL));
+  ASSERT_TRUE(json_cursor_enter_array(&cursor));
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+  ASSERT_TRUE(json_cursor_skip(&cursor));
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+
+  double number;
+  EXPECT_FALSE(json_cursor_get_number(&cursor, &number));
+  EXPECT_FALSE(json_cursor_finish(&cursor));
+  json_cursor_destroy(&cursor);
+}
+
+TEST(JsonCursorTest, DecodesEscapedStrings)
+{
+  const char source[] = R"(["image\/png", "plain", "é\n", "\u12"])";
+
+  TrackingAllocator tracker;
+  tracking_allocator_create(&tracker, NULL);
+
+  JsonCursor cursor;
+  ASSERT_TRUE(json_cursor_create(
+      &cursor, source, sizeof(source) - 1, &tracker.allocator));
+  ASSERT_TRUE(json_cursor_enter_array(&cursor));
+
+  StringView value;
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+  ASSERT_TRUE(json_cursor_get_unescaped_string(&cursor, &value));
+  EXPECT_TRUE(string_view_equals_cstr(value, "image/png"));
+
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+  ASSERT_TRUE(json_cursor_get_unescaped_string(&cursor, &value));
+  EXPECT_TRUE(string_view_equals_cstr(value, "plain"));
+  EXPECT_GE(value.data, source);
+  EXPECT_LT(value.data, source + sizeof(source));
+
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+  ASSERT_TRUE(json_cursor_get_unescaped_string(&cursor, &value));
+  EXPECT_TRUE(string_view_equals_cstr(value, "\xc3\xa9\n"));
+
+  ASSERT_TRUE(json_cursor_next_element(&cursor));
+  EXPECT_FALSE(json_cursor_get_unescaped_string(&cursor, &value));
+  EXPECT_FALSE(json_cursor_finish(&cursor));
+
+  json_cursor_destroy(&cursor);
+  EXPECT_EQ(tracker.currentBytes, 0);
+}
+
+TEST(JsonCursorTest, OnlyAllocatesTheStructuralIndex)
+{
+  std::string source = "{\"accessors\": [";
+  for (int i = 0; i < 1000; i++)
+  {
+    source += i > 0 ? "," : "";
+    source += R"({"bufferView": 1, "componentType": 5126, "count": 24,
+        "type": "VEC3", "max": [1, 1, 1], "min": [-1, -1, -1]})";
+  }
+  source += "]}";
+
+  TrackingAllocator tracker;
+  tracking_allocator_create(&tracker, NULL);
+
+  JsonCursor cursor;
+  ASSERT_TRUE(json_cursor_create(
+      &cursor, source.data(), source.size(), &tracker.allocator));
+  int64_t indexAllocations = tracker.totalAllocations;
+
+  int64_t total = 0;
+  StringView key;
+  ASSERT_TRUE(json_cursor_enter_object(&cursor));
+  while (json_cursor_next_member(&cursor, &key))
+  {
+    ASSERT_TRUE(json_cursor_enter_array(&cursor));
+    while (json_cursor_next_element(&cursor))
+    {
+      ASSERT_TRUE(json_cursor_enter_object(&cursor));
+      while (json_cursor_next_member(&cursor, &key))
+      {
+        int64_t count;
+        if (string_view_equals_cstr(key, "count")
+            && json_cursor_get_integer(&cursor, &count))
+        {
+          total += count;
+        }
+        else
+        {
+          json_cursor_skip(&cursor);
+        }
+      }
+    }
+  }
+
+  EXPECT_TRUE(json_cursor_finish(&cursor));
+  EXPECT_EQ(total, 24000);
+  EXPECT_EQ(tracker.totalAllocations, indexAllocations);
+
+  json_cursor_destroy(&cursor);
+  EXPECT_EQ(tracker.currentBytes, 0);
+}
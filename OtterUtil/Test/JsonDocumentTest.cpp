@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/Json/JsonDocument.h"
+#include "Otter/Util/Memory/TrackingAllocator.h"
+}
+
+TEST(JsonDocumentTest, ParsesNestedValues)
+{
+  const char source[] = R"({"name": "otter", "values": [1, 2.5, true, null],
+      "nested": {"empty": {}, "list": []}})";
+
+  JsonDocument document;
+  ASSERT_TRUE(json_document_parse(&document, source, sizeof(source) - 1, NULL));
+  ASSERT_EQ(document.root.type, JT_OBJECT);
+  EXPECT_EQ(document.root.length, 3);
+
+  JsonNode* name = json_node_get_member(&document.root, "name");
+  ASSERT_NE(name, nullptr);
+  ASSERT_EQ(name->type, JT_STRING);
+  EXPECT_TRUE(string_view_equals_cstr(json_node_get_string(name), "otter"));
+  EXPECT_GE(name->string, source);
+  EXPECT_LT(name->string, source + sizeof(source));
+
+  JsonNode* values = json_node_get_member(&document.root, "values");
+  ASSERT_NE(values, nullptr);
+  ASSERT_EQ(values->type, JT_ARRAY);
+  ASSERT_EQ(values->length, 4);
+  EXPECT_EQ(json_node_get_element(values, 0)->integer, 1);
+  EXPECT_EQ(json_node_get_element(values, 1)->floatingPoint, 2.5);
+  EXPECT_TRUE(json_node_get_element(values, 2)->boolean);
+  EXPECT_EQ(json_node_get_element(values, 3)->type, JT_NULL);
+  EXPECT_EQ(json_node_get_element(values, 4), nullptr);
+
+  JsonNode* nested = json_node_get_member(&document.root, "nested");
+  ASSERT_NE(nested, nullptr);
+  EXPECT_EQ(json_node_get_member(nested, "empty")->length, 0);
+  EXPECT_EQ(json_node_get_member(nested, "list")->type, JT_ARRAY);
+  EXPECT_EQ(json_node_get_member(nested, "missing"), nullptr);
+  EXPECT_EQ(json_node_get_member(name, "name"), nullptr);
+
+  json_document_destroy(&document);
+}
+
+TEST(JsonDocumentTest, LargeObjectsAreIndexed)
+{
+  std::string source = "{";
+  for (int i = 0; i < 1000; i++)
+  {
+    source += (i > 0 ? ",\"key" : "\"key") + std::to_string(i)
+            + "\": " + std::to_string(i);
+  }
+  source += ",\"key7\": -1}";
+
+  JsonDocument document;
+  ASSERT_TRUE(
+      json_document_parse(&document, source.data(), source.size(), NULL));
+  ASSERT_EQ(document.root.length, 1001);
+
+  for (int i = 0; i < 1000; i++)
+  {
+    std::string key = "key" + std::to_string(i);
+    JsonNode* value = json_node_get_member(&document.root, key.c_str());
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(value->integer, i);
+  }
+  EXPECT_EQ(json_node_get_member(&document.root, "key1000"), nullptr);
+
+  json_document_destroy(&document);
+}
+
+TEST(JsonDocumentTest, EscapedStringsAreCopied)
+{
+  const char source[] = R"({"a\tb": "line\nbreak"})";
+
+  JsonDocument document;
+  ASSERT_TRUE(json_document_parse(&document, source, sizeof(source) - 1, NULL));
+
+  JsonNode* value = json_node_get_member(&document.root, "a\tb");
+  ASSERT_NE(value, nullptr);
+  EXPECT_TRUE(
+      string_view_equals_cstr(json_node_get_string(value), "line\nbreak"));
+
+  json_document_destroy(&document);
+}
+
+TEST(JsonDocumentTest, RejectsMalformedDocuments)
+{
+  const char* documents[] = {
+      "{\"a\": 1,}", "[1, 2", "{\"a\" 1}", "[1 2]", "{1: 2}", "[,]",
+      "[\"open]", "[tru]", "[nulls]", "[\"a\"1]", "[1.5x]", "[1] 2"};
+
+  for (const char* source : documents)
+  {
+    TrackingAllocator tracker;
+    tracking_allocator_create(&tracker, NULL);
+
+    JsonDocument document;
+    EXPECT_FALSE(json_document_parse(
+        &document, source, strlen(source), &tracker.allocator))
+        << source;
+    EXPECT_EQ(tracker.currentBytes, 0);
+  }
+}
+
+TEST(JsonDocumentTest, UsesFarLessMemoryThanHashMapDom)
+{
+  std::string source = "{\"accessors\": [";
+  for (int i = 0; i < 1000; i++)
+  {
+    source += i > 0 ? "," : "";
+    source += R"({"bufferView": 1, "componentType": 5126, "count": 24,
+        "type": "VEC3", "max": [1, 1, 1], "min": [-1, -1, -1]})";
+  }
+  source += "]}";
+
+  TrackingAllocator hashMapTracker;
+  tracking_allocator_create(&hashMapTracker, NULL);
+  size_t cursor   = 0;
+  JsonValue* root = json_parse_with_allocator(
+      source.data(), source.size(), &cursor, &hashMapTracker.allocator);
+  ASSERT_NE(root, nullptr);
+  int64_t hashMapBytes = hashMapTracker.peakBytes;
+  json_destroy_with_allocator(root, &hashMapTracker.allocator);
+
+  TrackingAllocator documentTracker;
+  tracking_allocator_create(&documentTracker, NULL);
+  JsonDocument document;
+  ASSERT_TRUE(json_document_parse(
+      &document, source.data(), source.size(), &documentTracker.allocator));
+  int64_t documentBytes = documentTracker.peakBytes;
+  json_document_destroy(&document);
+
+  EXPECT_EQ(documentTracker.currentBytes, 0);
+  EXPECT_LT(documentBytes * 10, hashMapBytes);
+}
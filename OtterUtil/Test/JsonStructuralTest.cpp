@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/Json/JsonStructural.h"
+}
+
+static std::vector<uint32_t> build_positions(
+    const std::string& source, CpuSimdLevel level)
+{
+  JsonStructuralIndex index;
+  if (!json_structural_index_build(
+          &index, source.data(), source.size(), level, NULL))
+  {
+    ADD_FAILURE() << "Failed to index at level " << cpu_simd_level_name(level);
+    return {};
+  }
+
+  std::vector<uint32_t> positions(
+      index.positions, index.positions + index.count);
+  json_structural_index_destroy(&index);
+  return positions;
+}
+
+TEST(JsonStructuralTest, FindsTokenStarts)
+{
+  std::string source = R"({"a\"b,": [12, true] , "c":null})";
+
+  std::vector<uint32_t> expected = {
+      0, 1, 8, 10, 11, 13, 15, 19, 21, 23, 26, 27, 31};
+  EXPECT_EQ(build_positions(source, CPU_SIMD_SCALAR), expected);
+}
+
+TEST(JsonStructuralTest, KernelsAgreeWithScalar)
+{
+  // Backslash runs and quotes landing on every offset around the 64 byte
+  // blocks, so escapes and strings are carried from one block to the next.
+  std::string source = "[";
+  for (int i = 0; i < 200; i++)
+  {
+    source += i > 0 ? ", " : "";
+    source += "\"" + std::string(i % 7, '\\') + std::string(i % 7, '\\')
+            + std::string(i % 67, 'x') + "\\\"{},:[]\", -"
+            + std::to_string(i * 31) + ".5e2, false";
+  }
+  source += "]";
+
+  std::vector<uint32_t> expected = build_positions(source, CPU_SIMD_SCALAR);
+  ASSERT_FALSE(expected.empty());
+
+  for (int level = CPU_SIMD_SSE42; level <= cpu_get_simd_level(); level++)
+  {
+    EXPECT_EQ(build_positions(source, (CpuSimdLevel) level), expected)
+        << cpu_simd_level_name((CpuSimdLevel) level);
+  }
+}
+
+TEST(JsonStructuralTest, RejectsUnterminatedStrings)
+{
+  std::string source = std::string(100, ' ') + "[\"abc\\\"]";
+
+  for (int level = CPU_SIMD_SCALAR; level <= cpu_get_simd_level(); level++)
+  {
+    JsonStructuralIndex index;
+    EXPECT_FALSE(json_structural_index_build(&index, source.data(),
+        source.size(), (CpuSimdLevel) level, NULL))
+        << cpu_simd_level_name((CpuSimdLevel) level);
+  }
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/File.h"
+#include "Otter/Util/Json/JsonDocument.h"
+#include "Otter/Util/Json/JsonWriter.h"
+}
+
+static void write_sample(JsonWriter* writer)
+{
+  json_writer_begin_object(writer);
+  json_writer_key(writer, STRING_VIEW_LITERAL("name"));
+  json_writer_string(writer, STRING_VIEW_LITERAL("otter"));
+  json_writer_key(writer, STRING_VIEW_LITERAL("values"));
+  json_writer_begin_array(writer);
+  json_writer_integer(writer, -12);
+  json_writer_double(writer, 2.5);
+  json_writer_boolean(writer, true);
+  json_writer_null(writer);
+  json_writer_end_array(writer);
+  json_writer_key(writer, STRING_VIEW_LITERAL("empty"));
+  json_writer_begin_object(writer);
+  json_writer_end_object(writer);
+  json_writer_end_object(writer);
+}
+
+TEST(JsonWriterTest, WritesCompactJson)
+{
+  JsonWriter writer;
+  json_writer_create(&writer, JSON_WRITER_COMPACT, NULL);
+  write_sample(&writer);
+
+  EXPECT_TRUE(string_view_equals_cstr(json_writer_get_output(&writer),
+      R"({"name":"otter","values":[-12,2.5,true,null],"empty":{}})"));
+  EXPECT_TRUE(json_writer_close(&writer));
+}
+
+TEST(JsonWriterTest, WritesPrettyJson)
+{
+  JsonWriter writer;
+  json_writer_create(&writer, JSON_WRITER_PRETTY, NULL);
+  write_sample(&writer);
+
+  EXPECT_TRUE(string_view_equals_cstr(json_writer_get_output(&writer),
+      "{\n"
+      "  \"name\": \"otter\",\n"
+      "  \"values\": [\n"
+      "    -12,\n"
+      "    2.5,\n"
+      "    true,\n"
+      "    null\n"
+      "  ],\n"
+      "  \"empty\": {}\n"
+      "}"));
+  EXPECT_TRUE(json_writer_close(&writer));
+}
+
+TEST(JsonWriterTest, EscapedStringsReadBack)
+{
+  const char text[] = "quote \" slash \\ tab \t bell \x07 caf\xc3\xa9";
+
+  JsonWriter writer;
+  json_writer_create(&writer, JSON_WRITER_COMPACT, NULL);
+  json_writer_begin_array(&writer);
+  json_writer_string(&writer, string_view_create(text, sizeof(text) - 1));
+  json_writer_double(&writer, INFINITY);
+  json_writer_end_array(&writer);
+
+  StringView output = json_writer_get_output(&writer);
+  EXPECT_TRUE(string_view_equals_cstr(output,
+      R"(["quote \" slash \\ tab \t bell \u0007 caf)"
+      "\xc3\xa9\",null]"));
+
+  JsonDocument document;
+  ASSERT_TRUE(
+      json_document_parse(&document, output.data, output.length, NULL));
+  EXPECT_TRUE(string_view_equals_cstr(
+      json_node_get_string(json_node_get_element(&document.root, 0)), text));
+  EXPECT_EQ(json_node_get_element(&document.root, 1)->type, JT_NULL);
+  json_document_destroy(&document);
+
+  EXPECT_TRUE(json_writer_close(&writer));
+}
+
+TEST(JsonWriterTest, EscapesEveryCharacterAtEveryOffset)
+{
+  // Each ASCII character at each position of an eight byte chunk, so both
+  // the chunked and the byte at a time paths see all of them.
+  for (int c = 1; c < 0x80; c++)
+  {
+    for (int offset = 0; offset < 16; offset++)
+    {
+      std::string text(offset, 'a');
+      text += (char) c;
+      text += std::string(16 - offset, 'b');
+
+      std::string expected = "\"" + std::string(offset, 'a');
+      if (c == '"' || c == '\\')
+      {
+        expected += '\\';
+        expected += (char) c;
+      }
+      else if (c < 0x20)
+      {
+        char escape[8];
+        snprintf(escape, sizeof(escape), "\\u%04x", c);
+        const char* shortForms[] = {"\\b", "\\t", "\\n", nullptr, "\\f",
+            "\\r"};
+        expected += c >= '\b' && c <= '\r' && shortForms[c - '\b'] != nullptr
+                      ? shortForms[c - '\b']
+                      : escape;
+      }
+      else
+      {
+        expected += (char) c;
+      }
+      expected += std::string(16 - offset, 'b') + "\"";
+
+      JsonWriter writer;
+      json_writer_create(&writer, JSON_WRITER_COMPACT, NULL);
+      json_writer_string(
+          &writer, string_view_create(text.data(), text.size()));
+      StringView output = json_writer_get_output(&writer);
+      ASSERT_EQ(std::string(output.data, output.length), expected) << c;
+      json_writer_close(&writer);
+    }
+  }
+}
+
+TEST(JsonWriterTest, StreamsToFile)
+{
+  const char path[] = "JsonWriterTest.json";
+
+  // Enough to fill the file buffer several times, with one string longer
+  // than the buffer.
+  std::string longString(JSON_WRITER_FILE_BUFFER_SIZE * 2, 'x');
+  JsonWriter writer;
+  ASSERT_TRUE(json_writer_open(&writer, path, JSON_WRITER_COMPACT));
+  json_writer_begin_array(&writer);
+  for (int i = 0; i < 50000; i++)
+  {
+    json_writer_double(&writer, i * 0.25);
+  }
+  json_writer_string(
+      &writer, string_view_create(longString.data(), longString.size()));
+  json_writer_end_array(&writer);
+  ASSERT_TRUE(json_writer_close(&writer));
+
+  uint64_t length = 0;
+  char* text      = file_load(path, &length);
+  remove(path);
+  ASSERT_NE(text, nullptr);
+
+  JsonDocument document;
+  ASSERT_TRUE(json_document_parse(&document, text, length, NULL));
+  ASSERT_EQ(document.root.length, 50001);
+  for (int i = 0; i < 50000; i++)
+  {
+    JsonNode* value = json_node_get_element(&document.root, i);
+    double number   = value->type == JT_INTEGER ? (double) value->integer
+                                                : value->floatingPoint;
+    ASSERT_EQ(number, i * 0.25);
+  }
+  EXPECT_EQ(json_node_get_element(&document.root, 50000)->length,
+      longString.size());
+
+  json_document_destroy(&document);
+  free(text);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <Windows.h>
+
+#ifndef OTTER_PROFILE_LOCKS
+#define OTTER_PROFILE_LOCKS
+#endif
+
+extern "C"
+{
+#include "Otter/Util/Lock.h"
+}
+
+static DWORD WINAPI lock_test_take(void* lock)
+{
+  LOCK_ACQUIRE((Lock*) lock);
+  LOCK_RELEASE((Lock*) lock);
+  return 0;
+}
+
+TEST(LockTest, CountsAcquisitions)
+{
+  Lock lock;
+  lock_create(&lock, "lock_test_counts");
+  for (int i = 0; i < 10; i++)
+  {
+    LOCK_ACQUIRE(&lock);
+    LOCK_RELEASE(&lock);
+  }
+  lock_destroy(&lock);
+
+  LockSummary summary;
+  ASSERT_TRUE(lock_summary_get("lock_test_counts", &summary));
+  EXPECT_EQ(summary.acquisitions, 10);
+  EXPECT_EQ(summary.contended, 0);
+  EXPECT_EQ(summary.waitTime, 0.0f);
+}
+
+TEST(LockTest, AcquiresAsAnUnbracedStatement)
+{
+  Lock lock;
+  lock_create(&lock, "lock_test_unbraced");
+  for (int i = 0; i < 4; i++)
+  {
+    if (i % 2 == 0)
+      LOCK_ACQUIRE(&lock);
+    else
+      LOCK_ACQUIRE(&lock);
+    LOCK_RELEASE(&lock);
+  }
+  lock_destroy(&lock);
+
+  LockSummary summary;
+  ASSERT_TRUE(lock_summary_get("lock_test_unbraced", &summary));
+  EXPECT_EQ(summary.acquisitions, 4);
+}
+
+TEST(LockTest, CountsWaitsForAHeldLock)
+{
+  Lock lock;
+  lock_create(&lock, "lock_test_contended");
+
+  LOCK_ACQUIRE(&lock);
+  HANDLE thread = CreateThread(NULL, 0, lock_test_take, &lock, 0, NULL);
+  ASSERT_NE(thread, nullptr);
+  Sleep(50);
+  LOCK_RELEASE(&lock);
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+  lock_destroy(&lock);
+
+  LockSummary summary;
+  ASSERT_TRUE(lock_summary_get("lock_test_contended", &summary));
+  EXPECT_EQ(summary.acquisitions, 2);
+  EXPECT_EQ(summary.contended, 1);
+  EXPECT_GT(summary.waitTime, 0.01f);
+  EXPECT_EQ(summary.maxWaitTime, summary.waitTime);
+}
+
+TEST(LockTest, LocksWithTheSameNameShareCounts)
+{
+  Lock first;
+  Lock second;
+  lock_create(&first, "lock_test_shared");
+  lock_create(&second, "lock_test_shared");
+  LOCK_ACQUIRE(&first);
+  LOCK_ACQUIRE(&second);
+  LOCK_RELEASE(&second);
+  LOCK_RELEASE(&first);
+  lock_destroy(&first);
+  lock_destroy(&second);
+
+  LockSummary summary;
+  ASSERT_TRUE(lock_summary_get("lock_test_shared", &summary));
+  EXPECT_EQ(summary.acquisitions, 2);
+  EXPECT_FALSE(lock_summary_get("lock_test_missing", &summary));
+}
+
+TEST(LockTest, ReportsTheLongestHolders)
+{
+  Lock lock;
+  lock_create(&lock, "lock_test_report");
+  LOCK_ACQUIRE(&lock);
+  Sleep(5);
+  LOCK_RELEASE(&lock);
+  lock_destroy(&lock);
+
+  FILE* output = tmpfile();
+  ASSERT_NE(output, nullptr);
+  lock_report(output);
+  rewind(output);
+
+  std::stringstream report;
+  char line[256];
+  while (fgets(line, sizeof(line), output) != NULL)
+  {
+    report << line;
+  }
+  fclose(output);
+
+  std::string text = report.str();
+  size_t lockLine  = text.find("lock_test_report");
+  ASSERT_NE(lockLine, std::string::npos);
+  EXPECT_NE(text.find("LockTest.cpp:", lockLine), std::string::npos);
+}
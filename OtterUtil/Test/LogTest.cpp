@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/Log.h"
+}
+
+class LogTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    output = tmpfile();
+    ASSERT_NE(output, nullptr);
+    log_set_output(output);
+  }
+
+  void TearDown() override
+  {
+    log_set_output(NULL);
+    log_set_rate_limit(LOG_RATE_LIMIT);
+    fclose(output);
+  }
+
+  // What each line says after its timestamp, level and source location.
+  std::vector<std::string> read_messages()
+  {
+    log_flush();
+
+    std::vector<std::string> messages;
+    char line[4096];
+    rewind(output);
+    while (fgets(line, sizeof(line), output) != nullptr)
+    {
+      std::string text = line;
+      size_t source    = text.find("LogTest.cpp:");
+      if (source == std::string::npos)
+      {
+        continue;
+      }
+      size_t message = text.find(": ", source) + 2;
+      messages.push_back(text.substr(message, text.size() - message - 1));
+    }
+    return messages;
+  }
+
+  FILE* output = nullptr;
+};
+
+TEST_F(LogTest, FormatsLikePrintf)
+{
+  int value = 42;
+  LOG_WARNING("%d|%5d|%-5d|%05.2f|%x|%llu|%zu|%c|%%|%e", -7, value, value,
+      3.14159, 255u, 18446744073709551615ull, (size_t) 12, 'q', 1e-30);
+  LOG_WARNING("%s|%.3s|%8s|%-8s|%*d|%-*d|%.*f|%.*s", "otter", "otter",
+      "right", "left", 6, value, 6, value, 2, 2.71828, 2, "otter");
+  LOG_WARNING("%hhd|%hu|%ld|%lld|%#o|%g|%G", 300, 70000, -5L, -6ll, 8, 0.5,
+      1e100);
+  LOG_ERROR("%s and %p", (const char*) NULL, (void*) &value);
+
+  char expected[4][256];
+  snprintf(expected[0], sizeof(expected[0]),
+      "%d|%5d|%-5d|%05.2f|%x|%llu|%zu|%c|%%|%e", -7, value, value, 3.14159,
+      255u, 18446744073709551615ull, (size_t) 12, 'q', 1e-30);
+  snprintf(expected[1], sizeof(expected[1]),
+      "%s|%.3s|%8s|%-8s|%*d|%-*d|%.*f|%.*s", "otter", "otter", "right",
+      "left", 6, value, 6, value, 2, 2.71828, 2, "otter");
+  snprintf(expected[2], sizeof(expected[2]), "%hhd|%hu|%ld|%lld|%#o|%g|%G",
+      300, 70000, -5L, -6ll, 8, 0.5, 1e100);
+  snprintf(expected[3], sizeof(expected[3]), "(null) and %p", (void*) &value);
+
+  std::vector<std::string> messages = read_messages();
+  ASSERT_EQ(messages.size(), 4);
+  for (int i = 0; i < 4; i++)
+  {
+    EXPECT_EQ(messages[i], expected[i]);
+  }
+}
+
+TEST_F(LogTest, CopiesStringArguments)
+{
+  char name[] = "before";
+  LOG_WARNING("name is %s", name);
+  strcpy(name, "after!");
+
+  // Longer than a record holds, so it's cut short.
+  std::string longName(4000, 'x');
+  LOG_WARNING("long name is %s, unsupported %n stays", longName.c_str());
+
+  std::vector<std::string> messages = read_messages();
+  ASSERT_EQ(messages.size(), 2);
+  EXPECT_EQ(messages[0], "name is before");
+  EXPECT_EQ(messages[1].rfind("long name is xxx", 0), 0);
+  EXPECT_LT(messages[1].size(), longName.size());
+}
+
+TEST_F(LogTest, UnsupportedConversionsAreWrittenAsIs)
+{
+  LOG_WARNING("%d then %ls and %d", 1, L"wide", 2);
+
+  std::vector<std::string> messages = read_messages();
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0], "1 then %ls and %d");
+}
+
+TEST_F(LogTest, LongFlagRunsAreWrittenAsIs)
+{
+  std::string format = "%d then %" + std::string(64, '-') + "d";
+  LOG_WARNING(format.c_str(), 1, 2);
+
+  std::vector<std::string> messages = read_messages();
+  ASSERT_EQ(messages.size(), 1);
+  EXPECT_EQ(messages[0], "1 then %" + std::string(64, '-') + "d");
+}
+
+TEST_F(LogTest, RateLimitsRepeatedMessages)
+{
+  for (int i = 0; i < 100; i++)
+  {
+    LOG_WARNING("repeated %d", i);
+  }
+  EXPECT_EQ(read_messages().size(), LOG_RATE_LIMIT);
+
+  // The count of held back repeats goes with the next one written.
+  Sleep(1100);
+  LOG_WARNING("repeated %d", 100);
+  std::vector<std::string> messages = read_messages();
+  ASSERT_EQ(messages.size(), LOG_RATE_LIMIT + 1);
+  EXPECT_EQ(messages.back(), "repeated 100 (repeated 80 more times)");
+}
+
+TEST_F(LogTest, KeepsEveryThreadsMessagesInOrder)
+{
+  log_set_rate_limit(0);
+
+  const int threadCount = 8;
+  const int perThread   = 2000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; t++)
+  {
+    threads.emplace_back([t]() {
+      for (int i = 0; i < perThread; i++)
+      {
+        LOG_WARNING("thread %d message %d", t, i);
+        if (i % 256 == 0)
+        {
+          // Give the logging thread a chance so nothing is dropped.
+          Sleep(20);
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  std::vector<int> next(threadCount, 0);
+  for (const std::string& message : read_messages())
+  {
+    int t;
+    int i;
+    ASSERT_EQ(sscanf(message.c_str(), "thread %d message %d", &t, &i), 2)
+        << message;
+    EXPECT_EQ(i, next[t]++);
+  }
+  for (int t = 0; t < threadCount; t++)
+  {
+    EXPECT_EQ(next[t], perThread);
+  }
+}
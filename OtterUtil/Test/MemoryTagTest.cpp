@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/HashMap.h"
+#include "Otter/Util/Memory/MemoryTag.h"
+#include "Otter/Util/Memory/PoolAllocator.h"
+}
+
+static MemoryTagStatistics memory_tag_test_get(MemoryTag tag)
+{
+  MemoryTagStatistics statistics;
+  memory_tag_get_statistics(tag, &statistics);
+  return statistics;
+}
+
+TEST(MemoryTagTest, CountsCurrentAndPeakBytes)
+{
+  MemoryTagStatistics before = memory_tag_test_get(MEMORY_TAG_GENERAL);
+
+  void* first  = OTTER_ALLOC(MEMORY_TAG_GENERAL, 1000);
+  void* second = OTTER_ALLOC(MEMORY_TAG_GENERAL, 24);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  first = OTTER_REALLOC(MEMORY_TAG_GENERAL, first, 1000, 4000);
+  ASSERT_NE(first, nullptr);
+
+  MemoryTagStatistics during = memory_tag_test_get(MEMORY_TAG_GENERAL);
+  EXPECT_EQ(during.currentBytes - before.currentBytes, 4024);
+  EXPECT_EQ(during.liveAllocations - before.liveAllocations, 2);
+  EXPECT_EQ(during.totalAllocations - before.totalAllocations, 3);
+  EXPECT_GE(during.peakBytes, during.currentBytes);
+
+  OTTER_FREE(MEMORY_TAG_GENERAL, first, 4000);
+  OTTER_FREE(MEMORY_TAG_GENERAL, second, 24);
+
+  MemoryTagStatistics after = memory_tag_test_get(MEMORY_TAG_GENERAL);
+  EXPECT_EQ(after.currentBytes, before.currentBytes);
+  EXPECT_EQ(after.liveAllocations, before.liveAllocations);
+  EXPECT_GE(after.peakBytes, before.currentBytes + 4024);
+}
+
+TEST(MemoryTagTest, TracksOutsideMemory)
+{
+  MemoryTagStatistics before = memory_tag_test_get(MEMORY_TAG_GPU_BUFFER);
+
+  memory_tag_track(MEMORY_TAG_GPU_BUFFER, 1 << 20);
+  EXPECT_EQ(memory_tag_test_get(MEMORY_TAG_GPU_BUFFER).currentBytes,
+      before.currentBytes + (1 << 20));
+
+  memory_tag_untrack(MEMORY_TAG_GPU_BUFFER, 1 << 20);
+  EXPECT_EQ(memory_tag_test_get(MEMORY_TAG_GPU_BUFFER).currentBytes,
+      before.currentBytes);
+}
+
+TEST(MemoryTagTest, HashMapsAreCountedByDefault)
+{
+  MemoryTagStatistics before = memory_tag_test_get(MEMORY_TAG_HASH_MAP);
+
+  HashMap map;
+  ASSERT_TRUE(
+      hash_map_create(&map, HASH_MAP_DEFAULT_BUCKETS, HASH_MAP_DEFAULT_COEF));
+  EXPECT_GE(memory_tag_test_get(MEMORY_TAG_HASH_MAP).currentBytes
+                - before.currentBytes,
+      HASH_MAP_DEFAULT_BUCKETS * sizeof(StableAutoArray));
+
+  hash_map_destroy(&map, NULL);
+  EXPECT_EQ(memory_tag_test_get(MEMORY_TAG_HASH_MAP).currentBytes,
+      before.currentBytes);
+}
+
+TEST(MemoryTagTest, PoolsCountTheirSlabs)
+{
+  MemoryTagStatistics before = memory_tag_test_get(MEMORY_TAG_ECS);
+
+  PoolAllocator pool;
+  pool_allocator_create_tagged(&pool, MEMORY_TAG_ECS);
+  void* block = allocator_allocate(&pool.allocator, 32);
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(memory_tag_test_get(MEMORY_TAG_ECS).currentBytes,
+      before.currentBytes + POOL_ALLOCATOR_SLAB_SIZE);
+
+  allocator_deallocate(&pool.allocator, block, 32);
+  pool_allocator_destroy(&pool);
+  EXPECT_EQ(memory_tag_test_get(MEMORY_TAG_ECS).currentBytes,
+      before.currentBytes);
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/String/Number.h"
+}
+
+static ParsedNumber parse_all(const char* text)
+{
+  ParsedNumber number;
+  EXPECT_EQ(number_parse(text, strlen(text), &number), strlen(text)) << text;
+  return number;
+}
+
+TEST(NumberTest, ParsesIntegers)
+{
+  struct
+  {
+    const char* text;
+    int64_t value;
+  } cases[] = {{"0", 0}, {"-0", 0}, {"7", 7}, {"-42", -42},
+      {"12345678", 12345678}, {"123456789012", 123456789012},
+      {"9223372036854775807", INT64_MAX}, {"-9223372036854775808", INT64_MIN}};
+
+  for (auto& test : cases)
+  {
+    ParsedNumber number = parse_all(test.text);
+    EXPECT_EQ(number.type, NUMBER_INTEGER) << test.text;
+    EXPECT_EQ(number.integer, test.value) << test.text;
+  }
+
+  // Too big for 64 bits, so it falls back to a double.
+  ParsedNumber number = parse_all("9223372036854775808");
+  EXPECT_EQ(number.type, NUMBER_FLOAT);
+  EXPECT_EQ(number.floatingPoint, 9223372036854775808.0);
+}
+
+TEST(NumberTest, StopsAtEndOfNumber)
+{
+  ParsedNumber number;
+  EXPECT_EQ(number_parse("12.5, 3", 7, &number), 4);
+  EXPECT_EQ(number.type, NUMBER_FLOAT);
+  EXPECT_EQ(number.floatingPoint, 12.5);
+
+  // Only the given length is read, even inside a longer run of digits.
+  EXPECT_EQ(number_parse("123456789", 3, &number), 3);
+  EXPECT_EQ(number.integer, 123);
+}
+
+TEST(NumberTest, RejectsNonJsonNumbers)
+{
+  const char* texts[] = {
+      "", "-", "+1", ".5", "1.", "01", "1e", "1e+", "-x", "inf", "0x10"};
+
+  for (const char* text : texts)
+  {
+    ParsedNumber number;
+    size_t length = number_parse(text, strlen(text), &number);
+    EXPECT_TRUE(length == 0 || length < strlen(text)) << text;
+  }
+
+  int64_t integer;
+  EXPECT_FALSE(number_parse_integer(STRING_VIEW_LITERAL("12px"), &integer));
+  EXPECT_FALSE(number_parse_integer(STRING_VIEW_LITERAL("1.5"), &integer));
+  EXPECT_TRUE(number_parse_integer(STRING_VIEW_LITERAL("1440"), &integer));
+  EXPECT_EQ(integer, 1440);
+}
+
+TEST(NumberTest, RoundsLikeStrtod)
+{
+  const char* texts[] = {"0.1", "1e23", "2.2250738585072014e-308",
+      "4.9e-324", "2.4703282292062328e-324", "1.7976931348623157e308",
+      "1e400", "1e-400", "9007199254740993.0", "7.2057594037927933e16",
+      "0.000000000000000000000000000001234",
+      "123456789012345678901234567890.5",
+      "1.00000000000000011102230246251565404236316680908203125"};
+
+  for (const char* text : texts)
+  {
+    ParsedNumber number = parse_all(text);
+    EXPECT_EQ(number.type, NUMBER_FLOAT) << text;
+    EXPECT_EQ(number.floatingPoint, strtod(text, nullptr)) << text;
+  }
+}
+
+TEST(NumberTest, RoundTripsRandomDoubles)
+{
+  std::mt19937_64 random(31);
+  for (int i = 0; i < 100000; i++)
+  {
+    uint64_t bits = random();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (!std::isfinite(value))
+    {
+      continue;
+    }
+
+    char text[32];
+    snprintf(text, sizeof(text), "%.17e", value);
+
+    double parsed;
+    ASSERT_TRUE(number_parse_double(string_view_from_cstr(text), &parsed))
+        << text;
+    ASSERT_EQ(memcmp(&parsed, &value, sizeof(value)), 0) << text;
+  }
+}
+
+static std::string format_double(double value)
+{
+  char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+  return std::string(buffer, number_format_double(value, buffer));
+}
+
+TEST(NumberTest, FormatsShortestDoubles)
+{
+  struct
+  {
+    double value;
+    const char* text;
+  } cases[] = {{0.0, "0"}, {-0.0, "-0"}, {0.1, "0.1"}, {2.5, "2.5"},
+      {-100.0, "-100"}, {123456.789, "123456.789"},
+      {1e20, "100000000000000000000"}, {1e21, "1e+21"}, {1e23, "1e+23"},
+      {0.000001, "0.000001"}, {1e-7, "1e-7"},
+      {1.5e300, "1.5e+300"}, {5e-324, "5e-324"},
+      {1.7976931348623157e308, "1.7976931348623157e+308"},
+      {9007199254740993.0, "9007199254740992"}};
+
+  for (auto& test : cases)
+  {
+    EXPECT_EQ(format_double(test.value), test.text);
+  }
+
+  char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+  EXPECT_EQ(number_format_double(NAN, buffer), 0);
+  EXPECT_EQ(number_format_double(-INFINITY, buffer), 0);
+}
+
+TEST(NumberTest, FormattedDoublesAreShortestRoundTrips)
+{
+  std::mt19937_64 random(35);
+  for (int i = 0; i < 100000; i++)
+  {
+    uint64_t bits = random();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (!std::isfinite(value))
+    {
+      continue;
+    }
+
+    std::string text = format_double(value);
+    double parsed;
+    ASSERT_TRUE(number_parse_double(
+        string_view_create(text.data(), text.size()), &parsed))
+        << text;
+    ASSERT_EQ(memcmp(&parsed, &value, sizeof(value)), 0) << text;
+
+    // One significant digit fewer must not read back as the same double.
+    std::string digits;
+    for (char c : text.substr(0, text.find('e')))
+    {
+      if (c >= '0' && c <= '9' && (!digits.empty() || c != '0'))
+      {
+        digits += c;
+      }
+    }
+    digits.erase(digits.find_last_not_of('0') + 1);
+    if (digits.size() > 1)
+    {
+      char shorter[32];
+      snprintf(shorter, sizeof(shorter), "%.*e", (int) digits.size() - 2,
+          value);
+      EXPECT_NE(strtod(shorter, nullptr), value) << text;
+    }
+  }
+}
+
+TEST(NumberTest, FormatsIntegers)
+{
+  int64_t values[] = {0, 7, -42, 100, 1234567890, INT64_MAX, INT64_MIN};
+  for (int64_t value : values)
+  {
+    char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+    EXPECT_EQ(std::string(buffer, number_format_integer(value, buffer)),
+        std::to_string(value));
+  }
+}
@@ -0,0 +1,323 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/File.h"
+#include "Otter/Util/Json/JsonDocument.h"
+#include "Otter/Util/Profiler.h"
+}
+
+class ProfilerTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    profiler_init(frequency);
+  }
+
+  void TearDown() override
+  {
+    profiler_update();
+    profiler_destroy();
+  }
+};
+
+TEST_F(ProfilerTest, UnknownZonesHaveNoTime)
+{
+  EXPECT_EQ(profiler_clock_get("never_started"), INFINITY);
+}
+
+TEST_F(ProfilerTest, NestedZonesSplitSelfTime)
+{
+  PROFILE_ZONE("outer");
+  PROFILE_ZONE("inner");
+  Sleep(20);
+  PROFILE_ZONE_END();
+  PROFILE_ZONE_END();
+  profiler_update();
+
+  float inner = profiler_clock_get("inner");
+  float outer = profiler_clock_get("outer");
+  EXPECT_GE(inner, 0.015f);
+  EXPECT_GE(outer, inner);
+  EXPECT_FLOAT_EQ(profiler_clock_get_self("inner"), inner);
+  EXPECT_LT(profiler_clock_get_self("outer"), 0.01f);
+}
+
+TEST_F(ProfilerTest, AveragesOverAFullWindow)
+{
+  // A full window of samples used to leave the count at zero.
+  static ProfileSite site = {"full_window", __FILE__, __LINE__};
+  const int perHalf       = 100;
+  for (int i = 0; i < perHalf; i++)
+  {
+    profiler_zone_begin(&site);
+    profiler_zone_end();
+  }
+  profiler_update();
+  Sleep(PROFILE_WINDOW_MS + 50);
+
+  // The first zones move to the older half and the new ones start the next.
+  for (int i = 0; i < perHalf; i++)
+  {
+    profiler_zone_begin(&site);
+    profiler_zone_end();
+  }
+  profiler_update();
+
+  ProfileSummary summary;
+  ASSERT_TRUE(profiler_summary_get("full_window", PR_WINDOW, &summary));
+  EXPECT_EQ(summary.count, perHalf * 2);
+  EXPECT_TRUE(std::isfinite(profiler_clock_get("full_window")));
+
+  // Only the newer half is left once the window moves on again.
+  Sleep(PROFILE_WINDOW_MS + 50);
+  profiler_update();
+  ASSERT_TRUE(profiler_summary_get("full_window", PR_WINDOW, &summary));
+  EXPECT_EQ(summary.count, perHalf);
+  EXPECT_EQ(site.statistics.run.count, perHalf * 2);
+  EXPECT_TRUE(std::isfinite(profiler_clock_get("full_window")));
+}
+
+TEST_F(ProfilerTest, SummarizesTheTail)
+{
+  static ProfileSite site = {"summarized", __FILE__, __LINE__};
+  for (int i = 0; i < 100; i++)
+  {
+    profiler_zone_begin(&site);
+    if (i == 0)
+    {
+      Sleep(20);
+    }
+    profiler_zone_end();
+  }
+  profiler_update();
+
+  ProfileSummary summary;
+  ASSERT_TRUE(profiler_summary_get("summarized", PR_RUN, &summary));
+  EXPECT_EQ(summary.count, 100);
+  EXPECT_EQ(site.statistics.run.count, 100);
+
+  // One slow zone in a hundred is the worst and pulls the mean up, but only
+  // shows in the percentiles from 99 on.
+  EXPECT_GE(summary.max, 0.015f);
+  EXPECT_GE(summary.mean, summary.max / 100.0f);
+  EXPECT_LT(summary.p50, 0.001f);
+  EXPECT_LT(summary.p95, 0.001f);
+  EXPECT_LT(summary.p99, 0.001f);
+  EXPECT_EQ(profiler_percentile_get("summarized", PR_RUN, 100.0), summary.max);
+  EXPECT_LE(summary.min, summary.p50);
+
+  ASSERT_TRUE(profiler_summary_get("summarized", PR_WINDOW, &summary));
+  EXPECT_EQ(summary.count, 100);
+  EXPECT_EQ(profiler_percentile_get("never_started", PR_RUN, 50.0), INFINITY);
+}
+
+TEST_F(ProfilerTest, ThreadsShareASite)
+{
+  static ProfileSite parent = {"thread_parent", __FILE__, __LINE__};
+  static ProfileSite child  = {"thread_child", __FILE__, __LINE__};
+
+  // Few enough zones that nothing is dropped even if every thread ends up
+  // with the same buffer, as threads that exit hand theirs on.
+  const int threadCount = 8;
+  const int perThread   = 200;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; t++)
+  {
+    threads.emplace_back([]() {
+      for (int i = 0; i < perThread; i++)
+      {
+        profiler_zone_begin(&parent);
+        profiler_zone_begin(&child);
+        profiler_zone_end();
+        profiler_zone_end();
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  profiler_update();
+
+  EXPECT_EQ(parent.statistics.run.count, threadCount * perThread);
+  EXPECT_EQ(child.statistics.run.count, threadCount * perThread);
+  EXPECT_EQ(child.statistics.parent, &parent);
+  EXPECT_EQ(parent.statistics.parent, nullptr);
+}
+
+TEST_F(ProfilerTest, CapturesATrace)
+{
+  const char path[] = "ProfilerTest.json";
+  ASSERT_TRUE(profiler_capture_start(path, 2));
+  EXPECT_TRUE(profiler_capture_active());
+  EXPECT_FALSE(profiler_capture_start(path, 1));
+
+  PROFILE_ZONE("capture_enqueue");
+  uint64_t flow = profiler_flow_begin();
+  EXPECT_NE(flow, 0);
+  std::thread worker([flow]() {
+    profiler_set_thread_name("Capture worker");
+    PROFILE_ZONE("capture_task");
+    profiler_flow_end(flow);
+    PROFILE_ZONE_END();
+  });
+  worker.join();
+  PROFILE_ZONE_END();
+
+  profiler_update();
+  EXPECT_TRUE(profiler_capture_active());
+  profiler_update();
+  EXPECT_FALSE(profiler_capture_active());
+  EXPECT_EQ(profiler_flow_begin(), 0);
+
+  uint64_t length = 0;
+  char* text      = file_load(path, &length);
+  remove(path);
+  ASSERT_NE(text, nullptr);
+
+  JsonDocument document;
+  ASSERT_TRUE(json_document_parse(&document, text, length, NULL));
+  JsonNode* events = json_node_get_member(&document.root, "traceEvents");
+  ASSERT_NE(events, nullptr);
+
+  int64_t enqueueThread = -1;
+  int64_t taskThread    = -1;
+  int64_t namedThread   = -1;
+  int64_t flowBegin     = -1;
+  int64_t flowEnd       = -1;
+  int frames            = 0;
+  for (uint32_t i = 0; i < events->length; i++)
+  {
+    JsonNode* event = json_node_get_element(events, i);
+    JsonNode* name  = json_node_get_member(event, "name");
+    JsonNode* phase = json_node_get_member(event, "ph");
+    ASSERT_NE(name, nullptr);
+    ASSERT_NE(phase, nullptr);
+    std::string nameText(name->string, name->length);
+    std::string phaseText(phase->string, phase->length);
+    int64_t thread = json_node_get_member(event, "tid")->integer;
+
+    if (phaseText == "X" && nameText == "capture_enqueue")
+    {
+      enqueueThread = thread;
+    }
+    else if (phaseText == "X" && nameText == "capture_task")
+    {
+      taskThread = thread;
+    }
+    else if (phaseText == "s" || phaseText == "f")
+    {
+      EXPECT_EQ(json_node_get_member(event, "id")->integer, (int64_t) flow);
+      (phaseText == "s" ? flowBegin : flowEnd) = thread;
+    }
+    else if (phaseText == "i")
+    {
+      frames++;
+    }
+    else if (phaseText == "M")
+    {
+      JsonNode* threadName =
+          json_node_get_member(json_node_get_member(event, "args"), "name");
+      if (std::string(threadName->string, threadName->length)
+          == "Capture worker")
+      {
+        namedThread = thread;
+      }
+    }
+  }
+
+  EXPECT_NE(enqueueThread, -1);
+  EXPECT_NE(taskThread, -1);
+  EXPECT_NE(enqueueThread, taskThread);
+  EXPECT_EQ(namedThread, taskThread);
+  EXPECT_EQ(flowBegin, enqueueThread);
+  EXPECT_EQ(flowEnd, taskThread);
+  EXPECT_EQ(frames, 2);
+
+  json_document_destroy(&document);
+  free(text);
+}
+
+static void profiler_test_spin(int milliseconds)
+{
+  auto end = std::chrono::steady_clock::now()
+           + std::chrono::milliseconds(milliseconds);
+  while (std::chrono::steady_clock::now() < end)
+  {
+  }
+}
+
+TEST_F(ProfilerTest, WritesHitches)
+{
+  const char directory[] = "ProfilerTestHitches";
+  ASSERT_TRUE(profiler_hitch_detect(directory, 4.0f));
+  EXPECT_NE(profiler_flow_begin(), 0);
+
+  profiler_update();
+  for (int i = 0; i < PROFILE_HITCH_HISTORY; i++)
+  {
+    PROFILE_ZONE("steady_frame");
+    profiler_test_spin(2);
+    PROFILE_ZONE_END();
+    profiler_update();
+  }
+  EXPECT_STREQ(profiler_hitch_get_last_path(), "");
+
+  PROFILE_ZONE("hitch_frame");
+  profiler_test_spin(40);
+  PROFILE_ZONE_END();
+  profiler_update();
+  std::string path = profiler_hitch_get_last_path();
+  ASSERT_NE(path, "");
+  ASSERT_TRUE(profiler_hitch_detect(NULL, 0.0f));
+
+  uint64_t length = 0;
+  char* text      = file_load(path.c_str(), &length);
+  remove(path.c_str());
+  RemoveDirectoryA(directory);
+  ASSERT_NE(text, nullptr);
+
+  JsonDocument document;
+  ASSERT_TRUE(json_document_parse(&document, text, length, NULL));
+  JsonNode* events = json_node_get_member(&document.root, "traceEvents");
+  ASSERT_NE(events, nullptr);
+
+  int steadyZones = 0;
+  int hitchZones  = 0;
+  int frames      = 0;
+  for (uint32_t i = 0; i < events->length; i++)
+  {
+    JsonNode* event = json_node_get_element(events, i);
+    JsonNode* name  = json_node_get_member(event, "name");
+    JsonNode* phase = json_node_get_member(event, "ph");
+    std::string nameText(name->string, name->length);
+    std::string phaseText(phase->string, phase->length);
+    steadyZones += phaseText == "X" && nameText == "steady_frame";
+    hitchZones += phaseText == "X" && nameText == "hitch_frame";
+    frames += phaseText == "i";
+  }
+  EXPECT_EQ(steadyZones, PROFILE_HITCH_FRAMES - 1);
+  EXPECT_EQ(hitchZones, 1);
+  EXPECT_EQ(frames, PROFILE_HITCH_FRAMES);
+
+  JsonNode* hitch = json_node_get_member(&document.root, "hitch");
+  ASSERT_NE(hitch, nullptr);
+  EXPECT_GT(json_node_get_member(hitch, "frameMs")->floatingPoint, 30.0);
+  EXPECT_NE(json_node_get_member(hitch, "memory"), nullptr);
+
+  json_document_destroy(&document);
+  free(text);
+}
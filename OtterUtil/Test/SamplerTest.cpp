@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/File.h"
+#include "Otter/Util/Sampler.h"
+}
+
+// Builds a sample file in memory the way the sampler writes one.
+class SampleFileBuilder
+{
+public:
+  SampleFileBuilder()
+  {
+    SampleFileHeader header = {};
+    memcpy(header.magic, SAMPLE_FILE_MAGIC, sizeof(header.magic));
+    header.version   = SAMPLE_FILE_VERSION;
+    header.rate      = 1000;
+    header.frequency = 1000000;
+    header.start     = 5000000;
+    append(&header, sizeof(header));
+  }
+
+  void thread(uint32_t threadId, const char* name)
+  {
+    uint32_t length           = (uint32_t) strlen(name) + 1;
+    SampleThreadRecord record = {};
+    record.record             = {SR_THREAD, padded(sizeof(record) + length)};
+    record.threadId           = threadId;
+    record.nameLength         = length;
+    append(&record, sizeof(record));
+    append(name, length);
+    pad();
+  }
+
+  void stack(uint32_t threadId, int64_t timestamp,
+      const std::vector<uint64_t>& addresses)
+  {
+    uint32_t size =
+        (uint32_t) (sizeof(SampleStackRecord) + addresses.size() * 8);
+    SampleStackRecord record = {};
+    record.record            = {SR_STACK, size};
+    record.threadId          = threadId;
+    record.depth             = (uint32_t) addresses.size();
+    record.timestamp         = timestamp;
+    append(&record, sizeof(record));
+    append(addresses.data(), addresses.size() * 8);
+  }
+
+  const char* data() const
+  {
+    return (const char*) words.data();
+  }
+
+  uint64_t length() const
+  {
+    return size;
+  }
+
+private:
+  static uint32_t padded(size_t length)
+  {
+    return (uint32_t) ((length + 7) & ~(size_t) 7);
+  }
+
+  void append(const void* data, size_t length)
+  {
+    words.resize((size + length + 7) / 8);
+    memcpy((char*) words.data() + size, data, length);
+    size += length;
+  }
+
+  void pad()
+  {
+    size = padded(size);
+    words.resize(size / 8);
+  }
+
+  // Words keep the data 8 byte aligned.
+  std::vector<uint64_t> words;
+  size_t size = 0;
+};
+
+TEST(SamplerTest, ReadsRecords)
+{
+  SampleFileBuilder file;
+  file.thread(7, "Main");
+  file.stack(7, 5500000, {0x1000, 0x2000, 0x3000});
+
+  SampleReader reader;
+  ASSERT_TRUE(sample_reader_open(&reader, file.data(), file.length()));
+  EXPECT_EQ(reader.rate, 1000);
+
+  SampleEntry entry;
+  ASSERT_TRUE(sample_reader_next(&reader, &entry));
+  EXPECT_EQ(entry.type, SR_THREAD);
+  EXPECT_EQ(entry.threadId, 7);
+  EXPECT_STREQ(entry.name, "Main");
+
+  ASSERT_TRUE(sample_reader_next(&reader, &entry));
+  EXPECT_EQ(entry.type, SR_STACK);
+  EXPECT_EQ(entry.threadId, 7);
+  EXPECT_DOUBLE_EQ(entry.time, 0.5);
+  ASSERT_EQ(entry.depth, 3);
+  EXPECT_EQ(entry.addresses[0], 0x1000);
+  EXPECT_EQ(entry.addresses[2], 0x3000);
+
+  EXPECT_FALSE(sample_reader_next(&reader, &entry));
+  EXPECT_EQ(reader.offset, reader.length);
+}
+
+TEST(SamplerTest, StopsAtACutShortRecord)
+{
+  SampleFileBuilder file;
+  file.thread(1, "Task worker 0");
+  file.stack(1, 5000000, {0x1000, 0x2000});
+
+  SampleReader reader;
+  ASSERT_TRUE(sample_reader_open(&reader, file.data(), file.length() - 8));
+
+  SampleEntry entry;
+  ASSERT_TRUE(sample_reader_next(&reader, &entry));
+  EXPECT_FALSE(sample_reader_next(&reader, &entry));
+  EXPECT_LT(reader.offset, reader.length);
+}
+
+TEST(SamplerTest, RejectsOtherFiles)
+{
+  const char data[sizeof(SampleFileHeader)] = "OTTERLOG";
+
+  SampleReader reader;
+  EXPECT_FALSE(sample_reader_open(&reader, data, sizeof(data)));
+  EXPECT_FALSE(sample_reader_open(&reader, data, 4));
+}
+
+static volatile LONG g_samplerTestSpinning;
+
+static DWORD WINAPI sampler_test_spin(void* unused)
+{
+  sampler_register_thread("Spinner");
+  while (g_samplerTestSpinning)
+  {
+  }
+  return 0;
+}
+
+TEST(SamplerTest, SamplesRegisteredThreads)
+{
+  const char* path = "sampler_test.bin";
+  ASSERT_TRUE(sampler_start(path, SAMPLER_DEFAULT_RATE));
+  EXPECT_TRUE(sampler_active());
+  EXPECT_FALSE(sampler_start(path, SAMPLER_DEFAULT_RATE));
+
+  g_samplerTestSpinning = 1;
+  DWORD threadId;
+  HANDLE thread =
+      CreateThread(NULL, 0, sampler_test_spin, NULL, 0, &threadId);
+  ASSERT_NE(thread, nullptr);
+  Sleep(200);
+  InterlockedExchange(&g_samplerTestSpinning, 0);
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+
+  sampler_stop();
+  EXPECT_FALSE(sampler_active());
+
+  uint64_t length = 0;
+  char* data      = file_load(path, &length);
+  remove(path);
+  ASSERT_NE(data, nullptr);
+
+  SampleReader reader;
+  ASSERT_TRUE(sample_reader_open(&reader, data, length));
+  int stacks  = 0;
+  int modules = 0;
+  bool named  = false;
+  SampleEntry entry;
+  while (sample_reader_next(&reader, &entry))
+  {
+    if (entry.type == SR_THREAD && entry.threadId == threadId)
+    {
+      named = strcmp(entry.name, "Spinner") == 0;
+    }
+    stacks += entry.type == SR_STACK && entry.threadId == threadId;
+    modules += entry.type == SR_MODULE;
+  }
+  EXPECT_EQ(reader.offset, reader.length);
+  EXPECT_TRUE(named);
+  EXPECT_GT(stacks, 10);
+  EXPECT_GT(modules, 0);
+
+  free(data);
+}
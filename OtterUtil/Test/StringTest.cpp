@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/Json/Json.h"
+#include "Otter/Util/Memory/Arena.h"
+#include "Otter/Util/String/StringBuilder.h"
+#include "Otter/Util/String/StringView.h"
+}
+
+TEST(StringTest, ViewFindAndCompare)
+{
+  StringView view = STRING_VIEW_LITERAL("Body_BaseColor.png");
+
+  EXPECT_EQ(string_view_find(view, STRING_VIEW_LITERAL("_BaseColor")), 4);
+  EXPECT_EQ(string_view_find(view, STRING_VIEW_LITERAL("_Normal")), SIZE_MAX);
+  EXPECT_EQ(string_view_find_char(view, '.'), 14);
+  EXPECT_TRUE(
+      string_view_equals_cstr(string_view_substring(view, 0, 4), "Body"));
+  EXPECT_TRUE(
+      string_view_equals_cstr(string_view_substring(view, 15, 100), "png"));
+  EXPECT_FALSE(string_view_equals_cstr(view, "Body"));
+}
+
+TEST(StringTest, BuilderGrowsInPlaceOnArena)
+{
+  Arena arena;
+  ASSERT_TRUE(arena_create(&arena, ARENA_DEFAULT_BLOCK_SIZE, NULL));
+
+  StringBuilder builder;
+  string_builder_create(&builder, &arena.allocator);
+  ASSERT_TRUE(string_builder_append(&builder, STRING_VIEW_LITERAL("mesh")));
+  const char* start = builder.buffer;
+
+  for (int i = 0; i < 20; i++)
+  {
+    ASSERT_TRUE(string_builder_append_format(&builder, "_%d", i));
+  }
+  ASSERT_TRUE(string_builder_append_char(&builder, '!'));
+  EXPECT_EQ(builder.buffer, start);
+
+  StringView result = string_builder_finish(&builder);
+  EXPECT_EQ(result.data, start);
+  EXPECT_EQ(result.data[result.length], '\0');
+  EXPECT_EQ(strncmp(result.data, "mesh_0_1_2", 10), 0);
+  EXPECT_EQ(result.data[result.length - 1], '!');
+  EXPECT_LT(arena_get_used(&arena), result.length + 1 + ARENA_ALIGNMENT);
+
+  arena_destroy(&arena);
+}
+
+TEST(StringTest, JsonStringsBorrowDocument)
+{
+  const char document[] = "{\"plain\": \"otter\", "
+                          "\"escaped\": \"a\\\"b\\n\\u00e9\"}";
+  size_t cursor         = 0;
+  JsonValue* root       = json_parse(document, sizeof(document) - 1, &cursor);
+  ASSERT_NE(root, nullptr);
+
+  JsonValue* plain =
+      (JsonValue*) hash_map_get_value(&root->object, "plain", strlen("plain"));
+  ASSERT_NE(plain, nullptr);
+  EXPECT_FALSE(plain->ownsString);
+  EXPECT_TRUE(string_view_equals_cstr(plain->string, "otter"));
+  EXPECT_GE(plain->string.data, document);
+  EXPECT_LT(plain->string.data, document + sizeof(document));
+
+  JsonValue* escaped = (JsonValue*) hash_map_get_value(
+      &root->object, "escaped", strlen("escaped"));
+  ASSERT_NE(escaped, nullptr);
+  EXPECT_TRUE(escaped->ownsString);
+  EXPECT_TRUE(string_view_equals_cstr(escaped->string, "a\"b\n\xC3\xA9"));
+
+  json_destroy(root);
+}
@@ -0,0 +1,167 @@
+extern "C"
+{
+#include "Otter/Util/Array/TypedArray.h"
+}
+
+#include <gtest/gtest.h>
+
+struct TestElement
+{
+  int param1;
+  int param2;
+};
+
+TYPED_ARRAY_DEFINE(TestArray, test_array, TestElement);
+TYPED_ARRAY_DEFINE_SMALL(SmallTestArray, small_test_array, TestElement, 4);
+
+TEST(TypedArrayTests, typed_array_create)
+{
+  TestArray array;
+  test_array_create(&array);
+
+  ASSERT_EQ(array.size, 0);
+  ASSERT_EQ(array.capacity, 0);
+  ASSERT_EQ(array.heap, nullptr);
+
+  test_array_destroy(&array);
+}
+
+TEST(TypedArrayTests, typed_array_push_grows_geometrically)
+{
+  TestArray array;
+  test_array_create(&array);
+
+  for (int i = 0; i < 100; i++)
+  {
+    ASSERT_TRUE(test_array_push(&array, {i, -i}));
+  }
+
+  ASSERT_EQ(array.size, 100);
+  ASSERT_EQ(array.capacity, 128);
+  for (int i = 0; i < 100; i++)
+  {
+    ASSERT_EQ(test_array_get(&array, i)->param1, i);
+    ASSERT_EQ(test_array_get(&array, i)->param2, -i);
+  }
+
+  test_array_destroy(&array);
+}
+
+TEST(TypedArrayTests, typed_array_allocate_many)
+{
+  TestArray array;
+  test_array_create(&array);
+
+  TestElement* elements = test_array_allocate_many(&array, 20);
+  ASSERT_NE(elements, nullptr);
+  ASSERT_EQ(array.size, 20);
+  ASSERT_EQ(array.capacity, 32);
+  ASSERT_EQ(elements, test_array_data(&array));
+
+  test_array_destroy(&array);
+}
+
+TEST(TypedArrayTests, typed_array_reserve_and_shrink_to_fit)
+{
+  TestArray array;
+  test_array_create(&array);
+
+  ASSERT_TRUE(test_array_reserve(&array, 50));
+  ASSERT_EQ(array.capacity, 50);
+  TestElement* data = test_array_data(&array);
+  for (int i = 0; i < 50; i++)
+  {
+    test_array_push(&array, {i, i});
+  }
+  ASSERT_EQ(test_array_data(&array), data);
+
+  test_array_pop_many(&array, 40);
+  test_array_shrink_to_fit(&array);
+  ASSERT_EQ(array.capacity, 10);
+  ASSERT_EQ(test_array_get(&array, 9)->param1, 9);
+
+  test_array_clear(&array);
+  test_array_shrink_to_fit(&array);
+  ASSERT_EQ(array.capacity, 0);
+  ASSERT_EQ(array.heap, nullptr);
+
+  test_array_destroy(&array);
+}
+
+TEST(TypedArrayTests, typed_array_pop_shrinks_with_hysteresis)
+{
+  TestArray array;
+  test_array_create(&array);
+
+  test_array_allocate_many(&array, 64);
+  ASSERT_EQ(array.capacity, 64);
+
+  test_array_pop_many(&array, 31);
+  ASSERT_EQ(array.capacity, 64);
+
+  test_array_pop_many(&array, 17);
+  ASSERT_EQ(array.size, 16);
+  ASSERT_EQ(array.capacity, 32);
+
+  test_array_push(&array, {0, 0});
+  test_array_pop(&array);
+  ASSERT_EQ(array.capacity, 32);
+
+  test_array_destroy(&array);
+}
+
+TEST(TypedArrayTests, typed_array_small_stays_inline)
+{
+  SmallTestArray array;
+  small_test_array_create(&array);
+
+  ASSERT_EQ(array.capacity, 4);
+  for (int i = 0; i < 4; i++)
+  {
+    small_test_array_push(&array, {i, i * 2});
+  }
+
+  ASSERT_EQ(array.capacity, 4);
+  ASSERT_EQ(small_test_array_data(&array), array.inlineElements);
+
+  small_test_array_destroy(&array);
+}
+
+TEST(TypedArrayTests, typed_array_small_spills_and_returns)
+{
+  SmallTestArray array;
+  small_test_array_create(&array);
+
+  for (int i = 0; i < 40; i++)
+  {
+    small_test_array_push(&array, {i, i * 2});
+  }
+  ASSERT_GT(array.capacity, 4);
+  ASSERT_NE(small_test_array_data(&array), array.inlineElements);
+
+  small_test_array_pop_many(&array, 37);
+  small_test_array_shrink_to_fit(&array);
+  ASSERT_EQ(array.capacity, 4);
+  ASSERT_EQ(small_test_array_data(&array), array.inlineElements);
+  for (int i = 0; i < 3; i++)
+  {
+    ASSERT_EQ(small_test_array_get(&array, i)->param1, i);
+    ASSERT_EQ(small_test_array_get(&array, i)->param2, i * 2);
+  }
+
+  small_test_array_destroy(&array);
+}
+
+TEST(TypedArrayTests, typed_array_small_is_movable)
+{
+  SmallTestArray array;
+  small_test_array_create(&array);
+  small_test_array_push(&array, {7, 8});
+
+  SmallTestArray moved;
+  memcpy(&moved, &array, sizeof(moved));
+  ASSERT_EQ(small_test_array_get(&moved, 0)->param1, 7);
+  ASSERT_EQ(small_test_array_get(&moved, 0)->param2, 8);
+
+  small_test_array_destroy(&moved);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <Windows.h>
+
+extern "C"
+{
+#include "Otter/Util/Array/SparseAutoArray.h"
+#include "Otter/Util/Array/VirtualArray.h"
+}
+
+TEST(VirtualArrayTest, GrowthNeverMovesElements)
+{
+  VirtualArray array;
+  ASSERT_TRUE(
+      virtual_array_create(&array, sizeof(uint64_t), 1 << 20, VAF_NONE));
+  EXPECT_EQ(array.capacity, 0);
+
+  uint64_t* first = (uint64_t*) virtual_array_allocate(&array);
+  ASSERT_NE(first, nullptr);
+  *first = 42;
+
+  for (uint64_t i = 1; i < 100000; i++)
+  {
+    *(uint64_t*) virtual_array_allocate(&array) = i;
+  }
+
+  EXPECT_EQ(virtual_array_get(&array, 0), first);
+  EXPECT_EQ(*first, 42);
+  EXPECT_EQ(*(uint64_t*) virtual_array_get(&array, 99999), 99999);
+  EXPECT_GE(array.capacity, 100000);
+
+  virtual_array_destroy(&array);
+}
+
+TEST(VirtualArrayTest, ReservationIsALimit)
+{
+  VirtualArray array;
+  ASSERT_TRUE(virtual_array_create(&array, 64, 100, VAF_NONE));
+
+  EXPECT_NE(virtual_array_allocate_many(&array, 100), nullptr);
+  EXPECT_EQ(array.capacity, 100);
+  EXPECT_EQ(virtual_array_allocate(&array), nullptr);
+  EXPECT_EQ(array.size, 100);
+
+  virtual_array_destroy(&array);
+}
+
+TEST(VirtualArrayTest, ShrinkToFitDecommitsTail)
+{
+  VirtualArray array;
+  ASSERT_TRUE(virtual_array_create(&array, 1024, 4096, VAF_NONE));
+
+  char* elements = (char*) virtual_array_allocate_many(&array, 1024);
+  ASSERT_NE(elements, nullptr);
+  memset(elements, 0x5A, 1024 * 1024);
+  size_t committed = array.committedBytes;
+
+  virtual_array_pop_many(&array, 1000);
+  virtual_array_shrink_to_fit(&array);
+  EXPECT_LT(array.committedBytes, committed);
+  EXPECT_GE(array.capacity, 24);
+  EXPECT_EQ((unsigned char) elements[24 * 1024 - 1], 0x5A);
+
+  EXPECT_EQ(virtual_array_allocate_many(&array, 1000), elements + 24 * 1024);
+
+  virtual_array_destroy(&array);
+}
+
+TEST(VirtualArrayTest, LargePagesFallBack)
+{
+  VirtualArray array;
+  ASSERT_TRUE(virtual_array_create(&array, 16, 1024, VAF_LARGE_PAGES));
+
+  EXPECT_NE(virtual_array_allocate_many(&array, 1024), nullptr);
+
+  virtual_array_destroy(&array);
+}
+
+TEST(VirtualArrayTest, ReservedSparseArrayKeepsAddresses)
+{
+  SparseAutoArray list;
+  sparse_auto_array_create_reserved(&list, sizeof(uint64_t), 1 << 16, NULL);
+  ASSERT_TRUE(list.reserved);
+
+  uint64_t firstIndex = sparse_auto_array_allocate(&list);
+  uint64_t* first     = (uint64_t*) sparse_auto_array_get(&list, firstIndex);
+  ASSERT_NE(first, nullptr);
+  *first = 7;
+
+  for (int i = 0; i < 1000; i++)
+  {
+    sparse_auto_array_allocate(&list);
+  }
+  EXPECT_EQ(sparse_auto_array_get(&list, firstIndex), first);
+  EXPECT_EQ(*first, 7);
+  EXPECT_GE(list.components.size, 1001);
+
+  sparse_auto_array_deallocate(&list, 500);
+  EXPECT_EQ(sparse_auto_array_get(&list, 500), nullptr);
+
+  sparse_auto_array_destroy(&list);
+}